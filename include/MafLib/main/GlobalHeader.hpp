@@ -6,6 +6,7 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cassert>
 #include <chrono>
 #include <cmath>
@@ -15,10 +16,14 @@
 #include <execution>
 #include <iomanip>
 #include <iostream>
+#include <limits>
 #include <memory>
+#include <memory_resource>
+#include <numeric>
 #include <optional>
 #include <random>
 #include <ranges>
+#include <set>
 #include <span>
 #include <stdexcept>
 #include <type_traits>
@@ -1,3 +1,6 @@
+#ifndef MATH_H
+#define MATH_H
+#pragma once
 #include "MafLib/main/GlobalHeader.hpp"
 #include "MafLib/utility/UtilMath.hpp"
 
@@ -15,3 +18,5 @@ constexpr static size_t OMP_QUADRATIC_LIMIT = 100 * 100;
 /*** @brief Constant used as OMP lower bound for cubic algorithms. */
 constexpr static size_t OMP_CUBIC_LIMIT = 50 * 50;
 }  // namespace maf::math
+
+#endif
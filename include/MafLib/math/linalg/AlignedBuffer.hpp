@@ -0,0 +1,326 @@
+#ifndef ALIGNED_BUFFER_H
+#define ALIGNED_BUFFER_H
+#pragma once
+#include "MafLib/math/Math.hpp"
+
+/**
+ * @file AlignedBuffer.hpp
+ * @brief Contiguous, cache-line aligned element storage of Matrix and Vector.
+ *
+ * AlignedBuffer<T> is a minimal replacement for std::vector<T> that
+ * - aligns its storage to STORAGE_ALIGNMENT (64) bytes, so rows and SIMD
+ *   loads start on cache-line boundaries,
+ * - can be created uninitialised with the `default_init` tag, so storage
+ *   that is about to be overwritten (e.g. a product) is written only once,
+ * - allocates from a std::pmr::memory_resource. By default this is
+ *   `std::pmr::get_default_resource()`, so an application can route all
+ *   matrix storage through a pool or arena globally with
+ *   `std::pmr::set_default_resource()`, or per object by passing a resource.
+ *
+ * This file is intended to be included by LinAlg.hpp and Gemm.hpp and should
+ * not be included directly anywhere else.
+ */
+namespace maf::math {
+/** @brief Alignment in bytes of every AlignedBuffer allocation. */
+static constexpr size_t STORAGE_ALIGNMENT = 64;
+
+/**
+ * @brief Tag selecting the constructors that leave elements uninitialised.
+ * @details Reading an element before writing it is undefined behaviour.
+ */
+struct default_init_t {
+    explicit default_init_t() = default;
+};
+
+/** @brief Tag value for the uninitialised constructors. */
+inline constexpr default_init_t default_init{};
+
+/**
+ * @brief Owning, 64-byte aligned, contiguous storage of trivially copyable
+ * elements with a pluggable memory resource.
+ * @tparam T Element type (arithmetic types in MafLib).
+ */
+template <typename T>
+class AlignedBuffer {
+    static_assert(std::is_trivially_copyable_v<T> &&
+                      std::is_trivially_destructible_v<T>,
+                  "AlignedBuffer stores trivial element types only!");
+
+public:
+    using value_type = T;
+    using iterator = T*;
+    using const_iterator = const T*;
+    using reverse_iterator = std::reverse_iterator<T*>;
+    using const_reverse_iterator = std::reverse_iterator<const T*>;
+
+    /** @brief Creates an empty buffer. */
+    AlignedBuffer() noexcept : _resource(std::pmr::get_default_resource()) {}
+
+    /** @brief Creates an empty buffer that allocates from resource. */
+    explicit AlignedBuffer(std::pmr::memory_resource* resource) noexcept
+        : _resource(resource != nullptr ? resource
+                                        : std::pmr::get_default_resource()) {}
+
+    /** @brief Creates a buffer of size value-initialised (zero) elements. */
+    explicit AlignedBuffer(size_t size, std::pmr::memory_resource* resource = nullptr)
+        : AlignedBuffer(size, default_init, resource) {
+        std::fill_n(_data, _size, T());
+    }
+
+    /** @brief Creates a buffer of size uninitialised elements. */
+    AlignedBuffer(size_t size,
+                  default_init_t /*unused*/,
+                  std::pmr::memory_resource* resource = nullptr)
+        : AlignedBuffer(resource) {
+        _allocate(size);
+    }
+
+    /** @brief Copies the range [first, last), converting elements to T. */
+    template <std::input_iterator It>
+    AlignedBuffer(It first, It last, std::pmr::memory_resource* resource = nullptr)
+        : AlignedBuffer(resource) {
+        assign(first, last);
+    }
+
+    /** @brief Copies another buffer into storage from the default resource. */
+    AlignedBuffer(const AlignedBuffer& other)
+        : AlignedBuffer(other.size(), default_init) {
+        std::copy_n(other._data, _size, _data);
+    }
+
+    /** @brief Takes over the storage (and memory resource) of another buffer. */
+    AlignedBuffer(AlignedBuffer&& other) noexcept
+        : _data(std::exchange(other._data, nullptr)),
+          _size(std::exchange(other._size, 0)),
+          _resource(other._resource) {}
+
+    AlignedBuffer& operator=(const AlignedBuffer& other) {
+        if (this != &other) {
+            assign(other.begin(), other.end());
+        }
+        return *this;
+    }
+
+    AlignedBuffer& operator=(AlignedBuffer&& other) noexcept {
+        if (this != &other) {
+            _deallocate();
+            _data = std::exchange(other._data, nullptr);
+            _size = std::exchange(other._size, 0);
+            _resource = other._resource;
+        }
+        return *this;
+    }
+
+    ~AlignedBuffer() {
+        _deallocate();
+    }
+
+    // --- Getters ---
+
+    [[nodiscard]] T* data() noexcept {
+        return _data;
+    }
+
+    [[nodiscard]] const T* data() const noexcept {
+        return _data;
+    }
+
+    [[nodiscard]] size_t size() const noexcept {
+        return _size;
+    }
+
+    [[nodiscard]] bool empty() const noexcept {
+        return _size == 0;
+    }
+
+    /** @brief The memory resource this buffer allocates from. */
+    [[nodiscard]] std::pmr::memory_resource* resource() const noexcept {
+        return _resource;
+    }
+
+    T& operator[](size_t index) noexcept {
+        return _data[index];
+    }
+
+    const T& operator[](size_t index) const noexcept {
+        return _data[index];
+    }
+
+    /** @throws std::out_of_range if the index is invalid. */
+    T& at(size_t index) {
+        if (index >= _size) {
+            throw std::out_of_range("Index out of bounds.");
+        }
+        return _data[index];
+    }
+
+    /** @throws std::out_of_range if the index is invalid. */
+    const T& at(size_t index) const {
+        if (index >= _size) {
+            throw std::out_of_range("Index out of bounds.");
+        }
+        return _data[index];
+    }
+
+    // --- Iterators ---
+
+    iterator begin() noexcept {
+        return _data;
+    }
+
+    iterator end() noexcept {
+        return _data + _size;
+    }
+
+    const_iterator begin() const noexcept {
+        return _data;
+    }
+
+    const_iterator end() const noexcept {
+        return _data + _size;
+    }
+
+    const_iterator cbegin() const noexcept {
+        return _data;
+    }
+
+    const_iterator cend() const noexcept {
+        return _data + _size;
+    }
+
+    reverse_iterator rbegin() noexcept {
+        return reverse_iterator(end());
+    }
+
+    reverse_iterator rend() noexcept {
+        return reverse_iterator(begin());
+    }
+
+    const_reverse_iterator rbegin() const noexcept {
+        return const_reverse_iterator(end());
+    }
+
+    const_reverse_iterator rend() const noexcept {
+        return const_reverse_iterator(begin());
+    }
+
+    const_reverse_iterator crbegin() const noexcept {
+        return const_reverse_iterator(end());
+    }
+
+    const_reverse_iterator crend() const noexcept {
+        return const_reverse_iterator(begin());
+    }
+
+    // --- Modifiers ---
+
+    /**
+     * @brief Replaces the contents with [first, last), converting elements to
+     * T. Storage is reused when the size does not change.
+     */
+    template <std::input_iterator It>
+    void assign(It first, It last) {
+        if constexpr (std::forward_iterator<It>) {
+            const auto count = static_cast<size_t>(std::distance(first, last));
+            resize(count, default_init);
+            std::transform(first, last, _data, [](const auto& value) {
+                return static_cast<T>(value);
+            });
+        } else {
+            std::vector<T> staged;
+            for (; first != last; ++first) {
+                staged.push_back(static_cast<T>(*first));
+            }
+            assign(staged.begin(), staged.end());
+        }
+    }
+
+    /**
+     * @brief Changes the size; the first min(size, new size) elements keep
+     * their values and new elements are zero.
+     */
+    void resize(size_t size) {
+        const size_t old_size = std::min(size, _size);
+        resize(size, default_init, old_size);
+        std::fill(_data + old_size, _data + _size, T());
+    }
+
+    /**
+     * @brief Changes the size, keeping the first `keep` elements and leaving
+     * every other element uninitialised.
+     */
+    void resize(size_t size, default_init_t /*unused*/, size_t keep = 0) {
+        if (size == _size) {
+            return;
+        }
+        AlignedBuffer resized(size, default_init, _resource);
+        std::copy_n(_data, std::min({keep, size, _size}), resized._data);
+        *this = std::move(resized);
+    }
+
+    /** @brief Sets every element to value. */
+    void fill(const T& value) noexcept {
+        std::fill_n(_data, _size, value);
+    }
+
+    /** @brief Checks for exact element-wise equality. */
+    [[nodiscard]] bool operator==(const AlignedBuffer& other) const noexcept {
+        return _size == other._size && std::equal(begin(), end(), other.begin());
+    }
+
+private:
+    T* _data = nullptr;
+    size_t _size = 0;
+    std::pmr::memory_resource* _resource;
+
+    [[nodiscard]] static size_t _bytes(size_t size) noexcept {
+        // Whole cache lines, so that SIMD tails never straddle the allocation
+        const size_t bytes = size * sizeof(T);
+        const size_t lines = (bytes + STORAGE_ALIGNMENT - 1) / STORAGE_ALIGNMENT;
+        return lines * STORAGE_ALIGNMENT;
+    }
+
+    void _allocate(size_t size) {
+        if (size == 0) {
+            return;
+        }
+        if (size > std::numeric_limits<size_t>::max() / sizeof(T)) {
+            throw std::length_error("AlignedBuffer size is too large.");
+        }
+        _data = static_cast<T*>(_resource->allocate(_bytes(size), STORAGE_ALIGNMENT));
+        _size = size;
+    }
+
+    void _deallocate() noexcept {
+        if (_data != nullptr) {
+            _resource->deallocate(_data, _bytes(_size), STORAGE_ALIGNMENT);
+            _data = nullptr;
+            _size = 0;
+        }
+    }
+};
+
+namespace detail {
+/**
+ * @brief Leading dimension (in elements) of a padded row-major matrix.
+ *
+ * Rows are rounded up to whole cache lines so that every row starts aligned.
+ * If the resulting row pitch is a multiple of 4 KiB, one extra cache line is
+ * added: otherwise walking down a column hits the same cache set on every
+ * row (4K aliasing) and evicts itself.
+ */
+template <typename T>
+[[nodiscard]] constexpr size_t _padded_leading_dimension(size_t cols) noexcept {
+    constexpr size_t PAGE_BYTES = 4096;
+    const size_t line = std::max<size_t>(1, STORAGE_ALIGNMENT / sizeof(T));
+    size_t ld = ((cols + line - 1) / line) * line;
+    if ((ld * sizeof(T)) % PAGE_BYTES == 0) {
+        ld += line;
+    }
+    return ld;
+}
+
+}  // namespace detail
+}  // namespace maf::math
+
+#endif
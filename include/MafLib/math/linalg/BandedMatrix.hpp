@@ -0,0 +1,864 @@
+#ifndef BANDED_MATRIX_H
+#define BANDED_MATRIX_H
+#pragma once
+#include "LinAlg.hpp"
+
+/**
+ * @file BandedMatrix.hpp
+ * @brief Banded matrices in LAPACK band storage, their LU and Cholesky
+ * factorizations, and O(n) tridiagonal solvers.
+ *
+ * A matrix with `lower` subdiagonals and `upper` superdiagonals is stored
+ * column by column: column j holds the lower + upper + 1 band elements
+ * A(j - upper, j) ... A(j + lower, j), so element (i, j) lives at
+ * `data[j * leading_dimension() + upper + i - j]`. This is the LAPACK "AB"
+ * layout (transposed into a flat array), and every column of the band is
+ * contiguous, which is what the column-oriented factorizations below stream
+ * through.
+ *
+ * - BandedLU: partial pivoting LU (gbtrf). Pivoting widens U to
+ *   lower + upper superdiagonals, which the factor keeps extra room for;
+ *   the cost is O(n * lower * (lower + upper)).
+ * - BandedCholesky: Cholesky of a symmetric positive definite band
+ *   (pbtrf), O(n * lower^2), no pivoting and no fill outside the band.
+ * - solve_tridiagonal(): the Thomas algorithm, O(n), without pivoting.
+ * - solve_tridiagonal_batched(): the Thomas algorithm for many independent
+ *   systems at once, stored one system per column so that the sweeps are
+ *   SIMD across systems and the columns are split across threads.
+ */
+namespace maf::math {
+namespace detail {
+/**
+ * @brief In-place LU with partial pivoting of an n x n band matrix
+ * (LAPACK gbtf2).
+ * @details ab holds the matrix with kl + ku superdiagonals of room: element
+ * (i, j) is ab[j * ldab + kl + ku + i - j], ldab = 2 * kl + ku + 1, and the
+ * kl extra superdiagonals start zeroed. On return the band holds U and the
+ * multipliers of L; row j was swapped with row ipiv[j].
+ * @throws std::runtime_error if the matrix is singular.
+ */
+template <std::floating_point T>
+void _gbtrf(size_t n, size_t kl, size_t ku, T* ab, size_t ldab, size_t* ipiv) {
+    const size_t kv = kl + ku;
+    const auto element = [&](size_t i, size_t j) -> T& {
+        return ab[(j * ldab) + kv + i - j];
+    };
+
+    // Last column touched by the row swaps so far
+    size_t ju = 0;
+    for (size_t j = 0; j < n; ++j) {
+        const size_t km = std::min(kl, n - 1 - j);
+        T* column = &element(j, j);
+
+        size_t p = 0;
+        T max_val = std::abs(column[0]);
+        for (size_t i = 1; i <= km; ++i) {
+            if (std::abs(column[i]) > max_val) {
+                max_val = std::abs(column[i]);
+                p = i;
+            }
+        }
+        if (max_val == T(0)) {
+            throw std::runtime_error("Matrix is singular; pivot is near zero.");
+        }
+        ipiv[j] = j + p;
+        ju = std::max(ju, std::min(j + ku + p, n - 1));
+
+        if (p != 0) {
+            for (size_t c = j; c <= ju; ++c) {
+                std::swap(element(j, c), element(j + p, c));
+            }
+        }
+
+        const T inv_pivot = T(1) / column[0];
+        #pragma omp simd
+        for (size_t i = 1; i <= km; ++i) {
+            column[i] *= inv_pivot;
+        }
+
+        // Rank-1 update of the trailing band, one contiguous column at a time.
+        // Narrow bands skip the parallel region entirely: even a serialized
+        // one costs more than the update itself.
+        const auto update = [&](size_t c) {
+            T* target = &element(j, c);
+            const T u = target[0];
+            #pragma omp simd
+            for (size_t i = 1; i <= km; ++i) {
+                target[i] -= column[i] * u;
+            }
+        };
+        if (km * (ju - j) > OMP_LINEAR_LIMIT) {
+            #pragma omp parallel for
+            for (size_t c = j + 1; c <= ju; ++c) {
+                update(c);
+            }
+        } else {
+            for (size_t c = j + 1; c <= ju; ++c) {
+                update(c);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Solves A X = B in place with the factor of _gbtrf().
+ * @details B is n x m with row stride ldb; the m right-hand sides are
+ * swept together, so every row operation is a SIMD loop over them.
+ */
+template <std::floating_point T>
+void _gbtrs(size_t n,
+            size_t kl,
+            size_t ku,
+            const T* ab,
+            size_t ldab,
+            const size_t* ipiv,
+            T* b,
+            size_t ldb,
+            size_t m) noexcept {
+    const size_t kv = kl + ku;
+    const auto row = [&](size_t i) { return b + (i * ldb); };
+
+    for (size_t j = 0; j < n; ++j) {
+        T* b_j = row(j);
+        if (ipiv[j] != j) {
+            std::swap_ranges(b_j, b_j + m, row(ipiv[j]));
+        }
+        const T* l = ab + (j * ldab) + kv;
+        for (size_t i = 1; i <= std::min(kl, n - 1 - j); ++i) {
+            T* b_i = row(j + i);
+            #pragma omp simd
+            for (size_t r = 0; r < m; ++r) {
+                b_i[r] -= l[i] * b_j[r];
+            }
+        }
+    }
+
+    for (size_t j = n; j-- > 0;) {
+        T* b_j = row(j);
+        const T* u = ab + (j * ldab) + kv - j;
+        const T inv_pivot = T(1) / u[j];
+        #pragma omp simd
+        for (size_t r = 0; r < m; ++r) {
+            b_j[r] *= inv_pivot;
+        }
+        for (size_t i = j > kv ? j - kv : 0; i < j; ++i) {
+            T* b_i = row(i);
+            #pragma omp simd
+            for (size_t r = 0; r < m; ++r) {
+                b_i[r] -= u[i] * b_j[r];
+            }
+        }
+    }
+}
+
+/**
+ * @brief In-place Cholesky of an n x n symmetric positive definite band
+ * matrix with k subdiagonals (LAPACK pbtf2, lower).
+ * @details Element (i, j), j <= i <= j + k, is ab[j * (k + 1) + i - j].
+ * @throws std::invalid_argument if the matrix is not positive definite.
+ */
+template <std::floating_point T>
+void _pbtrf(size_t n, size_t k, T* ab) {
+    const size_t ld = k + 1;
+    for (size_t j = 0; j < n; ++j) {
+        T* column = ab + (j * ld);
+        if (!(column[0] > T(0))) {
+            throw std::invalid_argument("Matrix is not positive definite!");
+        }
+        const T pivot = std::sqrt(column[0]);
+        column[0] = pivot;
+        const size_t km = std::min(k, n - 1 - j);
+        const T inv_pivot = T(1) / pivot;
+        #pragma omp simd
+        for (size_t i = 1; i <= km; ++i) {
+            column[i] *= inv_pivot;
+        }
+
+        // A(j + c.., j + c) -= L(j + c.., j) * L(j + c, j)
+        const auto update = [&](size_t c) {
+            T* target = ab + ((j + c) * ld) - c;
+            const T l_c = column[c];
+            #pragma omp simd
+            for (size_t i = c; i <= km; ++i) {
+                target[i] -= column[i] * l_c;
+            }
+        };
+        if (km * km > OMP_LINEAR_LIMIT) {
+            #pragma omp parallel for
+            for (size_t c = 1; c <= km; ++c) {
+                update(c);
+            }
+        } else {
+            for (size_t c = 1; c <= km; ++c) {
+                update(c);
+            }
+        }
+    }
+}
+
+/** @brief Solves A X = B in place with the factor of _pbtrf(). */
+template <std::floating_point T>
+void _pbtrs(size_t n, size_t k, const T* ab, T* b, size_t ldb, size_t m) noexcept {
+    const size_t ld = k + 1;
+    const auto row = [&](size_t i) { return b + (i * ldb); };
+
+    // L Y = B
+    for (size_t j = 0; j < n; ++j) {
+        const T* column = ab + (j * ld);
+        T* b_j = row(j);
+        const T inv_pivot = T(1) / column[0];
+        #pragma omp simd
+        for (size_t r = 0; r < m; ++r) {
+            b_j[r] *= inv_pivot;
+        }
+        for (size_t i = 1; i <= std::min(k, n - 1 - j); ++i) {
+            T* b_i = row(j + i);
+            #pragma omp simd
+            for (size_t r = 0; r < m; ++r) {
+                b_i[r] -= column[i] * b_j[r];
+            }
+        }
+    }
+
+    // L^T X = Y
+    for (size_t j = n; j-- > 0;) {
+        const T* column = ab + (j * ld);
+        T* b_j = row(j);
+        for (size_t i = 1; i <= std::min(k, n - 1 - j); ++i) {
+            const T* b_i = row(j + i);
+            #pragma omp simd
+            for (size_t r = 0; r < m; ++r) {
+                b_j[r] -= column[i] * b_i[r];
+            }
+        }
+        const T inv_pivot = T(1) / column[0];
+        #pragma omp simd
+        for (size_t r = 0; r < m; ++r) {
+            b_j[r] *= inv_pivot;
+        }
+    }
+}
+
+/**
+ * @brief Copies (and converts) the right-hand sides of a band solve.
+ * @throws std::invalid_argument if B does not have n rows.
+ */
+template <typename T, MatrixOperand E>
+[[nodiscard]] Matrix<T> _band_right_hand_sides(size_t n, const E& b) {
+    if (b.row_count() != n) {
+        throw std::invalid_argument("Right-hand side size does not match!");
+    }
+    Matrix<T> x(n, b.column_count(), default_init);
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j < b.column_count(); ++j) {
+            x(i, j) = static_cast<T>(b(i, j));
+        }
+    }
+    return x;
+}
+
+/**
+ * @brief Runs a band solve on B (n x m, row stride ldb) in column blocks
+ * of BLOCK_SIZE right-hand sides, in parallel when there are several.
+ */
+template <typename T, typename Solve>
+void _band_solve_blocks(size_t n, size_t m, T* b, size_t ldb, Solve&& solve) {
+    const size_t blocks = (m + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    #pragma omp parallel for if (blocks > 1 && n * m > OMP_LINEAR_LIMIT)
+    for (size_t block = 0; block < blocks; ++block) {
+        const size_t first = block * BLOCK_SIZE;
+        solve(b + first, ldb, std::min<size_t>(BLOCK_SIZE, m - first));
+    }
+}
+
+}  // namespace detail
+
+/**
+ * @brief A rows x cols matrix with `lower` subdiagonals and `upper`
+ * superdiagonals, in LAPACK band storage.
+ *
+ * Only the (lower + upper + 1) * cols band elements are stored. Elements
+ * outside the band are zero and cannot be written.
+ *
+ * @tparam T Numeric type of the elements.
+ */
+template <Numeric T>
+class BandedMatrix {
+public:
+    /** @brief The numeric type of the matrix elements. */
+    using value_type = T;
+
+    // --- Constructors ---
+
+    /**
+     * @brief Creates a zero rows x cols matrix with the given bandwidths.
+     * @throws std::invalid_argument if dimensions are zero.
+     */
+    BandedMatrix(size_t rows, size_t cols, size_t lower, size_t upper)
+        : _rows(rows),
+          _cols(cols),
+          _lower(lower),
+          _upper(upper),
+          _data((lower + upper + 1) * cols) {
+        if (_rows == 0 || _cols == 0) {
+            throw std::invalid_argument("Matrix dimensions must be greater than zero.");
+        }
+    }
+
+    /**
+     * @brief Copies the band of a dense matrix; elements outside the band
+     * are ignored.
+     * @throws std::invalid_argument if the operand has zero dimensions.
+     */
+    template <MatrixOperand E>
+    BandedMatrix(const E& dense, size_t lower, size_t upper)
+        : BandedMatrix(dense.row_count(), dense.column_count(), lower, upper) {
+        for (size_t j = 0; j < _cols; ++j) {
+            for (size_t i = _first_row(j); i <= _last_row(j); ++i) {
+                (*this)(i, j) = static_cast<T>(dense(i, j));
+            }
+        }
+    }
+
+    /**
+     * @brief Creates an n x n tridiagonal matrix.
+     * @param lower The n - 1 subdiagonal elements A(i + 1, i).
+     * @param diagonal The n diagonal elements.
+     * @param upper The n - 1 superdiagonal elements A(i, i + 1).
+     * @throws std::invalid_argument if the sizes do not match.
+     */
+    [[nodiscard]] static BandedMatrix tridiagonal(std::span<const T> lower,
+                                                  std::span<const T> diagonal,
+                                                  std::span<const T> upper) {
+        const size_t n = diagonal.size();
+        if (n == 0 || lower.size() + 1 != n || upper.size() + 1 != n) {
+            throw std::invalid_argument(
+                "Tridiagonal matrix needs n - 1 sub-, n diagonal and n - 1 "
+                "superdiagonal elements!");
+        }
+        BandedMatrix result(n, n, 1, 1);
+        for (size_t i = 0; i < n; ++i) {
+            result(i, i) = diagonal[i];
+            if (i + 1 < n) {
+                result(i + 1, i) = lower[i];
+                result(i, i + 1) = upper[i];
+            }
+        }
+        return result;
+    }
+
+    // --- Getters ---
+
+    [[nodiscard]] size_t row_count() const noexcept {
+        return _rows;
+    }
+
+    [[nodiscard]] size_t column_count() const noexcept {
+        return _cols;
+    }
+
+    /** @brief Number of subdiagonals (kl). */
+    [[nodiscard]] size_t lower_bandwidth() const noexcept {
+        return _lower;
+    }
+
+    /** @brief Number of superdiagonals (ku). */
+    [[nodiscard]] size_t upper_bandwidth() const noexcept {
+        return _upper;
+    }
+
+    /** @brief Distance between consecutive columns of the band storage. */
+    [[nodiscard]] size_t leading_dimension() const noexcept {
+        return _lower + _upper + 1;
+    }
+
+    [[nodiscard]] bool is_square() const noexcept {
+        return _rows == _cols;
+    }
+
+    /** @brief Whether (row, col) lies inside the matrix and the band. */
+    [[nodiscard]] bool in_band(size_t row, size_t col) const noexcept {
+        return row < _rows && col < _cols && row + _upper >= col &&
+               col + _lower >= row;
+    }
+
+    /** @brief The band storage; see the file description for the layout. */
+    [[nodiscard]] std::span<const T> band_data() const noexcept {
+        return {_data.data(), _data.size()};
+    }
+
+    [[nodiscard]] std::span<T> band_data() noexcept {
+        return {_data.data(), _data.size()};
+    }
+
+    /**
+     * @brief Unchecked access to an element inside the band.
+     * @details (row, col) must satisfy in_band(); use at() otherwise.
+     */
+    [[nodiscard]] T& operator()(size_t row, size_t col) noexcept {
+        return _data[(col * leading_dimension()) + _upper + row - col];
+    }
+
+    [[nodiscard]] const T& operator()(size_t row, size_t col) const noexcept {
+        return _data[(col * leading_dimension()) + _upper + row - col];
+    }
+
+    /**
+     * @brief Reads element (row, col), zero outside the band.
+     * @throws std::out_of_range if the index is invalid.
+     */
+    [[nodiscard]] T at(size_t row, size_t col) const {
+        if (row >= _rows || col >= _cols) {
+            throw std::out_of_range("Matrix index out of range.");
+        }
+        return in_band(row, col) ? (*this)(row, col) : T(0);
+    }
+
+    // --- Methods ---
+
+    /** @brief Expands the matrix into dense storage. */
+    [[nodiscard]] Matrix<T> to_dense() const {
+        Matrix<T> result(_rows, _cols);
+        for (size_t j = 0; j < _cols; ++j) {
+            for (size_t i = _first_row(j); i <= _last_row(j); ++i) {
+                result(i, j) = (*this)(i, j);
+            }
+        }
+        return result;
+    }
+
+    // --- Operators ---
+
+    [[nodiscard]] bool operator==(const BandedMatrix& other) const noexcept {
+        return _rows == other._rows && _cols == other._cols &&
+               _lower == other._lower && _upper == other._upper &&
+               _data == other._data;
+    }
+
+    BandedMatrix& operator*=(T scalar) noexcept {
+        for (T& value : _data) {
+            value *= scalar;
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Banded matrix - vector multiplication, O(rows * bandwidth).
+     * @details Every row is a dot product along the band, rows in parallel.
+     * @throws std::invalid_argument if the vector is a row vector or the
+     * sizes do not match.
+     */
+    template <Numeric U>
+    [[nodiscard]] auto operator*(const Vector<U>& x) const {
+        using R = std::common_type_t<T, U>;
+        if (x.orientation() == Orientation::ROW) {
+            throw std::invalid_argument(
+                "Invalid multiplication: matrix * row vector.\n"
+                "Did you mean Vector * Matrix?");
+        }
+        if (x.size() != _cols) {
+            throw std::invalid_argument(
+                "Dimension mismatch in BandedMatrix * Vector multiplication.");
+        }
+        Vector<R> result(_rows, default_init, COLUMN);
+        const size_t ld = leading_dimension();
+        #pragma omp parallel for schedule(static) if (_rows * ld > OMP_LINEAR_LIMIT)
+        for (size_t i = 0; i < _rows; ++i) {
+            const size_t first = i > _lower ? i - _lower : 0;
+            const size_t last = std::min(i + _upper + 1, _cols);
+            R sum = R(0);
+            for (size_t j = first; j < last; ++j) {
+                sum += static_cast<R>((*this)(i, j)) * static_cast<R>(x[j]);
+            }
+            result[i] = sum;
+        }
+        return result;
+    }
+
+private:
+    size_t _rows;
+    size_t _cols;
+    size_t _lower;
+    size_t _upper;
+    AlignedBuffer<T> _data;
+
+    [[nodiscard]] size_t _first_row(size_t col) const noexcept {
+        return col > _upper ? col - _upper : 0;
+    }
+
+    [[nodiscard]] size_t _last_row(size_t col) const noexcept {
+        return std::min(col + _lower, _rows - 1);
+    }
+};
+
+/**
+ * @brief LU factorization with partial pivoting P A = L U of a square
+ * BandedMatrix.
+ *
+ * L keeps the lower bandwidth kl; row interchanges widen U to kl + ku
+ * superdiagonals, so the factor is stored with 2 * kl + ku + 1 band rows
+ * (as in LAPACK gbtrf). Factoring costs O(n * kl * (kl + ku)) and each
+ * solve O(n * (2 * kl + ku)), against O(n^3) and O(n^2) for the dense plu().
+ *
+ * @tparam T Floating point type of the factor.
+ */
+template <std::floating_point T>
+class BandedLU {
+public:
+    /**
+     * @brief Factors a square banded matrix.
+     * @throws std::invalid_argument if the matrix is not square.
+     * @throws std::runtime_error if the matrix is singular.
+     */
+    template <Numeric U>
+    explicit BandedLU(const BandedMatrix<U>& a)
+        : _n(a.row_count()),
+          _kl(a.lower_bandwidth()),
+          _ku(a.upper_bandwidth()),
+          _factor(((2 * _kl) + _ku + 1) * _n),
+          _pivots(_n, default_init) {
+        if (!a.is_square()) {
+            throw std::invalid_argument("Matrix must be square for LU decomposition!");
+        }
+        const size_t ld = _leading_dimension();
+        for (size_t j = 0; j < _n; ++j) {
+            const size_t first = j > _ku ? j - _ku : 0;
+            const size_t last = std::min(j + _kl, _n - 1);
+            for (size_t i = first; i <= last; ++i) {
+                _factor[(j * ld) + _kl + _ku + i - j] = static_cast<T>(a(i, j));
+            }
+        }
+        detail::_gbtrf(_n, _kl, _ku, _factor.data(), ld, _pivots.data());
+    }
+
+    // --- Getters ---
+
+    [[nodiscard]] size_t size() const noexcept {
+        return _n;
+    }
+
+    /** @brief Row j was interchanged with row pivots()[j] at step j. */
+    [[nodiscard]] std::span<const size_t> pivots() const noexcept {
+        return {_pivots.data(), _pivots.size()};
+    }
+
+    // --- Methods ---
+
+    /**
+     * @brief Solves A x = b.
+     * @throws std::invalid_argument if the size of b does not match.
+     */
+    template <Numeric U>
+    [[nodiscard]] Vector<T> solve(const Vector<U>& b) const {
+        if (b.size() != _n) {
+            throw std::invalid_argument("Right-hand side size does not match!");
+        }
+        Vector<T> x(_n, default_init, b.orientation());
+        for (size_t i = 0; i < _n; ++i) {
+            x[i] = static_cast<T>(b[i]);
+        }
+        detail::_gbtrs(_n,
+                       _kl,
+                       _ku,
+                       _factor.data(),
+                       _leading_dimension(),
+                       _pivots.data(),
+                       x.data().data(),
+                       1,
+                       1);
+        return x;
+    }
+
+    /**
+     * @brief Solves A X = B for every column of B.
+     * @throws std::invalid_argument if the row count of B does not match.
+     */
+    template <MatrixOperand E>
+    [[nodiscard]] Matrix<T> solve(const E& b) const {
+        Matrix<T> x = detail::_band_right_hand_sides<T>(_n, b);
+        detail::_band_solve_blocks(
+            _n,
+            x.column_count(),
+            x.data().data(),
+            x.leading_dimension(),
+            [&](T* block, size_t ldb, size_t m) {
+                detail::_gbtrs(_n,
+                               _kl,
+                               _ku,
+                               _factor.data(),
+                               _leading_dimension(),
+                               _pivots.data(),
+                               block,
+                               ldb,
+                               m);
+            });
+        return x;
+    }
+
+    /** @brief det(A), the signed product of the pivots. */
+    [[nodiscard]] T determinant() const noexcept {
+        const size_t ld = _leading_dimension();
+        T result = T(1);
+        for (size_t j = 0; j < _n; ++j) {
+            result *= _factor[(j * ld) + _kl + _ku];
+            if (_pivots[j] != j) {
+                result = -result;
+            }
+        }
+        return result;
+    }
+
+private:
+    size_t _n;
+    size_t _kl;
+    size_t _ku;
+    AlignedBuffer<T> _factor;
+    AlignedBuffer<size_t> _pivots;
+
+    [[nodiscard]] size_t _leading_dimension() const noexcept {
+        return (2 * _kl) + _ku + 1;
+    }
+};
+
+/**
+ * @brief Cholesky factorization A = L L^T of a symmetric positive definite
+ * BandedMatrix.
+ *
+ * L has the lower bandwidth of A, so the factor needs no more storage than
+ * the lower band. Factoring costs O(n * k^2) and each solve O(n * k) for k
+ * subdiagonals.
+ *
+ * @tparam T Floating point type of the factor.
+ */
+template <std::floating_point T>
+class BandedCholesky {
+public:
+    /**
+     * @brief Factors a symmetric positive definite banded matrix.
+     * @details A matrix with no superdiagonals is taken as the lower band
+     * of a symmetric matrix; otherwise both bands must be stored and equal.
+     * @throws std::invalid_argument if the matrix is not square, not
+     * symmetric or not positive definite.
+     */
+    template <Numeric U>
+    explicit BandedCholesky(const BandedMatrix<U>& a)
+        : _n(a.row_count()), _k(a.lower_bandwidth()), _factor((_k + 1) * _n) {
+        if (!a.is_square()) {
+            throw std::invalid_argument(
+                "Matrix must be square for Cholesky decomposition!");
+        }
+        const bool lower_only = a.upper_bandwidth() == 0;
+        if (!lower_only && a.upper_bandwidth() != _k) {
+            throw std::invalid_argument(
+                "Matrix must be symmetric to try Cholesky decomposition!");
+        }
+        for (size_t j = 0; j < _n; ++j) {
+            for (size_t i = j; i <= std::min(j + _k, _n - 1); ++i) {
+                if (!lower_only && !is_close(a(i, j), a(j, i))) {
+                    throw std::invalid_argument(
+                        "Matrix must be symmetric to try Cholesky decomposition!");
+                }
+                _factor[(j * (_k + 1)) + i - j] = static_cast<T>(a(i, j));
+            }
+        }
+        detail::_pbtrf(_n, _k, _factor.data());
+    }
+
+    // --- Getters ---
+
+    [[nodiscard]] size_t size() const noexcept {
+        return _n;
+    }
+
+    /** @brief The factor L as a BandedMatrix with no superdiagonals. */
+    [[nodiscard]] BandedMatrix<T> factor() const {
+        BandedMatrix<T> result(_n, _n, _k, 0);
+        std::ranges::copy(_factor, result.band_data().begin());
+        return result;
+    }
+
+    // --- Methods ---
+
+    /**
+     * @brief Solves A x = b.
+     * @throws std::invalid_argument if the size of b does not match.
+     */
+    template <Numeric U>
+    [[nodiscard]] Vector<T> solve(const Vector<U>& b) const {
+        if (b.size() != _n) {
+            throw std::invalid_argument("Right-hand side size does not match!");
+        }
+        Vector<T> x(_n, default_init, b.orientation());
+        for (size_t i = 0; i < _n; ++i) {
+            x[i] = static_cast<T>(b[i]);
+        }
+        detail::_pbtrs(_n, _k, _factor.data(), x.data().data(), 1, 1);
+        return x;
+    }
+
+    /**
+     * @brief Solves A X = B for every column of B.
+     * @throws std::invalid_argument if the row count of B does not match.
+     */
+    template <MatrixOperand E>
+    [[nodiscard]] Matrix<T> solve(const E& b) const {
+        Matrix<T> x = detail::_band_right_hand_sides<T>(_n, b);
+        detail::_band_solve_blocks(
+            _n,
+            x.column_count(),
+            x.data().data(),
+            x.leading_dimension(),
+            [&](T* block, size_t ldb, size_t m) {
+                detail::_pbtrs(_n, _k, _factor.data(), block, ldb, m);
+            });
+        return x;
+    }
+
+    /** @brief log(det(A)) = 2 * sum(log(L(j, j))). */
+    [[nodiscard]] T log_determinant() const noexcept {
+        T sum = T(0);
+        for (size_t j = 0; j < _n; ++j) {
+            sum += std::log(_factor[j * (_k + 1)]);
+        }
+        return T(2) * sum;
+    }
+
+private:
+    size_t _n;
+    size_t _k;
+    AlignedBuffer<T> _factor;
+};
+
+/**
+ * @brief Solves a tridiagonal system with the Thomas algorithm in O(n).
+ *
+ * There is no pivoting, so the system should be diagonally dominant or
+ * symmetric positive definite (as spline and finite-difference systems
+ * are); use BandedLU otherwise.
+ *
+ * @param lower The n - 1 subdiagonal elements A(i + 1, i).
+ * @param diagonal The n diagonal elements.
+ * @param upper The n - 1 superdiagonal elements A(i, i + 1).
+ * @param rhs The right-hand side, of size n.
+ * @return (Vector<T>) The solution, with the orientation of rhs.
+ *
+ * @throws std::invalid_argument if the sizes do not match.
+ * @throws std::runtime_error if a pivot is zero.
+ */
+template <std::floating_point T, Numeric U>
+[[nodiscard]] Vector<T> solve_tridiagonal(std::span<const T> lower,
+                                          std::span<const T> diagonal,
+                                          std::span<const T> upper,
+                                          const Vector<U>& rhs) {
+    const size_t n = diagonal.size();
+    if (n == 0 || lower.size() + 1 != n || upper.size() + 1 != n ||
+        rhs.size() != n) {
+        throw std::invalid_argument("Tridiagonal system sizes do not match!");
+    }
+
+    AlignedBuffer<T> c(n, default_init);
+    Vector<T> x(n, default_init, rhs.orientation());
+    T denominator = diagonal[0];
+    for (size_t i = 0; i < n; ++i) {
+        if (i > 0) {
+            denominator = diagonal[i] - (lower[i - 1] * c[i - 1]);
+        }
+        if (denominator == T(0)) {
+            throw std::runtime_error("Matrix is singular; pivot is near zero.");
+        }
+        const T inv = T(1) / denominator;
+        c[i] = i + 1 < n ? upper[i] * inv : T(0);
+        const T previous = i > 0 ? lower[i - 1] * x[i - 1] : T(0);
+        x[i] = (static_cast<T>(rhs[i]) - previous) * inv;
+    }
+    for (size_t i = n - 1; i-- > 0;) {
+        x[i] -= c[i] * x[i + 1];
+    }
+    return x;
+}
+
+/**
+ * @brief Solves many independent tridiagonal systems of the same size in
+ * place with the Thomas algorithm.
+ *
+ * System s is stored in column s of the n x batch matrices: lower(i, s) =
+ * A_s(i, i - 1), diagonal(i, s) = A_s(i, i), upper(i, s) = A_s(i, i + 1),
+ * and rhs(i, s) is its right-hand side, overwritten with the solution.
+ * lower(0, s) and upper(n - 1, s) are not read. In this layout step i of
+ * the sweeps is one SIMD loop over a row (all systems at once), and the
+ * systems are split across threads in column blocks.
+ *
+ * @throws std::invalid_argument if the shapes do not match.
+ * @throws std::runtime_error if a pivot of any system is zero.
+ */
+template <std::floating_point T>
+void solve_tridiagonal_batched(const Matrix<T>& lower,
+                               const Matrix<T>& diagonal,
+                               const Matrix<T>& upper,
+                               Matrix<T>& rhs) {
+    const size_t n = diagonal.row_count();
+    const size_t batch = diagonal.column_count();
+    const auto same_shape = [&](const Matrix<T>& m) {
+        return m.row_count() == n && m.column_count() == batch;
+    };
+    if (!same_shape(lower) || !same_shape(upper) || !same_shape(rhs)) {
+        throw std::invalid_argument("Tridiagonal system sizes do not match!");
+    }
+
+    // Column block of one task; a few cache lines wide
+    constexpr size_t width = 256;
+    const size_t blocks = (batch + width - 1) / width;
+    AlignedBuffer<T> c(n * batch, default_init);
+    bool singular = false;
+
+    #pragma omp parallel for reduction(|| : singular) if (n * batch > OMP_LINEAR_LIMIT)
+    for (size_t block = 0; block < blocks; ++block) {
+        const size_t first = block * width;
+        const size_t last = std::min(first + width, batch);
+        const T* b_0 = diagonal.row_span(0).data();
+        const T* u_0 = upper.row_span(0).data();
+        T* d_0 = rhs.row_span(0).data();
+        #pragma omp simd reduction(|| : singular)
+        for (size_t s = first; s < last; ++s) {
+            singular = singular || b_0[s] == T(0);
+            const T inv = T(1) / b_0[s];
+            c[s] = n > 1 ? u_0[s] * inv : T(0);
+            d_0[s] *= inv;
+        }
+        for (size_t i = 1; i < n; ++i) {
+            const T* a = lower.row_span(i).data();
+            const T* b = diagonal.row_span(i).data();
+            const T* u = upper.row_span(i).data();
+            const T* c_prev = c.data() + ((i - 1) * batch);
+            const T* d_prev = rhs.row_span(i - 1).data();
+            T* c_i = c.data() + (i * batch);
+            T* d = rhs.row_span(i).data();
+            const bool has_upper = i + 1 < n;
+            #pragma omp simd reduction(|| : singular)
+            for (size_t s = first; s < last; ++s) {
+                const T denominator = b[s] - (a[s] * c_prev[s]);
+                singular = singular || denominator == T(0);
+                const T inv = T(1) / denominator;
+                c_i[s] = has_upper ? u[s] * inv : T(0);
+                d[s] = (d[s] - (a[s] * d_prev[s])) * inv;
+            }
+        }
+        for (size_t i = n - 1; i-- > 0;) {
+            T* x = rhs.row_span(i).data();
+            const T* x_next = rhs.row_span(i + 1).data();
+            const T* c_i = c.data() + (i * batch);
+            #pragma omp simd
+            for (size_t s = first; s < last; ++s) {
+                x[s] -= c_i[s] * x_next[s];
+            }
+        }
+    }
+
+    if (singular) {
+        throw std::runtime_error("Matrix is singular; pivot is near zero.");
+    }
+}
+
+}  // namespace maf::math
+
+#endif
@@ -0,0 +1,209 @@
+#ifndef BATCHED_GEMM_H
+#define BATCHED_GEMM_H
+#pragma once
+#include "Matrix.hpp"
+
+/**
+ * @file BatchedGemm.hpp
+ * @brief Many independent small products C_l = alpha * A_l * B_l + beta * C_l.
+ *
+ * For matrices of a few rows and columns the packed GEMM engine is all
+ * overhead, and a SIMD loop over one product runs along a dimension of 3 or
+ * 4 elements. The batched kernel instead vectorizes across the batch:
+ * - members are processed in groups of BATCH_LANES (one cache line of T),
+ * - each group is copied into interleaved SoA buffers in which element
+ *   (i, j) of all members of the group is contiguous,
+ * - the inner loop of the kernel then runs over the members of the group,
+ *   so every SIMD lane computes the same element of a different product,
+ * - groups are distributed across threads with OpenMP, each thread reusing
+ *   its own interleave buffers, so nothing is allocated per product.
+ *
+ * This file is included by Matrix.hpp and should not be included directly
+ * anywhere else.
+ */
+namespace maf::math {
+namespace detail {
+/** @brief Batch members per interleaved group: one cache line of T. */
+template <typename T>
+constexpr static size_t BATCH_LANES = STORAGE_ALIGNMENT / sizeof(T);
+
+/**
+ * @brief Batched GEMM over members addressed by accessors.
+ * @param a_at a_at(l, i, p) returns A_l(i, p).
+ * @param b_at b_at(l, p, j) returns B_l(p, j).
+ * @param c_at c_at(l, i, j) returns a reference to C_l(i, j).
+ */
+template <Numeric T, typename AAt, typename BAt, typename CAt>
+void _batched_gemm(size_t batch,
+                   size_t m,
+                   size_t n,
+                   size_t k,
+                   T alpha,
+                   const AAt& a_at,
+                   const BAt& b_at,
+                   T beta,
+                   const CAt& c_at) {
+    constexpr size_t W = BATCH_LANES<T>;
+    if (batch == 0 || m == 0 || n == 0) {
+        return;
+    }
+
+    const size_t groups = (batch + W - 1) / W;
+    const bool parallel = batch * m * n * std::max<size_t>(k, 1) > GEMM_OMP_LIMIT;
+
+    #pragma omp parallel if (parallel)
+    {
+        AlignedBuffer<T> a_lanes(m * k * W, default_init);
+        AlignedBuffer<T> b_lanes(k * n * W, default_init);
+
+        #pragma omp for schedule(static)
+        for (size_t g = 0; g < groups; ++g) {
+            const size_t first = g * W;
+            const size_t lanes = std::min(W, batch - first);
+
+            // Interleave: element (i, p) of member first + l goes to lane l.
+            // Lanes past the end of the batch are zero.
+            for (size_t i = 0; i < m; ++i) {
+                for (size_t p = 0; p < k; ++p) {
+                    T* dst = a_lanes.data() + (((i * k) + p) * W);
+                    for (size_t l = 0; l < lanes; ++l) {
+                        dst[l] = a_at(first + l, i, p);
+                    }
+                    std::fill(dst + lanes, dst + W, T(0));
+                }
+            }
+            for (size_t p = 0; p < k; ++p) {
+                for (size_t j = 0; j < n; ++j) {
+                    T* dst = b_lanes.data() + (((p * n) + j) * W);
+                    for (size_t l = 0; l < lanes; ++l) {
+                        dst[l] = b_at(first + l, p, j);
+                    }
+                    std::fill(dst + lanes, dst + W, T(0));
+                }
+            }
+
+            for (size_t i = 0; i < m; ++i) {
+                for (size_t j = 0; j < n; ++j) {
+                    alignas(STORAGE_ALIGNMENT) T acc[W] = {};
+                    for (size_t p = 0; p < k; ++p) {
+                        const T* a_ip = a_lanes.data() + (((i * k) + p) * W);
+                        const T* b_pj = b_lanes.data() + (((p * n) + j) * W);
+                        #pragma omp simd aligned(a_ip, b_pj : STORAGE_ALIGNMENT)
+                        for (size_t l = 0; l < W; ++l) {
+                            acc[l] += a_ip[l] * b_pj[l];
+                        }
+                    }
+                    for (size_t l = 0; l < lanes; ++l) {
+                        T& c_ij = c_at(first + l, i, j);
+                        c_ij = (beta == T(0)) ? alpha * acc[l]
+                                              : (alpha * acc[l]) + (beta * c_ij);
+                    }
+                }
+            }
+        }
+    }
+}
+
+}  // namespace detail
+
+/**
+ * @brief Computes C_l = alpha * A_l * B_l + beta * C_l for every member l of
+ * a batch of same-shape views.
+ *
+ * The views may have any strides (e.g. blocks of larger matrices or
+ * transposes). C views must not overlap each other or any A or B view. When
+ * beta is zero C is not read.
+ *
+ * @param alpha Scalar multiplying every product.
+ * @param a Left operands, all m x k.
+ * @param b Right operands, all k x n.
+ * @param beta Scalar multiplying every C.
+ * @param c Results, all m x n.
+ * @throws std::invalid_argument if the batch sizes or shapes differ.
+ */
+template <Numeric T>
+void batched_gemm(T alpha,
+                  std::span<const ConstMatrixView<std::type_identity_t<T>>> a,
+                  std::span<const ConstMatrixView<std::type_identity_t<T>>> b,
+                  T beta,
+                  std::span<const MatrixView<std::type_identity_t<T>>> c) {
+    if (a.size() != b.size() || a.size() != c.size()) {
+        throw std::invalid_argument("Batch sizes do not match!");
+    }
+    if (a.empty()) {
+        return;
+    }
+    const size_t m = a[0].row_count();
+    const size_t k = a[0].column_count();
+    const size_t n = b[0].column_count();
+    for (size_t l = 0; l < a.size(); ++l) {
+        if (a[l].row_count() != m || a[l].column_count() != k ||
+            b[l].row_count() != k || b[l].column_count() != n ||
+            c[l].row_count() != m || c[l].column_count() != n) {
+            throw std::invalid_argument(
+                "Batched matrices must all have the same shape!");
+        }
+    }
+
+    detail::_batched_gemm(
+        a.size(),
+        m,
+        n,
+        k,
+        alpha,
+        [&](size_t l, size_t i, size_t p) { return a[l](i, p); },
+        [&](size_t l, size_t p, size_t j) { return b[l](p, j); },
+        beta,
+        [&](size_t l, size_t i, size_t j) -> T& { return c[l](i, j); });
+}
+
+/**
+ * @brief Computes C_l = alpha * A_l * B_l + beta * C_l for a strided batch.
+ *
+ * Member l of A is the dense row-major m x k matrix starting at
+ * a + l * stride_a, and likewise for B (k x n) and C (m x n). This is the
+ * layout of e.g. a std::vector holding the members back to back.
+ *
+ * @param batch Number of members.
+ * @param m Rows of every A and C.
+ * @param n Columns of every B and C.
+ * @param k Columns of every A and rows of every B.
+ * @param alpha Scalar multiplying every product.
+ * @param a Pointer to the first A.
+ * @param stride_a Distance between consecutive A members (>= m * k).
+ * @param b Pointer to the first B.
+ * @param stride_b Distance between consecutive B members (>= k * n).
+ * @param beta Scalar multiplying every C. When zero, C is write-only.
+ * @param c Pointer to the first C. Must not overlap A or B.
+ * @param stride_c Distance between consecutive C members (>= m * n).
+ */
+template <Numeric T>
+void batched_gemm(size_t batch,
+                  size_t m,
+                  size_t n,
+                  size_t k,
+                  T alpha,
+                  const T* a,
+                  size_t stride_a,
+                  const T* b,
+                  size_t stride_b,
+                  T beta,
+                  T* c,
+                  size_t stride_c) {
+    detail::_batched_gemm(
+        batch,
+        m,
+        n,
+        k,
+        alpha,
+        [&](size_t l, size_t i, size_t p) { return a[(l * stride_a) + (i * k) + p]; },
+        [&](size_t l, size_t p, size_t j) { return b[(l * stride_b) + (p * n) + j]; },
+        beta,
+        [&](size_t l, size_t i, size_t j) -> T& {
+            return c[(l * stride_c) + (i * n) + j];
+        });
+}
+
+}  // namespace maf::math
+
+#endif
@@ -5,72 +5,233 @@
 
 namespace maf::math {
 namespace detail {
+/** @brief Tile size of the task-based dense Cholesky. */
+constexpr static size_t CHOLESKY_TILE = 2 * BLOCK_SIZE;
+
 /**
- * @brief Internal implementation of Cholesky decomposition.
- *
- * Computes L where A = LL^T for symmetric positive definite matrix A.
- * Uses blocked algorithm with OpenMP parallelization.
+ * @brief Checks if a matrix, view or expression is symmetric.
+ * @details Same tolerance as Matrix::is_symmetric().
  */
-template <std::floating_point T>
-[[nodiscard]] Matrix<T> _cholesky(const Matrix<T>& matrix) {
-    if (!matrix.is_symmetric()) {
-        throw std::invalid_argument(
-            "Matrix must be symmetric to try Cholesky decomposition!");
+template <MatrixOperand E>
+[[nodiscard]] bool _is_symmetric(const E& matrix) {
+    if (matrix.row_count() != matrix.column_count()) {
+        return false;
     }
+    for (size_t i = 0; i < matrix.row_count(); ++i) {
+        for (size_t j = i + 1; j < matrix.column_count(); ++j) {
+            if (!is_close(matrix(i, j), matrix(j, i))) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
 
-    size_t n = matrix.row_count();
-    Matrix<T> L(n, n);
+/**
+ * @brief Computes L(i, j) (or L(j, j) when a_i == a_j) in place from the
+ * rows a_i and a_j, summing over columns first..j - 1.
+ * @details A non-positive pivot is stored as NaN for the caller to detect.
+ */
+template <std::floating_point T>
+inline void _potrf_element(T* a_i, const T* a_j, size_t first, size_t j) noexcept {
+    T sum = a_i[j];
+    #pragma omp simd reduction(- : sum)
+    for (size_t k = first; k < j; ++k) {
+        sum -= a_i[k] * a_j[k];
+    }
+    if (a_i == a_j) {
+        a_i[j] = sum > T(0) ? std::sqrt(sum) : std::numeric_limits<T>::quiet_NaN();
+    } else {
+        a_i[j] = sum / a_j[j];
+    }
+}
 
+/**
+ * @brief In-place blocked Cholesky factorization of a row-major n x n
+ * matrix with leading dimension lda.
+ *
+ * Only the lower triangle is read; on return it holds L and the strict upper
+ * triangle is zero. Right-looking: after each BLOCK_SIZE column panel is
+ * factored, the trailing lower triangle is updated block row by block row
+ * with the GEMM kernel. Used for dense blocks of larger factorizations,
+ * e.g. the supernodes of the sparse Cholesky.
+ *
+ * @throws std::invalid_argument if the matrix is not positive definite.
+ */
+template <std::floating_point T>
+void _potrf(size_t n, T* a, size_t lda) {
     for (size_t jj = 0; jj < n; jj += BLOCK_SIZE) {
-        const size_t j_end = std::min(jj + BLOCK_SIZE, n);
-        for (size_t j = jj; j < j_end; ++j) {
-            T sum = 0;
-            auto L_row_j = L.row_span(j);
-
-            #pragma omp simd
-            for (size_t k = 0; k < j; ++k) {
-                sum += L_row_j[k] * L_row_j[k];
-            }
+        const size_t nb = std::min<size_t>(BLOCK_SIZE, n - jj);
 
-            T diag_val = matrix.at(j, j) - sum;
-            if (diag_val <= 0) {
+        // Diagonal block; earlier panels are already subtracted, so only
+        // columns jj.. of the current panel are summed
+        for (size_t j = jj; j < jj + nb; ++j) {
+            T* a_j = a + (j * lda);
+            for (size_t i = jj; i <= j; ++i) {
+                _potrf_element(a_j, a + (i * lda), jj, i);
+            }
+            if (!(a_j[j] > T(0))) {
                 throw std::invalid_argument("Matrix is not positive definite!");
             }
-            L_row_j[j] = std::sqrt(diag_val);
-
-            for (size_t i = j + 1; i < j_end; ++i) {
-                T sum_i = 0;
-                auto L_row_i = L.row_span(i);
+        }
 
-                #pragma omp simd
-                for (size_t k = 0; k < j; ++k) {
-                    sum_i += L_row_i[k] * L_row_j[k];
-                }
-                L_row_i[j] = (matrix.at(i, j) - sum_i) / L_row_j[j];
+        // Panel below the diagonal block, rows in parallel
+        const bool parallel = (n - jj) * nb * nb > GEMM_OMP_LIMIT;
+        #pragma omp parallel for schedule(static) if (parallel)
+        for (size_t i = jj + nb; i < n; ++i) {
+            T* a_i = a + (i * lda);
+            for (size_t j = jj; j < jj + nb; ++j) {
+                _potrf_element(a_i, a + (j * lda), jj, j);
             }
         }
 
-        #pragma omp parallel for if (n > 1000)
-        for (size_t ii = j_end; ii < n; ii += BLOCK_SIZE) {
-            const size_t i_end = std::min(ii + BLOCK_SIZE, n);
+        // Trailing lower triangle: A22 -= L21 * L21^T, one block row at a
+        // time so that the upper triangle is not computed
+        const size_t start = jj + nb;
+        for (size_t ii = start; ii < n; ii += BLOCK_SIZE) {
+            const size_t mb = std::min<size_t>(BLOCK_SIZE, n - ii);
+            const T* l_i = a + (ii * lda) + jj;
+            const T* l_0 = a + (start * lda) + jj;
+            _gemm(mb,
+                  ii + mb - start,
+                  nb,
+                  T(-1),
+                  l_i,
+                  lda,
+                  1,
+                  l_0,
+                  1,
+                  lda,
+                  T(1),
+                  a + (ii * lda) + start,
+                  lda,
+                  1);
+        }
+    }
 
-            for (size_t i = ii; i < i_end; ++i) {
-                auto L_row_i = L.row_span(i);
+    for (size_t i = 0; i < n; ++i) {
+        std::fill(a + (i * lda) + i + 1, a + (i * lda) + n, T(0));
+    }
+}
 
-                for (size_t j = jj; j < j_end; ++j) {
-                    T sum = 0;
-                    auto L_row_j = L.row_span(j);
+/**
+ * @brief Tiled Cholesky factorization scheduled as a task graph.
+ *
+ * The lower triangle of an n x n matrix is cut into nb x nb tiles, tile
+ * (I, J) starting at `tile(I, J)` with rows ld apart. Step K is a POTRF of
+ * the diagonal tile, a TRSM of every tile below it and a SYRK / GEMM update
+ * of every trailing tile, each an OpenMP task whose `depend` clauses name
+ * the tiles it reads and writes. Steps are therefore not separated by
+ * barriers: the panel of step K + 1 is factored as soon as its tiles have
+ * been updated, while the rest of the trailing updates of step K still run.
+ *
+ * On return the tiles hold L, the strict upper halves of the diagonal tiles
+ * zeroed; tiles above the diagonal are not touched.
+ *
+ * @throws std::invalid_argument if the matrix is not positive definite.
+ */
+template <std::floating_point T, typename Tile>
+void _potrf_tiles(size_t n, size_t nb, size_t ld, Tile&& tile) {
+    const size_t tiles = (n + nb - 1) / nb;
+    if (tiles <= 1) {
+        _potrf(n, tile(0, 0), ld);
+        return;
+    }
+    const auto extent = [&](size_t I) { return std::min(nb, n - (I * nb)); };
+    // Exceptions cannot leave a task: a failed POTRF raises the flag and
+    // every later task is skipped
+    std::atomic<bool> failed = false;
 
-                    #pragma omp simd
-                    for (size_t k = 0; k < j; ++k) {
-                        sum += L_row_i[k] * L_row_j[k];
+    #pragma omp parallel
+    #pragma omp single
+    for (size_t K = 0; K < tiles; ++K) {
+        T* l_kk = tile(K, K);
+        const size_t width = extent(K);
+
+        #pragma omp task depend(inout : l_kk[0])
+        if (!failed) {
+            try {
+                _potrf(width, l_kk, ld);
+            } catch (const std::invalid_argument&) {
+                failed = true;
+            }
+        }
+
+        // L_IK = A_IK * L_KK^-T, one forward substitution per row
+        for (size_t I = K + 1; I < tiles; ++I) {
+            T* l_ik = tile(I, K);
+            #pragma omp task depend(in : l_kk[0]) depend(inout : l_ik[0])
+            if (!failed) {
+                for (size_t r = 0; r < extent(I); ++r) {
+                    for (size_t c = 0; c < width; ++c) {
+                        _potrf_element(l_ik + (r * ld), l_kk + (c * ld), 0, c);
                     }
-                    L_row_i[j] = (matrix.at(i, j) - sum) / L_row_j[j];
                 }
             }
         }
+
+        // A_IJ -= L_IK * L_JK^T for K < J <= I
+        for (size_t I = K + 1; I < tiles; ++I) {
+            for (size_t J = K + 1; J <= I; ++J) {
+                const T* l_ik = tile(I, K);
+                const T* l_jk = tile(J, K);
+                T* a_ij = tile(I, J);
+                #pragma omp task depend(in : l_ik[0], l_jk[0]) depend(inout : a_ij[0])
+                if (!failed) {
+                    _gemm(extent(I),
+                          extent(J),
+                          width,
+                          T(-1),
+                          l_ik,
+                          ld,
+                          1,
+                          l_jk,
+                          1,
+                          ld,
+                          T(1),
+                          a_ij,
+                          ld,
+                          1);
+                }
+            }
+        }
+    }
+
+    if (failed) {
+        throw std::invalid_argument("Matrix is not positive definite!");
+    }
+}
+
+/**
+ * @brief Internal implementation of Cholesky decomposition.
+ *
+ * Computes L where A = LL^T for symmetric positive definite matrix A. The
+ * lower triangle of the source is read element-wise (and converted to T)
+ * into L, so views and expressions are decomposed without being copied
+ * first, and then factored in place by the task-based _potrf_tiles().
+ */
+template <std::floating_point T, MatrixOperand Source>
+[[nodiscard]] Matrix<T> _cholesky(const Source& matrix) {
+    if (!_is_symmetric(matrix)) {
+        throw std::invalid_argument(
+            "Matrix must be symmetric to try Cholesky decomposition!");
     }
 
+    const size_t n = matrix.row_count();
+    Matrix<T> L(n, n);
+    #pragma omp parallel for schedule(dynamic) if (n * n > OMP_LINEAR_LIMIT)
+    for (size_t i = 0; i < n; ++i) {
+        auto L_row_i = L.row_span(i);
+        for (size_t j = 0; j <= i; ++j) {
+            L_row_i[j] = static_cast<T>(matrix(i, j));
+        }
+    }
+
+    T* a = L.data().data();
+    const size_t lda = L.leading_dimension();
+    constexpr size_t nb = CHOLESKY_TILE;
+    _potrf_tiles<T>(
+        n, nb, lda, [=](size_t I, size_t J) { return a + (I * nb * lda) + (J * nb); });
     return L;
 }
 
@@ -91,10 +252,10 @@ template <std::floating_point T>
  * and positive definite. This function checks for symmetry first. It
  * then detects non-positive-definiteness during the computation.
  *
- * The decomposition is computed using a blocked Cholesky-Crout algorithm
- * for improved cache performance. The implementation is parallelized
- * using OpenMP (for both multi-threading and SIMD vectorization)
- * for further performance gains.
+ * The decomposition is computed by a tiled right-looking algorithm whose
+ * POTRF, TRSM and GEMM tile kernels run as OpenMP tasks ordered only by
+ * the tiles they share, so independent updates of consecutive steps
+ * overlap instead of waiting at a barrier after every panel.
  *
  * More information:
  * https://en.wikipedia.org/wiki/Cholesky_decomposition
@@ -108,7 +269,7 @@ template <std::floating_point T>
  * @throws std::invalid_argument if the input matrix is not symmetric,
  * or if it is not positive definite (detected during factorization).
  *
- * @version 1.0 (Blocked & Parallelized)
+ * @version 2.0 (Tiled & Task Parallel)
  * @since 2025
  */
 template <typename ResultType = void, Numeric T>
@@ -121,12 +282,27 @@ template <typename ResultType = void, Numeric T>
     static_assert(std::is_floating_point_v<TargetType>,
                   "Cholesky result type must be floating point!");
 
-    if constexpr (std::is_same_v<TargetType, T>) {
-        return detail::_cholesky(matrix);
-    } else {
-        auto converted = matrix.template cast<TargetType>();
-        return detail::_cholesky(converted);
-    }
+    return detail::_cholesky<TargetType>(matrix);
+}
+
+/**
+ * @brief Computes the Cholesky decomposition of a view or lazy matrix
+ * expression.
+ * @details The operand is read in place, so decomposing a block of a larger
+ * matrix does not copy it.
+ */
+template <typename ResultType = void, MatrixExpression E>
+[[nodiscard]] auto cholesky(const E& expr) {
+    using T = typename E::value_type;
+    using TargetType =
+        std::conditional_t<std::is_same_v<ResultType, void>,
+                           std::conditional_t<std::is_floating_point_v<T>, T, double>,
+                           ResultType>;
+
+    static_assert(std::is_floating_point_v<TargetType>,
+                  "Cholesky result type must be floating point!");
+
+    return detail::_cholesky<TargetType>(expr);
 }
 
 }  // namespace maf::math
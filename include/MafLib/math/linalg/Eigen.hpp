@@ -0,0 +1,1034 @@
+#ifndef EIGEN_H
+#define EIGEN_H
+
+#pragma once
+#include "QR.hpp"
+
+/**
+ * @file Eigen.hpp
+ * @brief Dense symmetric eigensolver.
+ *
+ * The matrix is reduced to a tridiagonal T = Q^T A Q by blocked Householder
+ * reflections (_sytrd()), T is diagonalized by divide and conquer
+ * (_stedc()), and the eigenvectors of T are mapped back to those of A by
+ * applying Q in compact WY blocks. Every step except the O(n^2) tridiagonal
+ * part runs mostly in GEMM. Eigenvalues alone take an implicit QL sweep on T
+ * instead, without accumulating any vectors.
+ *
+ * A few extreme eigenpairs of a large operator are found iteratively by
+ * LOBPCG (eigsh()), which only needs products of the operator with blocks
+ * of vectors.
+ */
+namespace maf::math {
+/**
+ * @brief An operator eigsh() can iterate with: anything with a size and a
+ * product with a dense block of vectors of type T, such as Matrix,
+ * SymmetricMatrix or SparseMatrix.
+ */
+template <typename Op, typename T>
+concept BlockOperator = requires(const Op& op, const Matrix<T>& x) {
+    { op.row_count() } -> std::convertible_to<size_t>;
+    { op.column_count() } -> std::convertible_to<size_t>;
+    { op * x } -> MatrixOperand;
+};
+
+namespace detail {
+/** @brief Tridiagonal size below which divide and conquer uses implicit QL. */
+constexpr static size_t DC_LEAF = 32;
+
+/**
+ * @brief Reduces the first nb columns of the symmetric n x n matrix at `a`
+ * to tridiagonal form (LAPACK latrd, lower).
+ *
+ * The buffer is read as column-major, so column j of the algorithm is the
+ * contiguous row j of a row-major symmetric matrix. Reflector j is stored
+ * in A(j + 1:n, j) with its leading one in place, e[j] receives the
+ * off-diagonal and W (n x nb, column-major with columns ldw apart) the
+ * vectors of the trailing update A := A - V W^T - W V^T, which is left to
+ * the caller. The trailing matrix must hold both triangles.
+ */
+template <std::floating_point T>
+void _latrd(size_t n, size_t nb, T* a, size_t lda, T* e, T* tau, T* w, size_t ldw) {
+    std::vector<T> tmp(nb);
+
+    for (size_t i = 0; i < nb; ++i) {
+        T* a_i = a + (i * lda);
+        T* w_i = w + (i * ldw);
+        if (i > 0) {
+            // A(i:n, i) -= A(i:n, 0:i) W(i, 0:i)^T + W(i:n, 0:i) A(i, 0:i)^T
+            _gemv<T>(n - i, i, T(-1), a + i, 1, lda, w + i, ldw, T(1), a_i + i, 1);
+            _gemv<T>(n - i, i, T(-1), w + i, 1, ldw, a + i, lda, T(1), a_i + i, 1);
+        }
+        if (i + 1 == n) {
+            break;
+        }
+
+        const size_t len = n - i - 1;
+        tau[i] = _larfg(len, a_i + i + 1, 1);
+        e[i] = a_i[i + 1];
+        a_i[i + 1] = T(1);
+        const T* v = a_i + i + 1;
+        T* y = w_i + i + 1;
+
+        // W(i + 1:n, i) = tau (A - V W^T - W V^T)(i + 1:n, i + 1:n) v
+        const T* trailing = a + ((i + 1) * lda) + i + 1;
+        _gemv<T>(len, len, T(1), trailing, lda, 1, v, 1, T(0), y, 1);
+        if (i > 0) {
+            _gemv<T>(i, len, T(1), w + i + 1, ldw, 1, v, 1, T(0), tmp.data(), 1);
+            _gemv<T>(len, i, T(-1), a + i + 1, 1, lda, tmp.data(), 1, T(1), y, 1);
+            _gemv<T>(i, len, T(1), a + i + 1, lda, 1, v, 1, T(0), tmp.data(), 1);
+            _gemv<T>(len, i, T(-1), w + i + 1, 1, ldw, tmp.data(), 1, T(1), y, 1);
+        }
+
+        T dot = 0;
+        for (size_t t = 0; t < len; ++t) {
+            y[t] *= tau[i];
+            dot += y[t] * v[t];
+        }
+        const T alpha = T(-0.5) * tau[i] * dot;
+        #pragma omp simd
+        for (size_t t = 0; t < len; ++t) {
+            y[t] += alpha * v[t];
+        }
+    }
+}
+
+/**
+ * @brief Blocked reduction of the symmetric n x n matrix at `a` to
+ * tridiagonal form T = Q^T A Q (LAPACK sytrd, lower).
+ *
+ * Panels of BLOCK_SIZE columns are reduced with _latrd() and the trailing
+ * matrix is updated with two GEMMs, A_22 -= V W^T + W V^T, which keep both
+ * of its triangles. On return d and e (n - 1 elements) hold the diagonal
+ * and off-diagonal of T and row j of `a`, from column j + 2 on, the
+ * reflector H_j = I - tau[j] v_j v_j^T (the leading one of v_j implied at
+ * column j + 1); Q = H_0 ... H_(n - 2).
+ */
+template <std::floating_point T>
+void _sytrd(size_t n, T* a, size_t lda, T* d, T* e, T* tau) {
+    constexpr size_t nb = BLOCK_SIZE;
+    std::vector<T> w(n * nb);
+
+    size_t i = 0;
+    for (; n - i > 2 * nb; i += nb) {
+        const size_t s = n - i;
+        _latrd(s, nb, a + (i * lda) + i, lda, e + i, tau + i, w.data(), s);
+
+        // V(r, k) = v[k * lda + r], W(r, k) = wt[k * s + r]
+        const T* v = a + (i * lda) + i + nb;
+        const T* wt = w.data() + nb;
+        T* c = a + ((i + nb) * lda) + i + nb;
+        _gemm<T>(s - nb, s - nb, nb, T(-1), v, 1, lda, wt, s, 1, T(1), c, lda, 1);
+        _gemm<T>(s - nb, s - nb, nb, T(-1), wt, 1, s, v, lda, 1, T(1), c, lda, 1);
+
+        for (size_t j = i; j < i + nb; ++j) {
+            d[j] = a[(j * lda) + j];
+        }
+    }
+
+    const size_t rest = n - i;
+    std::vector<T> w_rest(rest * rest);
+    _latrd(rest, rest, a + (i * lda) + i, lda, e + i, tau + i, w_rest.data(), rest);
+    for (size_t j = i; j < n; ++j) {
+        d[j] = a[(j * lda) + j];
+    }
+}
+
+/**
+ * @brief Implicit QL with Wilkinson shifts on the symmetric tridiagonal
+ * (d, e) of size n, e[i] coupling i and i + 1 (LAPACK steqr).
+ * @details On return d holds the eigenvalues (unsorted). When z is not null
+ * every rotation is applied to the columns of the n x n matrix at `z`
+ * (rows ldz apart), accumulating the eigenvectors. e is destroyed.
+ * @throws std::runtime_error if an eigenvalue fails to converge.
+ */
+template <std::floating_point T>
+void _steql(size_t n, T* d, T* e, T* z, size_t ldz) {
+    if (n == 0) {
+        return;
+    }
+    const T eps = std::numeric_limits<T>::epsilon();
+    e[n - 1] = 0;
+
+    for (size_t l = 0; l < n; ++l) {
+        size_t iterations = 0;
+        while (true) {
+            size_t m = l;
+            for (; m + 1 < n; ++m) {
+                const T dd = std::abs(d[m]) + std::abs(d[m + 1]);
+                if (std::abs(e[m]) <= eps * dd) {
+                    break;
+                }
+            }
+            if (m == l) {
+                break;
+            }
+            if (++iterations > 60) {
+                throw std::runtime_error("Eigenvalue iteration did not converge.");
+            }
+
+            T g = (d[l + 1] - d[l]) / (T(2) * e[l]);
+            T r = std::hypot(g, T(1));
+            g = d[m] - d[l] + (e[l] / (g + std::copysign(r, g)));
+            T s = 1;
+            T c = 1;
+            T p = 0;
+            bool underflow = false;
+            for (size_t i = m; i-- > l;) {
+                const T f = s * e[i];
+                const T b = c * e[i];
+                r = std::hypot(f, g);
+                e[i + 1] = r;
+                if (r == T(0)) {
+                    d[i + 1] -= p;
+                    e[m] = 0;
+                    underflow = true;
+                    break;
+                }
+                s = f / r;
+                c = g / r;
+                g = d[i + 1] - p;
+                r = ((d[i] - g) * s) + (T(2) * c * b);
+                p = s * r;
+                d[i + 1] = g + p;
+                g = (c * r) - b;
+                if (z != nullptr) {
+                    for (size_t k = 0; k < n; ++k) {
+                        T* row = z + (k * ldz);
+                        const T zf = row[i + 1];
+                        row[i + 1] = (s * row[i]) + (c * zf);
+                        row[i] = (c * row[i]) - (s * zf);
+                    }
+                }
+            }
+            if (underflow) {
+                continue;
+            }
+            d[l] -= p;
+            e[l] = g;
+            e[m] = 0;
+        }
+    }
+}
+
+/**
+ * @brief Sorts n eigenvalues ascending and moves the matching columns of
+ * the n x n matrix at `q` (rows n apart) with them.
+ */
+template <std::floating_point T>
+void _sort_eigenpairs(size_t n, T* d, T* q) {
+    std::vector<size_t> order(n);
+    std::iota(order.begin(), order.end(), 0);
+    std::ranges::sort(order, [&](size_t x, size_t y) { return d[x] < d[y]; });
+
+    std::vector<T> values(n);
+    std::vector<T> vectors(n * n);
+    for (size_t c = 0; c < n; ++c) {
+        values[c] = d[order[c]];
+        for (size_t r = 0; r < n; ++r) {
+            vectors[(r * n) + c] = q[(r * n) + order[c]];
+        }
+    }
+    std::ranges::copy(values, d);
+    std::ranges::copy(vectors, q);
+}
+
+/**
+ * @brief Eigen-decomposition of D + rho z z^T, D = diag(d), merged into the
+ * eigenvectors Q of the two halves of a divide and conquer step (LAPACK
+ * laed1).
+ *
+ * Components of z that are negligible, and pairs of nearly equal d, are
+ * deflated (the latter by a Givens rotation of two columns of Q). The K
+ * remaining roots of the secular equation
+ * 1 + rho sum_j z_j^2 / (d_j - lambda) = 0 are found by bisection, in
+ * parallel, each relative to its nearest pole so that lambda - d_j keeps
+ * full relative accuracy. z is then recomputed from the roots (Gu and
+ * Eisenstat), which makes the eigenvectors of the rank-one update
+ * numerically orthogonal, and those are applied to Q with one GEMM.
+ *
+ * @param n Size of the problem.
+ * @param d On entry D, on exit the eigenvalues ascending.
+ * @param z The update vector; destroyed.
+ * @param rho The update scalar.
+ * @param q On entry the n x n block-diagonal eigenvector matrix of the
+ * halves, on exit the eigenvectors, both with rows n apart.
+ */
+template <std::floating_point T>
+void _dc_merge(size_t n, T* d, T* z, T rho, T* q) {
+    constexpr auto none = std::numeric_limits<size_t>::max();
+    const T eps = std::numeric_limits<T>::epsilon();
+
+    // D + rho z z^T with rho < 0 is -(-D + |rho| z z^T), same eigenvectors
+    const bool flip = rho < T(0);
+    if (flip) {
+        std::transform(d, d + n, d, std::negate<T>());
+        rho = -rho;
+    }
+    const T z_norm = std::sqrt(std::inner_product(z, z + n, z, T(0)));
+    if (z_norm > T(0)) {
+        std::transform(z, z + n, z, [&](T x) { return x / z_norm; });
+    }
+    rho *= z_norm * z_norm;
+
+    std::vector<size_t> order(n);
+    std::iota(order.begin(), order.end(), 0);
+    std::ranges::sort(order, [&](size_t x, size_t y) { return d[x] < d[y]; });
+    std::vector<T> ds(n);
+    std::vector<T> zs(n);
+    std::vector<T> qs(n * n);
+    T d_max = 0;
+    for (size_t c = 0; c < n; ++c) {
+        ds[c] = d[order[c]];
+        zs[c] = z[order[c]];
+        d_max = std::max(d_max, std::abs(ds[c]));
+        for (size_t r = 0; r < n; ++r) {
+            qs[(r * n) + c] = q[(r * n) + order[c]];
+        }
+    }
+
+    // Deflation
+    const T tol = T(8) * eps * std::max(d_max, rho);
+    std::vector<size_t> kept;
+    std::vector<size_t> deflated;
+    size_t prev = none;
+    for (size_t j = 0; j < n; ++j) {
+        if (rho * std::abs(zs[j]) <= tol) {
+            deflated.push_back(j);
+            continue;
+        }
+        if (prev == none) {
+            prev = j;
+            continue;
+        }
+        const T r = std::hypot(zs[j], zs[prev]);
+        const T c = zs[j] / r;
+        const T s = -zs[prev] / r;
+        if (std::abs((ds[j] - ds[prev]) * c * s) <= tol) {
+            zs[j] = r;
+            zs[prev] = 0;
+            for (size_t k = 0; k < n; ++k) {
+                T* row = qs.data() + (k * n);
+                const T x = row[prev];
+                const T y = row[j];
+                row[prev] = (c * x) + (s * y);
+                row[j] = (c * y) - (s * x);
+            }
+            const T d_prev = (ds[prev] * c * c) + (ds[j] * s * s);
+            ds[j] = (ds[prev] * s * s) + (ds[j] * c * c);
+            ds[prev] = d_prev;
+            deflated.push_back(prev);
+        } else {
+            kept.push_back(prev);
+        }
+        prev = j;
+    }
+    if (prev != none) {
+        kept.push_back(prev);
+    }
+
+    const size_t k = kept.size();
+    std::vector<T> dk(k);
+    std::vector<T> zk(k);
+    for (size_t i = 0; i < k; ++i) {
+        dk[i] = ds[kept[i]];
+        zk[i] = zs[kept[i]];
+    }
+    const T zk_norm2 = std::inner_product(zk.begin(), zk.end(), zk.begin(), T(0));
+
+    // Root i is origin[i] + shift[i], lambda - d_j = (d_origin - d_j) + shift
+    std::vector<size_t> origin(k);
+    std::vector<T> shift(k);
+    const auto secular = [&](size_t o, T tau) {
+        T f = 1;
+        for (size_t j = 0; j < k; ++j) {
+            f += rho * zk[j] * zk[j] / ((dk[j] - dk[o]) - tau);
+        }
+        return f;
+    };
+    #pragma omp parallel for schedule(dynamic, 16) if (k * k > OMP_LINEAR_LIMIT)
+    for (size_t i = 0; i < k; ++i) {
+        size_t o = i;
+        T lo = 0;
+        T hi = rho * zk_norm2;
+        if (i + 1 < k) {
+            const T half = (dk[i + 1] - dk[i]) / T(2);
+            hi = half;
+            if (secular(i, half) < T(0)) {
+                o = i + 1;
+                lo = (dk[i] - dk[i + 1]) + half;
+                hi = 0;
+            }
+        }
+        for (size_t iteration = 0; iteration < 256; ++iteration) {
+            const T mid = lo + ((hi - lo) / T(2));
+            if (mid <= lo || mid >= hi) {
+                break;
+            }
+            (secular(o, mid) > T(0) ? hi : lo) = mid;
+        }
+        origin[i] = o;
+        shift[i] = lo + ((hi - lo) / T(2));
+    }
+
+    // z recomputed from the roots: z_j^2 = prod_i (lambda_i - d_j) / (rho
+    // prod_(i != j) (d_i - d_j))
+    std::vector<T> z_hat(k);
+    #pragma omp parallel for schedule(static) if (k * k > OMP_LINEAR_LIMIT)
+    for (size_t j = 0; j < k; ++j) {
+        T w = ((dk[origin[j]] - dk[j]) + shift[j]) / rho;
+        for (size_t i = 0; i < k; ++i) {
+            if (i != j) {
+                w *= ((dk[origin[i]] - dk[j]) + shift[i]) / (dk[i] - dk[j]);
+            }
+        }
+        z_hat[j] = std::copysign(std::sqrt(std::max(w, T(0))), zk[j]);
+    }
+
+    // Eigenvectors of the update, u_i = (z_j / (d_j - lambda_i))_j normalized
+    std::vector<T> u(k * k);
+    #pragma omp parallel for schedule(static) if (k * k > OMP_LINEAR_LIMIT)
+    for (size_t i = 0; i < k; ++i) {
+        T norm = 0;
+        for (size_t j = 0; j < k; ++j) {
+            const T value = z_hat[j] / ((dk[j] - dk[origin[i]]) - shift[i]);
+            u[(j * k) + i] = value;
+            norm += value * value;
+        }
+        norm = std::sqrt(norm);
+        for (size_t j = 0; j < k; ++j) {
+            u[(j * k) + i] /= norm;
+        }
+    }
+
+    std::vector<T> q_kept(n * k);
+    std::vector<T> q_new(n * k);
+    for (size_t r = 0; r < n; ++r) {
+        for (size_t c = 0; c < k; ++c) {
+            q_kept[(r * k) + c] = qs[(r * n) + kept[c]];
+        }
+    }
+    _gemm<T>(n,
+             k,
+             k,
+             T(1),
+             q_kept.data(),
+             k,
+             1,
+             u.data(),
+             k,
+             1,
+             T(0),
+             q_new.data(),
+             k,
+             1);
+
+    // Eigenvalue and source column of every result, kept ones first
+    std::vector<std::pair<T, size_t>> results;
+    results.reserve(n);
+    for (size_t i = 0; i < k; ++i) {
+        results.emplace_back(dk[origin[i]] + shift[i], i);
+    }
+    for (size_t j : deflated) {
+        results.emplace_back(ds[j], k + j);
+    }
+    if (flip) {
+        for (auto& result : results) {
+            result.first = -result.first;
+        }
+    }
+    std::ranges::sort(results, {}, &std::pair<T, size_t>::first);
+
+    for (size_t c = 0; c < n; ++c) {
+        const auto [value, source] = results[c];
+        d[c] = value;
+        for (size_t r = 0; r < n; ++r) {
+            q[(r * n) + c] = source < k ? q_new[(r * k) + source]
+                                        : qs[(r * n) + (source - k)];
+        }
+    }
+}
+
+/**
+ * @brief Divide and conquer eigen-decomposition of the symmetric
+ * tridiagonal (d, e) of size n, e holding the n - 1 off-diagonals (LAPACK
+ * stedc).
+ *
+ * T is torn at the middle into two tridiagonals and a rank-one update,
+ * T = diag(T_1, T_2) + rho v v^T with rho the coupling element, the halves
+ * are solved recursively and merged by _dc_merge(). Below DC_LEAF the
+ * tridiagonal is solved by implicit QL.
+ *
+ * On return d holds the eigenvalues ascending and the n x n matrix at `q`
+ * (rows n apart) the eigenvectors as its columns.
+ */
+template <std::floating_point T>
+void _stedc(size_t n, T* d, const T* e, T* q) {
+    if (n <= DC_LEAF) {
+        std::fill_n(q, n * n, T(0));
+        for (size_t i = 0; i < n; ++i) {
+            q[(i * n) + i] = T(1);
+        }
+        std::vector<T> off(n);
+        std::copy_n(e, n - 1, off.begin());
+        _steql(n, d, off.data(), q, n);
+        _sort_eigenpairs(n, d, q);
+        return;
+    }
+
+    const size_t m = n / 2;
+    const T rho = e[m - 1];
+    d[m - 1] -= rho;
+    d[m] -= rho;
+    std::vector<T> q_1(m * m);
+    std::vector<T> q_2((n - m) * (n - m));
+    _stedc(m, d, e, q_1.data());
+    _stedc(n - m, d + m, e + m, q_2.data());
+
+    // z = diag(Q_1, Q_2)^T v: the last row of Q_1 and the first row of Q_2
+    std::vector<T> z(n);
+    std::copy_n(q_1.data() + ((m - 1) * m), m, z.begin());
+    std::copy_n(q_2.data(), n - m, z.begin() + m);
+
+    std::fill_n(q, n * n, T(0));
+    for (size_t r = 0; r < m; ++r) {
+        std::copy_n(q_1.data() + (r * m), m, q + (r * n));
+    }
+    for (size_t r = 0; r < n - m; ++r) {
+        std::copy_n(q_2.data() + (r * (n - m)), n - m, q + ((m + r) * n) + m);
+    }
+    _dc_merge(n, d, z.data(), rho, q);
+}
+
+/**
+ * @brief Internal implementation of the symmetric eigen-decomposition.
+ *
+ * Reduces the working matrix to tridiagonal form in place, solves the
+ * tridiagonal by divide and conquer and back-transforms its eigenvectors:
+ * the reflectors of _sytrd() are copied into the layout of _geqrf() and
+ * applied to the rows 1..n - 1 with _ormqr(), in compact WY blocks.
+ */
+template <std::floating_point T>
+[[nodiscard]] std::pair<Vector<T>, Matrix<T>> _eigh(Matrix<T>&& A) {
+    const size_t n = A.row_count();
+    const size_t lda = A.leading_dimension();
+    T* a = A.data().data();
+    std::vector<T> d(n);
+    std::vector<T> e(n);
+    std::vector<T> tau(n);
+    _sytrd(n, a, lda, d.data(), e.data(), tau.data());
+
+    std::vector<T> z(n * n);
+    _stedc(n, d.data(), e.data(), z.data());
+
+    Matrix<T> vectors(n, n, default_init);
+    for (size_t r = 0; r < n; ++r) {
+        std::copy_n(z.data() + (r * n), n, vectors.row_span(r).begin());
+    }
+    if (n > 1) {
+        // V(r, c) = v_c(r + 1) for r > c
+        const size_t m = n - 1;
+        std::vector<T> v(m * m);
+        for (size_t c = 0; c < m; ++c) {
+            for (size_t r = c + 1; r < m; ++r) {
+                v[(r * m) + c] = a[(c * lda) + r + 1];
+            }
+        }
+        const size_t ldv = vectors.leading_dimension();
+        _ormqr(m,
+               m,
+               v.data(),
+               m,
+               tau.data(),
+               false,
+               n,
+               vectors.data().data() + ldv,
+               ldv);
+    }
+    return std::make_pair(Vector<T>(n, std::move(d)), std::move(vectors));
+}
+
+/**
+ * @brief Internal implementation of the eigenvalues-only path: the
+ * tridiagonal reduction followed by implicit QL without eigenvectors.
+ */
+template <std::floating_point T>
+[[nodiscard]] Vector<T> _eigvalsh(Matrix<T>&& A) {
+    const size_t n = A.row_count();
+    std::vector<T> d(n);
+    std::vector<T> e(n);
+    std::vector<T> tau(n);
+    _sytrd(n, A.data().data(), A.leading_dimension(), d.data(), e.data(), tau.data());
+    _steql<T>(n, d.data(), e.data(), nullptr, 0);
+    std::ranges::sort(d);
+    return Vector<T>(n, std::move(d));
+}
+
+/** @brief Copies a square symmetric operand into the working matrix. */
+template <std::floating_point T, MatrixOperand E>
+[[nodiscard]] Matrix<T> _symmetric_working_copy(const E& matrix) {
+    if (matrix.row_count() != matrix.column_count()) {
+        throw std::invalid_argument("Matrix must be square for eigen-decomposition!");
+    }
+    if (!_is_symmetric(matrix)) {
+        throw std::invalid_argument(
+            "Matrix must be symmetric for symmetric eigen-decomposition!");
+    }
+    const size_t n = matrix.row_count();
+    Matrix<T> result(n, n, default_init);
+    #pragma omp parallel for if (n * n > OMP_LINEAR_LIMIT)
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j < n; ++j) {
+            result(i, j) = static_cast<T>(matrix(i, j));
+        }
+    }
+    return result;
+}
+
+/** @brief A^T B of two blocks of vectors with the same row count, by GEMM. */
+template <std::floating_point T>
+[[nodiscard]] Matrix<T> _inner(const Matrix<T>& a, const Matrix<T>& b) {
+    Matrix<T> result(a.column_count(), b.column_count(), default_init);
+    _gemm<T>(a.column_count(),
+             b.column_count(),
+             a.row_count(),
+             T(1),
+             a.data().data(),
+             1,
+             a.leading_dimension(),
+             b.data().data(),
+             b.leading_dimension(),
+             1,
+             T(0),
+             result.data().data(),
+             result.leading_dimension(),
+             1);
+    return result;
+}
+
+/** @brief a -= b c, by GEMM. */
+template <std::floating_point T>
+void _subtract_product(Matrix<T>& a, const Matrix<T>& b, const Matrix<T>& c) {
+    _gemm<T>(a.row_count(),
+             a.column_count(),
+             b.column_count(),
+             T(-1),
+             b.data().data(),
+             b.leading_dimension(),
+             1,
+             c.data().data(),
+             c.leading_dimension(),
+             1,
+             T(1),
+             a.data().data(),
+             a.leading_dimension(),
+             1);
+}
+
+/** @brief The listed columns of a block, side by side. */
+template <std::floating_point T>
+[[nodiscard]] Matrix<T> _columns(const Matrix<T>& a,
+                                 const std::vector<size_t>& columns,
+                                 size_t first_row = 0) {
+    Matrix<T> result(a.row_count() - first_row, columns.size(), default_init);
+    for (size_t i = 0; i < result.row_count(); ++i) {
+        for (size_t j = 0; j < columns.size(); ++j) {
+            result(i, j) = a(first_row + i, columns[j]);
+        }
+    }
+    return result;
+}
+
+/** @brief The blocks [a_0 a_1 ...] side by side; null blocks are skipped. */
+template <std::floating_point T>
+[[nodiscard]] Matrix<T> _side_by_side(std::initializer_list<const Matrix<T>*> blocks) {
+    size_t rows = 0;
+    size_t cols = 0;
+    for (const auto* block : blocks) {
+        if (block != nullptr) {
+            rows = block->row_count();
+            cols += block->column_count();
+        }
+    }
+    Matrix<T> result(rows, cols, default_init);
+    #pragma omp parallel for if (rows * cols > OMP_LINEAR_LIMIT)
+    for (size_t i = 0; i < rows; ++i) {
+        auto out = result.row_span(i).begin();
+        for (const auto* block : blocks) {
+            if (block != nullptr) {
+                out = std::ranges::copy(block->row_span(i), out).out;
+            }
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Rayleigh-Ritz on the orthonormal basis S with AS = A S: the b
+ * largest Ritz values, descending, and their coefficient vectors (m x b).
+ */
+template <std::floating_point T>
+[[nodiscard]] std::pair<std::vector<T>, Matrix<T>> _rayleigh_ritz(const Matrix<T>& s,
+                                                                  const Matrix<T>& as,
+                                                                  size_t b) {
+    Matrix<T> h = _inner(s, as);
+    const size_t m = h.row_count();
+    for (size_t i = 0; i < m; ++i) {
+        for (size_t j = 0; j < i; ++j) {
+            const T mean = (h(i, j) + h(j, i)) / T(2);
+            h(i, j) = mean;
+            h(j, i) = mean;
+        }
+    }
+    auto [theta, c] = _eigh(std::move(h));
+    std::vector<T> values(b);
+    Matrix<T> vectors(m, b, default_init);
+    for (size_t j = 0; j < b; ++j) {
+        values[j] = theta[m - 1 - j];
+        for (size_t i = 0; i < m; ++i) {
+            vectors(i, j) = c(i, m - 1 - j);
+        }
+    }
+    return std::make_pair(std::move(values), std::move(vectors));
+}
+
+/**
+ * @brief Block LOBPCG for the k largest eigenpairs of the symmetric n x n
+ * operator `apply` (Knyazev).
+ *
+ * A block X of k plus a few guard vectors is improved at every iteration by
+ * Rayleigh-Ritz on the span of [X R P]: X, the residuals R = A X - X Lambda
+ * of the pairs that have not converged yet, and the previous search
+ * directions P. Every block is orthonormalized (Householder QR), so the
+ * Rayleigh-Ritz is a small dense eigh(). Only R is multiplied by the
+ * operator; A X and A P are updated with the same coefficients as X and P.
+ * Operators small enough for a dense decomposition are decomposed directly.
+ * The columns of `start` (n x at most k + guard vectors, may be null), e.g.
+ * the eigenvectors of a nearby operator, replace the first random vectors
+ * of the initial block.
+ *
+ * @throws std::runtime_error if the pairs do not converge in
+ * max_iterations.
+ */
+template <std::floating_point T, typename Apply>
+[[nodiscard]] std::pair<Vector<T>, Matrix<T>> _lobpcg(size_t n,
+                                                     Apply&& apply,
+                                                     size_t k,
+                                                     double tolerance,
+                                                     size_t max_iterations,
+                                                     const Matrix<T>* start = nullptr) {
+    const size_t b = std::min(n, k + std::max<size_t>(k / 2, 4));
+
+    if (n <= 4 * b) {
+        Matrix<T> eye(n, n);
+        for (size_t i = 0; i < n; ++i) {
+            eye(i, i) = T(1);
+        }
+        Matrix<T> a = apply(eye);
+        for (size_t i = 0; i < n; ++i) {
+            for (size_t j = 0; j < i; ++j) {
+                const T mean = (a(i, j) + a(j, i)) / T(2);
+                a(i, j) = mean;
+                a(j, i) = mean;
+            }
+        }
+        auto [values, vectors] = _eigh(std::move(a));
+        Vector<T> top(k);
+        Matrix<T> top_vectors(n, k, default_init);
+        for (size_t j = 0; j < k; ++j) {
+            top[j] = values[n - 1 - j];
+            for (size_t i = 0; i < n; ++i) {
+                top_vectors(i, j) = vectors(i, n - 1 - j);
+            }
+        }
+        return std::make_pair(std::move(top), std::move(top_vectors));
+    }
+
+    const T tol = std::max(static_cast<T>(tolerance),
+                           T(100) * std::numeric_limits<T>::epsilon());
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<T> dis(-1, 1);
+    Matrix<T> x(n, b, default_init);
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j < b; ++j) {
+            x(i, j) = dis(gen);
+        }
+    }
+    if (start != nullptr) {
+        const size_t seeded = std::min(b, start->column_count());
+        for (size_t i = 0; i < n; ++i) {
+            std::copy_n(start->row_span(i).begin(), seeded, x.row_span(i).begin());
+        }
+    }
+    x = _qr(std::move(x)).first;
+    Matrix<T> ax = apply(x);
+
+    auto [lambda, c] = _rayleigh_ritz(x, ax, b);
+    x = x * c;
+    ax = ax * c;
+    std::optional<Matrix<T>> p;
+    std::optional<Matrix<T>> ap;
+
+    for (size_t iteration = 0; iteration < max_iterations; ++iteration) {
+        // Residuals of the pairs that have not converged
+        Matrix<T> r = ax;
+        T scale = std::numeric_limits<T>::min();
+        for (size_t j = 0; j < b; ++j) {
+            scale = std::max(scale, std::abs(lambda[j]));
+        }
+        std::vector<T> norms(b, T(0));
+        for (size_t i = 0; i < n; ++i) {
+            auto row = r.row_span(i);
+            auto x_row = x.row_span(i);
+            for (size_t j = 0; j < b; ++j) {
+                row[j] -= lambda[j] * x_row[j];
+                norms[j] += row[j] * row[j];
+            }
+        }
+        std::vector<size_t> active;
+        for (size_t j = 0; j < b; ++j) {
+            if (std::sqrt(norms[j]) > tol * scale) {
+                active.push_back(j);
+            }
+        }
+        if (active.empty() || active.front() >= k) {
+            Vector<T> values(k);
+            std::copy_n(lambda.begin(), k, values.data().begin());
+            std::vector<size_t> first(k);
+            std::iota(first.begin(), first.end(), 0);
+            return std::make_pair(std::move(values), _columns(x, first));
+        }
+
+        // R orthonormal and orthogonal to X, then A R
+        r = _columns(r, active);
+        for (size_t pass = 0; pass < 2; ++pass) {
+            _subtract_product(r, x, _inner(x, r));
+        }
+        r = _qr(std::move(r)).first;
+        Matrix<T> ar = apply(r);
+
+        // P orthonormal and orthogonal to X and R; A P follows with the
+        // same coefficients. A nearly dependent P is dropped.
+        if (p.has_value()) {
+            for (const auto& [basis, a_basis] :
+                 {std::pair{&x, &ax}, std::pair{&r, &ar}}) {
+                const Matrix<T> coefficients = _inner(*basis, *p);
+                _subtract_product(*p, *basis, coefficients);
+                _subtract_product(*ap, *a_basis, coefficients);
+            }
+            auto [q_p, r_p] = _qr(Matrix<T>(*p));
+            T diag_min = std::numeric_limits<T>::max();
+            T diag_max = 0;
+            for (size_t j = 0; j < r_p.row_count(); ++j) {
+                diag_min = std::min(diag_min, std::abs(r_p(j, j)));
+                diag_max = std::max(diag_max, std::abs(r_p(j, j)));
+            }
+            if (r_p.row_count() < p->column_count() ||
+                diag_min <= std::sqrt(std::numeric_limits<T>::epsilon()) * diag_max) {
+                p.reset();
+                ap.reset();
+            } else {
+                // A P R_p^-1, one forward substitution per row
+                #pragma omp parallel for if (n * r_p.row_count() > OMP_LINEAR_LIMIT)
+                for (size_t i = 0; i < n; ++i) {
+                    auto row = ap->row_span(i);
+                    for (size_t j = 0; j < row.size(); ++j) {
+                        T sum = row[j];
+                        for (size_t t = 0; t < j; ++t) {
+                            sum -= row[t] * r_p(t, j);
+                        }
+                        row[j] = sum / r_p(j, j);
+                    }
+                }
+                *p = std::move(q_p);
+            }
+        }
+
+        const Matrix<T> s = _side_by_side<T>({&x, &r, p ? &*p : nullptr});
+        const Matrix<T> as = _side_by_side<T>({&ax, &ar, ap ? &*ap : nullptr});
+        auto [theta, coefficients] = _rayleigh_ritz(s, as, b);
+
+        // The new P is the [R P] part of the new X, A P likewise
+        std::vector<size_t> all(b);
+        std::iota(all.begin(), all.end(), 0);
+        const Matrix<T> tail = _columns(coefficients, all, x.column_count());
+        p = _side_by_side<T>({&r, p ? &*p : nullptr}) * tail;
+        ap = _side_by_side<T>({&ar, ap ? &*ap : nullptr}) * tail;
+        lambda = std::move(theta);
+        x = s * coefficients;
+        ax = as * coefficients;
+    }
+    throw std::runtime_error("Eigenvalue iteration did not converge.");
+}
+
+}  // namespace detail
+
+/**
+ * @brief Computes all eigenvalues and eigenvectors of a symmetric matrix.
+ *
+ * The matrix is reduced to tridiagonal form by blocked Householder
+ * reflections, whose trailing updates are GEMMs. The tridiagonal is solved
+ * by divide and conquer: it is split recursively into halves and a rank-one
+ * update, whose secular equations are solved in parallel and whose
+ * eigenvectors are merged with GEMM. The eigenvectors are finally
+ * transformed back with the reflectors in compact WY form, again by GEMM.
+ *
+ * More information:
+ * https://en.wikipedia.org/wiki/Divide-and-conquer_eigenvalue_algorithm
+ *
+ * @tparam T The numeric type of the matrix elements; integers are
+ * decomposed in double.
+ * @param matrix The symmetric matrix (a Matrix, view or expression).
+ * @return A std::pair containing:
+ * 1. (Vector<T>) The eigenvalues in ascending order.
+ * 2. (Matrix<T>) The orthonormal eigenvectors, column i belonging to
+ * eigenvalue i.
+ *
+ * @throws std::invalid_argument if the matrix is not square or not
+ * symmetric.
+ * @throws std::runtime_error if the iteration fails to converge.
+ *
+ * @version 1.0 (Blocked & Divide and Conquer)
+ * @since 2025
+ */
+template <typename ResultType = void, MatrixOperand E>
+[[nodiscard]] auto eigh(const E& matrix) {
+    using T = typename E::value_type;
+    using TargetType =
+        std::conditional_t<std::is_same_v<ResultType, void>,
+                           std::conditional_t<std::is_floating_point_v<T>, T, double>,
+                           ResultType>;
+
+    static_assert(std::is_floating_point_v<TargetType>,
+                  "Eigen-decomposition result type must be floating point!");
+
+    return detail::_eigh(detail::_symmetric_working_copy<TargetType>(matrix));
+}
+
+/**
+ * @brief Computes the eigenvalues of a symmetric matrix, in ascending
+ * order.
+ * @details The blocked tridiagonal reduction of eigh() followed by implicit
+ * QL on the tridiagonal, O(n^2), without forming any eigenvectors.
+ * @throws std::invalid_argument if the matrix is not square or not
+ * symmetric.
+ * @throws std::runtime_error if the iteration fails to converge.
+ */
+template <typename ResultType = void, MatrixOperand E>
+[[nodiscard]] auto eigvalsh(const E& matrix) {
+    using T = typename E::value_type;
+    using TargetType =
+        std::conditional_t<std::is_same_v<ResultType, void>,
+                           std::conditional_t<std::is_floating_point_v<T>, T, double>,
+                           ResultType>;
+
+    static_assert(std::is_floating_point_v<TargetType>,
+                  "Eigen-decomposition result type must be floating point!");
+
+    return detail::_eigvalsh(detail::_symmetric_working_copy<TargetType>(matrix));
+}
+
+/**
+ * @brief Computes the k largest eigenpairs of a large symmetric operator.
+ *
+ * Runs block LOBPCG, which touches the operator only through products with
+ * blocks of about k vectors: one GEMM for a dense Matrix, a SYMM for a
+ * SymmetricMatrix and an SpMM for a SparseMatrix, instead of k separate
+ * matrix-vector products. Everything else is dense work on n x O(k) blocks
+ * (Householder QR, GEMM) and a small Rayleigh-Ritz eigh() per iteration, so
+ * the cost per iteration is one block product plus O(n k^2). Operators too
+ * small for that to pay off are decomposed densely with eigh().
+ *
+ * The iteration converges fastest when the wanted eigenvalues are well
+ * separated from the rest of the spectrum. Symmetry is assumed, not
+ * checked.
+ *
+ * More information:
+ * https://en.wikipedia.org/wiki/LOBPCG
+ *
+ * @tparam T The numeric type of the operator; integers are iterated in
+ * double.
+ * @param op The symmetric operator (Matrix, SymmetricMatrix, SparseMatrix
+ * or any type modelling BlockOperator).
+ * @param k The number of eigenpairs.
+ * @param tolerance Residual norm ||A x - lambda x|| at which a pair counts
+ * as converged, relative to the largest eigenvalue magnitude.
+ * @param max_iterations The iteration limit.
+ * @return A std::pair containing:
+ * 1. (Vector<T>) The k largest eigenvalues in descending order.
+ * 2. (Matrix<T>) The n x k orthonormal eigenvectors, column i belonging to
+ * eigenvalue i.
+ *
+ * @throws std::invalid_argument if the operator is not square or k is not
+ * in [1, n].
+ * @throws std::runtime_error if the iteration does not converge.
+ *
+ * @version 1.0 (Blocked LOBPCG)
+ * @since 2025
+ */
+template <typename ResultType = void, typename Op>
+    requires BlockOperator<
+        Op,
+        std::conditional_t<
+            std::is_same_v<ResultType, void>,
+            std::conditional_t<std::is_floating_point_v<typename Op::value_type>,
+                               typename Op::value_type,
+                               double>,
+            ResultType>>
+[[nodiscard]] auto eigsh(const Op& op,
+                         size_t k,
+                         double tolerance = 1e-8,
+                         size_t max_iterations = 1000) {
+    using T = typename Op::value_type;
+    using TargetType =
+        std::conditional_t<std::is_same_v<ResultType, void>,
+                           std::conditional_t<std::is_floating_point_v<T>, T, double>,
+                           ResultType>;
+
+    static_assert(std::is_floating_point_v<TargetType>,
+                  "Eigen-decomposition result type must be floating point!");
+
+    if (op.row_count() != op.column_count()) {
+        throw std::invalid_argument("Operator must be square for eigsh!");
+    }
+    const size_t n = op.row_count();
+    if (k == 0 || k > n) {
+        throw std::invalid_argument("Number of eigenpairs must be in [1, n]!");
+    }
+    auto apply = [&op](const Matrix<TargetType>& x) -> Matrix<TargetType> {
+        auto product = op * x;
+        if constexpr (std::is_same_v<decltype(product), Matrix<TargetType>>) {
+            return product;
+        } else if constexpr (MatrixExpression<decltype(product)>) {
+            return Matrix<TargetType>(product);
+        } else {
+            return product.template cast<TargetType>();
+        }
+    };
+    return detail::_lobpcg<TargetType>(n, apply, k, tolerance, max_iterations);
+}
+
+/**
+ * @brief Computes the k largest eigenpairs of a matrix-free symmetric
+ * operator of size n x n.
+ * @details As eigsh() above, with the operator given as a callable that
+ * returns A X for an n x b block X.
+ * @throws std::invalid_argument if k is not in [1, n].
+ * @throws std::runtime_error if the iteration does not converge.
+ */
+template <std::floating_point T, typename Apply>
+    requires std::is_invocable_r_v<Matrix<T>, Apply&, const Matrix<T>&>
+[[nodiscard]] std::pair<Vector<T>, Matrix<T>> eigsh(size_t n,
+                                                    Apply&& apply,
+                                                    size_t k,
+                                                    double tolerance = 1e-8,
+                                                    size_t max_iterations = 1000) {
+    if (k == 0 || k > n) {
+        throw std::invalid_argument("Number of eigenpairs must be in [1, n]!");
+    }
+    return detail::_lobpcg<T>(n, apply, k, tolerance, max_iterations);
+}
+
+}  // namespace maf::math
+
+#endif  // EIGEN_H
@@ -0,0 +1,479 @@
+#ifndef EXPRESSIONS_H
+#define EXPRESSIONS_H
+#pragma once
+#include "LinAlg.hpp"
+
+/**
+ * @file Expressions.hpp
+ * @brief Lazy expression templates for element-wise Matrix and Vector
+ * arithmetic.
+ *
+ * The element-wise operators (`+`, `-`, scalar `*`, scalar `/` and unary
+ * minus) do not compute anything. They return small expression nodes that
+ * reference (lvalue operands) or own (rvalue operands) their inputs. The
+ * whole expression tree is evaluated in a single fused, SIMD and OpenMP
+ * parallel loop when it is assigned to a Matrix or Vector, so an expression
+ * such as `A + B - 2.0 * C` allocates only its result and reads every
+ * operand exactly once.
+ *
+ * Expression nodes can be inspected like the containers they produce
+ * (`row_count()`, `at()`, `operator==`, ...), and `eval()` materializes them
+ * explicitly.
+ *
+ * @attention Expressions holding lvalue operands by reference must not
+ * outlive those operands.
+ *
+ * This file is intended to be included by LinAlg.hpp and should not be
+ * included directly anywhere else.
+ */
+namespace maf::math {
+namespace detail {
+// Element-wise functors. Operands are already converted to the result type.
+struct _add {
+    template <typename R>
+    constexpr R operator()(R lhs, R rhs) const noexcept {
+        return lhs + rhs;
+    }
+};
+
+struct _subtract {
+    template <typename R>
+    constexpr R operator()(R lhs, R rhs) const noexcept {
+        return lhs - rhs;
+    }
+};
+
+struct _negate {
+    template <typename R>
+    constexpr R operator()(R value) const noexcept {
+        return -value;
+    }
+};
+
+template <typename R>
+struct _add_scalar {
+    R scalar;
+    constexpr R operator()(R value) const noexcept {
+        return value + scalar;
+    }
+};
+
+template <typename R>
+struct _subtract_scalar {
+    R scalar;
+    constexpr R operator()(R value) const noexcept {
+        return value - scalar;
+    }
+};
+
+template <typename R>
+struct _subtract_from_scalar {
+    R scalar;
+    constexpr R operator()(R value) const noexcept {
+        return scalar - value;
+    }
+};
+
+template <typename R>
+struct _multiply_scalar {
+    R scalar;
+    constexpr R operator()(R value) const noexcept {
+        return value * scalar;
+    }
+};
+
+template <typename R>
+struct _divide_scalar_by {
+    R scalar;
+    constexpr R operator()(R value) const noexcept {
+        return scalar / value;
+    }
+};
+
+/**
+ * @brief How an expression stores an operand: lvalues by const reference,
+ * rvalues (temporaries) by value so that they cannot dangle. Also used as the
+ * normalized operand type in the name of expression nodes.
+ */
+template <typename E>
+using _operand_storage_t = std::conditional_t<std::is_lvalue_reference_v<E>,
+                                              const std::remove_cvref_t<E>&,
+                                              std::remove_cvref_t<E>>;
+
+template <typename E>
+struct is_matrix_expression : std::false_type {};
+
+template <typename E>
+struct is_vector_expression : std::false_type {};
+
+template <typename E>
+struct is_matrix : std::false_type {};
+
+template <Numeric T>
+struct is_matrix<Matrix<T>> : std::true_type {};
+
+template <typename E>
+struct is_vector : std::false_type {};
+
+template <Numeric T>
+struct is_vector<Vector<T>> : std::true_type {};
+
+}  // namespace detail
+
+/** @brief A lazy, non-owning matrix-shaped expression (not a Matrix). */
+template <typename E>
+concept MatrixExpression = detail::is_matrix_expression<std::remove_cvref_t<E>>::value;
+
+/** @brief Anything usable as a matrix operand: a Matrix or a MatrixExpression. */
+template <typename E>
+concept MatrixOperand =
+    detail::is_matrix<std::remove_cvref_t<E>>::value || MatrixExpression<E>;
+
+/** @brief A lazy, non-owning vector-shaped expression (not a Vector). */
+template <typename E>
+concept VectorExpression = detail::is_vector_expression<std::remove_cvref_t<E>>::value;
+
+/** @brief Anything usable as a vector operand: a Vector or a VectorExpression. */
+template <typename E>
+concept VectorOperand =
+    detail::is_vector<std::remove_cvref_t<E>>::value || VectorExpression<E>;
+
+//=============================================================================
+// MATRIX EXPRESSIONS
+//=============================================================================
+
+/**
+ * @brief Lazy element-wise map over one matrix operand (`fn(e(i, j))`).
+ * @tparam R Element type of the expression.
+ * @tparam Fn Functor applied to every element (may carry a scalar).
+ * @tparam E Operand type, reference-qualified as captured.
+ */
+template <Numeric R, typename Fn, typename E>
+class MatrixUnaryExpr {
+public:
+    using value_type = R;
+
+    MatrixUnaryExpr(E&& operand, Fn fn)
+        : _operand(std::forward<E>(operand)), _fn(fn) {}
+
+    /** @brief The captured operand. */
+    [[nodiscard]] const auto& operand() const noexcept {
+        return _operand;
+    }
+
+    [[nodiscard]] size_t row_count() const noexcept {
+        return _operand.row_count();
+    }
+
+    [[nodiscard]] size_t column_count() const noexcept {
+        return _operand.column_count();
+    }
+
+    [[nodiscard]] size_t size() const noexcept {
+        return row_count() * column_count();
+    }
+
+    /** @brief Computes the element at (row, col) with no bounds check. */
+    [[nodiscard]] R operator()(size_t row, size_t col) const {
+        return _fn(static_cast<R>(_operand(row, col)));
+    }
+
+    /**
+     * @brief Computes the element at (row, col).
+     * @throws std::out_of_range if the index is invalid.
+     */
+    [[nodiscard]] R at(size_t row, size_t col) const {
+        if (row >= row_count() || col >= column_count()) {
+            throw std::out_of_range("Index out of bounds.");
+        }
+        return (*this)(row, col);
+    }
+
+    /** @brief Evaluates the expression into a new Matrix. */
+    [[nodiscard]] Matrix<R> eval() const {
+        return Matrix<R>(*this);
+    }
+
+    /** @brief Evaluates the expression into a new Matrix of type U. */
+    template <Numeric U>
+    [[nodiscard]] Matrix<U> cast() const {
+        return Matrix<U>(*this);
+    }
+
+private:
+    detail::_operand_storage_t<E> _operand;
+    Fn _fn;
+};
+
+/**
+ * @brief Lazy element-wise combination of two matrix operands
+ * (`fn(lhs(i, j), rhs(i, j))`).
+ * @tparam R Element type of the expression.
+ * @tparam Fn Binary functor applied to every pair of elements.
+ * @tparam L Left operand type, reference-qualified as captured.
+ * @tparam Rhs Right operand type, reference-qualified as captured.
+ */
+template <Numeric R, typename Fn, typename L, typename Rhs>
+class MatrixBinaryExpr {
+public:
+    using value_type = R;
+
+    MatrixBinaryExpr(L&& lhs, Rhs&& rhs)
+        : _lhs(std::forward<L>(lhs)), _rhs(std::forward<Rhs>(rhs)) {}
+
+    /** @brief The captured left operand. */
+    [[nodiscard]] const auto& lhs() const noexcept {
+        return _lhs;
+    }
+
+    /** @brief The captured right operand. */
+    [[nodiscard]] const auto& rhs() const noexcept {
+        return _rhs;
+    }
+
+    [[nodiscard]] size_t row_count() const noexcept {
+        return _lhs.row_count();
+    }
+
+    [[nodiscard]] size_t column_count() const noexcept {
+        return _lhs.column_count();
+    }
+
+    [[nodiscard]] size_t size() const noexcept {
+        return row_count() * column_count();
+    }
+
+    /** @brief Computes the element at (row, col) with no bounds check. */
+    [[nodiscard]] R operator()(size_t row, size_t col) const {
+        return Fn{}(static_cast<R>(_lhs(row, col)), static_cast<R>(_rhs(row, col)));
+    }
+
+    /**
+     * @brief Computes the element at (row, col).
+     * @throws std::out_of_range if the index is invalid.
+     */
+    [[nodiscard]] R at(size_t row, size_t col) const {
+        if (row >= row_count() || col >= column_count()) {
+            throw std::out_of_range("Index out of bounds.");
+        }
+        return (*this)(row, col);
+    }
+
+    /** @brief Evaluates the expression into a new Matrix. */
+    [[nodiscard]] Matrix<R> eval() const {
+        return Matrix<R>(*this);
+    }
+
+    /** @brief Evaluates the expression into a new Matrix of type U. */
+    template <Numeric U>
+    [[nodiscard]] Matrix<U> cast() const {
+        return Matrix<U>(*this);
+    }
+
+private:
+    detail::_operand_storage_t<L> _lhs;
+    detail::_operand_storage_t<Rhs> _rhs;
+};
+
+namespace detail {
+template <Numeric R, typename Fn, typename E>
+struct is_matrix_expression<MatrixUnaryExpr<R, Fn, E>> : std::true_type {};
+
+template <Numeric R, typename Fn, typename L, typename Rhs>
+struct is_matrix_expression<MatrixBinaryExpr<R, Fn, L, Rhs>> : std::true_type {};
+
+/**
+ * @brief Applies `op(dst_row[j * cs], expr(row, j))` along one row.
+ * @details Contiguous rows (cs == 1) get their own vectorized loop.
+ */
+template <typename T, typename E, typename Op>
+inline void _assign_matrix_row(
+    T* dst_row, size_t cs, const E& expr, size_t row, Op op) {
+    const size_t cols = expr.column_count();
+    if (cs == 1) {
+        #pragma omp simd
+        for (size_t j = 0; j < cols; ++j) {
+            op(dst_row[j], expr(row, j));
+        }
+    } else {
+        for (size_t j = 0; j < cols; ++j) {
+            op(dst_row[j * cs], expr(row, j));
+        }
+    }
+}
+
+/**
+ * @brief The fused evaluation loop shared by all matrix assignments.
+ *
+ * Applies `op(dst(i, j), expr(i, j))` to every element of a destination with
+ * row stride rs and column stride cs (a row-major Matrix is (cols, 1)). Rows
+ * are distributed across OpenMP threads for large expressions and every
+ * contiguous row is vectorized.
+ */
+template <typename T, typename E, typename Op>
+inline void _assign_matrix(T* dst, size_t rs, size_t cs, const E& expr, Op op) {
+    const size_t rows = expr.row_count();
+    const size_t cols = expr.column_count();
+
+    if (rows * cols > OMP_LINEAR_LIMIT) {
+        #pragma omp parallel for
+        for (size_t i = 0; i < rows; ++i) {
+            _assign_matrix_row(dst + (i * rs), cs, expr, i, op);
+        }
+    } else {
+        for (size_t i = 0; i < rows; ++i) {
+            _assign_matrix_row(dst + (i * rs), cs, expr, i, op);
+        }
+    }
+}
+
+/**
+ * @brief Returns the operand itself if it is already a Matrix, or its
+ * evaluation otherwise. Used where a kernel needs materialized storage.
+ */
+template <MatrixOperand E>
+[[nodiscard]] inline decltype(auto) _materialize(const E& operand) {
+    if constexpr (MatrixExpression<E>) {
+        return operand.eval();
+    } else {
+        return (operand);
+    }
+}
+
+}  // namespace detail
+
+//=============================================================================
+// VECTOR EXPRESSIONS
+//=============================================================================
+
+/**
+ * @brief Lazy element-wise map over one vector operand (`fn(e[i])`).
+ * @tparam R Element type of the expression.
+ * @tparam Fn Functor applied to every element (may carry a scalar).
+ * @tparam E Operand type, reference-qualified as captured.
+ */
+template <Numeric R, typename Fn, typename E>
+class VectorUnaryExpr {
+public:
+    using value_type = R;
+
+    VectorUnaryExpr(E&& operand, Fn fn)
+        : _operand(std::forward<E>(operand)), _fn(fn) {}
+
+    [[nodiscard]] size_t size() const noexcept {
+        return _operand.size();
+    }
+
+    [[nodiscard]] Orientation orientation() const noexcept {
+        return _operand.orientation();
+    }
+
+    /** @brief Computes the element at index with no bounds check. */
+    [[nodiscard]] R operator[](size_t index) const {
+        return _fn(static_cast<R>(_operand[index]));
+    }
+
+    /**
+     * @brief Computes the element at index.
+     * @throws std::out_of_range if the index is invalid.
+     */
+    [[nodiscard]] R at(size_t index) const {
+        if (index >= size()) {
+            throw std::out_of_range("Index out of bounds.");
+        }
+        return (*this)[index];
+    }
+
+    /** @brief Evaluates the expression into a new Vector. */
+    [[nodiscard]] Vector<R> eval() const {
+        return Vector<R>(*this);
+    }
+
+private:
+    detail::_operand_storage_t<E> _operand;
+    Fn _fn;
+};
+
+/**
+ * @brief Lazy element-wise combination of two vector operands
+ * (`fn(lhs[i], rhs[i])`).
+ * @tparam R Element type of the expression.
+ * @tparam Fn Binary functor applied to every pair of elements.
+ * @tparam L Left operand type, reference-qualified as captured.
+ * @tparam Rhs Right operand type, reference-qualified as captured.
+ */
+template <Numeric R, typename Fn, typename L, typename Rhs>
+class VectorBinaryExpr {
+public:
+    using value_type = R;
+
+    VectorBinaryExpr(L&& lhs, Rhs&& rhs)
+        : _lhs(std::forward<L>(lhs)), _rhs(std::forward<Rhs>(rhs)) {}
+
+    [[nodiscard]] size_t size() const noexcept {
+        return _lhs.size();
+    }
+
+    [[nodiscard]] Orientation orientation() const noexcept {
+        return _lhs.orientation();
+    }
+
+    /** @brief Computes the element at index with no bounds check. */
+    [[nodiscard]] R operator[](size_t index) const {
+        return Fn{}(static_cast<R>(_lhs[index]), static_cast<R>(_rhs[index]));
+    }
+
+    /**
+     * @brief Computes the element at index.
+     * @throws std::out_of_range if the index is invalid.
+     */
+    [[nodiscard]] R at(size_t index) const {
+        if (index >= size()) {
+            throw std::out_of_range("Index out of bounds.");
+        }
+        return (*this)[index];
+    }
+
+    /** @brief Evaluates the expression into a new Vector. */
+    [[nodiscard]] Vector<R> eval() const {
+        return Vector<R>(*this);
+    }
+
+private:
+    detail::_operand_storage_t<L> _lhs;
+    detail::_operand_storage_t<Rhs> _rhs;
+};
+
+namespace detail {
+template <Numeric R, typename Fn, typename E>
+struct is_vector_expression<VectorUnaryExpr<R, Fn, E>> : std::true_type {};
+
+template <Numeric R, typename Fn, typename L, typename Rhs>
+struct is_vector_expression<VectorBinaryExpr<R, Fn, L, Rhs>> : std::true_type {};
+
+/**
+ * @brief The fused evaluation loop shared by all vector assignments.
+ * @details Applies `op(dst[i], expr[i])` to every element, in parallel for
+ * large vectors and vectorized otherwise.
+ */
+template <typename T, typename E, typename Op>
+inline void _assign_vector(T* dst, const E& expr, Op op) {
+    const size_t n = expr.size();
+
+    if (n > OMP_LINEAR_LIMIT) {
+        #pragma omp parallel for simd
+        for (size_t i = 0; i < n; ++i) {
+            op(dst[i], expr[i]);
+        }
+    } else {
+        #pragma omp simd
+        for (size_t i = 0; i < n; ++i) {
+            op(dst[i], expr[i]);
+        }
+    }
+}
+
+}  // namespace detail
+}  // namespace maf::math
+
+#endif
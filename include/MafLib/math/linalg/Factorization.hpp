@@ -0,0 +1,482 @@
+#ifndef FACTORIZATION_H
+#define FACTORIZATION_H
+#pragma once
+#include "LinAlg.hpp"
+#include "SymmetricMatrix.hpp"
+#include "TriangularMatrix.hpp"
+
+/**
+ * @file Factorization.hpp
+ * @brief Factorization objects that factor a dense matrix once and then
+ * solve against any number of right-hand sides.
+ *
+ * The factors are kept as packed TriangularMatrix objects, so every solve
+ * is a pair of blocked triangular solves (trsv() for a vector, trsm() for
+ * a matrix of right-hand sides) and costs O(n^2) per right-hand side
+ * against O(n^3) for factoring again. QRFactorization keeps its Q implicit
+ * as Householder reflectors, applied in blocks with apply_q() / apply_qt().
+ */
+namespace maf::math {
+namespace detail {
+/** @brief Copies a matrix, view or expression into a Matrix<T>. */
+template <std::floating_point T, MatrixOperand E>
+[[nodiscard]] Matrix<T> _converted(const E& matrix) {
+    Matrix<T> result(matrix.row_count(), matrix.column_count(), default_init);
+    for (size_t i = 0; i < matrix.row_count(); ++i) {
+        for (size_t j = 0; j < matrix.column_count(); ++j) {
+            result(i, j) = static_cast<T>(matrix(i, j));
+        }
+    }
+    return result;
+}
+}  // namespace detail
+
+/**
+ * @brief LU factorization with partial pivoting P A = L U of a square
+ * matrix, kept for repeated solves.
+ *
+ * The matrix is factored in place with getrf() and the packed result is
+ * split into a unit lower and an upper TriangularMatrix.
+ *
+ * @tparam T Floating point type of the factors.
+ */
+template <std::floating_point T>
+class LUFactorization {
+public:
+    /**
+     * @brief Factors a square matrix; an rvalue is factored without a copy.
+     * @throws std::invalid_argument if the matrix is not square.
+     * @throws std::runtime_error if the matrix is singular.
+     */
+    explicit LUFactorization(Matrix<T> matrix)
+        : _pivots(getrf(matrix)),
+          _permutation(detail::_ipiv_to_permutation(_pivots)),
+          _l(matrix),
+          _u(matrix) {}
+
+    /**
+     * @brief Factors a square matrix of another type, a view or an
+     * expression, converted to T.
+     */
+    template <MatrixOperand E>
+        requires(!std::same_as<E, Matrix<T>>)
+    explicit LUFactorization(const E& matrix)
+        : LUFactorization(detail::_converted<T>(matrix)) {}
+
+    // --- Getters ---
+
+    [[nodiscard]] size_t size() const noexcept {
+        return _u.size();
+    }
+
+    /** @brief Row i was interchanged with row pivots()[i] at step i. */
+    [[nodiscard]] const std::vector<uint32>& pivots() const noexcept {
+        return _pivots;
+    }
+
+    /** @brief Row i of P A is row permutation()[i] of A. */
+    [[nodiscard]] const std::vector<uint32>& permutation() const noexcept {
+        return _permutation;
+    }
+
+    /** @brief The unit lower triangular factor L. */
+    [[nodiscard]] const TriangularMatrix<T, LOWER, UNIT>& lower() const noexcept {
+        return _l;
+    }
+
+    /** @brief The upper triangular factor U. */
+    [[nodiscard]] const TriangularMatrix<T, UPPER>& upper() const noexcept {
+        return _u;
+    }
+
+    // --- Methods ---
+
+    /**
+     * @brief Solves A x = b.
+     * @throws std::invalid_argument if the size of b does not match.
+     */
+    template <Numeric U>
+    [[nodiscard]] Vector<T> solve(const Vector<U>& b) const {
+        if (b.size() != size()) {
+            throw std::invalid_argument("Right-hand side size does not match!");
+        }
+        Vector<T> x(size(), default_init, b.orientation());
+        for (size_t i = 0; i < size(); ++i) {
+            x[i] = static_cast<T>(b[_permutation[i]]);
+        }
+        trsv(_l, x);
+        trsv(_u, x);
+        return x;
+    }
+
+    /**
+     * @brief Solves A X = B for every column of B.
+     * @throws std::invalid_argument if the row count of B does not match.
+     */
+    template <MatrixOperand E>
+    [[nodiscard]] Matrix<T> solve(const E& b) const {
+        if (b.row_count() != size()) {
+            throw std::invalid_argument("Right-hand side size does not match!");
+        }
+        Matrix<T> x(size(), b.column_count(), default_init);
+        #pragma omp parallel for if (size() * b.column_count() > OMP_LINEAR_LIMIT)
+        for (size_t i = 0; i < size(); ++i) {
+            for (size_t j = 0; j < b.column_count(); ++j) {
+                x(i, j) = static_cast<T>(b(_permutation[i], j));
+            }
+        }
+        trsm(_l, x);
+        trsm(_u, x);
+        return x;
+    }
+
+    /** @brief A^-1, solved column by column from the identity. */
+    [[nodiscard]] Matrix<T> inverse() const {
+        return solve(identity_matrix<T>(size()));
+    }
+
+    /** @brief det(A), the signed product of the pivots. */
+    [[nodiscard]] T determinant() const noexcept {
+        T result = T(1);
+        for (size_t i = 0; i < size(); ++i) {
+            result *= _u(i, i);
+            if (_pivots[i] != i) {
+                result = -result;
+            }
+        }
+        return result;
+    }
+
+    /**
+     * @brief log |det(A)|, which does not overflow for large matrices.
+     * @details The sign is lost; it is the sign of determinant() whenever
+     * that does not underflow.
+     */
+    [[nodiscard]] T log_determinant() const noexcept {
+        T result = T(0);
+        for (size_t i = 0; i < size(); ++i) {
+            result += std::log(std::abs(_u(i, i)));
+        }
+        return result;
+    }
+
+private:
+    std::vector<uint32> _pivots;
+    std::vector<uint32> _permutation;
+    TriangularMatrix<T, LOWER, UNIT> _l;
+    TriangularMatrix<T, UPPER> _u;
+};
+
+/**
+ * @brief Cholesky factorization A = L L^T of a symmetric positive definite
+ * matrix, kept for repeated solves.
+ *
+ * The factor is computed by the tiled cholesky() of SymmetricMatrix and
+ * stored packed, in about half the memory of a dense matrix.
+ *
+ * @tparam T Floating point type of the factor.
+ */
+template <std::floating_point T>
+class CholeskyFactorization {
+public:
+    /**
+     * @brief Factors a SymmetricMatrix.
+     * @throws std::invalid_argument if the matrix is not positive definite.
+     */
+    template <Numeric U>
+    explicit CholeskyFactorization(const SymmetricMatrix<U>& matrix)
+        : _l(cholesky<T>(matrix)) {}
+
+    /**
+     * @brief Factors a dense matrix, view or expression.
+     * @throws std::invalid_argument if the matrix is not square, not
+     * symmetric or not positive definite.
+     */
+    template <MatrixOperand E>
+    explicit CholeskyFactorization(const E& matrix)
+        : CholeskyFactorization(_symmetric(matrix)) {}
+
+    // --- Getters ---
+
+    [[nodiscard]] size_t size() const noexcept {
+        return _l.size();
+    }
+
+    /** @brief The lower triangular factor L. */
+    [[nodiscard]] const TriangularMatrix<T, LOWER>& factor() const noexcept {
+        return _l;
+    }
+
+    // --- Methods ---
+
+    /**
+     * @brief Solves A x = b as L y = b, L^T x = y.
+     * @throws std::invalid_argument if the size of b does not match.
+     */
+    template <Numeric U>
+    [[nodiscard]] Vector<T> solve(const Vector<U>& b) const {
+        Vector<T> x = _l.solve(b);
+        trsv(_l, x, TRANSPOSE);
+        return x;
+    }
+
+    /**
+     * @brief Solves A X = B for every column of B.
+     * @throws std::invalid_argument if the row count of B does not match.
+     */
+    template <MatrixOperand E>
+    [[nodiscard]] Matrix<T> solve(const E& b) const {
+        Matrix<T> x = _l.solve(b);
+        trsm(_l, x, TRANSPOSE);
+        return x;
+    }
+
+    /** @brief A^-1, solved column by column from the identity. */
+    [[nodiscard]] Matrix<T> inverse() const {
+        return solve(identity_matrix<T>(size()));
+    }
+
+    /** @brief det(A), the squared product of the diagonal of L. */
+    [[nodiscard]] T determinant() const noexcept {
+        T result = T(1);
+        for (size_t i = 0; i < size(); ++i) {
+            result *= _l(i, i) * _l(i, i);
+        }
+        return result;
+    }
+
+    /** @brief log det(A), which does not overflow for large matrices. */
+    [[nodiscard]] T log_determinant() const noexcept {
+        T result = T(0);
+        for (size_t i = 0; i < size(); ++i) {
+            result += std::log(_l(i, i));
+        }
+        return T(2) * result;
+    }
+
+private:
+    TriangularMatrix<T, LOWER> _l;
+
+    template <MatrixOperand E>
+    [[nodiscard]] static SymmetricMatrix<T> _symmetric(const E& matrix) {
+        if (!detail::_is_symmetric(matrix)) {
+            throw std::invalid_argument(
+                "Matrix must be symmetric to try Cholesky decomposition!");
+        }
+        return SymmetricMatrix<T>(matrix);
+    }
+};
+
+/**
+ * @brief Householder QR factorization A = Q R of an m x n matrix, kept for
+ * least squares solves and for applying Q.
+ *
+ * The matrix is factored in place with geqrf(); Q stays implicit as the
+ * reflectors below the diagonal and is applied in compact WY blocks, so
+ * apply_q() and apply_qt() cost O(m n p) for p columns without ever forming
+ * the m x m matrix. q() forms the thin Q when it is needed explicitly.
+ *
+ * @tparam T Floating point type of the factors.
+ */
+template <std::floating_point T>
+class QRFactorization {
+public:
+    /** @brief Factors a matrix; an rvalue is factored without a copy. */
+    explicit QRFactorization(Matrix<T> matrix)
+        : _tau(geqrf(matrix)), _packed(std::move(matrix)) {}
+
+    /**
+     * @brief Factors a matrix of another type, a view or an expression,
+     * converted to T.
+     */
+    template <MatrixOperand E>
+        requires(!std::same_as<E, Matrix<T>>)
+    explicit QRFactorization(const E& matrix)
+        : QRFactorization(detail::_converted<T>(matrix)) {}
+
+    // --- Getters ---
+
+    [[nodiscard]] size_t row_count() const noexcept {
+        return _packed.row_count();
+    }
+
+    [[nodiscard]] size_t column_count() const noexcept {
+        return _packed.column_count();
+    }
+
+    /** @brief The scalars of the reflectors H_j = I - tau[j] v_j v_j^T. */
+    [[nodiscard]] const std::vector<T>& tau() const noexcept {
+        return _tau;
+    }
+
+    /** @brief R on and above the diagonal, the reflectors below it. */
+    [[nodiscard]] const Matrix<T>& packed() const noexcept {
+        return _packed;
+    }
+
+    // --- Methods ---
+
+    /** @brief The min(m, n) x n upper trapezoidal factor R. */
+    [[nodiscard]] Matrix<T> r() const {
+        Matrix<T> result(_tau.size(), column_count());
+        for (size_t i = 0; i < _tau.size(); ++i) {
+            for (size_t j = i; j < column_count(); ++j) {
+                result(i, j) = _packed(i, j);
+            }
+        }
+        return result;
+    }
+
+    /** @brief The m x min(m, n) factor Q with orthonormal columns. */
+    [[nodiscard]] Matrix<T> q() const {
+        Matrix<T> result(row_count(), _tau.size());
+        for (size_t i = 0; i < _tau.size(); ++i) {
+            result(i, i) = T(1);
+        }
+        apply_q(result);
+        return result;
+    }
+
+    /**
+     * @brief Overwrites C with Q C.
+     * @throws std::invalid_argument if the row count of C does not match.
+     */
+    void apply_q(Matrix<T>& c) const {
+        _apply(false, c);
+    }
+
+    /**
+     * @brief Overwrites C with Q^T C.
+     * @throws std::invalid_argument if the row count of C does not match.
+     */
+    void apply_qt(Matrix<T>& c) const {
+        _apply(true, c);
+    }
+
+    /**
+     * @brief Overwrites x with Q x.
+     * @throws std::invalid_argument if the size of x does not match.
+     */
+    void apply_q(Vector<T>& x) const {
+        _apply(false, x);
+    }
+
+    /**
+     * @brief Overwrites x with Q^T x.
+     * @throws std::invalid_argument if the size of x does not match.
+     */
+    void apply_qt(Vector<T>& x) const {
+        _apply(true, x);
+    }
+
+    /**
+     * @brief Least squares solution of A x = b, x = R^-1 (Q^T b)[0:n].
+     * @throws std::invalid_argument if A has fewer rows than columns or the
+     * size of b does not match.
+     * @throws std::runtime_error if A is rank deficient.
+     */
+    template <Numeric U>
+    [[nodiscard]] Vector<T> solve(const Vector<U>& b) const {
+        Vector<T> y(b.size(), default_init, b.orientation());
+        for (size_t i = 0; i < b.size(); ++i) {
+            y[i] = static_cast<T>(b[i]);
+        }
+        _check_solvable(b.size());
+        apply_qt(y);
+
+        Vector<T> x(column_count(), default_init, b.orientation());
+        std::copy_n(y.data().begin(), column_count(), x.data().begin());
+        trsv(_upper(), x);
+        return x;
+    }
+
+    /**
+     * @brief Least squares solution of A X = B for every column of B.
+     * @throws std::invalid_argument if A has fewer rows than columns or the
+     * row count of B does not match.
+     * @throws std::runtime_error if A is rank deficient.
+     */
+    template <MatrixOperand E>
+    [[nodiscard]] Matrix<T> solve(const E& b) const {
+        _check_solvable(b.row_count());
+        Matrix<T> y = detail::_converted<T>(b);
+        apply_qt(y);
+
+        Matrix<T> x(column_count(), b.column_count(), default_init);
+        for (size_t i = 0; i < column_count(); ++i) {
+            std::ranges::copy(y.row_span(i), x.row_span(i).begin());
+        }
+        trsm(_upper(), x);
+        return x;
+    }
+
+private:
+    std::vector<T> _tau;
+    Matrix<T> _packed;
+
+    template <typename Operand>
+    void _apply(bool transpose, Operand& c) const {
+        if (_rows_of(c) != row_count()) {
+            throw std::invalid_argument("Operand row count does not match!");
+        }
+        detail::_ormqr(row_count(),
+                       _tau.size(),
+                       _packed.data().data(),
+                       _packed.leading_dimension(),
+                       _tau.data(),
+                       transpose,
+                       _columns_of(c),
+                       c.data().data(),
+                       _leading_dimension_of(c));
+    }
+
+    [[nodiscard]] static size_t _rows_of(const Matrix<T>& c) noexcept {
+        return c.row_count();
+    }
+
+    [[nodiscard]] static size_t _rows_of(const Vector<T>& x) noexcept {
+        return x.size();
+    }
+
+    [[nodiscard]] static size_t _columns_of(const Matrix<T>& c) noexcept {
+        return c.column_count();
+    }
+
+    [[nodiscard]] static size_t _columns_of(const Vector<T>& /*unused*/) noexcept {
+        return 1;
+    }
+
+    [[nodiscard]] static size_t _leading_dimension_of(const Matrix<T>& c) noexcept {
+        return c.leading_dimension();
+    }
+
+    [[nodiscard]] static size_t _leading_dimension_of(
+        const Vector<T>& /*unused*/) noexcept {
+        return 1;
+    }
+
+    void _check_solvable(size_t rhs_rows) const {
+        if (row_count() < column_count()) {
+            throw std::invalid_argument(
+                "Least squares needs at least as many rows as columns!");
+        }
+        if (rhs_rows != row_count()) {
+            throw std::invalid_argument("Right-hand side size does not match!");
+        }
+        for (size_t i = 0; i < column_count(); ++i) {
+            if (is_close(_packed(i, i), static_cast<T>(0), 1e-9)) {
+                throw std::runtime_error("Matrix is rank deficient.");
+            }
+        }
+    }
+
+    /** @brief The leading n x n triangle of R. */
+    [[nodiscard]] TriangularMatrix<T, UPPER> _upper() const {
+        return TriangularMatrix<T, UPPER>(
+            _packed.block(0, 0, column_count(), column_count()));
+    }
+};
+
+}  // namespace maf::math
+
+#endif
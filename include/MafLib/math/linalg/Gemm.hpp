@@ -0,0 +1,335 @@
+#ifndef GEMM_H
+#define GEMM_H
+#pragma once
+#include "AlignedBuffer.hpp"
+#include "MafLib/math/Math.hpp"
+
+/**
+ * @file Gemm.hpp
+ * @brief Portable packed GEMM engine (C = alpha * A * B + beta * C).
+ *
+ * The implementation follows the BLIS/GotoBLAS design:
+ * - B is split into KC x NC panels and A into MC x KC blocks, sized so that
+ *   a packed block of A stays in L2 and a micro-panel of B stays in L1.
+ * - Both are copied ("packed") into contiguous buffers in the exact order in
+ *   which the micro-kernel reads them, zero-padded to full register tiles.
+ * - The micro-kernel keeps an MR x NR tile of C in registers for the whole
+ *   KC loop, so every loaded element of A is reused NR times and every
+ *   loaded element of B MR times.
+ *
+ * All operands are addressed through a row stride and a column stride, so
+ * row-major, column-major and transposed operands are handled by the packing
+ * step without extra copies.
+ *
+ * The element types of A, B and C are independent of the compute type T in
+ * which the micro-kernel accumulates. Packing converts A and B to T on the
+ * fly and the micro-kernel converts on write-back, so mixed products
+ * (float x double, int x double, float storage with double accumulation)
+ * need no staging copies of the operands.
+ *
+ * This file is included by Matrix.hpp and should not be included directly
+ * anywhere else.
+ */
+namespace maf::math {
+namespace detail {
+/**
+ * @brief Cache and register blocking parameters of the packed GEMM engine.
+ *
+ * MR x NR is the register tile of the micro-kernel. The defaults target
+ * 256-bit SIMD (AVX2/FMA: 12 vector accumulators) and also fit the 32
+ * 128-bit registers of NEON.
+ */
+template <typename T>
+struct GemmBlocking {
+    static constexpr size_t MR = 4;
+    static constexpr size_t NR = 4;
+    static constexpr size_t MC = 64;
+    static constexpr size_t KC = 256;
+    static constexpr size_t NC = 4096;
+};
+
+template <>
+struct GemmBlocking<double> {
+    static constexpr size_t MR = 6;
+    static constexpr size_t NR = 8;
+    static constexpr size_t MC = 96;
+    static constexpr size_t KC = 256;
+    static constexpr size_t NC = 4096;
+};
+
+template <>
+struct GemmBlocking<float> {
+    static constexpr size_t MR = 6;
+    static constexpr size_t NR = 16;
+    static constexpr size_t MC = 96;
+    static constexpr size_t KC = 256;
+    static constexpr size_t NC = 4096;
+};
+
+/** @brief Minimal amount of work (m * n * k) before GEMM goes parallel. */
+constexpr static size_t GEMM_OMP_LIMIT = 64 * 64 * 64;
+
+/**
+ * @brief Packs an mc x kc block of A into MR-row micro-panels, converting
+ * the elements to T.
+ * @details Micro-panel p holds rows [p * MR, p * MR + MR) stored column by
+ * column; rows past mc are zero-filled.
+ */
+template <typename T, typename TA>
+inline void _gemm_pack_a(size_t mc,
+                         size_t kc,
+                         const TA* a,
+                         size_t rsa,
+                         size_t csa,
+                         T* packed) {
+    constexpr size_t MR = GemmBlocking<T>::MR;
+    for (size_t ir = 0; ir < mc; ir += MR) {
+        const size_t mr = std::min(MR, mc - ir);
+        T* dst = packed + (ir * kc);
+        for (size_t p = 0; p < kc; ++p) {
+            const TA* src = a + (ir * rsa) + (p * csa);
+            for (size_t i = 0; i < mr; ++i) {
+                dst[(p * MR) + i] = static_cast<T>(src[i * rsa]);
+            }
+            for (size_t i = mr; i < MR; ++i) {
+                dst[(p * MR) + i] = T(0);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Packs the NR-column micro-panel of a kc x nc panel of B that starts
+ * at column jr, converting the elements to T.
+ * @details The micro-panel is stored row by row; columns past nc are
+ * zero-filled. Packing one micro-panel per call lets threads share the work.
+ */
+template <typename T, typename TB>
+inline void _gemm_pack_b(size_t kc,
+                         size_t nc,
+                         const TB* b,
+                         size_t rsb,
+                         size_t csb,
+                         T* packed,
+                         size_t jr) {
+    constexpr size_t NR = GemmBlocking<T>::NR;
+    const size_t nr = std::min(NR, nc - jr);
+    T* dst = packed + (jr * kc);
+    for (size_t p = 0; p < kc; ++p) {
+        const TB* src = b + (p * rsb) + (jr * csb);
+        if (csb == 1) {
+            #pragma omp simd
+            for (size_t j = 0; j < nr; ++j) {
+                dst[(p * NR) + j] = static_cast<T>(src[j]);
+            }
+        } else {
+            for (size_t j = 0; j < nr; ++j) {
+                dst[(p * NR) + j] = static_cast<T>(src[j * csb]);
+            }
+        }
+        for (size_t j = nr; j < NR; ++j) {
+            dst[(p * NR) + j] = T(0);
+        }
+    }
+}
+
+/**
+ * @brief Register-tiled micro-kernel: C_tile = alpha * A_panel * B_panel +
+ * beta * C_tile.
+ *
+ * The MR x NR accumulator is a local array with compile-time extents, which
+ * the compiler keeps entirely in vector registers and updates with fused
+ * multiply-adds. Only the valid mr x nr corner is written back to C, converted
+ * to TC. When beta is zero C is never read, so it may hold uninitialised
+ * memory.
+ */
+template <typename T, typename TC>
+inline void _gemm_micro_kernel(size_t kc,
+                               const T* a,
+                               const T* b,
+                               T alpha,
+                               T beta,
+                               TC* c,
+                               size_t rsc,
+                               size_t csc,
+                               size_t mr,
+                               size_t nr) {
+    constexpr size_t MR = GemmBlocking<T>::MR;
+    constexpr size_t NR = GemmBlocking<T>::NR;
+
+    T acc[MR][NR] = {};
+    for (size_t p = 0; p < kc; ++p) {
+        const T* a_p = a + (p * MR);
+        const T* b_p = b + (p * NR);
+        for (size_t i = 0; i < MR; ++i) {
+            const T a_ip = a_p[i];
+            #pragma omp simd
+            for (size_t j = 0; j < NR; ++j) {
+                acc[i][j] += a_ip * b_p[j];
+            }
+        }
+    }
+
+    if (beta == T(0)) {
+        for (size_t i = 0; i < mr; ++i) {
+            TC* c_row = c + (i * rsc);
+            for (size_t j = 0; j < nr; ++j) {
+                c_row[j * csc] = static_cast<TC>(alpha * acc[i][j]);
+            }
+        }
+    } else {
+        for (size_t i = 0; i < mr; ++i) {
+            TC* c_row = c + (i * rsc);
+            for (size_t j = 0; j < nr; ++j) {
+                const T c_ij = static_cast<T>(c_row[j * csc]);
+                c_row[j * csc] = static_cast<TC>((beta * c_ij) + (alpha * acc[i][j]));
+            }
+        }
+    }
+}
+
+/**
+ * @brief Scales an m x n strided matrix in-place: C = beta * C.
+ * @details Used for the degenerate k == 0 case; beta == 0 clears C without
+ * reading it.
+ */
+template <typename T, typename TC>
+inline void _gemm_scale(size_t m, size_t n, T beta, TC* c, size_t rsc, size_t csc) {
+    for (size_t i = 0; i < m; ++i) {
+        for (size_t j = 0; j < n; ++j) {
+            TC& value = c[(i * rsc) + (j * csc)];
+            value = (beta == T(0)) ? TC(0)
+                                   : static_cast<TC>(beta * static_cast<T>(value));
+        }
+    }
+}
+
+/**
+ * @brief Packed, cache-blocked and parallel general matrix multiply.
+ *
+ * Computes C = alpha * A * B + beta * C where A is m x k, B is k x n and C is
+ * m x n. Every operand is described by a base pointer, a row stride and a
+ * column stride, so a row-major matrix with leading dimension ld is passed
+ * as (ptr, ld, 1) and its transpose as (ptr, 1, ld).
+ *
+ * Loop structure (outer to inner): NC panels of B (jc), KC slices of the
+ * inner dimension (pc, B panel packed cooperatively by all threads), MC
+ * blocks of A (ic, distributed across threads, each packing its own block),
+ * then NR and MR micro-tiles handled by the register micro-kernel.
+ *
+ * @tparam T Floating point compute type: packing converts A and B to T, the
+ * micro-kernel accumulates in T.
+ * @tparam TA Element type of A.
+ * @tparam TB Element type of B.
+ * @tparam TC Element type of C.
+ * @param m Rows of A and C.
+ * @param n Columns of B and C.
+ * @param k Columns of A and rows of B.
+ * @param alpha Scalar multiplying A * B.
+ * @param a Pointer to A(0, 0).
+ * @param rsa Distance between consecutive rows of A.
+ * @param csa Distance between consecutive columns of A.
+ * @param b Pointer to B(0, 0).
+ * @param rsb Distance between consecutive rows of B.
+ * @param csb Distance between consecutive columns of B.
+ * @param beta Scalar multiplying C. When zero, C is write-only.
+ * @param c Pointer to C(0, 0). Must not alias A or B.
+ * @param rsc Distance between consecutive rows of C.
+ * @param csc Distance between consecutive columns of C.
+ */
+template <typename T, typename TA, typename TB, typename TC>
+void _gemm(size_t m,
+           size_t n,
+           size_t k,
+           T alpha,
+           const TA* a,
+           size_t rsa,
+           size_t csa,
+           const TB* b,
+           size_t rsb,
+           size_t csb,
+           T beta,
+           TC* c,
+           size_t rsc,
+           size_t csc) {
+    using Blocking = GemmBlocking<T>;
+    constexpr size_t MR = Blocking::MR;
+    constexpr size_t NR = Blocking::NR;
+
+    if (m == 0 || n == 0) {
+        return;
+    }
+    if (k == 0 || alpha == T(0)) {
+        _gemm_scale(m, n, beta, c, rsc, csc);
+        return;
+    }
+
+    // Inside a parallel region (e.g. one GEMM per tile of a tiled
+    // algorithm) the caller owns the threads; run on the calling one.
+    const bool parallel = m * n * k > GEMM_OMP_LIMIT && !omp_in_parallel();
+    const size_t threads = parallel ? static_cast<size_t>(omp_get_max_threads()) : 1;
+
+    // Shrink the A blocks when m is small so that every thread gets work.
+    const size_t rows_per_thread = (m + threads - 1) / threads;
+    const size_t mc_block =
+        std::min(Blocking::MC, std::max(MR, ((rows_per_thread + MR - 1) / MR) * MR));
+    const size_t kc_block = std::min(Blocking::KC, k);
+    const size_t nc_block = std::min(Blocking::NC, ((n + NR - 1) / NR) * NR);
+
+    AlignedBuffer<T> b_packed(kc_block * nc_block, default_init);
+
+    #pragma omp parallel if (parallel)
+    {
+        AlignedBuffer<T> a_packed(mc_block * kc_block, default_init);
+
+        for (size_t jc = 0; jc < n; jc += nc_block) {
+            const size_t nc = std::min(nc_block, n - jc);
+
+            for (size_t pc = 0; pc < k; pc += kc_block) {
+                const size_t kc = std::min(kc_block, k - pc);
+                const T beta_pc = (pc == 0) ? beta : T(1);
+
+                #pragma omp for schedule(static)
+                for (size_t jr = 0; jr < nc; jr += NR) {
+                    _gemm_pack_b(kc,
+                                 nc,
+                                 b + (pc * rsb) + (jc * csb),
+                                 rsb,
+                                 csb,
+                                 b_packed.data(),
+                                 jr);
+                }
+
+                #pragma omp for schedule(dynamic)
+                for (size_t ic = 0; ic < m; ic += mc_block) {
+                    const size_t mc = std::min(mc_block, m - ic);
+                    _gemm_pack_a(
+                        mc, kc, a + (ic * rsa) + (pc * csa), rsa, csa, a_packed.data());
+
+                    for (size_t jr = 0; jr < nc; jr += NR) {
+                        const size_t nr = std::min(NR, nc - jr);
+                        for (size_t ir = 0; ir < mc; ir += MR) {
+                            const size_t mr = std::min(MR, mc - ir);
+                            TC* c_tile = c + ((ic + ir) * rsc) + ((jc + jr) * csc);
+                            _gemm_micro_kernel(kc,
+                                               a_packed.data() + (ir * kc),
+                                               b_packed.data() + (jr * kc),
+                                               alpha,
+                                               beta_pc,
+                                               c_tile,
+                                               rsc,
+                                               csc,
+                                               mr,
+                                               nr);
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+}  // namespace detail
+}  // namespace maf::math
+
+#endif
@@ -0,0 +1,221 @@
+#ifndef GEMV_H
+#define GEMV_H
+#pragma once
+#include "AlignedBuffer.hpp"
+#include "MafLib/math/Math.hpp"
+
+/**
+ * @file Gemv.hpp
+ * @brief Matrix-vector kernels (y = alpha * A * x + beta * y).
+ *
+ * A matrix-vector product reads every element of A exactly once, so it is
+ * limited by memory bandwidth; the kernels therefore stream A in its storage
+ * order and never allocate:
+ * - rows of A contiguous (row-major, the Matrix * Vector case): GEMV_ROWS
+ *   rows are reduced at once with SIMD dot products that share every load
+ *   of x, and row blocks are distributed across threads,
+ * - columns of A contiguous (a transposed row-major matrix, i.e. the
+ *   Vector * Matrix case): each thread owns a panel of GEMV_PANEL outputs,
+ *   kept in a local accumulator, and adds GEMV_COLUMNS scaled columns per
+ *   sweep with SIMD axpy updates.
+ *
+ * Like the GEMM engine, A, x and y may have different element types; all
+ * arithmetic is done in the compute type T.
+ *
+ * This file is included by Matrix.hpp and should not be included directly
+ * anywhere else.
+ */
+namespace maf::math {
+namespace detail {
+/** @brief Rows reduced together by the row-major GEMV kernel. */
+constexpr static size_t GEMV_ROWS = 4;
+
+/** @brief Outputs accumulated per thread task by the column-major kernel. */
+constexpr static size_t GEMV_PANEL = 256;
+
+/** @brief Columns added per sweep over a panel by the column-major kernel. */
+constexpr static size_t GEMV_COLUMNS = 4;
+
+/** @brief y = alpha * sum + beta * y; y is not read when beta is zero. */
+template <typename T, typename TY>
+inline void _gemv_store(T alpha, T sum, T beta, TY& y) noexcept {
+    y = (beta == T(0)) ? static_cast<TY>(alpha * sum)
+                       : static_cast<TY>((alpha * sum) + (beta * static_cast<T>(y)));
+}
+
+/** @brief Dot product of n elements of a strided row and a strided x. */
+template <typename T, typename TA, typename TX>
+[[nodiscard]] inline T _gemv_dot(
+    size_t n, const TA* row, size_t csa, const TX* x, size_t incx) noexcept {
+    T sum = T(0);
+    if (csa == 1 && incx == 1) {
+        #pragma omp simd reduction(+ : sum)
+        for (size_t j = 0; j < n; ++j) {
+            sum += static_cast<T>(row[j]) * static_cast<T>(x[j]);
+        }
+    } else {
+        for (size_t j = 0; j < n; ++j) {
+            sum += static_cast<T>(row[j * csa]) * static_cast<T>(x[j * incx]);
+        }
+    }
+    return sum;
+}
+
+/**
+ * @brief GEMV kernel for A with contiguous (or general) rows: one SIMD
+ * reduction per block of GEMV_ROWS rows, row blocks in parallel.
+ */
+template <typename T, typename TA, typename TX, typename TY>
+void _gemv_rows(size_t m,
+                size_t n,
+                T alpha,
+                const TA* a,
+                size_t rsa,
+                size_t csa,
+                const TX* x,
+                size_t incx,
+                T beta,
+                TY* y,
+                size_t incy) {
+    const size_t blocks = (m + GEMV_ROWS - 1) / GEMV_ROWS;
+
+    #pragma omp parallel for schedule(static) if (m * n > OMP_LINEAR_LIMIT)
+    for (size_t block = 0; block < blocks; ++block) {
+        const size_t i = block * GEMV_ROWS;
+        if (i + GEMV_ROWS > m || csa != 1 || incx != 1) {
+            for (size_t r = i; r < std::min(i + GEMV_ROWS, m); ++r) {
+                const T sum = _gemv_dot<T>(n, a + (r * rsa), csa, x, incx);
+                _gemv_store(alpha, sum, beta, y[r * incy]);
+            }
+            continue;
+        }
+
+        const TA* a0 = a + (i * rsa);
+        const TA* a1 = a0 + rsa;
+        const TA* a2 = a1 + rsa;
+        const TA* a3 = a2 + rsa;
+        T s0 = T(0);
+        T s1 = T(0);
+        T s2 = T(0);
+        T s3 = T(0);
+        #pragma omp simd reduction(+ : s0, s1, s2, s3)
+        for (size_t j = 0; j < n; ++j) {
+            const T x_j = static_cast<T>(x[j]);
+            s0 += static_cast<T>(a0[j]) * x_j;
+            s1 += static_cast<T>(a1[j]) * x_j;
+            s2 += static_cast<T>(a2[j]) * x_j;
+            s3 += static_cast<T>(a3[j]) * x_j;
+        }
+        _gemv_store(alpha, s0, beta, y[i * incy]);
+        _gemv_store(alpha, s1, beta, y[(i + 1) * incy]);
+        _gemv_store(alpha, s2, beta, y[(i + 2) * incy]);
+        _gemv_store(alpha, s3, beta, y[(i + 3) * incy]);
+    }
+}
+
+/**
+ * @brief GEMV kernel for A with contiguous columns: panels of GEMV_PANEL
+ * outputs in parallel, each accumulating GEMV_COLUMNS columns per sweep.
+ */
+template <typename T, typename TA, typename TX, typename TY>
+void _gemv_columns(size_t m,
+                   size_t n,
+                   T alpha,
+                   const TA* a,
+                   size_t csa,
+                   const TX* x,
+                   size_t incx,
+                   T beta,
+                   TY* y,
+                   size_t incy) {
+    const size_t panels = (m + GEMV_PANEL - 1) / GEMV_PANEL;
+
+    #pragma omp parallel for schedule(static) if (m * n > OMP_LINEAR_LIMIT)
+    for (size_t panel = 0; panel < panels; ++panel) {
+        const size_t i0 = panel * GEMV_PANEL;
+        const size_t rows = std::min(GEMV_PANEL, m - i0);
+        alignas(STORAGE_ALIGNMENT) T acc[GEMV_PANEL] = {};
+
+        size_t j = 0;
+        for (; j + GEMV_COLUMNS <= n; j += GEMV_COLUMNS) {
+            const TA* c0 = a + i0 + (j * csa);
+            const TA* c1 = c0 + csa;
+            const TA* c2 = c1 + csa;
+            const TA* c3 = c2 + csa;
+            const T x0 = static_cast<T>(x[j * incx]);
+            const T x1 = static_cast<T>(x[(j + 1) * incx]);
+            const T x2 = static_cast<T>(x[(j + 2) * incx]);
+            const T x3 = static_cast<T>(x[(j + 3) * incx]);
+            #pragma omp simd
+            for (size_t i = 0; i < rows; ++i) {
+                acc[i] += (static_cast<T>(c0[i]) * x0) + (static_cast<T>(c1[i]) * x1) +
+                          (static_cast<T>(c2[i]) * x2) + (static_cast<T>(c3[i]) * x3);
+            }
+        }
+        for (; j < n; ++j) {
+            const TA* column = a + i0 + (j * csa);
+            const T x_j = static_cast<T>(x[j * incx]);
+            #pragma omp simd
+            for (size_t i = 0; i < rows; ++i) {
+                acc[i] += static_cast<T>(column[i]) * x_j;
+            }
+        }
+
+        for (size_t i = 0; i < rows; ++i) {
+            _gemv_store(alpha, acc[i], beta, y[(i0 + i) * incy]);
+        }
+    }
+}
+
+/**
+ * @brief General matrix-vector multiply y = alpha * A * x + beta * y.
+ *
+ * A is m x n and addressed through a row and a column stride, so the
+ * transposed product x^T * A of a row-major matrix is (ptr, 1, ld).
+ *
+ * @tparam T Compute type of the products and sums.
+ * @param m Rows of A and elements of y.
+ * @param n Columns of A and elements of x.
+ * @param alpha Scalar multiplying A * x.
+ * @param a Pointer to A(0, 0).
+ * @param rsa Distance between consecutive rows of A.
+ * @param csa Distance between consecutive columns of A.
+ * @param x Pointer to x(0).
+ * @param incx Distance between consecutive elements of x.
+ * @param beta Scalar multiplying y. When zero, y is write-only.
+ * @param y Pointer to y(0). Must not alias A or x.
+ * @param incy Distance between consecutive elements of y.
+ */
+template <typename T, typename TA, typename TX, typename TY>
+void _gemv(size_t m,
+           size_t n,
+           T alpha,
+           const TA* a,
+           size_t rsa,
+           size_t csa,
+           const TX* x,
+           size_t incx,
+           T beta,
+           TY* y,
+           size_t incy) {
+    if (m == 0) {
+        return;
+    }
+    if (n == 0) {
+        for (size_t i = 0; i < m; ++i) {
+            _gemv_store(alpha, T(0), beta, y[i * incy]);
+        }
+        return;
+    }
+
+    if (rsa == 1 && csa != 1) {
+        _gemv_columns(m, n, alpha, a, csa, x, incx, beta, y, incy);
+    } else {
+        _gemv_rows(m, n, alpha, a, rsa, csa, x, incx, beta, y, incy);
+    }
+}
+
+}  // namespace detail
+}  // namespace maf::math
+
+#endif
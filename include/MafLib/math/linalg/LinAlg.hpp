@@ -21,13 +21,37 @@ class Vector;
 template <Numeric T>
 class Matrix;
 
+template <Numeric T>
+class MatrixView;
+
+template <Numeric T>
+class ConstMatrixView;
+
 /** @brief Specifies if the vector behaves as a row or column vector. */
 enum Orientation : uint8 { ROW, COLUMN };
 
+/**
+ * @brief Specifies if matrix rows are padded to whole cache lines (and away
+ * from multiples of 4 KiB, which cause cache set aliasing).
+ */
+enum Padding : uint8 { UNPADDED, PADDED };
+
 // Functions
 
 }  // namespace maf::math
 
+#include "AlignedBuffer.hpp"
+#include "Expressions.hpp"
+#include "MatrixView.hpp"
 #include "Matrix.hpp"
 #include "Vector.hpp"
+#include "SVector.hpp"
+#include "SMatrix.hpp"
+#include "SparseMatrix.hpp"
+#include "SparseCholesky.hpp"
+#include "BandedMatrix.hpp"
+#include "TriangularMatrix.hpp"
+#include "SymmetricMatrix.hpp"
+#include "Factorization.hpp"
+#include "PCA.hpp"
 #endif
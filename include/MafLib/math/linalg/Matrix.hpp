@@ -2,6 +2,9 @@
 #define MATRIX_H
 #pragma once
 
+#include "Gemm.hpp"
+#include "Gemv.hpp"
+#include "Transpose.hpp"
 #include "LinAlg.hpp"
 
 namespace maf::math {
@@ -36,16 +39,52 @@ public:
     /**
      * @brief Default constructor. Creates an empty 0x0 matrix.
      */
-    Matrix() : _rows(0), _cols(0) {}
+    Matrix() : _rows(0), _cols(0), _stride(0) {}
 
     /**
-     * @brief Constructs an uninitialized matrix of size rows x cols.
+     * @brief Constructs a zero-filled matrix of size rows x cols.
      * @param rows Number of rows.
      * @param cols Number of columns.
      * @throws std::invalid_argument if dimensions are zero.
      */
     Matrix(size_t rows, size_t cols);
 
+    /**
+     * @brief Constructs a zero-filled matrix with a chosen row padding and
+     * memory resource.
+     * @param rows Number of rows.
+     * @param cols Number of columns.
+     * @param padding PADDED rounds every row up to whole cache lines, see
+     * leading_dimension().
+     * @param resource Memory resource for the storage, or nullptr for
+     * std::pmr::get_default_resource().
+     * @throws std::invalid_argument if dimensions are zero.
+     */
+    Matrix(size_t rows,
+           size_t cols,
+           Padding padding,
+           std::pmr::memory_resource* resource = nullptr);
+
+    /**
+     * @brief Constructs a matrix of size rows x cols without initialising its
+     * elements.
+     * @details Use this for results that are overwritten right away, so that
+     * the memory is written once instead of twice. Padding elements are still
+     * zeroed.
+     * @param rows Number of rows.
+     * @param cols Number of columns.
+     * @param padding PADDED rounds every row up to whole cache lines, see
+     * leading_dimension().
+     * @param resource Memory resource for the storage, or nullptr for
+     * std::pmr::get_default_resource().
+     * @throws std::invalid_argument if dimensions are zero.
+     */
+    Matrix(size_t rows,
+           size_t cols,
+           default_init_t /*unused*/,
+           Padding padding = UNPADDED,
+           std::pmr::memory_resource* resource = nullptr);
+
     /**
      * @brief Constructs a matrix from a raw data pointer.
      * @param rows Number of rows.
@@ -103,23 +142,32 @@ public:
     template <Numeric U>
     Matrix(size_t rows, size_t cols, std::initializer_list<U> list);
 
+    /**
+     * @brief Constructs by evaluating a lazy element-wise expression.
+     * @details The whole expression tree is computed in one fused, parallel
+     * and vectorized loop. Elements are converted to T.
+     * @param expr The expression to evaluate (see Expressions.hpp).
+     */
+    template <MatrixExpression E>
+    Matrix(const E& expr);
+
     // --- Getters and setters ---
 
     /**
-     * @brief Gets a mutable reference to the underlying std::vector
-     * data store.
-     * @return std::vector<T>&
+     * @brief Gets a mutable reference to the underlying aligned storage.
+     * @details Row i starts at element i * leading_dimension(). Elements
+     * past column_count() in a padded row are unspecified.
+     * @return AlignedBuffer<T>&
      */
-    [[nodiscard]] std::vector<T>& data() noexcept {
+    [[nodiscard]] AlignedBuffer<T>& data() noexcept {
         return _data;
     }
 
     /**
-     * @brief Gets a const reference to the underlying std::vector data
-     * store.
-     * @return const std::vector<T>&
+     * @brief Gets a const reference to the underlying aligned storage.
+     * @return const AlignedBuffer<T>&
      */
-    [[nodiscard]] const std::vector<T>& data() const noexcept {
+    [[nodiscard]] const AlignedBuffer<T>& data() const noexcept {
         return _data;
     }
 
@@ -135,7 +183,15 @@ public:
 
     /** @brief Gets the total number of elements (rows * cols). */
     [[nodiscard]] size_t size() const noexcept {
-        return _data.size();
+        return _rows * _cols;
+    }
+
+    /**
+     * @brief Gets the distance in elements between consecutive rows.
+     * @details Equal to column_count() unless the matrix was created PADDED.
+     */
+    [[nodiscard]] size_t leading_dimension() const noexcept {
+        return _stride;
     }
 
     /**
@@ -154,6 +210,20 @@ public:
         return _data.at(_get_index(row, col));
     }
 
+    /**
+     * @brief Accesses the element at (row, col) with no bounds check.
+     */
+    T& operator()(size_t row, size_t col) noexcept {
+        return _data[(row * _stride) + col];
+    }
+
+    /**
+     * @brief Accesses the element at (row, col) with no bounds check.
+     */
+    const T& operator()(size_t row, size_t col) const noexcept {
+        return _data[(row * _stride) + col];
+    }
+
     /**
      * @brief Gets a mutable std::span of a single row.
      * @throws std::out_of_range if the row is invalid.
@@ -170,6 +240,86 @@ public:
         return std::span<const T>(&_data.at(_get_index(row, 0)), _cols);
     }
 
+    // --- Views ---
+
+    /** @brief Gets a mutable view of the whole matrix (see MatrixView.hpp). */
+    [[nodiscard]] MatrixView<T> view() noexcept {
+        return MatrixView<T>(*this);
+    }
+
+    /** @brief Gets a read-only view of the whole matrix. */
+    [[nodiscard]] ConstMatrixView<T> view() const noexcept {
+        return ConstMatrixView<T>(*this);
+    }
+
+    /**
+     * @brief Gets a mutable, zero-copy view of the rows x cols block whose
+     * top-left corner is (row, col).
+     * @throws std::out_of_range if the block does not fit.
+     */
+    [[nodiscard]] MatrixView<T> block(size_t row,
+                                      size_t col,
+                                      size_t rows,
+                                      size_t cols) {
+        return view().block(row, col, rows, cols);
+    }
+
+    /**
+     * @brief Gets a read-only, zero-copy view of a block.
+     * @throws std::out_of_range if the block does not fit.
+     */
+    [[nodiscard]] ConstMatrixView<T> block(size_t row,
+                                           size_t col,
+                                           size_t rows,
+                                           size_t cols) const {
+        return view().block(row, col, rows, cols);
+    }
+
+    /**
+     * @brief Gets a mutable 1 x cols view of a single row.
+     * @throws std::out_of_range if the row is invalid.
+     */
+    [[nodiscard]] MatrixView<T> row(size_t row) {
+        return view().row(row);
+    }
+
+    /**
+     * @brief Gets a read-only 1 x cols view of a single row.
+     * @throws std::out_of_range if the row is invalid.
+     */
+    [[nodiscard]] ConstMatrixView<T> row(size_t row) const {
+        return view().row(row);
+    }
+
+    /**
+     * @brief Gets a mutable rows x 1 view of a single column.
+     * @throws std::out_of_range if the column is invalid.
+     */
+    [[nodiscard]] MatrixView<T> col(size_t col) {
+        return view().col(col);
+    }
+
+    /**
+     * @brief Gets a read-only rows x 1 view of a single column.
+     * @throws std::out_of_range if the column is invalid.
+     */
+    [[nodiscard]] ConstMatrixView<T> col(size_t col) const {
+        return view().col(col);
+    }
+
+    /**
+     * @brief Gets a mutable view of the transpose without copying.
+     * @details Use `transposed()` for an owning copy.
+     */
+    [[nodiscard]] MatrixView<T> t() noexcept {
+        return view().t();
+    }
+
+    /** @brief Gets a read-only view of the transpose without copying. */
+    [[nodiscard]] ConstMatrixView<T> t() const noexcept {
+        return view().t();
+    }
+
     // --- Checkers ---
 
     /** @brief Checks if the matrix is square (rows == cols). */
@@ -222,16 +372,21 @@ public:
 
     /**
      * @brief Performs an in-place transpose of the matrix.
-     * @details Uses a parallelized, blocked algorithm.
-     * @throws std::invalid_argument if the matrix is not square.
+     * @details Square matrices swap blocks across the diagonal in parallel.
+     * Rectangular matrices are permuted inside their own storage by cycle
+     * following, using one bit of scratch per element, so transposing e.g. a
+     * 1e6 x 64 data matrix does not double the peak memory. PADDED
+     * rectangular matrices are the exception: their transpose needs a
+     * differently sized buffer and is computed out of place.
      */
     void transpose();
 
     /**
      * @brief Creates and returns a new matrix that is the transpose of
      * this one.
-     * @return A new Matrix<T> of size (cols x rows).
-     * @details Defined in MatrixMethods.hpp
+     * @return A new Matrix<T> of size (cols x rows), padded if this one is.
+     * @details Uses the parallel cache-oblivious kernel of Transpose.hpp.
+     * Defined in MatrixMethods.hpp
      */
     [[nodiscard]] Matrix<T> transposed() const;
 
@@ -244,36 +399,24 @@ public:
     [[nodiscard]] constexpr bool operator==(const Matrix& other) const noexcept;
 
     /**
-     * @brief Unary minus. Returns a new matrix with all elements negated.
-     * @return `Matrix<T>`
+     * @brief Assigns a lazy element-wise expression.
+     * @details The expression is evaluated in one fused loop directly into
+     * this matrix's storage when the shapes match.
      */
-    [[nodiscard]] auto operator-() const noexcept;
+    template <MatrixExpression E>
+    Matrix<T>& operator=(const E& expr);
 
-    /**
-     * @brief Element-wise matrix addition.
-     * @tparam U Numeric type of the other matrix.
-     * @return Matrix of the common, promoted type.
-     * @throws std::invalid_argument if dimensions do not match.
-     */
-    template <Numeric U>
-    [[nodiscard]] auto operator+(const Matrix<U>& other) const;
-
-    /**
-     * @brief Element-wise scalar addition (Matrix + scalar).
-     * @tparam U An arithmetic scalar type.
-     * @return Matrix of the common, promoted type.
-     */
-    template <Numeric U>
-    [[nodiscard]] auto operator+(const U& scalar) const noexcept;
+    // Element-wise +, -, scalar * and / and unary minus are lazy free
+    // operators, see MatrixOperators.hpp and Expressions.hpp.
 
     /**
      * @brief Element-wise matrix addition.
-     * @tparam U Numeric type of the other matrix.
+     * @tparam E A Matrix or lazy expression, evaluated in one fused loop.
      * @attention This method doesn't cast the matrix is U is broader type
      * @throws std::invalid_argument if dimensions do not match.
      */
-    template <Numeric U>
-    Matrix<T>& operator+=(const Matrix<U>& other);
+    template <MatrixOperand E>
+    Matrix<T>& operator+=(const E& other);
 
     /**
      * @brief Element-wise scalar addition (Matrix + scalar).
@@ -286,29 +429,12 @@ public:
 
     /**
      * @brief Element-wise matrix subtraction.
-     * @tparam U Numeric type of the other matrix.
-     * @return Matrix of the common, promoted type.
-     * @throws std::invalid_argument if dimensions do not match.
-     */
-    template <Numeric U>
-    [[nodiscard]] auto operator-(const Matrix<U>& other) const;
-
-    /**
-     * @brief Element-wise scalar subtraction (Matrix - scalar).
-     * @tparam U An arithmetic scalar type.
-     * @return Matrix of the common, promoted type.
-     */
-    template <Numeric U>
-    [[nodiscard]] auto operator-(const U& scalar) const noexcept;
-
-    /**
-     * @brief Element-wise matrix subtraction.
-     * @tparam U Numeric type of the other matrix.
+     * @tparam E A Matrix or lazy expression, evaluated in one fused loop.
      * @attention This method doesn't cast the matrix is U is broader type
      * @throws std::invalid_argument if dimensions do not match.
      */
-    template <Numeric U>
-    Matrix<T>& operator-=(const Matrix<U>& other);
+    template <MatrixOperand E>
+    Matrix<T>& operator-=(const E& other);
 
     /**
      * @brief Element-wise scalar subtraction (Matrix - scalar).
@@ -321,7 +447,11 @@ public:
 
     /**
      * @brief Standard algebraic matrix multiplication (A * B).
-     * @details Implemented with a parallelized, cache-blocked algorithm.
+     * @details Uses BLAS (Accelerate) where available for float * float and
+     * double * double. Every other floating point product, including mixed
+     * types such as float * double or int * double, runs on the packed GEMM
+     * engine from Gemm.hpp, which converts the operands while packing them.
+     * Integer products use a parallelized, cache-blocked algorithm.
      * @tparam U Numeric type of the other matrix.
      * @return Matrix of the common, promoted type.
      * @throws std::invalid_argument if inner dimensions do not match
@@ -338,147 +468,76 @@ public:
         const size_t a_rows = _rows;
         const size_t b_cols = other.column_count();
         const size_t a_cols = _cols;
-        Matrix<R> result(a_rows, b_cols);
+        const size_t lda = _stride;
+        const size_t ldb = other.leading_dimension();
+        // Every path below overwrites the result, so it is not zeroed here
+        Matrix<R> result(a_rows, b_cols, default_init);
 
         const T* a_data = this->_data.data();
         const U* b_data = other.data().data();
         R* c_data = result.data().data();
 
-        result.fill(R(0));
-
+        if constexpr (!std::is_floating_point_v<R>) {
+            // Integer types - use fallback
+            result.fill(R(0));
+            _fallback_matrix_multiply(
+                a_data, b_data, c_data, a_rows, a_cols, b_cols, lda, ldb);
 #if defined(__APPLE__) && defined(ACCELERATE_AVAILABLE)
-        // Handle all floating-point combinations with proper conversion
-        if constexpr (std::is_floating_point_v<R>) {
-            if constexpr (std::is_same_v<R, float>) {
-                // Both matrices are float or can be safely converted to float
-                std::vector<float> a_converted, b_converted;
-                const float* a_ptr = a_data;
-                const float* b_ptr = b_data;
-
-                // Convert matrix A if needed
-                if constexpr (!std::is_same_v<T, float>) {
-                    a_converted.resize(_data.size());
-                    std::transform(
-                        _data.begin(), _data.end(), a_converted.begin(), [](T val) {
-                            return static_cast<float>(val);
-                        });
-                    a_ptr = a_converted.data();
-                } else {
-                    a_ptr = a_data;
-                }
-
-                // Convert matrix B if needed
-                if constexpr (!std::is_same_v<U, float>) {
-                    b_converted.resize(other.data().size());
-                    std::transform(other.data().begin(),
-                                   other.data().end(),
-                                   b_converted.begin(),
-                                   [](U val) { return static_cast<float>(val); });
-                    b_ptr = b_converted.data();
-                } else {
-                    b_ptr = b_data;
-                }
-
-                cblas_sgemm(CblasRowMajor,
-                            CblasNoTrans,
-                            CblasNoTrans,
-                            a_rows,
-                            b_cols,
-                            a_cols,
-                            1.0F,
-                            a_ptr,
-                            a_cols,
-                            b_ptr,
-                            b_cols,
-                            0.0F,
-                            c_data,
-                            b_cols);
-            } else if constexpr (std::is_same_v<R, double>) {
-                // Both matrices are double or can be safely converted to double
-                std::vector<double> a_converted, b_converted;
-                const double* a_ptr;
-                const double* b_ptr;
-
-                // Convert matrix A if needed
-                if constexpr (!std::is_same_v<T, double>) {
-                    a_converted.resize(_data.size());
-                    std::transform(
-                        _data.begin(), _data.end(), a_converted.begin(), [](T val) {
-                            return static_cast<double>(val);
-                        });
-                    a_ptr = a_converted.data();
-                } else {
-                    a_ptr = a_data;
-                }
-
-                // Convert matrix B if needed
-                if constexpr (!std::is_same_v<U, double>) {
-                    b_converted.resize(other.data().size());
-                    std::transform(other.data().begin(),
-                                   other.data().end(),
-                                   b_converted.begin(),
-                                   [](U val) { return static_cast<double>(val); });
-                    b_ptr = b_converted.data();
-                } else {
-                    b_ptr = b_data;
-                }
-
-                cblas_dgemm(CblasRowMajor,
-                            CblasNoTrans,
-                            CblasNoTrans,
-                            a_rows,
-                            b_cols,
-                            a_cols,
-                            1.0,
-                            a_ptr,
-                            a_cols,
-                            b_ptr,
-                            b_cols,
-                            0.0,
-                            c_data,
-                            b_cols);
-            }
+        } else if constexpr (std::is_same_v<T, float> && std::is_same_v<U, float>) {
+            cblas_sgemm(CblasRowMajor,
+                        CblasNoTrans,
+                        CblasNoTrans,
+                        a_rows,
+                        b_cols,
+                        a_cols,
+                        1.0F,
+                        a_data,
+                        lda,
+                        b_data,
+                        ldb,
+                        0.0F,
+                        c_data,
+                        b_cols);
+        } else if constexpr (std::is_same_v<T, double> && std::is_same_v<U, double>) {
+            cblas_dgemm(CblasRowMajor,
+                        CblasNoTrans,
+                        CblasNoTrans,
+                        a_rows,
+                        b_cols,
+                        a_cols,
+                        1.0,
+                        a_data,
+                        lda,
+                        b_data,
+                        ldb,
+                        0.0,
+                        c_data,
+                        b_cols);
+#endif
         } else {
-            // Integer types - use fallback
-            _fallback_matrix_multiply(a_data, b_data, c_data, a_rows, a_cols, b_cols);
+            // Mixed operand types are converted to R while they are packed
+            detail::_gemm(a_rows,
+                          b_cols,
+                          a_cols,
+                          R(1),
+                          a_data,
+                          lda,
+                          1,
+                          b_data,
+                          ldb,
+                          1,
+                          R(0),
+                          c_data,
+                          b_cols,
+                          1);
         }
-#else
-        // Default non-Apple implementation
-        _fallback_matrix_multiply(a_data, b_data, c_data, a_rows, a_cols, b_cols);
-#endif
         return result;
     }
 
-    /**
-     * @brief Element-wise scalar multiplication (Matrix * scalar).
-     * @tparam U An arithmetic scalar type.
-     * @return Matrix of the common, promoted type.
-     */
-    template <Numeric U>
-    [[nodiscard]] auto operator*(const U& scalar) const {
-        using R = std::common_type_t<T, U>;
-
-        Matrix<R> result(_rows, _cols);
-
-        std::transform(_data.begin(),
-                       _data.end(),
-                       result.data().begin(),
-                       [scalar](const T& value) {
-                           return static_cast<R>(value) * static_cast<R>(scalar);
-                       });
-        return result;
-    }
-
-    /**
-     * @brief Element-wise scalar multiplication (scalar * Matrix).
-     */
-    template <Numeric U>
-    [[nodiscard]] friend auto operator*(const U& scalar, const Matrix<T>& matrix) {
-        return matrix * scalar;
-    }
-
     /**
      * @brief Matrix-Vector multiplication (Matrix * column_vector).
+     * @details Runs the blocked, parallel GEMV kernel from Gemv.hpp.
+     * @see gemv() for the in-place y = alpha * A * x + beta * y.
      * @tparam U Numeric type of the vector.
      * @return A new column Vector of the common, promoted type.
      * @throws std::invalid_argument if vector is not a column vector or
@@ -502,50 +561,18 @@ public:
                 "Dimension mismatch in Matrix * Vector multiplication.");
         }
 
-        Vector<R> result(n, std::vector<R>(n, R(0)), COLUMN);
-
-        #pragma omp parallel for
-        for (size_t i = 0; i < n; ++i) {
-            R sum = R(0);
-            auto L_row_i = this->row_span(i);
-            #pragma omp simd reduction(+ : sum)
-            for (size_t j = 0; j < m; ++j) {
-                sum += static_cast<R>(L_row_i[j]) * static_cast<R>(other.at(j));
-            }
-            result.at(i) = sum;
-        }
-        return result;
-    }
-
-    /**
-     * @brief Element-wise scalar division (Matrix / scalar).
-     * @tparam U An arithmetic scalar type.
-     * @return Matrix of the common, promoted type.
-     */
-    template <Numeric U>
-    [[nodiscard]] auto operator/(const U& scalar) const {
-        // Note: This promotes T to double if T is int, which is
-        // usually desired for division.
-        using R = std::common_type_t<T, U, double>;
-        return *this * (R(1) / static_cast<R>(scalar));
-    }
-
-    /**
-     * @brief Element-wise scalar division (scalar / Matrix).
-     * @tparam U An arithmetic scalar type.
-     * @return Matrix of the common, promoted type.
-     */
-    template <Numeric U>
-    [[nodiscard]] friend auto operator/(const U& scalar, const Matrix<T>& matrix) {
-        using R = std::common_type_t<T, U, double>;
-
-        Matrix<R> result(matrix._rows, matrix._cols);
-        std::transform(matrix._data.begin(),
-                       matrix._data.end(),
-                       result.data().begin(),
-                       [scalar](const T& value) {
-                           return static_cast<R>(scalar) / static_cast<R>(value);
-                       });
+        Vector<R> result(n, default_init, COLUMN);
+        detail::_gemv(n,
+                      m,
+                      R(1),
+                      _data.data(),
+                      _stride,
+                      1,
+                      other.data().data(),
+                      1,
+                      R(0),
+                      result.data().data(),
+                      1);
         return result;
     }
 
@@ -570,7 +597,8 @@ public:
 private:
     size_t _rows;
     size_t _cols;
-    std::vector<T> _data;
+    size_t _stride;
+    AlignedBuffer<T> _data;
 
     /**
      * @brief Internal check if a row/column index is within bounds.
@@ -589,33 +617,20 @@ private:
         if (!_is_valid_index(row, col)) {
             throw std::out_of_range("Index out of bounds.");
         }
-        return (row * _cols) + col;
+        return (row * _stride) + col;
     }
 
-    /**
-     * @brief Internal helper to invert the sign of all elements in-place.
-     */
-    void _invert_sign() {
-        if (_data.size() > OMP_LINEAR_LIMIT) {
-            #pragma omp parallel for
-            for (size_t i = 0; i < _data.size(); ++i) {
-                _data[i] = -_data[i];
-            }
-        } else {
-            for (size_t i = 0; i < _data.size(); ++i) {
-                _data[i] = -_data[i];
-            }
-        }
-    }
-
-    // Fallback matrix multiplication implementation
+    // Fallback matrix multiplication implementation, C must be zeroed and
+    // unpadded; lda and ldb are the leading dimensions of A and B
     template <typename A, typename B, typename C>
     void _fallback_matrix_multiply(const A* a_data,
                                    const B* b_data,
                                    C* c_data,
                                    size_t a_rows,
                                    size_t a_cols,
-                                   size_t b_cols) const {
+                                   size_t b_cols,
+                                   size_t lda,
+                                   size_t ldb) const {
         #pragma omp parallel for collapse(2) if (a_rows * b_cols > 10000)
         for (size_t ii = 0; ii < a_rows; ii += BLOCK_SIZE) {
             for (size_t jj = 0; jj < b_cols; jj += BLOCK_SIZE) {
@@ -627,8 +642,8 @@ private:
 
                     for (size_t i = ii; i < i_end; ++i) {
                         for (size_t k = kk; k < k_end; ++k) {
-                            const C a_ik = static_cast<C>(a_data[(i * a_cols) + k]);
-                            const size_t b_offset = k * b_cols;
+                            const C a_ik = static_cast<C>(a_data[(i * lda) + k]);
+                            const size_t b_offset = k * ldb;
                             const size_t c_offset = i * b_cols;
 
                             #pragma omp simd
@@ -644,14 +659,22 @@ private:
     }
 };
 
+template <MatrixExpression E>
+Matrix(const E&) -> Matrix<typename E::value_type>;
+
 }  // namespace maf::math
 
+#include "BatchedGemm.hpp"
 #include "Cholesky.hpp"
+#include "Eigen.hpp"
 #include "MatrixCheckers.hpp"
 #include "MatrixConstructors.hpp"
 #include "MatrixFactories.hpp"
 #include "MatrixMethods.hpp"
 #include "MatrixOperators.hpp"
 #include "PLU.hpp"
+#include "QR.hpp"
+#include "SVD.hpp"
+#include "Strassen.hpp"
 
 #endif
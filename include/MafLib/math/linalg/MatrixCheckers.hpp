@@ -19,15 +19,23 @@ template <Numeric T>
 }
 
 // Checks if matrix is symmetric.
+// Compares BLOCK_SIZE x BLOCK_SIZE tiles with their mirror tiles, so that the
+// column-wise reads of the mirror stay in cache.
 template <Numeric T>
 [[nodiscard]] constexpr bool Matrix<T>::is_symmetric() const {
     if (!is_square()) {
         return false;
     }
-    for (size_t i = 0; i < _rows; ++i) {
-        for (size_t j = i + 1; j < _cols; ++j) {
-            if (!is_close(at(i, j), at(j, i))) {
-                return false;
+    for (size_t ii = 0; ii < _rows; ii += BLOCK_SIZE) {
+        const size_t i_end = std::min(ii + BLOCK_SIZE, _rows);
+        for (size_t jj = ii; jj < _cols; jj += BLOCK_SIZE) {
+            const size_t j_end = std::min(jj + BLOCK_SIZE, _cols);
+            for (size_t i = ii; i < i_end; ++i) {
+                for (size_t j = std::max(jj, i + 1); j < j_end; ++j) {
+                    if (!is_close((*this)(i, j), (*this)(j, i))) {
+                        return false;
+                    }
+                }
             }
         }
     }
@@ -89,7 +97,9 @@ template <Numeric T>
         return true;
     }
     try {
-        plu(*this);
+        using TargetType = std::conditional_t<std::is_floating_point_v<T>, T, double>;
+        Matrix<TargetType> lu = this->template cast<TargetType>();
+        getrf(lu);
         return false;
     } catch (const std::runtime_error& e) {
         return true;
@@ -108,14 +118,14 @@ template <Numeric T>
 
 /**
  * @brief Checks if two matrices are element-wise equal within a tolerance.
- * @tparam T Numeric type of the first matrix.
- * @tparam U Numeric type of the second matrix.
+ * @tparam L A Matrix or lazy matrix expression.
+ * @tparam R A Matrix or lazy matrix expression.
  * @param eps The absolute tolerance for equality.
  * @return true if dimensions match and all elements are "close".
  */
-template <Numeric T, Numeric U>
-[[nodiscard]] constexpr bool loosely_equal(const Matrix<T>& first,
-                                           const Matrix<U>& second,
+template <MatrixOperand L, MatrixOperand R>
+[[nodiscard]] constexpr bool loosely_equal(const L& first,
+                                           const R& second,
                                            double eps = 1e-6) {
     size_t n = first.row_count();
     size_t m = first.column_count();
@@ -11,19 +11,55 @@
  * should not be included directly anywhere else.
  */
 namespace maf::math {
-// Constructs an uninitialized matrix of size rows x cols.
+// Constructs a zero-filled matrix of size rows x cols.
 template <Numeric T>
-Matrix<T>::Matrix(size_t rows, size_t cols) : _rows(rows), _cols(cols) {
+Matrix<T>::Matrix(size_t rows, size_t cols) : Matrix(rows, cols, UNPADDED) {}
+
+// Constructs a zero-filled matrix with the given padding and memory resource.
+template <Numeric T>
+Matrix<T>::Matrix(size_t rows,
+                  size_t cols,
+                  Padding padding,
+                  std::pmr::memory_resource* resource)
+    : _rows(rows),
+      _cols(cols),
+      _stride(padding == PADDED ? detail::_padded_leading_dimension<T>(cols) : cols),
+      _data(resource) {
+    if (rows == 0 || cols == 0) {
+        throw std::invalid_argument("Matrix dimensions must be greater than zero.");
+    }
+
+    _data.resize(rows * _stride);
+}
+
+// Constructs a matrix without initialising its elements.
+template <Numeric T>
+Matrix<T>::Matrix(size_t rows,
+                  size_t cols,
+                  default_init_t /*unused*/,
+                  Padding padding,
+                  std::pmr::memory_resource* resource)
+    : _rows(rows),
+      _cols(cols),
+      _stride(padding == PADDED ? detail::_padded_leading_dimension<T>(cols) : cols),
+      _data(resource) {
     if (rows == 0 || cols == 0) {
         throw std::invalid_argument("Matrix dimensions must be greater than zero.");
     }
 
-    _data.resize(rows * cols);
+    _data.resize(rows * _stride, default_init);
+    if (_stride != _cols) {
+        for (size_t i = 0; i < rows; ++i) {
+            T* row = _data.data() + (i * _stride);
+            std::fill(row + _cols, row + _stride, T(0));
+        }
+    }
 }
 
 // Constructs a matrix from a raw data pointer.
 template <Numeric T>
-Matrix<T>::Matrix(size_t rows, size_t cols, T* data) : _rows(rows), _cols(cols) {
+Matrix<T>::Matrix(size_t rows, size_t cols, T* data)
+    : _rows(rows), _cols(cols), _stride(cols) {
     if (rows == 0 || cols == 0) {
         throw std::invalid_argument("Matrix dimensions must be greater than zero!");
     }
@@ -37,7 +73,7 @@ Matrix<T>::Matrix(size_t rows, size_t cols, T* data) : _rows(rows), _cols(cols)
 // Constructs from a std::vector, filled by rows.
 template <Numeric T>
 Matrix<T>::Matrix(size_t rows, size_t cols, const std::vector<T>& data)
-    : _rows(rows), _cols(cols) {
+    : _rows(rows), _cols(cols), _stride(cols) {
     if (rows == 0 || cols == 0) {
         throw std::invalid_argument("Matrix dimensions must be greater than zero.");
     }
@@ -52,7 +88,7 @@ Matrix<T>::Matrix(size_t rows, size_t cols, const std::vector<T>& data)
 // Constructs from a nested std::vector (vector of vectors).
 template <Numeric T>
 Matrix<T>::Matrix(size_t rows, size_t cols, const std::vector<std::vector<T>>& data)
-    : _rows(rows), _cols(cols) {
+    : _rows(rows), _cols(cols), _stride(cols) {
     if (rows == 0 || cols == 0) {
         throw std::invalid_argument("Matrix dimensions must be greater than zero.");
     }
@@ -61,7 +97,7 @@ Matrix<T>::Matrix(size_t rows, size_t cols, const std::vector<std::vector<T>>& d
         throw std::invalid_argument("Data size does not match matrix size.");
     }
 
-    _data.resize(rows * cols);
+    _data.resize(rows * cols, default_init);
     for (size_t i = 0; i < rows; ++i) {
         for (size_t j = 0; j < cols; ++j) {
             _data.at(_get_index(i, j)) = static_cast<T>(data.at(i).at(j));
@@ -73,7 +109,7 @@ Matrix<T>::Matrix(size_t rows, size_t cols, const std::vector<std::vector<T>>& d
 template <Numeric T>
 template <size_t N>
 Matrix<T>::Matrix(size_t rows, size_t cols, const std::array<T, N>& data)
-    : _rows(rows), _cols(cols) {
+    : _rows(rows), _cols(cols), _stride(cols) {
     if (rows == 0 || cols == 0) {
         throw std::invalid_argument("Matrix dimensions must be greater than zero.");
     }
@@ -88,7 +124,7 @@ Matrix<T>::Matrix(size_t rows, size_t cols, const std::array<T, N>& data)
 template <Numeric T>
 template <Numeric U>
 Matrix<T>::Matrix(size_t rows, size_t cols, std::initializer_list<U> list)
-    : _rows(rows), _cols(cols) {
+    : _rows(rows), _cols(cols), _stride(cols) {
     if (rows == 0 || cols == 0) {
         throw std::invalid_argument("Matrix dimensions must be greater than zero.");
     }
@@ -98,6 +134,28 @@ Matrix<T>::Matrix(size_t rows, size_t cols, std::initializer_list<U> list)
     _data.assign(list.begin(), list.end());
 }
 
+// Evaluates a lazy element-wise expression.
+template <Numeric T>
+template <MatrixExpression E>
+Matrix<T>::Matrix(const E& expr)
+    : _rows(expr.row_count()),
+      _cols(expr.column_count()),
+      _stride(_cols),
+      _data(_rows * _cols, default_init) {
+    if constexpr (detail::is_matrix_view<E>::value) {
+        // A transposed (column-contiguous) view: copy it with the transpose
+        // kernel instead of striding through the source
+        if (expr.row_stride() == 1 && expr.col_stride() != 1) {
+            detail::_transpose(
+                _cols, _rows, expr.data(), expr.col_stride(), _data.data(), _cols);
+            return;
+        }
+    }
+    detail::_assign_matrix(_data.data(), _cols, 1, expr, [](T& dst, auto value) {
+        dst = static_cast<T>(value);
+    });
+}
+
 }  // namespace maf::math
 
 #endif
@@ -8,15 +8,8 @@ namespace maf::math {
 template <Numeric T>
 template <Numeric U>
 [[nodiscard]] Matrix<U> Matrix<T>::cast() const {
-    // Replace this with explicit constructor casting when implemented
-    Matrix<U> result(_rows, _cols);
-
-    const size_t n = _data.size();
-
-    for (size_t i = 0; i < n; ++i) {
-        result.data()[i] = static_cast<U>(_data[i]);
-    }
-    return result;
+    // Converts through the fused expression loop, which also drops padding
+    return Matrix<U>(ConstMatrixView<T>(*this));
 }
 
 // Inplace fill
@@ -51,10 +44,18 @@ void Matrix<T>::make_identity() {
 template <Numeric T>
 void Matrix<T>::transpose() {
     if (!is_square()) {
-        throw std::invalid_argument("Matrix must be square to transpose in-place.");
+        if (_stride != _cols) {
+            // The padded layout of the transpose does not fit the buffer
+            *this = transposed();
+            return;
+        }
+        detail::_transpose_in_place(_data.data(), _rows, _cols);
+        std::swap(_rows, _cols);
+        _stride = _cols;
+        return;
     }
 
-    #pragma omp parallel for
+    #pragma omp parallel for schedule(dynamic) if (_rows * _cols > OMP_LINEAR_LIMIT)
     for (size_t i = 0; i < _rows; i += BLOCK_SIZE) {
         for (size_t j = i; j < _cols; j += BLOCK_SIZE) {
             const size_t n = std::min(i + BLOCK_SIZE, _rows);
@@ -63,14 +64,14 @@ void Matrix<T>::transpose() {
                 // Diagonal block
                 for (size_t k = i; k < n; ++k) {
                     for (size_t l = k + 1; l < m; ++l) {
-                        std::swap(this->at(k, l), this->at(l, k));
+                        std::swap((*this)(k, l), (*this)(l, k));
                     }
                 }
             } else {
                 // Off-diagonal block
                 for (size_t k = i; k < n; ++k) {
                     for (size_t l = j; l < m; ++l) {
-                        std::swap(this->at(k, l), this->at(l, k));
+                        std::swap((*this)(k, l), (*this)(l, k));
                     }
                 }
             }
@@ -81,14 +82,13 @@ void Matrix<T>::transpose() {
 // Creates new transposed matrix
 template <Numeric T>
 Matrix<T> Matrix<T>::transposed() const {
-    Matrix<T> result(_cols, _rows);
-
-    #pragma omp parallel for if (_data.size() > 100 * 100)
-    for (size_t i = 0; i < _rows; ++i) {
-        for (size_t j = 0; j < _cols; ++j) {
-            result.at(j, i) = this->at(i, j);
-        }
-    }
+    Matrix<T> result(_cols,
+                     _rows,
+                     default_init,
+                     _stride != _cols ? PADDED : UNPADDED,
+                     _data.resource());
+    detail::_transpose(
+        _rows, _cols, _data.data(), _stride, result._data.data(), result._stride);
     return result;
 }
 
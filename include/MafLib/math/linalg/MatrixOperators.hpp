@@ -3,226 +3,532 @@
 #pragma once
 #include "Matrix.hpp"
 
+/**
+ * @file MatrixOperators.hpp
+ * @brief Contains the arithmetic operators of the Matrix<T> class.
+ *
+ * Element-wise operators are lazy: they accept any MatrixOperand (a Matrix,
+ * a view or an expression) and return expression nodes from Expressions.hpp
+ * which are evaluated in one fused loop on assignment.
+ *
+ * This file is intended to be included at the *end* of Matrix.hpp and
+ * should not be included directly anywhere else.
+ */
 namespace maf::math {
+namespace detail {
+/**
+ * @brief Builds an element-wise binary expression after checking that both
+ * operands have the same shape.
+ * @throws std::invalid_argument with the given message on shape mismatch.
+ */
+template <typename Fn, typename L, typename Rhs>
+[[nodiscard]] auto _make_matrix_binary(L&& lhs, Rhs&& rhs, const char* message) {
+    if (lhs.row_count() != rhs.row_count() ||
+        lhs.column_count() != rhs.column_count()) {
+        throw std::invalid_argument(message);
+    }
+    using R = std::common_type_t<typename std::remove_cvref_t<L>::value_type,
+                                 typename std::remove_cvref_t<Rhs>::value_type>;
+    return MatrixBinaryExpr<R, Fn, _operand_storage_t<L>, _operand_storage_t<Rhs>>(
+        std::forward<L>(lhs), std::forward<Rhs>(rhs));
+}
+
+/** @brief Builds an element-wise unary expression with result type R. */
+template <Numeric R, typename Fn, typename E>
+[[nodiscard]] auto _make_matrix_unary(E&& operand, Fn fn) noexcept {
+    return MatrixUnaryExpr<R, Fn, _operand_storage_t<E>>(std::forward<E>(operand), fn);
+}
+
+}  // namespace detail
+
 // Checks if elements are exactly equal
 template <Numeric T>
 [[nodiscard]] constexpr bool Matrix<T>::operator==(const Matrix& other) const noexcept {
     if (_rows != other._rows || _cols != other._cols) {
         return false;
     }
-    return _data == other._data;
+    if (_stride == _cols && other._stride == _cols) {
+        return _data == other._data;
+    }
+    for (size_t i = 0; i < _rows; ++i) {
+        const T* row = _data.data() + (i * _stride);
+        const T* other_row = other._data.data() + (i * other._stride);
+        if (!std::equal(row, row + _cols, other_row)) {
+            return false;
+        }
+    }
+    return true;
 }
 
-// Unary minus sign, creates a copy
-template <Numeric T>
-[[nodiscard]] auto Matrix<T>::operator-() const noexcept {
-    Matrix<T> result(*this);
-    result._invert_sign();
-    return result;
+/**
+ * @brief Checks for exact element-wise equality when at least one side is a
+ * lazy expression.
+ * @details For floating-point, use `loosely_equal()`.
+ */
+template <MatrixOperand L, MatrixOperand R>
+    requires(MatrixExpression<L> || MatrixExpression<R>)
+[[nodiscard]] bool operator==(const L& lhs, const R& rhs) {
+    if (lhs.row_count() != rhs.row_count() ||
+        lhs.column_count() != rhs.column_count()) {
+        return false;
+    }
+    for (size_t i = 0; i < lhs.row_count(); ++i) {
+        for (size_t j = 0; j < lhs.column_count(); ++j) {
+            if (lhs(i, j) != rhs(i, j)) {
+                return false;
+            }
+        }
+    }
+    return true;
 }
 
-// Add 2 matrices element-wise
-template <Numeric T>
-template <Numeric U>
-[[nodiscard]] auto Matrix<T>::operator+(const Matrix<U>& other) const {
-    if (_rows != other.row_count() || _cols != other.column_count()) {
-        throw std::invalid_argument(
-            "Matrices have to be of same dimensions for addition!");
-    }
-    using R = std::common_type_t<T, U>;
+/**
+ * @brief Unary minus. Lazily negates all elements.
+ * @return An expression of the operand's element type.
+ */
+template <typename E>
+    requires MatrixOperand<E>
+[[nodiscard]] auto operator-(E&& matrix) noexcept {
+    using R = typename std::remove_cvref_t<E>::value_type;
+    return detail::_make_matrix_unary<R>(std::forward<E>(matrix), detail::_negate{});
+}
 
-    Matrix<R> result(_rows, _cols);
+/**
+ * @brief Element-wise matrix addition.
+ * @return An expression of the common, promoted type.
+ * @throws std::invalid_argument if dimensions do not match.
+ */
+template <typename L, typename R>
+    requires MatrixOperand<L> && MatrixOperand<R>
+[[nodiscard]] auto operator+(L&& lhs, R&& rhs) {
+    return detail::_make_matrix_binary<detail::_add>(
+        std::forward<L>(lhs),
+        std::forward<R>(rhs),
+        "Matrices have to be of same dimensions for addition!");
+}
 
-    if (_data.size() > OMP_LINEAR_LIMIT) {
-        #pragma omp parallel for
-        for (size_t i = 0; i < _data.size(); ++i) {
-            result.data()[i] =
-                static_cast<R>(_data[i]) + static_cast<R>(other.data()[i]);
-        }
-    } else {
-        #pragma omp simd
-        for (size_t i = 0; i < _data.size(); ++i) {
-            result.data()[i] =
-                static_cast<R>(_data[i]) + static_cast<R>(other.data()[i]);
-        }
+/**
+ * @brief Element-wise scalar addition (Matrix + scalar).
+ * @return An expression of the common, promoted type.
+ */
+template <typename E, Numeric U>
+    requires MatrixOperand<E>
+[[nodiscard]] auto operator+(E&& matrix, const U& scalar) noexcept {
+    using R = std::common_type_t<typename std::remove_cvref_t<E>::value_type, U>;
+    return detail::_make_matrix_unary<R>(
+        std::forward<E>(matrix), detail::_add_scalar<R>{static_cast<R>(scalar)});
+}
+
+/**
+ * @brief Element-wise scalar addition (scalar + Matrix).
+ */
+template <Numeric U, typename E>
+    requires MatrixOperand<E>
+[[nodiscard]] auto operator+(const U& scalar, E&& matrix) noexcept {
+    return std::forward<E>(matrix) + scalar;
+}
+
+/**
+ * @brief Element-wise matrix subtraction.
+ * @return An expression of the common, promoted type.
+ * @throws std::invalid_argument if dimensions do not match.
+ */
+template <typename L, typename R>
+    requires MatrixOperand<L> && MatrixOperand<R>
+[[nodiscard]] auto operator-(L&& lhs, R&& rhs) {
+    return detail::_make_matrix_binary<detail::_subtract>(
+        std::forward<L>(lhs),
+        std::forward<R>(rhs),
+        "Matrices have to be of same dimensions for subtraction!");
+}
+
+/**
+ * @brief Element-wise scalar subtraction (Matrix - scalar).
+ * @return An expression of the common, promoted type.
+ */
+template <typename E, Numeric U>
+    requires MatrixOperand<E>
+[[nodiscard]] auto operator-(E&& matrix, const U& scalar) noexcept {
+    using R = std::common_type_t<typename std::remove_cvref_t<E>::value_type, U>;
+    return detail::_make_matrix_unary<R>(
+        std::forward<E>(matrix), detail::_subtract_scalar<R>{static_cast<R>(scalar)});
+}
+
+/**
+ * @brief Element-wise scalar subtraction (scalar - Matrix).
+ * @return An expression of the common, promoted type.
+ */
+template <Numeric U, typename E>
+    requires MatrixOperand<E>
+[[nodiscard]] auto operator-(const U& scalar, E&& matrix) noexcept {
+    using R = std::common_type_t<typename std::remove_cvref_t<E>::value_type, U>;
+    return detail::_make_matrix_unary<R>(
+        std::forward<E>(matrix),
+        detail::_subtract_from_scalar<R>{static_cast<R>(scalar)});
+}
+
+/**
+ * @brief Element-wise scalar multiplication (Matrix * scalar).
+ * @return An expression of the common, promoted type.
+ */
+template <typename E, Numeric U>
+    requires MatrixOperand<E>
+[[nodiscard]] auto operator*(E&& matrix, const U& scalar) noexcept {
+    using R = std::common_type_t<typename std::remove_cvref_t<E>::value_type, U>;
+    return detail::_make_matrix_unary<R>(
+        std::forward<E>(matrix), detail::_multiply_scalar<R>{static_cast<R>(scalar)});
+}
+
+/**
+ * @brief Element-wise scalar multiplication (scalar * Matrix).
+ */
+template <Numeric U, typename E>
+    requires MatrixOperand<E>
+[[nodiscard]] auto operator*(const U& scalar, E&& matrix) noexcept {
+    return std::forward<E>(matrix) * scalar;
+}
+
+/**
+ * @brief Element-wise scalar division (Matrix / scalar).
+ * @details Promotes integer matrices to double, which is usually desired
+ * for division.
+ * @return An expression of the common, promoted type.
+ */
+template <typename E, Numeric U>
+    requires MatrixOperand<E>
+[[nodiscard]] auto operator/(E&& matrix, const U& scalar) noexcept {
+    using R =
+        std::common_type_t<typename std::remove_cvref_t<E>::value_type, U, double>;
+    return detail::_make_matrix_unary<R>(
+        std::forward<E>(matrix),
+        detail::_multiply_scalar<R>{R(1) / static_cast<R>(scalar)});
+}
+
+/**
+ * @brief Element-wise scalar division (scalar / Matrix).
+ * @return An expression of the common, promoted type.
+ */
+template <Numeric U, typename E>
+    requires MatrixOperand<E>
+[[nodiscard]] auto operator/(const U& scalar, E&& matrix) noexcept {
+    using R =
+        std::common_type_t<typename std::remove_cvref_t<E>::value_type, U, double>;
+    return detail::_make_matrix_unary<R>(
+        std::forward<E>(matrix), detail::_divide_scalar_by<R>{static_cast<R>(scalar)});
+}
+
+namespace detail {
+/**
+ * @brief Multiplies two strided operands on the packed GEMM engine.
+ * @details Products accumulate in Compute and are stored as Result; the
+ * operands are converted while they are packed.
+ * @throws std::invalid_argument if inner dimensions do not match.
+ */
+template <std::floating_point Compute, Numeric Result, Numeric T, Numeric U>
+[[nodiscard]] Matrix<Result> _gemm_views(const ConstMatrixView<T>& a,
+                                         const ConstMatrixView<U>& b) {
+    if (a.column_count() != b.row_count()) {
+        throw std::invalid_argument(
+            "Matrix inner dimensions do not match for multiplication!");
+    }
+    if (a.row_count() == 0 || b.column_count() == 0) {
+        return Matrix<Result>();
     }
+    Matrix<Result> result(a.row_count(), b.column_count(), default_init);
+    _gemm(a.row_count(),
+          b.column_count(),
+          a.column_count(),
+          Compute(1),
+          a.data(),
+          a.row_stride(),
+          a.col_stride(),
+          b.data(),
+          b.row_stride(),
+          b.col_stride(),
+          Compute(0),
+          result.data().data(),
+          b.column_count(),
+          1);
     return result;
 }
 
-// Add a scalar to each element of matrix
-template <Numeric T>
-template <Numeric U>
-[[nodiscard]] auto Matrix<T>::operator+(const U& scalar) const noexcept {
-    using R = std::common_type_t<T, U>;
+}  // namespace detail
 
-    Matrix<R> result(_rows, _cols);
-    R r_scalar = static_cast<R>(scalar);
-
-    if (_data.size() > OMP_LINEAR_LIMIT) {
-        #pragma omp parallel for
-        for (size_t i = 0; i < _data.size(); ++i) {
-            result.data()[i] = static_cast<R>(_data[i]) + r_scalar;
-        }
+/**
+ * @brief Algebraic matrix multiplication where at least one side is a view
+ * or a lazy expression.
+ * @details Floating point views and matrices are passed to the packed GEMM
+ * engine with their strides, so blocks and transposes are multiplied without
+ * being copied, and mixed element types are converted during packing. Other
+ * expression operands are evaluated first.
+ * @throws std::invalid_argument if inner dimensions do not match.
+ */
+template <MatrixOperand L, MatrixOperand R>
+    requires(MatrixExpression<L> || MatrixExpression<R>)
+[[nodiscard]] auto operator*(const L& lhs, const R& rhs) {
+    using T = typename L::value_type;
+    using U = typename R::value_type;
+    using Common = std::common_type_t<T, U>;
+    if constexpr (detail::_strided_operand<L> && detail::_strided_operand<R> &&
+                  std::is_floating_point_v<Common>) {
+        return detail::_gemm_views<Common, Common>(detail::_as_view(lhs),
+                                                   detail::_as_view(rhs));
     } else {
-        #pragma omp simd
-        for (size_t i = 0; i < _data.size(); ++i) {
-            result.data()[i] = static_cast<R>(_data[i]) + r_scalar;
-        }
+        return detail::_materialize(lhs) * detail::_materialize(rhs);
     }
-    return result;
 }
 
 /**
- * @brief Element-wise scalar addition (scalar + Matrix).
+ * @brief Matrix multiplication with an explicit accumulation type.
+ *
+ * Like `lhs * rhs`, but every dot product is accumulated in Accumulator.
+ * The result keeps the common element type of the operands (Accumulator if
+ * both are integers). For example `multiply<double>(A, B)` with float A and
+ * B stores a float result computed with double accumulation, which keeps
+ * half the memory traffic of a double product at close to double accuracy.
+ *
+ * Operands are converted to Accumulator while the GEMM engine packs them,
+ * so no converted copies are made. Lazy expressions are evaluated first.
+ *
+ * @tparam Accumulator Floating point type of the accumulation.
+ * @return Matrix of the common type of the operands.
+ * @throws std::invalid_argument if inner dimensions do not match.
  */
-template <Numeric T, Numeric U>
-[[nodiscard]] auto operator+(const U& scalar, const Matrix<T>& matrix) noexcept {
-    return matrix + scalar;
+template <std::floating_point Accumulator, MatrixOperand L, MatrixOperand R>
+[[nodiscard]] auto multiply(const L& lhs, const R& rhs) {
+    using Common = std::common_type_t<typename L::value_type, typename R::value_type>;
+    using Result =
+        std::conditional_t<std::is_floating_point_v<Common>, Common, Accumulator>;
+    if constexpr (detail::_strided_operand<L> && detail::_strided_operand<R>) {
+        return detail::_gemm_views<Accumulator, Result>(detail::_as_view(lhs),
+                                                        detail::_as_view(rhs));
+    } else {
+        return multiply<Accumulator>(detail::_materialize(lhs),
+                                     detail::_materialize(rhs));
+    }
 }
 
-// Add 2 matrices element-wise
-template <Numeric T>
-template <Numeric U>
-Matrix<T>& Matrix<T>::operator+=(const Matrix<U>& other) {
-    if (_rows != other.row_count() || _cols != other.column_count()) {
+/**
+ * @brief Matrix-Vector multiplication (view or expression * column_vector).
+ * @details Views run on the GEMV kernel with their strides; expressions are
+ * read element-wise, without being materialized.
+ * @return A new column Vector of the common, promoted type.
+ * @throws std::invalid_argument if vector is not a column vector or
+ * dimensions do not match.
+ */
+template <MatrixExpression E, Numeric U>
+[[nodiscard]] auto operator*(const E& matrix, const Vector<U>& vec) {
+    using R = std::common_type_t<typename E::value_type, U>;
+
+    const size_t n = matrix.row_count();
+    const size_t m = matrix.column_count();
+
+    if (vec.orientation() == Orientation::ROW) {
         throw std::invalid_argument(
-            "Matrices have to be of same dimensions for addition!");
+            "Invalid multiplication: matrix * row vector.\n"
+            "Did you mean Vector * Matrix?");
+    }
+    if (vec.size() != m) {
+        throw std::invalid_argument(
+            "Dimension mismatch in Matrix * Vector multiplication.");
     }
 
-    if (_data.size() > OMP_LINEAR_LIMIT) {
-        #pragma omp parallel for
-        for (size_t i = 0; i < _data.size(); ++i) {
-            _data[i] += static_cast<T>(other.data()[i]);
-        }
+    Vector<R> result(n, default_init, COLUMN);
+    if constexpr (detail::is_matrix_view<E>::value) {
+        detail::_gemv(n,
+                      m,
+                      R(1),
+                      matrix.data(),
+                      matrix.row_stride(),
+                      matrix.col_stride(),
+                      vec.data().data(),
+                      1,
+                      R(0),
+                      result.data().data(),
+                      1);
     } else {
-        #pragma omp simd
-        for (size_t i = 0; i < _data.size(); ++i) {
-            _data[i] += static_cast<T>(other.data()[i]);
+        #pragma omp parallel for if (n * m > OMP_LINEAR_LIMIT)
+        for (size_t i = 0; i < n; ++i) {
+            R sum = R(0);
+            for (size_t j = 0; j < m; ++j) {
+                sum += static_cast<R>(matrix(i, j)) * static_cast<R>(vec[j]);
+            }
+            result[i] = sum;
         }
     }
+    return result;
+}
 
-    return *this;
+namespace detail {
+/**
+ * @brief Checks the operands of gemv() / gevm() and runs the kernel on A
+ * described by (rows, cols, rs, cs).
+ */
+template <Numeric T, Numeric TA, Numeric U>
+void _checked_gemv(T alpha,
+                   const TA* a,
+                   size_t rows,
+                   size_t cols,
+                   size_t rs,
+                   size_t cs,
+                   const Vector<U>& x,
+                   T beta,
+                   Vector<T>& y) {
+    if (x.size() != cols || y.size() != rows) {
+        throw std::invalid_argument(
+            "Dimension mismatch in Matrix * Vector multiplication.");
+    }
+    if constexpr (std::is_same_v<T, U>) {
+        if (&x == &y) {
+            throw std::invalid_argument("Output vector must not be the input vector!");
+        }
+    }
+    using R = std::common_type_t<T, TA, U>;
+    _gemv(rows,
+          cols,
+          static_cast<R>(alpha),
+          a,
+          rs,
+          cs,
+          x.data().data(),
+          1,
+          static_cast<R>(beta),
+          y.data().data(),
+          1);
 }
 
-// Add a scalar to each element of matrix
-template <Numeric T>
-template <Numeric U>
-Matrix<T>& Matrix<T>::operator+=(const U& scalar) noexcept {
-    using R = std::common_type_t<T, U>;
+}  // namespace detail
 
-    R r_scalar = static_cast<R>(scalar);
+/**
+ * @brief In-place general matrix-vector product y = alpha * A * x + beta * y.
+ *
+ * Runs the blocked, parallel GEMV kernel directly on the storage of A, x and
+ * y, without allocating, so it can sit in the inner loop of iterative
+ * solvers. A may be a Matrix or a view (e.g. `A.t()` for A^T * x). The
+ * orientation of the vectors is not checked. When beta is zero, y is not
+ * read.
+ *
+ * @throws std::invalid_argument if x does not have A.column_count() elements,
+ * y does not have A.row_count() elements, or x and y are the same vector.
+ */
+template <Numeric T, MatrixOperand E, Numeric U>
+    requires detail::_strided_operand<E>
+void gemv(std::type_identity_t<T> alpha,
+          const E& a,
+          const Vector<U>& x,
+          std::type_identity_t<T> beta,
+          Vector<T>& y) {
+    const auto view = detail::_as_view(a);
+    detail::_checked_gemv(alpha,
+                          view.data(),
+                          view.row_count(),
+                          view.column_count(),
+                          view.row_stride(),
+                          view.col_stride(),
+                          x,
+                          beta,
+                          y);
+}
 
-    if (_data.size() > OMP_LINEAR_LIMIT) {
-        #pragma omp parallel for
-        for (size_t i = 0; i < _data.size(); ++i) {
-            _data[i] += r_scalar;
-        }
-    } else {
-        #pragma omp simd
-        for (size_t i = 0; i < _data.size(); ++i) {
-            _data[i] += r_scalar;
-        }
+/**
+ * @brief In-place vector-matrix product y = alpha * x^T * A + beta * y.
+ *
+ * The transposed counterpart of gemv(): for a row-major A the kernel runs
+ * over column panels of A, reading it in storage order. The orientation of
+ * the vectors is not checked. When beta is zero, y is not read.
+ *
+ * @throws std::invalid_argument if x does not have A.row_count() elements,
+ * y does not have A.column_count() elements, or x and y are the same vector.
+ */
+template <Numeric T, Numeric U, MatrixOperand E>
+    requires detail::_strided_operand<E>
+void gevm(std::type_identity_t<T> alpha,
+          const Vector<U>& x,
+          const E& a,
+          std::type_identity_t<T> beta,
+          Vector<T>& y) {
+    const auto view = detail::_as_view(a);
+    detail::_checked_gemv(alpha,
+                          view.data(),
+                          view.column_count(),
+                          view.row_count(),
+                          view.col_stride(),
+                          view.row_stride(),
+                          x,
+                          beta,
+                          y);
+}
+
+// Assigns a lazy expression, evaluating it in one fused loop
+template <Numeric T>
+template <MatrixExpression E>
+Matrix<T>& Matrix<T>::operator=(const E& expr) {
+    if (_rows != expr.row_count() || _cols != expr.column_count() ||
+        detail::_aliases(expr, detail::_footprint_of(ConstMatrixView<T>(*this)))) {
+        // The expression reads this matrix through another mapping (or has a
+        // different shape), so evaluate it first
+        *this = Matrix<T>(expr);
+        return *this;
     }
+    detail::_assign_matrix(_data.data(), _stride, 1, expr, [](T& dst, auto value) {
+        dst = static_cast<T>(value);
+    });
     return *this;
 }
 
-// Subtract 2 matrices element-wise
+// Add a matrix or expression element-wise
 template <Numeric T>
-template <Numeric U>
-[[nodiscard]] auto Matrix<T>::operator-(const Matrix<U>& other) const {
+template <MatrixOperand E>
+Matrix<T>& Matrix<T>::operator+=(const E& other) {
     if (_rows != other.row_count() || _cols != other.column_count()) {
         throw std::invalid_argument(
-            "Matrices have to be of same dimensions for subtraction!");
+            "Matrices have to be of same dimensions for addition!");
     }
-    using R = std::common_type_t<T, U>;
-
-    Matrix<R> result(_rows, _cols);
-    if (_data.size() > OMP_LINEAR_LIMIT) {
-        #pragma omp parallel for
-        for (size_t i = 0; i < _data.size(); ++i) {
-            result.data()[i] =
-                static_cast<R>(_data[i]) - static_cast<R>(other.data()[i]);
-        }
-    } else {
-        #pragma omp simd
-        for (size_t i = 0; i < _data.size(); ++i) {
-            result.data()[i] =
-                static_cast<R>(_data[i]) - static_cast<R>(other.data()[i]);
-        }
+    if (detail::_aliases(other, detail::_footprint_of(ConstMatrixView<T>(*this)))) {
+        return *this += other.template cast<T>();
     }
-    return result;
+    detail::_assign_matrix(_data.data(), _stride, 1, other, [](T& dst, auto value) {
+        dst += static_cast<T>(value);
+    });
+    return *this;
 }
 
-// Subtract a scalar from each element of matrix
+// Add a scalar to each element of matrix
 template <Numeric T>
 template <Numeric U>
-[[nodiscard]] auto Matrix<T>::operator-(const U& scalar) const noexcept {
+Matrix<T>& Matrix<T>::operator+=(const U& scalar) noexcept {
     using R = std::common_type_t<T, U>;
 
-    Matrix<R> result(_rows, _cols);
     R r_scalar = static_cast<R>(scalar);
 
     if (_data.size() > OMP_LINEAR_LIMIT) {
         #pragma omp parallel for
         for (size_t i = 0; i < _data.size(); ++i) {
-            result.data()[i] = static_cast<R>(_data[i]) - r_scalar;
+            _data[i] += r_scalar;
         }
     } else {
         #pragma omp simd
         for (size_t i = 0; i < _data.size(); ++i) {
-            result.data()[i] = static_cast<R>(_data[i]) - r_scalar;
-        }
-    }
-    return result;
-}
-
-/**
- * @brief Element-wise scalar subtraction (scalar - Matrix).
- * @tparam U An arithmetic scalar type.
- * @return Matrix of the common, promoted type.
- */
-template <Numeric T, Numeric U>
-[[nodiscard]] auto operator-(const U& scalar, const Matrix<T>& matrix) {
-    using R = std::common_type_t<T, U>;
-
-    Matrix<R> result(matrix.row_count(), matrix.column_count());
-    R r_scalar = static_cast<R>(scalar);
-
-    if (matrix.size() > OMP_LINEAR_LIMIT) {
-        #pragma omp parallel for
-        for (size_t i = 0; i < matrix.size(); ++i) {
-            result.data()[i] = r_scalar - static_cast<R>(matrix.data()[i]);
-        }
-    } else {
-        #pragma omp simd
-        for (size_t i = 0; i < matrix.size(); ++i) {
-            result.data()[i] = r_scalar - static_cast<R>(matrix.data()[i]);
+            _data[i] += r_scalar;
         }
     }
-    return result;
+    return *this;
 }
 
-// Subtract 2 matrices element-wise
+// Subtract a matrix or expression element-wise
 template <Numeric T>
-template <Numeric U>
-Matrix<T>& Matrix<T>::operator-=(const Matrix<U>& other) {
+template <MatrixOperand E>
+Matrix<T>& Matrix<T>::operator-=(const E& other) {
     if (_rows != other.row_count() || _cols != other.column_count()) {
         throw std::invalid_argument(
             "Matrices have to be of same dimensions for addition!");
     }
-
-    if (_data.size() > OMP_LINEAR_LIMIT) {
-        #pragma omp parallel for
-        for (size_t i = 0; i < _data.size(); ++i) {
-            _data[i] -= static_cast<T>(other.data()[i]);
-        }
-    } else {
-        #pragma omp simd
-        for (size_t i = 0; i < _data.size(); ++i) {
-            _data[i] -= static_cast<T>(other.data()[i]);
-        }
+    if (detail::_aliases(other, detail::_footprint_of(ConstMatrixView<T>(*this)))) {
+        return *this -= other.template cast<T>();
     }
-
+    detail::_assign_matrix(_data.data(), _stride, 1, other, [](T& dst, auto value) {
+        dst -= static_cast<T>(value);
+    });
     return *this;
 }
 
@@ -0,0 +1,530 @@
+#ifndef MATRIX_VIEW_H
+#define MATRIX_VIEW_H
+#pragma once
+#include "LinAlg.hpp"
+
+/**
+ * @file MatrixView.hpp
+ * @brief Non-owning, strided views into matrix storage.
+ *
+ * A view describes a rows x cols window of existing storage by a pointer to
+ * its first element (the offset into the parent), a row stride and a column
+ * stride. Blocks, single rows and columns, and transposes of a Matrix (or of
+ * another view) are therefore O(1) to create and never copy elements:
+ *
+ * @code
+ * auto top_left = A.block(0, 0, 2, 2);  // MatrixView<T>, writes go to A
+ * auto column = A.col(3);               // rows x 1
+ * auto product = A.t() * B;             // GEMM reads A transposed in place
+ * @endcode
+ *
+ * Views are MatrixExpression operands, so they work with every element-wise
+ * operator, with `loosely_equal()`, `plu()`, `cholesky()` and with matrix
+ * products. Assigning an expression that reads overlapping storage through a
+ * different mapping (e.g. `A = A.t()`) is detected and evaluated through a
+ * temporary.
+ *
+ * @attention A view must not outlive the storage it refers to, and resizing
+ * the parent matrix invalidates it.
+ *
+ * This file is intended to be included by LinAlg.hpp and should not be
+ * included directly anywhere else.
+ */
+namespace maf::math {
+namespace detail {
+/** @brief Throws std::out_of_range if a block does not fit in the parent. */
+inline void _check_block(size_t row,
+                         size_t col,
+                         size_t rows,
+                         size_t cols,
+                         size_t parent_rows,
+                         size_t parent_cols) {
+    if (row > parent_rows || col > parent_cols || rows > parent_rows - row ||
+        cols > parent_cols - col) {
+        throw std::out_of_range("Block exceeds matrix bounds.");
+    }
+}
+
+}  // namespace detail
+
+/**
+ * @brief A read-only, non-owning, strided view of a matrix.
+ *
+ * Element (i, j) of the view lives at `data()[i * row_stride() + j *
+ * col_stride()]`.
+ *
+ * @tparam T The numeric type of the viewed elements.
+ */
+template <Numeric T>
+class ConstMatrixView {
+public:
+    /** @brief The numeric type of the matrix elements. */
+    using value_type = T;
+
+    /**
+     * @brief Constructs a view over raw strided storage.
+     * @param data Pointer to element (0, 0) of the view.
+     * @param rows Number of rows.
+     * @param cols Number of columns.
+     * @param row_stride Distance between consecutive rows.
+     * @param col_stride Distance between consecutive columns.
+     */
+    ConstMatrixView(const T* data,
+                    size_t rows,
+                    size_t cols,
+                    size_t row_stride,
+                    size_t col_stride) noexcept
+        : _data(data),
+          _rows(rows),
+          _cols(cols),
+          _row_stride(row_stride),
+          _col_stride(col_stride) {}
+
+    /** @brief Views the whole matrix. */
+    ConstMatrixView(const Matrix<T>& matrix) noexcept
+        : ConstMatrixView(matrix.data().data(),
+                          matrix.row_count(),
+                          matrix.column_count(),
+                          matrix.leading_dimension(),
+                          1) {}
+
+    /** @brief Pointer to element (0, 0). */
+    [[nodiscard]] const T* data() const noexcept {
+        return _data;
+    }
+
+    /** @brief Gets the number of rows. */
+    [[nodiscard]] size_t row_count() const noexcept {
+        return _rows;
+    }
+
+    /** @brief Gets the number of columns. */
+    [[nodiscard]] size_t column_count() const noexcept {
+        return _cols;
+    }
+
+    /** @brief Gets the total number of elements (rows * cols). */
+    [[nodiscard]] size_t size() const noexcept {
+        return _rows * _cols;
+    }
+
+    /** @brief Distance between consecutive rows in the underlying storage. */
+    [[nodiscard]] size_t row_stride() const noexcept {
+        return _row_stride;
+    }
+
+    /** @brief Distance between consecutive columns in the underlying storage. */
+    [[nodiscard]] size_t col_stride() const noexcept {
+        return _col_stride;
+    }
+
+    /** @brief Accesses the element at (row, col) with no bounds check. */
+    [[nodiscard]] const T& operator()(size_t row, size_t col) const noexcept {
+        return _data[(row * _row_stride) + (col * _col_stride)];
+    }
+
+    /**
+     * @brief Accesses the element at (row, col).
+     * @throws std::out_of_range if the index is invalid.
+     */
+    [[nodiscard]] const T& at(size_t row, size_t col) const {
+        if (row >= _rows || col >= _cols) {
+            throw std::out_of_range("Index out of bounds.");
+        }
+        return (*this)(row, col);
+    }
+
+    /**
+     * @brief Views the rows x cols block whose top-left corner is (row, col).
+     * @throws std::out_of_range if the block does not fit.
+     */
+    [[nodiscard]] ConstMatrixView block(size_t row,
+                                        size_t col,
+                                        size_t rows,
+                                        size_t cols) const {
+        detail::_check_block(row, col, rows, cols, _rows, _cols);
+        return ConstMatrixView(
+            _data + (row * _row_stride) + (col * _col_stride),
+            rows,
+            cols,
+            _row_stride,
+            _col_stride);
+    }
+
+    /**
+     * @brief Views a single row as a 1 x cols matrix.
+     * @throws std::out_of_range if the row is invalid.
+     */
+    [[nodiscard]] ConstMatrixView row(size_t row) const {
+        return block(row, 0, 1, _cols);
+    }
+
+    /**
+     * @brief Views a single column as a rows x 1 matrix.
+     * @throws std::out_of_range if the column is invalid.
+     */
+    [[nodiscard]] ConstMatrixView col(size_t col) const {
+        return block(0, col, _rows, 1);
+    }
+
+    /** @brief Views the transpose by swapping the strides. */
+    [[nodiscard]] ConstMatrixView t() const noexcept {
+        return ConstMatrixView(_data, _cols, _rows, _col_stride, _row_stride);
+    }
+
+    /** @brief Copies the viewed elements into a new Matrix. */
+    [[nodiscard]] Matrix<T> eval() const {
+        return Matrix<T>(*this);
+    }
+
+    /** @brief Copies the viewed elements into a new Matrix of type U. */
+    template <Numeric U>
+    [[nodiscard]] Matrix<U> cast() const {
+        return Matrix<U>(*this);
+    }
+
+private:
+    const T* _data;
+    size_t _rows;
+    size_t _cols;
+    size_t _row_stride;
+    size_t _col_stride;
+};
+
+/**
+ * @brief A mutable, non-owning, strided view of a matrix.
+ *
+ * Copying a view is shallow, like std::span. Assigning to a view (from
+ * another view, a Matrix or an expression) writes the elements through to
+ * the viewed storage.
+ *
+ * @tparam T The numeric type of the viewed elements.
+ */
+template <Numeric T>
+class MatrixView {
+public:
+    /** @brief The numeric type of the matrix elements. */
+    using value_type = T;
+
+    /**
+     * @brief Constructs a view over raw strided storage.
+     * @param data Pointer to element (0, 0) of the view.
+     * @param rows Number of rows.
+     * @param cols Number of columns.
+     * @param row_stride Distance between consecutive rows.
+     * @param col_stride Distance between consecutive columns.
+     */
+    MatrixView(T* data,
+               size_t rows,
+               size_t cols,
+               size_t row_stride,
+               size_t col_stride) noexcept
+        : _data(data),
+          _rows(rows),
+          _cols(cols),
+          _row_stride(row_stride),
+          _col_stride(col_stride) {}
+
+    /** @brief Views the whole matrix. */
+    MatrixView(Matrix<T>& matrix) noexcept
+        : MatrixView(matrix.data().data(),
+                     matrix.row_count(),
+                     matrix.column_count(),
+                     matrix.leading_dimension(),
+                     1) {}
+
+    MatrixView(const MatrixView& other) noexcept = default;
+
+    /** @brief Converts to a read-only view of the same elements. */
+    operator ConstMatrixView<T>() const noexcept {
+        return ConstMatrixView<T>(_data, _rows, _cols, _row_stride, _col_stride);
+    }
+
+    /** @brief Pointer to element (0, 0). */
+    [[nodiscard]] T* data() const noexcept {
+        return _data;
+    }
+
+    /** @brief Gets the number of rows. */
+    [[nodiscard]] size_t row_count() const noexcept {
+        return _rows;
+    }
+
+    /** @brief Gets the number of columns. */
+    [[nodiscard]] size_t column_count() const noexcept {
+        return _cols;
+    }
+
+    /** @brief Gets the total number of elements (rows * cols). */
+    [[nodiscard]] size_t size() const noexcept {
+        return _rows * _cols;
+    }
+
+    /** @brief Distance between consecutive rows in the underlying storage. */
+    [[nodiscard]] size_t row_stride() const noexcept {
+        return _row_stride;
+    }
+
+    /** @brief Distance between consecutive columns in the underlying storage. */
+    [[nodiscard]] size_t col_stride() const noexcept {
+        return _col_stride;
+    }
+
+    /** @brief Accesses the element at (row, col) with no bounds check. */
+    [[nodiscard]] T& operator()(size_t row, size_t col) const noexcept {
+        return _data[(row * _row_stride) + (col * _col_stride)];
+    }
+
+    /**
+     * @brief Accesses the element at (row, col).
+     * @throws std::out_of_range if the index is invalid.
+     */
+    [[nodiscard]] T& at(size_t row, size_t col) const {
+        if (row >= _rows || col >= _cols) {
+            throw std::out_of_range("Index out of bounds.");
+        }
+        return (*this)(row, col);
+    }
+
+    /**
+     * @brief Views the rows x cols block whose top-left corner is (row, col).
+     * @throws std::out_of_range if the block does not fit.
+     */
+    [[nodiscard]] MatrixView block(size_t row,
+                                   size_t col,
+                                   size_t rows,
+                                   size_t cols) const {
+        detail::_check_block(row, col, rows, cols, _rows, _cols);
+        return MatrixView(_data + (row * _row_stride) + (col * _col_stride),
+                          rows,
+                          cols,
+                          _row_stride,
+                          _col_stride);
+    }
+
+    /**
+     * @brief Views a single row as a 1 x cols matrix.
+     * @throws std::out_of_range if the row is invalid.
+     */
+    [[nodiscard]] MatrixView row(size_t row) const {
+        return block(row, 0, 1, _cols);
+    }
+
+    /**
+     * @brief Views a single column as a rows x 1 matrix.
+     * @throws std::out_of_range if the column is invalid.
+     */
+    [[nodiscard]] MatrixView col(size_t col) const {
+        return block(0, col, _rows, 1);
+    }
+
+    /** @brief Views the transpose by swapping the strides. */
+    [[nodiscard]] MatrixView t() const noexcept {
+        return MatrixView(_data, _cols, _rows, _col_stride, _row_stride);
+    }
+
+    /** @brief Copies the viewed elements into a new Matrix. */
+    [[nodiscard]] Matrix<T> eval() const {
+        return Matrix<T>(*this);
+    }
+
+    /** @brief Copies the viewed elements into a new Matrix of type U. */
+    template <Numeric U>
+    [[nodiscard]] Matrix<U> cast() const {
+        return Matrix<U>(*this);
+    }
+
+    /** @brief Sets every viewed element to value. */
+    void fill(T value) const noexcept;
+
+    /**
+     * @brief Copies the elements of another view into this one.
+     * @throws std::invalid_argument if dimensions do not match.
+     */
+    MatrixView& operator=(const MatrixView& other);
+
+    /**
+     * @brief Writes a Matrix, view or lazy expression into the viewed
+     * elements.
+     * @throws std::invalid_argument if dimensions do not match.
+     */
+    template <MatrixOperand E>
+    MatrixView& operator=(const E& expr);
+
+    /**
+     * @brief Element-wise addition into the viewed elements.
+     * @throws std::invalid_argument if dimensions do not match.
+     */
+    template <MatrixOperand E>
+    MatrixView& operator+=(const E& other);
+
+    /**
+     * @brief Element-wise subtraction from the viewed elements.
+     * @throws std::invalid_argument if dimensions do not match.
+     */
+    template <MatrixOperand E>
+    MatrixView& operator-=(const E& other);
+
+private:
+    T* _data;
+    size_t _rows;
+    size_t _cols;
+    size_t _row_stride;
+    size_t _col_stride;
+
+    template <typename E, typename Op>
+    void _assign(const E& expr, Op op, const char* message);
+};
+
+namespace detail {
+template <Numeric T>
+struct is_matrix_expression<ConstMatrixView<T>> : std::true_type {};
+
+template <Numeric T>
+struct is_matrix_expression<MatrixView<T>> : std::true_type {};
+
+template <typename E>
+struct is_matrix_view : std::false_type {};
+
+template <Numeric T>
+struct is_matrix_view<ConstMatrixView<T>> : std::true_type {};
+
+template <Numeric T>
+struct is_matrix_view<MatrixView<T>> : std::true_type {};
+
+/** @brief A Matrix or a view, i.e. an operand with addressable strided storage. */
+template <typename E>
+concept _strided_operand = is_matrix<std::remove_cvref_t<E>>::value ||
+                           is_matrix_view<std::remove_cvref_t<E>>::value;
+
+/** @brief Read-only view of a Matrix or view operand. */
+template <_strided_operand E>
+[[nodiscard]] auto _as_view(const E& operand) noexcept {
+    return ConstMatrixView<typename E::value_type>(operand);
+}
+
+/**
+ * @brief The memory occupied by a strided matrix and the way it maps
+ * (row, col) to addresses.
+ */
+struct _Footprint {
+    const std::byte* first = nullptr;
+    const std::byte* last = nullptr;
+    const void* origin = nullptr;
+    size_t row_stride = 0;
+    size_t col_stride = 0;
+};
+
+template <typename T>
+[[nodiscard]] _Footprint _footprint_of(ConstMatrixView<T> view) noexcept {
+    if (view.size() == 0) {
+        return {};
+    }
+    const T* last = &view(view.row_count() - 1, view.column_count() - 1);
+    return {reinterpret_cast<const std::byte*>(view.data()),
+            reinterpret_cast<const std::byte*>(last + 1),
+            view.data(),
+            view.row_stride(),
+            view.col_stride()};
+}
+
+/**
+ * @brief Checks whether evaluating expr into dst could read elements that
+ * were already overwritten.
+ *
+ * This is the case when some leaf of the expression overlaps the
+ * destination's memory through a different (row, col) mapping, e.g.
+ * `A = A.t()` or `A.block(0, 0, 2, 2) = A.block(1, 1, 2, 2)`. Leaves that
+ * map identically, like `A = A + B`, are safe for element-wise evaluation.
+ */
+template <typename E>
+[[nodiscard]] bool _aliases(const E& expr, const _Footprint& dst) {
+    using X = std::remove_cvref_t<E>;
+    if constexpr (_strided_operand<X>) {
+        const _Footprint src = _footprint_of(_as_view(expr));
+        if (src.first == nullptr || dst.first == nullptr) {
+            return false;
+        }
+        const std::less<> before;
+        if (!before(src.first, dst.last) || !before(dst.first, src.last)) {
+            return false;
+        }
+        return src.origin != dst.origin || src.row_stride != dst.row_stride ||
+               src.col_stride != dst.col_stride;
+    } else if constexpr (requires { expr.lhs(); }) {
+        return _aliases(expr.lhs(), dst) || _aliases(expr.rhs(), dst);
+    } else if constexpr (requires { expr.operand(); }) {
+        return _aliases(expr.operand(), dst);
+    } else {
+        return false;
+    }
+}
+
+}  // namespace detail
+
+template <Numeric T>
+void MatrixView<T>::fill(T value) const noexcept {
+    for (size_t i = 0; i < _rows; ++i) {
+        for (size_t j = 0; j < _cols; ++j) {
+            (*this)(i, j) = value;
+        }
+    }
+}
+
+// Applies op to every viewed element, going through a temporary on aliasing
+template <Numeric T>
+template <typename E, typename Op>
+void MatrixView<T>::_assign(const E& expr, Op op, const char* message) {
+    if (_rows != expr.row_count() || _cols != expr.column_count()) {
+        throw std::invalid_argument(message);
+    }
+    if (detail::_aliases(expr, detail::_footprint_of(ConstMatrixView<T>(*this)))) {
+        const Matrix<T> temporary(expr);
+        detail::_assign_matrix(_data, _row_stride, _col_stride, temporary, op);
+        return;
+    }
+    detail::_assign_matrix(_data, _row_stride, _col_stride, expr, op);
+}
+
+template <Numeric T>
+MatrixView<T>& MatrixView<T>::operator=(const MatrixView& other) {
+    _assign(
+        other,
+        [](T& dst, T value) { dst = value; },
+        "Matrices have to be of same dimensions for assignment!");
+    return *this;
+}
+
+template <Numeric T>
+template <MatrixOperand E>
+MatrixView<T>& MatrixView<T>::operator=(const E& expr) {
+    _assign(
+        expr,
+        [](T& dst, auto value) { dst = static_cast<T>(value); },
+        "Matrices have to be of same dimensions for assignment!");
+    return *this;
+}
+
+template <Numeric T>
+template <MatrixOperand E>
+MatrixView<T>& MatrixView<T>::operator+=(const E& other) {
+    _assign(
+        other,
+        [](T& dst, auto value) { dst += static_cast<T>(value); },
+        "Matrices have to be of same dimensions for addition!");
+    return *this;
+}
+
+template <Numeric T>
+template <MatrixOperand E>
+MatrixView<T>& MatrixView<T>::operator-=(const E& other) {
+    _assign(
+        other,
+        [](T& dst, auto value) { dst -= static_cast<T>(value); },
+        "Matrices have to be of same dimensions for subtraction!");
+    return *this;
+}
+
+}  // namespace maf::math
+
+#endif
@@ -0,0 +1,528 @@
+#ifndef PCA_H
+#define PCA_H
+#pragma once
+#include "Factorization.hpp"
+#include "LinAlg.hpp"
+#include "SVD.hpp"
+
+/**
+ * @file PCA.hpp
+ * @brief Principal component analysis of data matrices too large for a
+ * dense decomposition.
+ *
+ * Rows of the data are observations and columns are features. Neither
+ * algorithm forms the d x d covariance matrix:
+ * - fit() and pca() run a randomized range finder with power iterations on
+ *   the whole matrix, which is only ever multiplied by thin n x (k + p)
+ *   blocks through GEMM,
+ * - add_rows() updates the components incrementally from mini-batches of
+ *   rows, so the data never has to be resident at once; only a batch with
+ *   more rows than features is reduced to a d x d Gram matrix.
+ *
+ * Centering is implicit in both: the mean is subtracted inside the products
+ * and never from the data itself.
+ */
+namespace maf::math {
+namespace detail {
+/**
+ * @brief (A - 1 mean^T) B for the m x d data A and a d x p block B: one
+ * GEMM on A, then the rank-one correction.
+ */
+template <std::floating_point T, Numeric U>
+[[nodiscard]] Matrix<T> _centered_product(const ConstMatrixView<U>& a,
+                                          const std::vector<T>& mean,
+                                          const Matrix<T>& b) {
+    Matrix<T> result = _gemm_views<T, T>(a, b.view());
+    std::vector<T> shift(b.column_count());
+    _gemv<T>(b.column_count(),
+             b.row_count(),
+             T(1),
+             b.data().data(),
+             1,
+             b.leading_dimension(),
+             mean.data(),
+             1,
+             T(0),
+             shift.data(),
+             1);
+    #pragma omp parallel for if (result.row_count() * shift.size() > OMP_LINEAR_LIMIT)
+    for (size_t i = 0; i < result.row_count(); ++i) {
+        auto row = result.row_span(i);
+        for (size_t j = 0; j < shift.size(); ++j) {
+            row[j] -= shift[j];
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief (A - 1 mean^T)^T Q for the m x d data A and an m x p block Q: one
+ * GEMM on A^T, then the rank-one correction.
+ */
+template <std::floating_point T, Numeric U>
+[[nodiscard]] Matrix<T> _centered_product_t(const ConstMatrixView<U>& a,
+                                            const std::vector<T>& mean,
+                                            const Matrix<T>& q) {
+    Matrix<T> result = _gemm_views<T, T>(a.t(), q.view());
+    std::vector<T> sums(q.column_count(), T(0));
+    for (size_t i = 0; i < q.row_count(); ++i) {
+        const auto row = q.row_span(i);
+        for (size_t j = 0; j < sums.size(); ++j) {
+            sums[j] += row[j];
+        }
+    }
+    #pragma omp parallel for if (result.row_count() * sums.size() > OMP_LINEAR_LIMIT)
+    for (size_t i = 0; i < result.row_count(); ++i) {
+        auto row = result.row_span(i);
+        for (size_t j = 0; j < sums.size(); ++j) {
+            row[j] -= mean[i] * sums[j];
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief The k largest singular values and right singular vectors (d x k)
+ * of the r x d matrix at `b`, rows rsb and columns csb apart.
+ *
+ * Forms the smaller of the Gram matrices B B^T (r x r, the right vectors
+ * then being B^T U S^-1) and B^T B (d x d) with SYRK, so no Gram matrix is
+ * ever larger than B itself, and extracts only its k largest eigenpairs
+ * with _lobpcg() instead of decomposing it fully; small Gram matrices are
+ * decomposed densely. `start` (may be null) seeds the iteration with
+ * approximate eigenvectors of the Gram matrix, e.g. the previous
+ * components. Directions whose singular value is below the accuracy of the
+ * Gram matrix are dropped, and every vector has its largest component
+ * positive, which makes the result deterministic.
+ */
+template <std::floating_point T>
+[[nodiscard]] std::pair<std::vector<T>, Matrix<T>> _right_singular(
+    size_t r,
+    size_t d,
+    const T* b,
+    size_t rsb,
+    size_t csb,
+    size_t k,
+    const Matrix<T>* start = nullptr) {
+    const size_t g = std::min(r, d);
+    SymmetricMatrix<T> gram(g);
+    if (r <= d) {
+        _syrk(T(1), ConstMatrixView<T>(b, r, d, rsb, csb), T(0), gram);
+    } else {
+        _syrk(T(1), ConstMatrixView<T>(b, d, r, csb, rsb), T(0), gram);
+    }
+    auto [lambda, top] = _lobpcg<T>(
+        g,
+        [&gram](const Matrix<T>& x) -> Matrix<T> { return gram * x; },
+        k,
+        1e-10,
+        1000,
+        start);
+
+    std::vector<T> s(k);
+    for (size_t j = 0; j < k; ++j) {
+        s[j] = std::sqrt(std::max(lambda[j], T(0)));
+    }
+    size_t rank = 0;
+    while (rank < k && s[rank] > std::sqrt(std::numeric_limits<T>::epsilon()) * s[0]) {
+        ++rank;
+    }
+    s.resize(rank);
+    if (rank == 0) {
+        return std::make_pair(std::move(s), Matrix<T>());
+    }
+    if (rank < k) {
+        std::vector<size_t> kept(rank);
+        std::iota(kept.begin(), kept.end(), 0);
+        top = _columns(top, kept);
+    }
+
+    Matrix<T> v(d, rank, default_init);
+    if (r <= d) {
+        _gemm<T>(d,
+                 rank,
+                 r,
+                 T(1),
+                 b,
+                 csb,
+                 rsb,
+                 top.data().data(),
+                 top.leading_dimension(),
+                 1,
+                 T(0),
+                 v.data().data(),
+                 v.leading_dimension(),
+                 1);
+    } else {
+        v = std::move(top);
+    }
+
+    for (size_t j = 0; j < rank; ++j) {
+        size_t largest = 0;
+        for (size_t i = 1; i < d; ++i) {
+            if (std::abs(v(i, j)) > std::abs(v(largest, j))) {
+                largest = i;
+            }
+        }
+        const T scale = (r <= d ? T(1) / s[j] : T(1)) * (v(largest, j) < 0 ? -1 : 1);
+        for (size_t i = 0; i < d; ++i) {
+            v(i, j) *= scale;
+        }
+    }
+    return std::make_pair(std::move(s), std::move(v));
+}
+
+/** @brief Calls f with a strided view of the operand, evaluated if lazy. */
+template <std::floating_point T, MatrixOperand E, typename F>
+decltype(auto) _with_view(const E& operand, F&& f) {
+    if constexpr (_strided_operand<E>) {
+        return f(_as_view(operand));
+    } else {
+        const Matrix<T> evaluated = _converted<T>(operand);
+        return f(evaluated.view());
+    }
+}
+
+}  // namespace detail
+
+/**
+ * @brief Principal component analysis, fitted either at once by a
+ * randomized range finder (fit()) or incrementally from batches of rows
+ * (add_rows()).
+ *
+ * The model keeps the mean of the rows seen, the top principal axes as the
+ * columns of a d x k matrix and their singular values, O(d k) memory in
+ * total. Each add_rows() decomposes the small matrix
+ * [S V^T; X_c; c (mean_old - mean_batch)] of the current components, the
+ * centered batch and a mean correction (Ross et al., "Incremental Learning
+ * for Robust Visual Tracking"), so the model after any number of batches
+ * equals a rank-k PCA of all rows up to the truncation at every step.
+ * Batches can follow fit(), e.g. to roll a model forward in time.
+ *
+ * @tparam T Floating point type of the model.
+ */
+template <std::floating_point T>
+class PCA {
+public:
+    /**
+     * @brief Creates an empty model of `component_count` components over
+     * `feature_count` features.
+     * @throws std::invalid_argument if either count is zero or there are
+     * more components than features.
+     */
+    PCA(size_t feature_count, size_t component_count)
+        : _features(feature_count),
+          _components(component_count),
+          _mean(feature_count, T(0)) {
+        if (feature_count == 0 || component_count == 0) {
+            throw std::invalid_argument("Matrix dimensions must be greater than zero.");
+        }
+        if (component_count > feature_count) {
+            throw std::invalid_argument("More components requested than features!");
+        }
+    }
+
+    // --- Getters ---
+
+    /** @brief Rows (observations) fitted so far. */
+    [[nodiscard]] size_t row_count() const noexcept {
+        return _rows;
+    }
+
+    [[nodiscard]] size_t feature_count() const noexcept {
+        return _features;
+    }
+
+    /**
+     * @brief Components currently kept: the requested count once the data
+     * seen has at least that rank.
+     */
+    [[nodiscard]] size_t component_count() const noexcept {
+        return _singular.size();
+    }
+
+    /** @brief The mean of the rows fitted so far. */
+    [[nodiscard]] Vector<T> mean() const {
+        return Vector<T>(_features, _mean);
+    }
+
+    /**
+     * @brief The principal axes as the columns of a d x k matrix (empty
+     * before anything is fitted).
+     */
+    [[nodiscard]] const Matrix<T>& components() const noexcept {
+        return _vectors;
+    }
+
+    /** @brief The singular values of the centered data, descending. */
+    [[nodiscard]] const std::vector<T>& singular_values() const noexcept {
+        return _singular;
+    }
+
+    // --- Methods ---
+
+    /** @brief The variance along each component, s_j^2 / (n - 1). */
+    [[nodiscard]] Vector<T> explained_variance() const {
+        Vector<T> result(_singular.size());
+        for (size_t j = 0; j < _singular.size(); ++j) {
+            result[j] = _singular[j] * _singular[j] / _degrees_of_freedom();
+        }
+        return result;
+    }
+
+    /** @brief The fraction of the total variance along each component. */
+    [[nodiscard]] Vector<T> explained_variance_ratio() const {
+        Vector<T> result(_singular.size());
+        for (size_t j = 0; j < _singular.size(); ++j) {
+            result[j] = _sum_squares > T(0)
+                            ? _singular[j] * _singular[j] / _sum_squares
+                            : T(0);
+        }
+        return result;
+    }
+
+    /**
+     * @brief Fits the model to all rows of `data` with a randomized range
+     * finder, replacing anything fitted before.
+     *
+     * A Gaussian sketch Y = A_c Omega of k + oversampling columns is taken
+     * and sharpened by `power_iterations` rounds of Y = A_c (A_c^T Y), each
+     * product re-orthonormalized with QR; the small matrix Q^T A_c is then
+     * decomposed exactly. Every pass over A is one GEMM with a thin block
+     * and the data is never copied (lazy expressions are evaluated once).
+     * Power iterations matter when the spectrum decays slowly, as for
+     * noisy returns.
+     *
+     * @throws std::invalid_argument if the feature count does not match or
+     * there are fewer rows than components.
+     */
+    template <MatrixOperand E>
+    void fit(const E& data,
+             size_t power_iterations = 2,
+             size_t oversampling = detail::SKETCH_OVERSAMPLING) {
+        if (data.column_count() != _features) {
+            throw std::invalid_argument("Data column count does not match!");
+        }
+        if (data.row_count() < _components) {
+            throw std::invalid_argument(
+                "PCA needs at least as many rows as components!");
+        }
+        detail::_with_view<T>(
+            data, [&](const auto& a) { _fit(a, power_iterations, oversampling); });
+    }
+
+    /**
+     * @brief Updates the model with a batch of rows (a matrix, view or
+     * expression).
+     * @details For a batch of b rows the working matrix is r x d,
+     * r = k + b + 1. Its smaller Gram matrix costs O(min(r, d) r d) and
+     * only its top k eigenpairs are extracted, at O(min(r, d)^2 k) per
+     * LOBPCG iteration; the iteration starts from the current components,
+     * so it usually takes few. Batches larger than d rows cost O(b d^2).
+     * @throws std::invalid_argument if the feature count does not match.
+     */
+    template <MatrixOperand E>
+    void add_rows(const E& batch) {
+        if (batch.column_count() != _features) {
+            throw std::invalid_argument("Batch column count does not match!");
+        }
+        const size_t b = batch.row_count();
+        if (b == 0) {
+            return;
+        }
+        const size_t d = _features;
+        const size_t kept = _singular.size();
+        const size_t n = _rows + b;
+        const size_t r = kept + b + (_rows > 0 ? 1 : 0);
+
+        // [S V^T; X - mean_batch; c (mean_old - mean_batch)]
+        Matrix<T> work(r, d, default_init);
+        for (size_t j = 0; j < kept; ++j) {
+            for (size_t i = 0; i < d; ++i) {
+                work(j, i) = _singular[j] * _vectors(i, j);
+            }
+        }
+        std::vector<T> batch_mean(d, T(0));
+        for (size_t i = 0; i < b; ++i) {
+            auto row = work.row_span(kept + i);
+            for (size_t j = 0; j < d; ++j) {
+                row[j] = static_cast<T>(batch(i, j));
+                batch_mean[j] += row[j];
+            }
+        }
+        T batch_sum_squares = 0;
+        for (size_t j = 0; j < d; ++j) {
+            batch_mean[j] /= static_cast<T>(b);
+        }
+        for (size_t i = 0; i < b; ++i) {
+            auto row = work.row_span(kept + i);
+            for (size_t j = 0; j < d; ++j) {
+                row[j] -= batch_mean[j];
+                batch_sum_squares += row[j] * row[j];
+            }
+        }
+        if (_rows > 0) {
+            const T c = std::sqrt(static_cast<T>(_rows) * static_cast<T>(b) /
+                                  static_cast<T>(n));
+            auto row = work.row_span(r - 1);
+            for (size_t j = 0; j < d; ++j) {
+                const T delta = _mean[j] - batch_mean[j];
+                row[j] = c * delta;
+                batch_sum_squares += row[j] * row[j];
+            }
+        }
+
+        // The current components seed the iteration: they are eigenvectors
+        // of the d x d Gram matrix, and W V their images for the r x r one
+        const size_t k = std::min({_components, r, d});
+        std::optional<Matrix<T>> start;
+        if (kept > 0) {
+            start = r <= d ? work * _vectors : _vectors;
+        }
+        auto [s, v] = detail::_right_singular<T>(r,
+                                                 d,
+                                                 work.data().data(),
+                                                 work.leading_dimension(),
+                                                 1,
+                                                 k,
+                                                 start ? &*start : nullptr);
+        for (size_t j = 0; j < d; ++j) {
+            _mean[j] += (batch_mean[j] - _mean[j]) * static_cast<T>(b) /
+                        static_cast<T>(n);
+        }
+        _sum_squares += batch_sum_squares;
+        _singular = std::move(s);
+        _vectors = std::move(v);
+        _rows = n;
+    }
+
+    /**
+     * @brief Projects rows onto the components: (X - 1 mean^T) V, n x k.
+     * @throws std::invalid_argument if the feature count does not match.
+     * @throws std::runtime_error if the model has no components yet.
+     */
+    template <MatrixOperand E>
+    [[nodiscard]] Matrix<T> transform(const E& data) const {
+        if (data.column_count() != _features) {
+            throw std::invalid_argument("Data column count does not match!");
+        }
+        if (_singular.empty()) {
+            throw std::runtime_error("PCA model has no components to project on!");
+        }
+        return detail::_with_view<T>(data, [&](const auto& a) {
+            return detail::_centered_product(a, _mean, _vectors);
+        });
+    }
+
+private:
+    size_t _features;
+    size_t _components;
+    size_t _rows = 0;
+    std::vector<T> _mean;
+    std::vector<T> _singular;
+    Matrix<T> _vectors;
+    // Sum of squared deviations from the mean, for the variance ratios
+    T _sum_squares = 0;
+
+    [[nodiscard]] T _degrees_of_freedom() const noexcept {
+        return static_cast<T>(std::max<size_t>(_rows, 2) - 1);
+    }
+
+    template <Numeric U>
+    void _fit(const ConstMatrixView<U>& a,
+              size_t power_iterations,
+              size_t oversampling) {
+        const size_t m = a.row_count();
+        const size_t d = _features;
+
+        std::vector<T> ones(m, T(1));
+        detail::_gemv<T>(d,
+                         m,
+                         T(1) / static_cast<T>(m),
+                         a.data(),
+                         a.col_stride(),
+                         a.row_stride(),
+                         ones.data(),
+                         1,
+                         T(0),
+                         _mean.data(),
+                         1);
+        T sum_squares = 0;
+        const bool parallel = m * d > OMP_LINEAR_LIMIT;
+        #pragma omp parallel for reduction(+ : sum_squares) if (parallel)
+        for (size_t i = 0; i < m; ++i) {
+            for (size_t j = 0; j < d; ++j) {
+                const T deviation = static_cast<T>(a(i, j)) - _mean[j];
+                sum_squares += deviation * deviation;
+            }
+        }
+
+        const size_t l = std::min(_components + oversampling, std::min(m, d));
+        Matrix<T> q = detail::_qr(detail::_centered_product(
+                                      a, _mean, detail::_gaussian_matrix<T>(d, l, 42)))
+                          .first;
+        for (size_t iteration = 0; iteration < power_iterations; ++iteration) {
+            const Matrix<T> z =
+                detail::_qr(detail::_centered_product_t(a, _mean, q)).first;
+            q = detail::_qr(detail::_centered_product(a, _mean, z)).first;
+        }
+        // B^T = A_c^T Q, d x l
+        const Matrix<T> bt = detail::_centered_product_t(a, _mean, q);
+        auto [s, v] = detail::_right_singular<T>(
+            l, d, bt.data().data(), 1, bt.leading_dimension(), _components);
+
+        _rows = m;
+        _sum_squares = sum_squares;
+        _singular = std::move(s);
+        _vectors = std::move(v);
+    }
+};
+
+/**
+ * @brief Randomized principal component analysis of a data matrix (rows
+ * are observations).
+ *
+ * Runs PCA::fit(): a Gaussian sketch of k + oversampling columns, refined
+ * by power iterations, reduces the problem to a small dense decomposition.
+ * Every pass over the data is one GEMM with a thin block, so the cost is
+ * O(m d (k + p) (2 q + 2)) for q power iterations and the covariance is
+ * never formed. The sketch uses a fixed seed, so results are reproducible.
+ *
+ * More information:
+ * https://en.wikipedia.org/wiki/Principal_component_analysis
+ *
+ * @tparam T The numeric type of the data; integers are analysed in double.
+ * @param data The m x d data matrix (a Matrix, view or expression).
+ * @param k The number of components.
+ * @param power_iterations Passes that sharpen the sketch; 1-3 is typical.
+ * @param oversampling Extra sketch columns beyond k.
+ * @return The fitted PCA model.
+ *
+ * @throws std::invalid_argument if k is zero or exceeds the number of rows
+ * or features.
+ *
+ * @version 1.0 (Randomized)
+ * @since 2025
+ */
+template <typename ResultType = void, MatrixOperand E>
+[[nodiscard]] auto pca(const E& data,
+                       size_t k,
+                       size_t power_iterations = 2,
+                       size_t oversampling = detail::SKETCH_OVERSAMPLING) {
+    using T = typename E::value_type;
+    using TargetType =
+        std::conditional_t<std::is_same_v<ResultType, void>,
+                           std::conditional_t<std::is_floating_point_v<T>, T, double>,
+                           ResultType>;
+
+    static_assert(std::is_floating_point_v<TargetType>,
+                  "PCA result type must be floating point!");
+
+    PCA<TargetType> model(data.column_count(), k);
+    model.fit(data, power_iterations, oversampling);
+    return model;
+}
+
+}  // namespace maf::math
+
+#endif  // PCA_H
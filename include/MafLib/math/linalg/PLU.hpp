@@ -6,142 +6,222 @@
 
 namespace maf::math {
 namespace detail {
+/** @brief Width below which the recursive LU and its TRSM stop splitting. */
+constexpr static size_t GETRF_LEAF = 16;
+
 /**
- * @brief Internal implementation of PLU decomposition.
- *
- * Computes L and U where P * A = L * U for square matrix A.
- * Uses blocked algorithm with OpenMP parallelization.
+ * @brief Solves L X = B in place, L being the m x m unit lower triangle at
+ * `l` and B the m x w block at `b`, both with rows lda apart.
+ * @details Recursive on the rows of L: the top half is solved, the bottom
+ * half of B is updated with one GEMM, B_2 -= L_21 * X_1, then solved.
  */
 template <std::floating_point T>
-[[nodiscard]] std::tuple<std::vector<uint32>, Matrix<T>, Matrix<T>> _plu(
-    Matrix<T>&& _U) {
-    if (!_U.is_square()) {
-        throw std::invalid_argument("Matrix must be square for PLU decomposition!");
-    }
+void _trsm_unit_lower(size_t m, size_t w, const T* l, T* b, size_t lda) {
+    // Columns of B solved together by one thread
+    constexpr size_t columns = 256;
 
-    const size_t n = _U.row_count();
-    if (n == 0) {
-        return {std::vector<uint32>(), Matrix<T>(), Matrix<T>()};
-    }
+    if (m <= GETRF_LEAF) {
+        #pragma omp parallel for if (w * m > OMP_LINEAR_LIMIT && !omp_in_parallel())
+        for (size_t jb = 0; jb < w; jb += columns) {
+            const size_t len = std::min(columns, w - jb);
+            for (size_t i = 1; i < m; ++i) {
+                T* row_i = b + (i * lda) + jb;
+                for (size_t k = 0; k < i; ++k) {
+                    const T mult = l[(i * lda) + k];
+                    const T* row_k = b + (k * lda) + jb;
 
-    std::vector<uint32> P(n);
-    // TODO: Change this to ranges::iota when Apple Clang fully supports c++23
-    std::iota(P.begin(), P.end(), 0);
-    Matrix<T> L = identity_matrix<T>(n);
-
-    // Conceptual block matrix:
-    // A = [A_11, A_12]
-    //     [A_21, A_22]
-
-    for (size_t ib = 0; ib < n; ib += BLOCK_SIZE) {
-        const size_t block_end = std::min(ib + BLOCK_SIZE, n);
-        // Panel Factorization
-        // This computes L_11, L_21, U_11 and updates P
-        for (size_t i = ib; i < block_end && i < n - 1; ++i) {
-            // Find Pivot
-            size_t pivot_row = i;
-            T max_val = std::abs(_U.at(i, i));
-
-            for (size_t j = i + 1; j < n; ++j) {
-                T curr_val = std::abs(_U.at(j, i));
-                if (curr_val > max_val) {
-                    max_val = curr_val;
-                    pivot_row = j;
+                    #pragma omp simd
+                    for (size_t j = 0; j < len; ++j) {
+                        row_i[j] -= mult * row_k[j];
+                    }
                 }
             }
+        }
+        return;
+    }
 
-            if (is_close(max_val, static_cast<T>(0), 1e-9)) {
-                throw std::runtime_error("Matrix is singular; pivot is near zero.");
-            }
-
-            if (pivot_row != i) {
-                // Swap permutation vector
-                std::swap(P[i], P[pivot_row]);
-
-                // Swap entire rows in our working matrix
-                auto row_i = _U.row_span(i);
-                auto row_p = _U.row_span(pivot_row);
-                std::ranges::swap_ranges(row_i, row_p);
+    const size_t m1 = m / 2;
+    _trsm_unit_lower(m1, w, l, b, lda);
+    _gemm<T>(m - m1,
+             w,
+             m1,
+             T(-1),
+             l + (m1 * lda),
+             lda,
+             1,
+             b,
+             lda,
+             1,
+             T(1),
+             b + (m1 * lda),
+             lda,
+             1);
+    _trsm_unit_lower(m - m1, w, l + (m1 * lda) + m1, b + (m1 * lda), lda);
+}
 
-                // Swap the already computed part of L
-                if (i > 0) {
-                    auto l_row_i = L.row_span(i).subspan(0, i);
-                    auto l_row_p = L.row_span(pivot_row).subspan(0, i);
-                    std::ranges::swap_ranges(l_row_i, l_row_p);
-                }
-            }
+/**
+ * @brief Recursive LU of the panel of columns [j, j + w) and rows [j, n) of
+ * the n x n matrix at `a`.
+ *
+ * The left half of the panel is factored, its U part solved into the right
+ * half with _trsm_unit_lower(), the rest of the right half updated with one
+ * GEMM, A_22 -= L_21 * U_12, and the right half factored the same way.
+ * Below GETRF_LEAF columns the panel is factored column by column. Pivot
+ * rows are swapped over their full length, so columns outside the panel see
+ * the interchanges as well.
+ */
+template <std::floating_point T>
+void _getrf_recursive(size_t n, size_t j, size_t w, T* a, size_t lda, uint32* ipiv) {
+    if (w > GETRF_LEAF) {
+        const size_t w1 = w / 2;
+        const size_t w2 = w - w1;
+        _getrf_recursive(n, j, w1, a, lda, ipiv);
 
-            // Elimination within panel
-            const T pivot = _U.at(i, i);
-            const T inv_pivot = T(1) / pivot;
+        T* a_11 = a + (j * lda) + j;
+        _trsm_unit_lower(w1, w2, a_11, a_11 + w1, lda);
+        _gemm<T>(n - j - w1,
+                 w2,
+                 w1,
+                 T(-1),
+                 a_11 + (w1 * lda),
+                 lda,
+                 1,
+                 a_11 + w1,
+                 lda,
+                 1,
+                 T(1),
+                 a_11 + (w1 * lda) + w1,
+                 lda,
+                 1);
 
-            #pragma omp parallel for if (n - (i + 1) > 256)
-            for (size_t j = i + 1; j < n; ++j) {
-                T mult = _U.at(j, i) * inv_pivot;
-                L.at(j, i) = mult;
+        _getrf_recursive(n, j + w1, w2, a, lda, ipiv);
+        return;
+    }
 
-                #pragma omp simd
-                for (size_t k = i + 1; k < block_end; ++k) {
-                    _U.at(j, k) -= mult * _U.at(i, k);
-                }
+    const size_t panel_end = j + w;
+    for (size_t i = j; i < panel_end; ++i) {
+        size_t pivot_row = i;
+        T max_val = std::abs(a[(i * lda) + i]);
+        for (size_t r = i + 1; r < n; ++r) {
+            const T curr_val = std::abs(a[(r * lda) + i]);
+            if (curr_val > max_val) {
+                max_val = curr_val;
+                pivot_row = r;
             }
         }
+        if (is_close(max_val, static_cast<T>(0), 1e-9)) {
+            throw std::runtime_error("Matrix is singular; pivot is near zero.");
+        }
 
-        // Update Trailing Matrix
-        if (block_end < n) {
-            // Triangular Solve for U_12
-            // We must solve L_11 * U_12 = A_12
-            #pragma omp parallel for if (n - block_end > 128)
-            for (size_t j = block_end; j < n; ++j) {
-                for (size_t i = ib; i < block_end; ++i) {
-                    T sum = _U.at(i, j);
-
-                    // Can't be SIMD because of column fetching
-                    for (size_t k = ib; k < i; ++k) {
-                        sum -= L.at(i, k) * _U.at(k, j);
-                    }
-                    _U.at(i, j) = sum;
-                }
-            }
+        ipiv[i] = static_cast<uint32>(pivot_row);
+        if (pivot_row != i) {
+            std::swap_ranges(a + (i * lda), a + (i * lda) + n, a + (pivot_row * lda));
+        }
 
-            // Now we can apply all the elimination effects on the next block
-            #pragma omp parallel for if (n - block_end >128)
-            for (size_t i = block_end; i < n; ++i) {
-                auto target_row = _U.row_span(i).subspan(block_end);
-                const size_t len = target_row.size();
-                for (size_t k = ib; k < block_end; ++k) {
-                    const T mult = L.at(i, k);
-                    if (is_close(mult, static_cast<T>(0), static_cast<T>(1e-9))) {
-                        continue;
-                    }
-                    auto pivot_row = _U.row_span(k).subspan(block_end);
+        const T inv_pivot = T(1) / a[(i * lda) + i];
+        const T* pivot_row_ptr = a + (i * lda);
 
-                    #pragma omp simd
-                    for (size_t j = 0; j < len; ++j) {
-                        target_row[j] -= mult * pivot_row[j];
-                    }
-                }
+        #pragma omp parallel for if (n - (i + 1) > 256)
+        for (size_t r = i + 1; r < n; ++r) {
+            T* row = a + (r * lda);
+            const T mult = row[i] * inv_pivot;
+            row[i] = mult;
+
+            #pragma omp simd
+            for (size_t k = i + 1; k < panel_end; ++k) {
+                row[k] -= mult * pivot_row_ptr[k];
             }
         }
     }
-    if (is_close(_U.at(n - 1, n - 1), static_cast<T>(0), 1e-9)) {
-        throw std::runtime_error("Matrix is singular; pivot is near zero.");
+}
+
+/**
+ * @brief Recursive in-place LU factorization with partial pivoting.
+ *
+ * Overwrites the row-major n x n matrix at `a` with L and U packed together
+ * (the unit diagonal of L is implied) and writes the row interchanges to
+ * `ipiv`: at step i row i was swapped with row ipiv[i] >= i. Whole rows are
+ * swapped, so the stored L is already in pivoted order.
+ *
+ * The matrix is split into column halves recursively (see
+ * _getrf_recursive()), so apart from the narrow leaf panels every update,
+ * the triangular solves included, is a GEMM through the packed kernel.
+ */
+template <std::floating_point T>
+void _getrf(size_t n, T* a, size_t lda, uint32* ipiv) {
+    if (n > 0) {
+        _getrf_recursive(n, 0, n, a, lda, ipiv);
+    }
+}
+
+/**
+ * @brief Converts LAPACK-style row interchanges into the final permutation.
+ * @details Row i of P * A is row result[i] of A.
+ */
+[[nodiscard]] inline std::vector<uint32> _ipiv_to_permutation(
+    const std::vector<uint32>& ipiv) {
+    std::vector<uint32> permutation(ipiv.size());
+    // TODO: Change this to ranges::iota when Apple Clang fully supports c++23
+    std::iota(permutation.begin(), permutation.end(), 0);
+    for (size_t i = 0; i < ipiv.size(); ++i) {
+        std::swap(permutation[i], permutation[ipiv[i]]);
     }
+    return permutation;
+}
 
-    // Extract U
-    Matrix<T> U(n, n);
+/**
+ * @brief Internal implementation of PLU decomposition.
+ *
+ * Computes L and U where P * A = L * U for square matrix A by factoring the
+ * working matrix in place, then moving the strict lower part into L. The
+ * working matrix becomes U, so only L is allocated on top of it.
+ */
+template <std::floating_point T>
+[[nodiscard]] std::tuple<std::vector<uint32>, Matrix<T>, Matrix<T>> _plu(
+    Matrix<T>&& U) {
+    const std::vector<uint32> ipiv = getrf(U);
+    const size_t n = U.row_count();
+
+    Matrix<T> L(n, n);
     #pragma omp parallel for schedule(static) if (n > 256)
     for (size_t i = 0; i < n; ++i) {
-        T* u_row = &U.at(i, i);
-        const T* a_row = &_U.at(i, i);
-        const size_t len = n - i;
-        std::copy_n(a_row, len, u_row);
+        auto u_row = U.row_span(i);
+        auto l_row = L.row_span(i);
+        std::copy_n(u_row.begin(), i, l_row.begin());
+        std::fill_n(u_row.begin(), i, T(0));
+        l_row[i] = T(1);
     }
 
-    return std::make_tuple(std::move(P), std::move(L), std::move(U));
+    return std::make_tuple(_ipiv_to_permutation(ipiv), std::move(L), std::move(U));
 }
 
 }  // namespace detail
+/**
+ * @brief Factors a square matrix in place as P * A = L * U (LAPACK getrf).
+ *
+ * On return the matrix holds U on and above the diagonal and the multipliers
+ * of L below it; the unit diagonal of L is not stored. No other n x n buffer
+ * is allocated, so this is the entry point for large systems, where plu()
+ * would need about three times the memory.
+ *
+ * @param matrix The square matrix to overwrite with the packed factors.
+ * @return The row interchanges (ipiv): at step i row i was swapped with row
+ * ipiv[i].
+ *
+ * @throws std::invalid_argument if the matrix is not square.
+ * @throws std::runtime_error if a pivot is near zero.
+ */
+template <std::floating_point T>
+std::vector<uint32> getrf(Matrix<T>& matrix) {
+    if (!matrix.is_square()) {
+        throw std::invalid_argument("Matrix must be square for PLU decomposition!");
+    }
+    const size_t n = matrix.row_count();
+    std::vector<uint32> ipiv(n);
+    detail::_getrf(n, matrix.data().data(), matrix.leading_dimension(), ipiv.data());
+    return ipiv;
+}
+
 /**
  * @brief Performs a blocked PLU decomposition on a square matrix.
  *
@@ -151,8 +231,9 @@ template <std::floating_point T>
  * - L is a unit lower triangular matrix
  * - U is an upper triangular matrix
  *
- * The decomposition is computed using a right-looking blocked algorithm for
- * improved cache performance. It employs partial pivoting (row swapping) to
+ * The decomposition is computed using a recursive algorithm that splits the
+ * columns in halves, so the bulk of the work runs as GEMM trailing updates
+ * through the packed kernel. It employs partial pivoting (row swapping) to
  * ensure numerical stability. The implementation is parallelized using OpenMP
  * for further performance gains on multi-core systems.
  *
@@ -170,7 +251,7 @@ template <std::floating_point T>
  *
  * @throws std::invalid_argument if the input matrix is not square.
  *
- * @version 1.0 (Blocked & Parallelized)
+ * @version 2.0 (Recursive & Parallelized)
  * @since 2025
  */
 
@@ -191,6 +272,25 @@ template <typename ResultType = void, Numeric T>
     }
 }
 
+/**
+ * @brief Performs a PLU decomposition of a view or lazy matrix expression.
+ * @details The operand is copied (and converted) once into the working
+ * matrix of the factorization, then decomposed as above.
+ */
+template <typename ResultType = void, MatrixExpression E>
+[[nodiscard]] auto plu(const E& expr) {
+    using T = typename E::value_type;
+    using TargetType =
+        std::conditional_t<std::is_same_v<ResultType, void>,
+                           std::conditional_t<std::is_floating_point_v<T>, T, double>,
+                           ResultType>;
+
+    static_assert(std::is_floating_point_v<TargetType>,
+                  "PLU result type must be floating point!");
+
+    return detail::_plu(Matrix<TargetType>(expr));
+}
+
 }  // namespace maf::math
 
 #endif  // PLU_H
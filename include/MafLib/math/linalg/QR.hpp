@@ -1,18 +1,605 @@
-#include "MafLib/main/GlobalHeader.hpp"
-#include "Matrix.hpp"
+#ifndef QR_H
+#define QR_H
+
 #pragma once
+#include "Matrix.hpp"
 
 namespace maf::math {
+namespace detail {
+/**
+ * @brief Generates the Householder reflector H = I - tau v v^T with
+ * H x = (beta, 0, ..., 0)^T for the m elements of x, inc apart (LAPACK
+ * larfg).
+ * @details On return x holds beta followed by v without its implied
+ * leading one. A zero tau (H = I) is returned when x is already reduced.
+ */
+template <std::floating_point T>
+[[nodiscard]] T _larfg(size_t m, T* x, size_t inc) {
+    T tail = 0;
+    for (size_t i = 1; i < m; ++i) {
+        tail += x[i * inc] * x[i * inc];
+    }
+    if (tail == T(0)) {
+        return T(0);
+    }
 
-template <typename T>
-[[nodiscard]] std::pair<Matrix<T>, Matrix<T>>
-QR_decompostion(const Matrix<T> &matrix) {
-    if (!matrix.is_symmetric()) {
-        throw std::invalid_argument(
-            "Matrix must be symmetric to try QR decomposition!");
+    const T alpha = x[0];
+    const T beta = -std::copysign(std::sqrt((alpha * alpha) + tail), alpha);
+    const T scale = T(1) / (alpha - beta);
+    for (size_t i = 1; i < m; ++i) {
+        x[i * inc] *= scale;
+    }
+    x[0] = beta;
+    return (beta - alpha) / beta;
+}
+
+/**
+ * @brief Unblocked Householder QR of the row-major m x n matrix at `a`
+ * (LAPACK geqr2).
+ * @details Reflector j is generated from column j and applied to the
+ * columns right of it, one rank-1 update per reflector. On return R is on
+ * and above the diagonal and the reflectors v_j below it.
+ */
+template <std::floating_point T>
+void _geqr2(size_t m, size_t n, T* a, size_t lda, T* tau) {
+    const size_t k = std::min(m, n);
+    std::vector<T> w(n);
+
+    for (size_t j = 0; j < k; ++j) {
+        T* a_jj = a + (j * lda) + j;
+        tau[j] = _larfg(m - j, a_jj, lda);
+        const size_t width = n - j - 1;
+        if (tau[j] == T(0) || width == 0) {
+            continue;
+        }
+
+        // w = A^T v, accumulated row by row, then A -= tau v w^T
+        T* row_j = a_jj + 1;
+        std::copy_n(row_j, width, w.begin());
+        for (size_t i = 1; i < m - j; ++i) {
+            const T v = a_jj[i * lda];
+            const T* row = row_j + (i * lda);
+            #pragma omp simd
+            for (size_t c = 0; c < width; ++c) {
+                w[c] += v * row[c];
+            }
+        }
+        #pragma omp simd
+        for (size_t c = 0; c < width; ++c) {
+            row_j[c] -= tau[j] * w[c];
+        }
+        for (size_t i = 1; i < m - j; ++i) {
+            const T scale = tau[j] * a_jj[i * lda];
+            T* row = row_j + (i * lda);
+            #pragma omp simd
+            for (size_t c = 0; c < width; ++c) {
+                row[c] -= scale * w[c];
+            }
+        }
+    }
+}
+
+/**
+ * @brief Compact WY form H_1 ... H_k = I - V T V^T of k consecutive
+ * reflectors stored below the diagonal of the m x k panel at `a`.
+ * @details V (m x k, unit lower trapezoidal) is copied out of the panel into
+ * `v`, and the upper triangular T (k x k) is built in `t` from the Gram
+ * matrix V^T V, one GEMM (LAPACK larft, forward columnwise).
+ */
+template <std::floating_point T>
+void _larft(size_t m, size_t k, const T* a, size_t lda, const T* tau, T* v, T* t) {
+    for (size_t i = 0; i < m; ++i) {
+        const T* row = a + (i * lda);
+        T* v_row = v + (i * k);
+        for (size_t c = 0; c < k; ++c) {
+            v_row[c] = c < i ? row[c] : (c == i ? T(1) : T(0));
+        }
+    }
+
+    std::vector<T> gram(k * k);
+    _gemm<T>(k, k, m, T(1), v, 1, k, v, k, 1, T(0), gram.data(), k, 1);
+
+    // T(0:i, i) = -tau_i T(0:i, 0:i) V(:, 0:i)^T v_i
+    std::fill_n(t, k * k, T(0));
+    for (size_t i = 0; i < k; ++i) {
+        for (size_t r = 0; r < i; ++r) {
+            T sum = 0;
+            for (size_t c = r; c < i; ++c) {
+                sum += t[(r * k) + c] * gram[(c * k) + i];
+            }
+            t[(r * k) + i] = -tau[i] * sum;
+        }
+        t[(i * k) + i] = tau[i];
+    }
+}
+
+/**
+ * @brief Applies I - V T V^T (or its transpose) from the left to the m x p
+ * matrix at `c` (LAPACK larfb).
+ * @details Three GEMMs: W = V^T C, W = op(T) W and C -= V W.
+ */
+template <std::floating_point T>
+void _larfb(size_t m,
+            size_t k,
+            const T* v,
+            const T* t,
+            bool transpose,
+            size_t p,
+            T* c,
+            size_t ldc) {
+    std::vector<T> w(k * p);
+    std::vector<T> tw(k * p);
+    _gemm<T>(k, p, m, T(1), v, 1, k, c, ldc, 1, T(0), w.data(), p, 1);
+    _gemm<T>(k,
+             p,
+             k,
+             T(1),
+             t,
+             transpose ? 1 : k,
+             transpose ? k : 1,
+             w.data(),
+             p,
+             1,
+             T(0),
+             tw.data(),
+             p,
+             1);
+    _gemm<T>(m, p, k, T(-1), v, k, 1, tw.data(), p, 1, T(1), c, ldc, 1);
+}
+
+/**
+ * @brief Blocked Householder QR of the row-major m x n matrix at `a`
+ * (LAPACK geqrf).
+ *
+ * Panels of BLOCK_SIZE columns are factored with _geqr2(), and their
+ * reflectors are applied to the trailing columns at once in compact WY form
+ * with _larfb(), so most of the work runs in GEMM. The result has the
+ * layout of _geqr2().
+ */
+template <std::floating_point T>
+void _geqrf(size_t m, size_t n, T* a, size_t lda, T* tau) {
+    const size_t k = std::min(m, n);
+    std::vector<T> v(m * BLOCK_SIZE);
+    std::vector<T> t(BLOCK_SIZE * BLOCK_SIZE);
+
+    for (size_t j = 0; j < k; j += BLOCK_SIZE) {
+        const size_t jb = std::min<size_t>(BLOCK_SIZE, k - j);
+        T* panel = a + (j * lda) + j;
+        _geqr2(m - j, jb, panel, lda, tau + j);
+
+        if (j + jb < n) {
+            _larft(m - j, jb, panel, lda, tau + j, v.data(), t.data());
+            _larfb(m - j, jb, v.data(), t.data(), true, n - j - jb, panel + jb, lda);
+        }
+    }
+}
+
+/**
+ * @brief Applies Q (or Q^T) of a QR factorization from the left to the
+ * m x p matrix at `c` (LAPACK ormqr).
+ * @details `a` holds the k reflectors of the m-row factorization. Blocks of
+ * BLOCK_SIZE reflectors are applied in compact WY form: forward for Q^T,
+ * backward for Q = H_1 ... H_k.
+ */
+template <std::floating_point T>
+void _ormqr(size_t m,
+            size_t k,
+            const T* a,
+            size_t lda,
+            const T* tau,
+            bool transpose,
+            size_t p,
+            T* c,
+            size_t ldc) {
+    if (k == 0 || p == 0) {
+        return;
+    }
+    std::vector<T> v(m * BLOCK_SIZE);
+    std::vector<T> t(BLOCK_SIZE * BLOCK_SIZE);
+    const size_t blocks = (k + BLOCK_SIZE - 1) / BLOCK_SIZE;
+
+    for (size_t b = 0; b < blocks; ++b) {
+        const size_t j = (transpose ? b : blocks - 1 - b) * BLOCK_SIZE;
+        const size_t jb = std::min<size_t>(BLOCK_SIZE, k - j);
+        _larft(m - j, jb, a + (j * lda) + j, lda, tau + j, v.data(), t.data());
+        _larfb(m - j, jb, v.data(), t.data(), transpose, p, c + (j * ldc), ldc);
+    }
+}
+
+/**
+ * @brief Internal implementation of QR decomposition.
+ *
+ * Factors the working matrix in place with _geqrf(), then forms the thin Q
+ * by applying the reflectors to the leading columns of the identity and
+ * moves the upper trapezoid into R.
+ */
+template <std::floating_point T>
+[[nodiscard]] std::pair<Matrix<T>, Matrix<T>> _qr(Matrix<T>&& A) {
+    const std::vector<T> tau = geqrf(A);
+    const size_t m = A.row_count();
+    const size_t n = A.column_count();
+    const size_t k = tau.size();
+
+    Matrix<T> Q(m, k);
+    for (size_t i = 0; i < k; ++i) {
+        Q.at(i, i) = T(1);
+    }
+    _ormqr(m,
+           k,
+           A.data().data(),
+           A.leading_dimension(),
+           tau.data(),
+           false,
+           k,
+           Q.data().data(),
+           Q.leading_dimension());
+
+    Matrix<T> R(k, n);
+    #pragma omp parallel for schedule(static) if (k * n > OMP_LINEAR_LIMIT)
+    for (size_t i = 0; i < k; ++i) {
+        auto a_row = A.row_span(i);
+        std::copy(a_row.begin() + i, a_row.end(), R.row_span(i).begin() + i);
     }
 
-    size_t n = matrix.row_count();
+    return std::make_pair(std::move(Q), std::move(R));
 }
 
-} // namespace maf::math
+/** @brief Rows one thread of a TSQR folds into its R factor at a time. */
+constexpr static size_t TSQR_CHUNK = 1024;
+
+/**
+ * @brief Replaces the w x w upper triangle `r` by the R factor of
+ * [r; C], C being the `rows` x w rows at `c` (rows w apart).
+ * @details `work` is scratch of at least (w + rows) * w elements.
+ */
+template <std::floating_point T>
+void _tsqr_fold(size_t w, T* r, size_t rows, const T* c, T* work) {
+    std::copy_n(r, w * w, work);
+    std::copy_n(c, rows * w, work + (w * w));
+    std::vector<T> tau(w);
+    _geqrf(w + rows, w, work, w, tau.data());
+    for (size_t i = 0; i < w; ++i) {
+        std::fill_n(r + (i * w), i, T(0));
+        std::copy(work + (i * w) + i, work + ((i + 1) * w), r + (i * w) + i);
+    }
+}
+
+/**
+ * @brief Communication-avoiding QR of a tall m x w matrix, returning only
+ * its w x w R factor (row-major).
+ *
+ * The rows are split into one contiguous block per thread. Each thread
+ * streams its block in chunks of TSQR_CHUNK rows, written by
+ * `fill(first, count, dst)` into a chunk buffer, and folds every chunk into
+ * its own R with _tsqr_fold(). The per-thread factors are then merged
+ * pairwise in a binary reduction tree. Only one chunk per thread is ever
+ * materialized.
+ */
+template <std::floating_point T, typename Fill>
+[[nodiscard]] std::vector<T> _tsqr(size_t m, size_t w, Fill&& fill) {
+    const size_t chunk = std::max(TSQR_CHUNK, w);
+    const size_t threads =
+        omp_in_parallel() ? 1 : static_cast<size_t>(omp_get_max_threads());
+    const size_t blocks = std::clamp<size_t>((m + chunk - 1) / chunk, 1, threads);
+    std::vector<std::vector<T>> r(blocks, std::vector<T>(w * w, T(0)));
+
+    #pragma omp parallel for schedule(static) if (blocks > 1)
+    for (size_t b = 0; b < blocks; ++b) {
+        const size_t first = b * m / blocks;
+        const size_t last = (b + 1) * m / blocks;
+        std::vector<T> rows(chunk * w);
+        std::vector<T> work((w + chunk) * w);
+        for (size_t i = first; i < last; i += chunk) {
+            const size_t count = std::min(chunk, last - i);
+            fill(i, count, rows.data());
+            _tsqr_fold(w, r[b].data(), count, rows.data(), work.data());
+        }
+    }
+
+    // Tree reduction: R_b = qr([R_b; R_(b + stride)])
+    std::vector<T> work(2 * w * w);
+    for (size_t stride = 1; stride < blocks; stride *= 2) {
+        #pragma omp parallel for firstprivate(work) if (blocks > 2 * stride)
+        for (size_t b = 0; b < blocks - stride; b += 2 * stride) {
+            _tsqr_fold(w, r[b].data(), w, r[b + stride].data(), work.data());
+        }
+    }
+    return std::move(r[0]);
+}
+
+/**
+ * @brief Least squares solution from the R factor of the augmented
+ * matrix [A b]: solves R_11 x = r_12 by back substitution, R_11 being the
+ * leading n x n block of the (n + 1) x (n + 1) triangle at `r`.
+ * @throws std::runtime_error if A is rank deficient.
+ */
+template <std::floating_point T>
+[[nodiscard]] Vector<T> _tsqr_solve(size_t n, const std::vector<T>& r) {
+    const size_t w = n + 1;
+    Vector<T> x(n);
+    for (size_t i = n; i-- > 0;) {
+        const T pivot = r[(i * w) + i];
+        if (is_close(pivot, static_cast<T>(0), 1e-9)) {
+            throw std::runtime_error("Matrix is rank deficient.");
+        }
+        T sum = r[(i * w) + n];
+        for (size_t j = i + 1; j < n; ++j) {
+            sum -= r[(i * w) + j] * x[j];
+        }
+        x[i] = sum / pivot;
+    }
+    return x;
+}
+
+/**
+ * @brief The rows [first, first + count) of an operand, converted to T,
+ * followed by the matching entries of `rhs` (if any) as an extra column.
+ */
+template <std::floating_point T, MatrixOperand E, typename Rhs>
+void _tsqr_rows(const E& a, const Rhs* rhs, size_t first, size_t count, T* dst) {
+    const size_t n = a.column_count();
+    const size_t w = rhs == nullptr ? n : n + 1;
+    for (size_t i = 0; i < count; ++i) {
+        T* row = dst + (i * w);
+        for (size_t j = 0; j < n; ++j) {
+            row[j] = static_cast<T>(a(first + i, j));
+        }
+        if (rhs != nullptr) {
+            row[n] = static_cast<T>((*rhs)[first + i]);
+        }
+    }
+}
+
+}  // namespace detail
+
+/**
+ * @brief Factors an m x n matrix in place as A = Q R (LAPACK geqrf).
+ *
+ * On return the matrix holds R on and above the diagonal and the Householder
+ * vectors below it (their leading ones are not stored). Q = H_1 ... H_k,
+ * H_j = I - tau[j] v_j v_j^T, is kept implicit; apply it with
+ * QRFactorization or form it with qr().
+ *
+ * @param matrix The matrix to overwrite with the packed factors.
+ * @return The min(m, n) reflector scalars tau.
+ */
+template <std::floating_point T>
+std::vector<T> geqrf(Matrix<T>& matrix) {
+    const size_t m = matrix.row_count();
+    const size_t n = matrix.column_count();
+    std::vector<T> tau(std::min(m, n));
+    detail::_geqrf(m, n, matrix.data().data(), matrix.leading_dimension(), tau.data());
+    return tau;
+}
+
+/**
+ * @brief Performs a blocked Householder QR decomposition.
+ *
+ * This function computes the thin QR factorization A = QR of an m x n
+ * matrix A, where, with k = min(m, n):
+ * - Q is an m x k matrix with orthonormal columns
+ * - R is a k x n upper trapezoidal (for m >= n, upper triangular) matrix
+ *
+ * Panels of columns are reduced with Householder reflectors, and each panel
+ * is applied to the rest of the matrix in the compact WY form
+ * I - V T V^T, so that most of the work runs in GEMM.
+ *
+ * More information:
+ * https://en.wikipedia.org/wiki/QR_decomposition#Using_Householder_reflections
+ *
+ * @tparam T The floating point type of the matrix elements (e.g., float,
+ * double).
+ * @param matrix The const reference to the input matrix (A) to decompose.
+ * @return A std::pair containing:
+ * 1. (Matrix<T>) The matrix Q with orthonormal columns.
+ * 2. (Matrix<T>) The upper trapezoidal matrix R.
+ *
+ * @version 1.0 (Blocked compact WY)
+ * @since 2025
+ */
+template <typename ResultType = void, Numeric T>
+[[nodiscard]] auto qr(const Matrix<T>& matrix) {
+    using TargetType =
+        std::conditional_t<std::is_same_v<ResultType, void>,
+                           std::conditional_t<std::is_floating_point_v<T>, T, double>,
+                           ResultType>;
+
+    static_assert(std::is_floating_point_v<TargetType>,
+                  "QR result type must be floating point!");
+
+    if constexpr (std::is_same_v<TargetType, T>) {
+        return detail::_qr(Matrix<TargetType>(matrix));
+    } else {
+        return detail::_qr(matrix.template cast<TargetType>());
+    }
+}
+
+/**
+ * @brief Performs a QR decomposition of a view or lazy matrix expression.
+ * @details The operand is copied (and converted) once into the working
+ * matrix of the factorization, then decomposed as above.
+ */
+template <typename ResultType = void, MatrixExpression E>
+[[nodiscard]] auto qr(const E& expr) {
+    using T = typename E::value_type;
+    using TargetType =
+        std::conditional_t<std::is_same_v<ResultType, void>,
+                           std::conditional_t<std::is_floating_point_v<T>, T, double>,
+                           ResultType>;
+
+    static_assert(std::is_floating_point_v<TargetType>,
+                  "QR result type must be floating point!");
+
+    return detail::_qr(Matrix<TargetType>(expr));
+}
+
+/**
+ * @brief R factor of a tall-skinny matrix by communication-avoiding QR
+ * (TSQR).
+ *
+ * Every thread factors its own contiguous block of rows, streamed through
+ * a small chunk buffer, and the per-thread R factors are merged in a binary
+ * reduction tree. Threads share nothing until the merge, so for m >> n the
+ * work scales with the number of cores, unlike the column-oriented geqrf().
+ * Views and lazy expressions are read row by row and never copied whole.
+ *
+ * More information:
+ * https://en.wikipedia.org/wiki/QR_decomposition (see "TSQR")
+ *
+ * @param matrix The m x n matrix to factor, m >= n.
+ * @return The n x n upper triangular R with A = Q R (Q is not formed).
+ *
+ * @throws std::invalid_argument if the matrix has fewer rows than columns.
+ */
+template <typename ResultType = void, MatrixOperand E>
+[[nodiscard]] auto tsqr(const E& matrix) {
+    using T = typename E::value_type;
+    using TargetType =
+        std::conditional_t<std::is_same_v<ResultType, void>,
+                           std::conditional_t<std::is_floating_point_v<T>, T, double>,
+                           ResultType>;
+
+    static_assert(std::is_floating_point_v<TargetType>,
+                  "TSQR result type must be floating point!");
+
+    const size_t m = matrix.row_count();
+    const size_t n = matrix.column_count();
+    if (m < n) {
+        throw std::invalid_argument("TSQR needs at least as many rows as columns!");
+    }
+    const auto r = detail::_tsqr<TargetType>(
+        m, n, [&](size_t first, size_t count, TargetType* dst) {
+            detail::_tsqr_rows<TargetType>(
+                matrix, static_cast<const Vector<T>*>(nullptr), first, count, dst);
+        });
+    return Matrix<TargetType>(n, n, r);
+}
+
+/**
+ * @brief Least squares solution of A x = b, minimizing ||A x - b||_2.
+ *
+ * The augmented matrix [A b] is reduced with TSQR (see tsqr()), which leaves
+ * Q^T b in its last column, so Q is never formed and A and b are read only
+ * once, block by block across the threads.
+ *
+ * @param a The m x n design matrix, m >= n.
+ * @param b The m observations.
+ * @return The n coefficients x.
+ *
+ * @throws std::invalid_argument if A has fewer rows than columns or the
+ * size of b does not match.
+ * @throws std::runtime_error if A is rank deficient.
+ */
+template <typename ResultType = void, MatrixOperand E, Numeric U>
+[[nodiscard]] auto lstsq(const E& a, const Vector<U>& b) {
+    using T = typename E::value_type;
+    using TargetType =
+        std::conditional_t<std::is_same_v<ResultType, void>,
+                           std::conditional_t<std::is_floating_point_v<T>, T, double>,
+                           ResultType>;
+
+    static_assert(std::is_floating_point_v<TargetType>,
+                  "Least squares result type must be floating point!");
+
+    const size_t m = a.row_count();
+    const size_t n = a.column_count();
+    if (m < n) {
+        throw std::invalid_argument(
+            "Least squares needs at least as many rows as columns!");
+    }
+    if (b.size() != m) {
+        throw std::invalid_argument("Right-hand side size does not match!");
+    }
+    const auto r = detail::_tsqr<TargetType>(
+        m, n + 1, [&](size_t first, size_t count, TargetType* dst) {
+            detail::_tsqr_rows<TargetType>(a, &b, first, count, dst);
+        });
+    return detail::_tsqr_solve(n, r);
+}
+
+/**
+ * @brief Streaming TSQR: row blocks of a tall matrix are folded into its R
+ * factor as they arrive, so the matrix never has to be resident at once.
+ *
+ * Each add_rows() factors its block in parallel with the TSQR of tsqr() and
+ * merges the result into the running R. For a streamed least squares
+ * problem add the rows of the augmented matrix [A b] and call solve().
+ *
+ * @tparam T Floating point type of the R factor.
+ */
+template <std::floating_point T>
+class TallSkinnyQR {
+public:
+    /**
+     * @brief Creates an empty factorization of a matrix with `columns`
+     * columns.
+     * @throws std::invalid_argument if columns is zero.
+     */
+    explicit TallSkinnyQR(size_t columns) : _columns(columns), _r(columns * columns) {
+        if (columns == 0) {
+            throw std::invalid_argument("Matrix dimensions must be greater than zero.");
+        }
+    }
+
+    // --- Getters ---
+
+    /** @brief Rows added so far. */
+    [[nodiscard]] size_t row_count() const noexcept {
+        return _rows;
+    }
+
+    [[nodiscard]] size_t column_count() const noexcept {
+        return _columns;
+    }
+
+    // --- Methods ---
+
+    /**
+     * @brief Folds a block of rows (a matrix, view or expression) into R.
+     * @throws std::invalid_argument if the column count does not match.
+     */
+    template <MatrixOperand E>
+    void add_rows(const E& block) {
+        if (block.column_count() != _columns) {
+            throw std::invalid_argument("Row block column count does not match!");
+        }
+        const auto r = detail::_tsqr<T>(
+            block.row_count(), _columns, [&](size_t first, size_t count, T* dst) {
+                detail::_tsqr_rows<T>(
+                    block, static_cast<const Vector<T>*>(nullptr), first, count, dst);
+            });
+        std::vector<T> work(2 * _columns * _columns);
+        detail::_tsqr_fold(_columns, _r.data(), _columns, r.data(), work.data());
+        _rows += block.row_count();
+    }
+
+    /** @brief The upper triangular R of all rows added so far. */
+    [[nodiscard]] Matrix<T> r() const {
+        return Matrix<T>(_columns, _columns, _r);
+    }
+
+    /**
+     * @brief Least squares solution when the rows added were those of the
+     * augmented matrix [A b]: minimizes ||A x - b||_2 over the first
+     * column_count() - 1 columns.
+     * @throws std::invalid_argument if there are fewer than two columns or
+     * fewer rows than columns of A.
+     * @throws std::runtime_error if A is rank deficient.
+     */
+    [[nodiscard]] Vector<T> solve() const {
+        if (_columns < 2 || _rows < _columns - 1) {
+            throw std::invalid_argument(
+                "Least squares needs at least as many rows as columns!");
+        }
+        return detail::_tsqr_solve(_columns - 1, _r);
+    }
+
+private:
+    size_t _columns;
+    size_t _rows = 0;
+    std::vector<T> _r;
+};
+
+}  // namespace maf::math
+
+#endif  // QR_H
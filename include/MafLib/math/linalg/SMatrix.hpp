@@ -0,0 +1,521 @@
+#ifndef SMATRIX_H
+#define SMATRIX_H
+#pragma once
+#include "LinAlg.hpp"
+#include "SVector.hpp"
+
+namespace maf::math {
+/**
+ * @brief A row-major matrix whose dimensions are fixed at compile time.
+ *
+ * SMatrix stores its R * C elements inline, so small matrices (3x3
+ * covariance blocks, 6x6 state transitions, ...) live on the stack and never
+ * touch the allocator. Every kernel - multiplication, transpose,
+ * determinant, inverse and Cholesky - has compile-time trip counts and is
+ * unrolled, and none of them has OpenMP regions or runtime size checks.
+ * Construction and most operations are constexpr.
+ *
+ * Interoperation with the dynamic types:
+ * - `SMatrix<T, R, C>(m)` copies a Matrix, view or expression of matching
+ *   shape, e.g. `SMatrix<double, 3, 3>(A.block(0, 0, 3, 3))`.
+ * - `view()` returns a (Const)MatrixView over the inline storage, so an
+ *   SMatrix can be used anywhere a matrix expression is accepted:
+ *   `A.block(0, 0, 3, 3) = s.view();` or `Matrix<double> m = s.view();`.
+ * - `to_matrix()` copies into a heap-allocated Matrix.
+ *
+ * @tparam T The numeric type of the elements.
+ * @tparam R The number of rows.
+ * @tparam C The number of columns.
+ */
+template <Numeric T, size_t R, size_t C>
+class SMatrix {
+    static_assert(R > 0 && C > 0, "SMatrix dimensions must be positive!");
+
+    /** @brief Type used by determinant, inverse and Cholesky. */
+    using _floating_t = std::conditional_t<std::is_floating_point_v<T>, T, double>;
+
+public:
+    /** @brief The numeric type of the matrix elements. */
+    using value_type = T;
+
+    // --- Constructors ---
+
+    /** @brief Creates a zero matrix. */
+    constexpr SMatrix() noexcept = default;
+
+    /**
+     * @brief Creates a matrix from exactly R * C values in row-major order.
+     * @details `SMatrix<double, 2, 2> m(1, 2, 3, 4);`
+     */
+    template <Numeric... U>
+        requires(sizeof...(U) == R * C)
+    constexpr SMatrix(U... values) noexcept : _data{static_cast<T>(values)...} {}
+
+    /** @brief Creates a matrix from a row-major std::array. */
+    constexpr explicit SMatrix(const std::array<T, R * C>& data) noexcept
+        : _data(data) {}
+
+    /**
+     * @brief Copies a Matrix, view or expression.
+     * @throws std::invalid_argument if the shape is not R x C.
+     */
+    template <MatrixOperand E>
+    explicit SMatrix(const E& matrix) {
+        if (matrix.row_count() != R || matrix.column_count() != C) {
+            throw std::invalid_argument("Matrix shape does not match SMatrix shape!");
+        }
+        for (size_t i = 0; i < R; ++i) {
+            for (size_t j = 0; j < C; ++j) {
+                (*this)(i, j) = static_cast<T>(matrix(i, j));
+            }
+        }
+    }
+
+    /** @brief Returns the identity matrix. */
+    [[nodiscard]] static constexpr SMatrix identity() noexcept
+        requires(R == C)
+    {
+        SMatrix result;
+        detail::_static_for<R>([&](size_t i) { result(i, i) = T(1); });
+        return result;
+    }
+
+    // --- Getters ---
+
+    [[nodiscard]] static constexpr size_t row_count() noexcept {
+        return R;
+    }
+
+    [[nodiscard]] static constexpr size_t column_count() noexcept {
+        return C;
+    }
+
+    [[nodiscard]] static constexpr size_t size() noexcept {
+        return R * C;
+    }
+
+    [[nodiscard]] constexpr T* data() noexcept {
+        return _data.data();
+    }
+
+    [[nodiscard]] constexpr const T* data() const noexcept {
+        return _data.data();
+    }
+
+    /** @brief Unchecked element access. */
+    [[nodiscard]] constexpr T& operator()(size_t row, size_t col) noexcept {
+        return _data[(row * C) + col];
+    }
+
+    /** @brief Unchecked element access. */
+    [[nodiscard]] constexpr const T& operator()(size_t row, size_t col) const noexcept {
+        return _data[(row * C) + col];
+    }
+
+    /** @throws std::out_of_range if the indices are invalid. */
+    [[nodiscard]] constexpr T& at(size_t row, size_t col) {
+        if (row >= R || col >= C) {
+            throw std::out_of_range("Index out of bounds.");
+        }
+        return (*this)(row, col);
+    }
+
+    /** @throws std::out_of_range if the indices are invalid. */
+    [[nodiscard]] constexpr const T& at(size_t row, size_t col) const {
+        if (row >= R || col >= C) {
+            throw std::out_of_range("Index out of bounds.");
+        }
+        return (*this)(row, col);
+    }
+
+    /** @brief Copies row `row`. */
+    [[nodiscard]] constexpr SVector<T, C> row(size_t row) const noexcept {
+        SVector<T, C> result;
+        detail::_static_for<C>([&](size_t j) { result[j] = (*this)(row, j); });
+        return result;
+    }
+
+    /** @brief Copies column `col`. */
+    [[nodiscard]] constexpr SVector<T, R> col(size_t col) const noexcept {
+        SVector<T, R> result;
+        detail::_static_for<R>([&](size_t i) { result[i] = (*this)(i, col); });
+        return result;
+    }
+
+    /** @brief Read-only view of the inline storage. */
+    [[nodiscard]] ConstMatrixView<T> view() const noexcept {
+        return ConstMatrixView<T>(_data.data(), R, C, C, 1);
+    }
+
+    /** @brief Writable view of the inline storage. */
+    [[nodiscard]] MatrixView<T> view() noexcept {
+        return MatrixView<T>(_data.data(), R, C, C, 1);
+    }
+
+    // --- Methods ---
+
+    /** @brief Copies the elements into a heap-allocated Matrix. */
+    [[nodiscard]] Matrix<T> to_matrix() const {
+        return Matrix<T>(view());
+    }
+
+    /** @brief Converts the elements to U. */
+    template <Numeric U>
+    [[nodiscard]] constexpr SMatrix<U, R, C> cast() const noexcept {
+        SMatrix<U, R, C> result;
+        detail::_static_for<R * C>(
+            [&](size_t i) { result.data()[i] = static_cast<U>(_data[i]); });
+        return result;
+    }
+
+    [[nodiscard]] constexpr SMatrix<T, C, R> transposed() const noexcept {
+        SMatrix<T, C, R> result;
+        detail::_static_for<R>([&](size_t i) {
+            detail::_static_for<C>([&](size_t j) { result(j, i) = (*this)(i, j); });
+        });
+        return result;
+    }
+
+    [[nodiscard]] constexpr T trace() const noexcept
+        requires(R == C)
+    {
+        return detail::_static_sum<T, R>([&](size_t i) { return (*this)(i, i); });
+    }
+
+    /** @brief Checks symmetry with the same tolerance as Matrix::is_symmetric(). */
+    [[nodiscard]] bool is_symmetric() const
+        requires(R == C)
+    {
+        bool symmetric = true;
+        detail::_static_for<R>([&](auto i) {
+            detail::_static_for<R>([&](auto j) {
+                if constexpr (j > i) {
+                    symmetric = symmetric && is_close((*this)(i, j), (*this)(j, i));
+                }
+            });
+        });
+        return symmetric;
+    }
+
+    /**
+     * @brief Computes the determinant.
+     * @details Closed form up to 3x3, otherwise an unrolled LU factorization
+     * with partial pivoting. Integer matrices are evaluated in double.
+     */
+    [[nodiscard]] constexpr _floating_t determinant() const noexcept
+        requires(R == C)
+    {
+        using F = _floating_t;
+        const auto a = [&](size_t i, size_t j) {
+            return static_cast<F>((*this)(i, j));
+        };
+
+        if constexpr (R == 1) {
+            return a(0, 0);
+        } else if constexpr (R == 2) {
+            return (a(0, 0) * a(1, 1)) - (a(0, 1) * a(1, 0));
+        } else if constexpr (R == 3) {
+            return (a(0, 0) * ((a(1, 1) * a(2, 2)) - (a(1, 2) * a(2, 1)))) -
+                   (a(0, 1) * ((a(1, 0) * a(2, 2)) - (a(1, 2) * a(2, 0)))) +
+                   (a(0, 2) * ((a(1, 0) * a(2, 1)) - (a(1, 1) * a(2, 0))));
+        } else {
+            SMatrix<F, R, R> lu = cast<F>();
+            F det = F(1);
+            bool singular = false;
+
+            detail::_static_for<R>([&](auto k) {
+                if (singular) {
+                    return;
+                }
+                const size_t pivot = lu._pivot_row(k);
+                if (lu(pivot, k) == F(0)) {
+                    singular = true;
+                    return;
+                }
+                if (pivot != k) {
+                    lu._swap_rows(pivot, k);
+                    det = -det;
+                }
+                det *= lu(k, k);
+                lu._eliminate_below(k);
+            });
+            return singular ? F(0) : det;
+        }
+    }
+
+    /**
+     * @brief Computes the inverse.
+     * @details Adjugate formula up to 3x3, otherwise unrolled Gauss-Jordan
+     * elimination with partial pivoting. Integer matrices are inverted in
+     * double. Singularity is judged relative to the scale of the elements,
+     * so matrices with uniformly small elements are still inverted.
+     * @throws std::runtime_error if the matrix is singular.
+     */
+    [[nodiscard]] constexpr SMatrix<_floating_t, R, R> inverse() const
+        requires(R == C)
+    {
+        using F = _floating_t;
+        const F tolerance = static_cast<F>(R) * std::numeric_limits<F>::epsilon();
+        const auto a = [&](size_t i, size_t j) {
+            return static_cast<F>((*this)(i, j));
+        };
+
+        if constexpr (R <= 3) {
+            // |det| against the product of the largest element of every row
+            F scale = F(1);
+            detail::_static_for<R>([&](size_t i) {
+                F row_max = F(0);
+                detail::_static_for<R>([&](size_t j) {
+                    row_max = std::max(row_max, detail::_static_abs(a(i, j)));
+                });
+                scale *= row_max;
+            });
+            const F det = determinant();
+            if (detail::_static_abs(det) <= tolerance * scale) {
+                throw std::runtime_error(
+                    "Matrix is singular; determinant is near zero.");
+            }
+            const F inv_det = F(1) / det;
+            if constexpr (R == 1) {
+                return SMatrix<F, 1, 1>(inv_det);
+            } else if constexpr (R == 2) {
+                return SMatrix<F, 2, 2>(a(1, 1) * inv_det,
+                                        -a(0, 1) * inv_det,
+                                        -a(1, 0) * inv_det,
+                                        a(0, 0) * inv_det);
+            } else {
+                SMatrix<F, 3, 3> result;
+                detail::_static_for<3>([&](size_t i) {
+                    detail::_static_for<3>([&](size_t j) {
+                        // Cofactor (j, i) of the cyclically shifted minor
+                        const size_t r0 = (j + 1) % 3;
+                        const size_t r1 = (j + 2) % 3;
+                        const size_t c0 = (i + 1) % 3;
+                        const size_t c1 = (i + 2) % 3;
+                        const F cofactor =
+                            (a(r0, c0) * a(r1, c1)) - (a(r0, c1) * a(r1, c0));
+                        result(i, j) = cofactor * inv_det;
+                    });
+                });
+                return result;
+            }
+        } else {
+            SMatrix<F, R, R> lu = cast<F>();
+            auto result = SMatrix<F, R, R>::identity();
+            // Pivots are compared against the largest element of the matrix
+            F scale = F(0);
+            detail::_static_for<R * R>([&](size_t index) {
+                scale = std::max(scale, detail::_static_abs(lu._data[index]));
+            });
+
+            detail::_static_for<R>([&](auto k) {
+                const size_t pivot = lu._pivot_row(k);
+                if (detail::_static_abs(lu(pivot, k)) <= tolerance * scale) {
+                    throw std::runtime_error("Matrix is singular; pivot is near zero.");
+                }
+                if (pivot != k) {
+                    lu._swap_rows(pivot, k);
+                    result._swap_rows(pivot, k);
+                }
+
+                const F inv_pivot = F(1) / lu(k, k);
+                detail::_static_for<R>([&](size_t j) {
+                    lu(k, j) *= inv_pivot;
+                    result(k, j) *= inv_pivot;
+                });
+
+                detail::_static_for<R>([&](auto i) {
+                    if constexpr (i != k) {
+                        const F factor = lu(i, k);
+                        detail::_static_for<R>([&](size_t j) {
+                            lu(i, j) -= factor * lu(k, j);
+                            result(i, j) -= factor * result(k, j);
+                        });
+                    }
+                });
+            });
+            return result;
+        }
+    }
+
+    /**
+     * @brief Computes the lower triangular L with A = LL^T, unrolled.
+     * @throws std::invalid_argument if the matrix is not symmetric or not
+     * positive definite.
+     */
+    [[nodiscard]] SMatrix<_floating_t, R, R> cholesky() const
+        requires(R == C)
+    {
+        using F = _floating_t;
+        if (!is_symmetric()) {
+            throw std::invalid_argument(
+                "Matrix must be symmetric to try Cholesky decomposition!");
+        }
+
+        SMatrix<F, R, R> L;
+        detail::_static_for<R>([&](auto j) {
+            constexpr size_t J = decltype(j)::value;
+            const F diag_val =
+                static_cast<F>((*this)(j, j)) -
+                detail::_static_sum<F, J>([&](size_t k) { return L(j, k) * L(j, k); });
+            if (diag_val <= 0) {
+                throw std::invalid_argument("Matrix is not positive definite!");
+            }
+            L(j, j) = std::sqrt(diag_val);
+
+            detail::_static_for<R>([&](auto i) {
+                if constexpr (i > j) {
+                    const F sum = detail::_static_sum<F, J>(
+                        [&](size_t k) { return L(i, k) * L(j, k); });
+                    L(i, j) = (static_cast<F>((*this)(i, j)) - sum) / L(j, j);
+                }
+            });
+        });
+        return L;
+    }
+
+    // --- Operators ---
+
+    [[nodiscard]] constexpr bool operator==(const SMatrix& other) const noexcept {
+        return _data == other._data;
+    }
+
+    constexpr SMatrix& operator+=(const SMatrix& other) noexcept {
+        detail::_static_for<R * C>([&](size_t i) { _data[i] += other._data[i]; });
+        return *this;
+    }
+
+    constexpr SMatrix& operator-=(const SMatrix& other) noexcept {
+        detail::_static_for<R * C>([&](size_t i) { _data[i] -= other._data[i]; });
+        return *this;
+    }
+
+    constexpr SMatrix& operator*=(T scalar) noexcept {
+        detail::_static_for<R * C>([&](size_t i) { _data[i] *= scalar; });
+        return *this;
+    }
+
+    constexpr SMatrix& operator/=(T scalar) noexcept {
+        detail::_static_for<R * C>([&](size_t i) { _data[i] /= scalar; });
+        return *this;
+    }
+
+    [[nodiscard]] friend constexpr SMatrix operator+(SMatrix lhs,
+                                                     const SMatrix& rhs) noexcept {
+        return lhs += rhs;
+    }
+
+    [[nodiscard]] friend constexpr SMatrix operator-(SMatrix lhs,
+                                                     const SMatrix& rhs) noexcept {
+        return lhs -= rhs;
+    }
+
+    [[nodiscard]] friend constexpr SMatrix operator-(SMatrix matrix) noexcept {
+        detail::_static_for<R * C>(
+            [&](size_t i) { matrix._data[i] = -matrix._data[i]; });
+        return matrix;
+    }
+
+    [[nodiscard]] friend constexpr SMatrix operator*(SMatrix matrix,
+                                                     T scalar) noexcept {
+        return matrix *= scalar;
+    }
+
+    [[nodiscard]] friend constexpr SMatrix operator*(T scalar,
+                                                     SMatrix matrix) noexcept {
+        return matrix *= scalar;
+    }
+
+    [[nodiscard]] friend constexpr SMatrix operator/(SMatrix matrix,
+                                                     T scalar) noexcept {
+        return matrix /= scalar;
+    }
+
+private:
+    std::array<T, R * C> _data{};
+
+    template <Numeric, size_t, size_t>
+    friend class SMatrix;
+
+    /** @brief Row index of the largest |a(i, k)| for i >= k. */
+    [[nodiscard]] constexpr size_t _pivot_row(size_t k) const noexcept {
+        size_t pivot = k;
+        for (size_t i = k + 1; i < R; ++i) {
+            if (detail::_static_abs((*this)(i, k)) >
+                detail::_static_abs((*this)(pivot, k))) {
+                pivot = i;
+            }
+        }
+        return pivot;
+    }
+
+    constexpr void _swap_rows(size_t first, size_t second) noexcept {
+        detail::_static_for<C>(
+            [&](size_t j) { std::swap((*this)(first, j), (*this)(second, j)); });
+    }
+
+    /** @brief One step of Gaussian elimination below pivot (k, k). */
+    template <size_t K>
+    constexpr void _eliminate_below(std::integral_constant<size_t, K> /*k*/) noexcept {
+        detail::_static_for<R>([&](auto i) {
+            if constexpr (i > K) {
+                const T factor = (*this)(i, K) / (*this)(K, K);
+                detail::_static_for<C>([&](auto j) {
+                    if constexpr (j > K) {
+                        (*this)(i, j) -= factor * (*this)(K, j);
+                    }
+                });
+            }
+        });
+    }
+};
+
+/** @brief Unrolled matrix product. */
+template <Numeric T, size_t R, size_t C, size_t K>
+[[nodiscard]] constexpr SMatrix<T, R, K> operator*(
+    const SMatrix<T, R, C>& lhs, const SMatrix<T, C, K>& rhs) noexcept {
+    SMatrix<T, R, K> result;
+    detail::_static_for<R>([&](size_t i) {
+        detail::_static_for<K>([&](size_t j) {
+            result(i, j) = detail::_static_sum<T, C>(
+                [&](size_t k) { return lhs(i, k) * rhs(k, j); });
+        });
+    });
+    return result;
+}
+
+/** @brief Unrolled matrix-vector product A * x. */
+template <Numeric T, size_t R, size_t C>
+[[nodiscard]] constexpr SVector<T, R> operator*(const SMatrix<T, R, C>& matrix,
+                                                const SVector<T, C>& vec) noexcept {
+    SVector<T, R> result;
+    detail::_static_for<R>([&](size_t i) {
+        result[i] =
+            detail::_static_sum<T, C>([&](size_t k) { return matrix(i, k) * vec[k]; });
+    });
+    return result;
+}
+
+/** @brief Unrolled vector-matrix product x^T * A. */
+template <Numeric T, size_t R, size_t C>
+[[nodiscard]] constexpr SVector<T, C> operator*(
+    const SVector<T, R>& vec, const SMatrix<T, R, C>& matrix) noexcept {
+    SVector<T, C> result;
+    detail::_static_for<C>([&](size_t j) {
+        result[j] =
+            detail::_static_sum<T, R>([&](size_t k) { return vec[k] * matrix(k, j); });
+    });
+    return result;
+}
+
+/**
+ * @brief Computes the Cholesky decomposition of a fixed-size matrix.
+ * @see SMatrix::cholesky()
+ */
+template <Numeric T, size_t N>
+[[nodiscard]] auto cholesky(const SMatrix<T, N, N>& matrix) {
+    return matrix.cholesky();
+}
+
+}  // namespace maf::math
+#endif
@@ -0,0 +1,501 @@
+#ifndef SVD_H
+#define SVD_H
+
+#pragma once
+#include "QR.hpp"
+
+/**
+ * @file SVD.hpp
+ * @brief Singular value decomposition A = U diag(s) V^T.
+ *
+ * svd() runs a one-sided Jacobi iteration (Hestenes): the columns of A are
+ * rotated in pairs until they are mutually orthogonal, at which point their
+ * norms are the singular values. It is slower than bidiagonalization but
+ * computes even the small singular values to high relative accuracy. Tall
+ * matrices are first reduced to their n x n R factor with blocked
+ * Householder QR. The pairs are visited in round-robin order, so each round
+ * is a set of disjoint pairs rotated in parallel.
+ *
+ * randomized_svd() approximates the top k triplets of a large matrix from a
+ * Gaussian sketch: the matrix is only multiplied by thin blocks, through
+ * GEMM, and the exact SVD is taken of a small (k + p) x n projection.
+ */
+namespace maf::math {
+namespace detail {
+/** @brief Columns a randomized sketch samples beyond the rank wanted. */
+constexpr static size_t SKETCH_OVERSAMPLING = 10;
+
+/** @brief Jacobi sweeps after which svd() gives up. */
+constexpr static size_t JACOBI_MAX_SWEEPS = 60;
+
+/** @brief A rows x cols matrix of independent standard normal samples. */
+template <std::floating_point T>
+[[nodiscard]] Matrix<T> _gaussian_matrix(size_t rows, size_t cols, uint32 seed) {
+    std::mt19937 gen(seed);
+    std::normal_distribution<T> dis(T(0), T(1));
+    Matrix<T> result(rows, cols, default_init);
+    for (size_t i = 0; i < rows; ++i) {
+        for (auto& value : result.row_span(i)) {
+            value = dis(gen);
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Rotates rows i and j of the n x m matrix at `w` until they are
+ * orthogonal, applying the same rotation to rows i and j of `vt` (n x n,
+ * may be null).
+ * @return Whether the rows were not yet orthogonal to the tolerance.
+ */
+template <std::floating_point T>
+bool _jacobi_rotate(
+    size_t m, size_t n, T* w_i, T* w_j, T* vt_i, T* vt_j, T tolerance) {
+    T alpha = 0;
+    T beta = 0;
+    T gamma = 0;
+    #pragma omp simd reduction(+ : alpha, beta, gamma)
+    for (size_t t = 0; t < m; ++t) {
+        alpha += w_i[t] * w_i[t];
+        beta += w_j[t] * w_j[t];
+        gamma += w_i[t] * w_j[t];
+    }
+    if (gamma == T(0) || std::abs(gamma) <= tolerance * std::sqrt(alpha * beta)) {
+        return false;
+    }
+
+    const T zeta = (beta - alpha) / (T(2) * gamma);
+    const T tangent =
+        std::copysign(T(1), zeta) / (std::abs(zeta) + std::sqrt(T(1) + (zeta * zeta)));
+    const T c = T(1) / std::sqrt(T(1) + (tangent * tangent));
+    const T s = c * tangent;
+    #pragma omp simd
+    for (size_t t = 0; t < m; ++t) {
+        const T x = w_i[t];
+        const T y = w_j[t];
+        w_i[t] = (c * x) - (s * y);
+        w_j[t] = (s * x) + (c * y);
+    }
+    if (vt_i != nullptr) {
+        #pragma omp simd
+        for (size_t t = 0; t < n; ++t) {
+            const T x = vt_i[t];
+            const T y = vt_j[t];
+            vt_i[t] = (c * x) - (s * y);
+            vt_j[t] = (s * x) + (c * y);
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief One-sided Jacobi on the rows of the n x m matrix at `w`, n <= m
+ * (LAPACK gesvj on W = A^T, whose rows are the columns of A).
+ *
+ * Every sweep visits all n (n - 1) / 2 pairs in n - 1 round-robin rounds
+ * (the circle method, with a bye when n is odd); the pairs of a round are
+ * disjoint and rotated in parallel. On return the rows are orthogonal, row
+ * i being s_i u_i^T, and the rotations have been applied to the rows of
+ * `vt` (n x n, may be null), which become v_i^T when `vt` starts as I.
+ *
+ * @throws std::runtime_error if the rows are not orthogonal after
+ * JACOBI_MAX_SWEEPS sweeps.
+ */
+template <std::floating_point T>
+void _gesvj(size_t n, size_t m, T* w, size_t ldw, T* vt, size_t ldvt) {
+    if (n < 2) {
+        return;
+    }
+    const T tolerance =
+        std::sqrt(static_cast<T>(m)) * std::numeric_limits<T>::epsilon();
+    const size_t players = n + (n % 2);
+    const size_t pairs = players / 2;
+    const auto player = [&](size_t slot, size_t round) {
+        return slot == 0 ? 0 : 1 + ((slot - 1 + round) % (players - 1));
+    };
+
+    for (size_t sweep = 0; sweep < JACOBI_MAX_SWEEPS; ++sweep) {
+        bool rotated = false;
+        const bool parallel = m * n > OMP_LINEAR_LIMIT;
+        for (size_t round = 0; round + 1 < players; ++round) {
+            #pragma omp parallel for reduction(|| : rotated) if (parallel)
+            for (size_t k = 0; k < pairs; ++k) {
+                size_t i = player(k, round);
+                size_t j = player(players - 1 - k, round);
+                if (i >= n || j >= n) {
+                    continue;
+                }
+                if (i > j) {
+                    std::swap(i, j);
+                }
+                T* vt_i = vt == nullptr ? nullptr : vt + (i * ldvt);
+                T* vt_j = vt == nullptr ? nullptr : vt + (j * ldvt);
+                if (_jacobi_rotate(m, n, w + (i * ldw), w + (j * ldw), vt_i, vt_j,
+                                   tolerance)) {
+                    rotated = true;
+                }
+            }
+        }
+        if (!rotated) {
+            return;
+        }
+    }
+    throw std::runtime_error("SVD did not converge.");
+}
+
+/**
+ * @brief Replaces the columns of the square orthogonal-to-be matrix `u`
+ * listed in `missing` (left vectors of zero singular values) by an
+ * orthonormal basis of the complement of the other columns.
+ */
+template <std::floating_point T>
+void _complete_orthonormal(Matrix<T>& u, const std::vector<size_t>& missing) {
+    const size_t n = u.row_count();
+    std::vector<size_t> present;
+    for (size_t j = 0, next = 0; j < u.column_count(); ++j) {
+        if (next < missing.size() && missing[next] == j) {
+            ++next;
+        } else {
+            present.push_back(j);
+        }
+    }
+    Matrix<T> x = _gaussian_matrix<T>(n, missing.size(), 7);
+    if (!present.empty()) {
+        Matrix<T> basis(n, present.size(), default_init);
+        for (size_t i = 0; i < n; ++i) {
+            for (size_t j = 0; j < present.size(); ++j) {
+                basis(i, j) = u(i, present[j]);
+            }
+        }
+        // Two passes of block Gram-Schmidt, X -= B (B^T X)
+        for (size_t pass = 0; pass < 2; ++pass) {
+            const Matrix<T> coefficients = basis.t() * x;
+            x -= basis * coefficients;
+        }
+    }
+    const Matrix<T> q = _qr(std::move(x)).first;
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j < missing.size(); ++j) {
+            u(i, missing[j]) = q(i, j);
+        }
+    }
+}
+
+/**
+ * @brief Internal implementation of the SVD of an m x n matrix, m >= n.
+ *
+ * A tall matrix is reduced to R with blocked Householder QR first (so the
+ * Jacobi sweeps run on n x n instead of m x n), then W = R^T (or A^T) is
+ * orthogonalized with _gesvj(). The singular values are the row norms of
+ * W, sorted descending; U = Q (W^T diag(s)^-1) is formed by GEMM. Only the
+ * values are computed when `vectors` is false.
+ */
+template <std::floating_point T>
+[[nodiscard]] std::tuple<Matrix<T>, Vector<T>, Matrix<T>> _svd(Matrix<T>&& a,
+                                                               bool vectors) {
+    const size_t m = a.row_count();
+    const size_t n = a.column_count();
+
+    Matrix<T> q;
+    Matrix<T> w;
+    if (m > n && vectors) {
+        auto [q_a, r_a] = _qr(std::move(a));
+        q = std::move(q_a);
+        w = r_a.transposed();
+    } else if (m > n) {
+        // R alone, as the upper triangle left by geqrf()
+        static_cast<void>(geqrf(a));
+        w = Matrix<T>(n, n);
+        for (size_t i = 0; i < n; ++i) {
+            for (size_t j = 0; j <= i; ++j) {
+                w(i, j) = a(j, i);
+            }
+        }
+    } else {
+        w = a.transposed();
+    }
+    Matrix<T> vt;
+    if (vectors) {
+        vt = Matrix<T>(n, n);
+        for (size_t i = 0; i < n; ++i) {
+            vt(i, i) = T(1);
+        }
+    }
+    _gesvj(n,
+           n,
+           w.data().data(),
+           w.leading_dimension(),
+           vectors ? vt.data().data() : static_cast<T*>(nullptr),
+           vectors ? vt.leading_dimension() : 0);
+
+    std::vector<T> norms(n);
+    for (size_t i = 0; i < n; ++i) {
+        T sum = 0;
+        for (const T value : w.row_span(i)) {
+            sum += value * value;
+        }
+        norms[i] = std::sqrt(sum);
+    }
+    std::vector<size_t> order(n);
+    std::iota(order.begin(), order.end(), 0);
+    std::ranges::stable_sort(order,
+                             [&](size_t i, size_t j) { return norms[i] > norms[j]; });
+    Vector<T> s(n);
+    for (size_t j = 0; j < n; ++j) {
+        s[j] = norms[order[j]];
+    }
+    if (!vectors) {
+        return std::make_tuple(Matrix<T>(), std::move(s), Matrix<T>());
+    }
+
+    Matrix<T> u(n, n, default_init);
+    Matrix<T> v(n, n, default_init);
+    std::vector<size_t> missing;
+    for (size_t j = 0; j < n; ++j) {
+        const auto row = w.row_span(order[j]);
+        const T inverse = s[j] > std::numeric_limits<T>::min() ? T(1) / s[j] : T(0);
+        if (inverse == T(0)) {
+            missing.push_back(j);
+        }
+        for (size_t i = 0; i < n; ++i) {
+            u(i, j) = row[i] * inverse;
+            v(i, j) = vt(order[j], i);
+        }
+    }
+    if (!missing.empty()) {
+        _complete_orthonormal(u, missing);
+    }
+    if (m > n) {
+        u = q * u;
+    }
+    return std::make_tuple(std::move(u), std::move(s), std::move(v));
+}
+
+/** @brief Copies a matrix, view or expression into a Matrix<T>. */
+template <std::floating_point T, MatrixOperand E>
+[[nodiscard]] Matrix<T> _svd_working_copy(const E& matrix) {
+    if constexpr (is_matrix<E>::value) {
+        return matrix.template cast<T>();
+    } else {
+        return Matrix<T>(matrix);
+    }
+}
+
+/** @brief The SVD of any m x n matrix, through its transpose when wide. */
+template <std::floating_point T>
+[[nodiscard]] std::tuple<Matrix<T>, Vector<T>, Matrix<T>> _svd_any(Matrix<T>&& a,
+                                                                   bool vectors) {
+    if (a.row_count() >= a.column_count()) {
+        return _svd(std::move(a), vectors);
+    }
+    auto [u, s, v] = _svd(a.transposed(), vectors);
+    return std::make_tuple(std::move(v), std::move(s), std::move(u));
+}
+
+/**
+ * @brief Randomized truncated SVD of the m x n matrix viewed by `a`
+ * (Halko, Martinsson & Tropp).
+ *
+ * Y = A Omega for a Gaussian n x l Omega, l = k + oversampling, is
+ * orthonormalized into Q; each power iteration replaces Q by the
+ * orthonormalized A (A^T Q). Then B^T = A^T Q (n x l) is decomposed
+ * exactly, B^T = U_B S V_B^T, which gives A ~ (Q V_B) S U_B^T. All
+ * products with A are GEMMs with thin blocks.
+ */
+template <std::floating_point T, Numeric U>
+[[nodiscard]] std::tuple<Matrix<T>, Vector<T>, Matrix<T>> _randomized_svd(
+    const ConstMatrixView<U>& a,
+    size_t k,
+    size_t power_iterations,
+    size_t oversampling) {
+    const size_t m = a.row_count();
+    const size_t n = a.column_count();
+    const size_t l = std::min(k + oversampling, std::min(m, n));
+
+    const Matrix<T> omega = _gaussian_matrix<T>(n, l, 42);
+    Matrix<T> q = _qr(_gemm_views<T, T>(a, omega.view())).first;
+    for (size_t iteration = 0; iteration < power_iterations; ++iteration) {
+        const Matrix<T> z = _qr(_gemm_views<T, T>(a.t(), _as_view(q))).first;
+        q = _qr(_gemm_views<T, T>(a, z.view())).first;
+    }
+    auto [u_b, s_b, v_b] = _svd(_gemm_views<T, T>(a.t(), _as_view(q)), true);
+
+    const Matrix<T> left = q * v_b;
+    Matrix<T> u(m, k, default_init);
+    Vector<T> s(k);
+    Matrix<T> v(n, k, default_init);
+    for (size_t j = 0; j < k; ++j) {
+        s[j] = s_b[j];
+    }
+    for (size_t i = 0; i < m; ++i) {
+        std::copy_n(left.row_span(i).begin(), k, u.row_span(i).begin());
+    }
+    for (size_t i = 0; i < n; ++i) {
+        std::copy_n(u_b.row_span(i).begin(), k, v.row_span(i).begin());
+    }
+    return std::make_tuple(std::move(u), std::move(s), std::move(v));
+}
+
+/** @brief The default cutoff of pinv() and matrix_rank(): max(m, n) eps s_max. */
+template <std::floating_point T>
+[[nodiscard]] T _singular_cutoff(size_t m, size_t n, const Vector<T>& s, double rcond) {
+    const T relative = rcond >= 0 ? static_cast<T>(rcond)
+                                  : static_cast<T>(std::max(m, n)) *
+                                        std::numeric_limits<T>::epsilon();
+    return s.size() == 0 ? T(0) : relative * s[0];
+}
+
+}  // namespace detail
+
+/**
+ * @brief Computes the thin singular value decomposition A = U diag(s) V^T.
+ *
+ * One-sided Jacobi: the columns of A (of R, after a blocked QR, for tall
+ * matrices) are rotated in pairs, in parallel round-robin order, until they
+ * are orthogonal. Singular values come out to high relative accuracy, which
+ * makes this the choice for small and medium matrices; for a few leading
+ * triplets of a large matrix see randomized_svd().
+ *
+ * More information:
+ * https://en.wikipedia.org/wiki/Jacobi_eigenvalue_algorithm (see "One-sided
+ * Jacobi")
+ *
+ * @tparam T The numeric type of the matrix elements; integers are
+ * decomposed in double.
+ * @param matrix The m x n matrix (a Matrix, view or expression).
+ * @return A std::tuple containing, for p = min(m, n):
+ * 1. (Matrix<T>) U, m x p with orthonormal columns.
+ * 2. (Vector<T>) The p singular values in descending order.
+ * 3. (Matrix<T>) V, n x p with orthonormal columns (not V^T).
+ *
+ * @throws std::runtime_error if the Jacobi sweeps fail to converge.
+ *
+ * @version 1.0 (One-sided Jacobi & Parallelized)
+ * @since 2025
+ */
+template <typename ResultType = void, MatrixOperand E>
+[[nodiscard]] auto svd(const E& matrix) {
+    using T = typename E::value_type;
+    using TargetType =
+        std::conditional_t<std::is_same_v<ResultType, void>,
+                           std::conditional_t<std::is_floating_point_v<T>, T, double>,
+                           ResultType>;
+
+    static_assert(std::is_floating_point_v<TargetType>,
+                  "SVD result type must be floating point!");
+
+    return detail::_svd_any(detail::_svd_working_copy<TargetType>(matrix), true);
+}
+
+/**
+ * @brief Computes the singular values of a matrix, in descending order.
+ * @details The Jacobi sweeps of svd() without accumulating V or forming U.
+ * @throws std::runtime_error if the Jacobi sweeps fail to converge.
+ */
+template <typename ResultType = void, MatrixOperand E>
+[[nodiscard]] auto singular_values(const E& matrix) {
+    using T = typename E::value_type;
+    using TargetType =
+        std::conditional_t<std::is_same_v<ResultType, void>,
+                           std::conditional_t<std::is_floating_point_v<T>, T, double>,
+                           ResultType>;
+
+    static_assert(std::is_floating_point_v<TargetType>,
+                  "SVD result type must be floating point!");
+
+    return std::get<1>(
+        detail::_svd_any(detail::_svd_working_copy<TargetType>(matrix), false));
+}
+
+/**
+ * @brief Approximates the k leading singular triplets of a large matrix.
+ *
+ * Samples the range of A with a Gaussian test matrix of k + oversampling
+ * columns, sharpens it with power iterations (worthwhile when the singular
+ * values decay slowly) and takes the exact SVD of the small projection.
+ * A is read only through GEMMs with thin blocks: Matrices and views are
+ * never copied, lazy expressions are evaluated once. The test matrix uses
+ * a fixed seed, so results are reproducible.
+ *
+ * More information:
+ * https://en.wikipedia.org/wiki/Low-rank_approximation
+ *
+ * @param matrix The m x n matrix (a Matrix, view or expression).
+ * @param k The number of triplets, at most min(m, n).
+ * @param power_iterations Passes that sharpen the sketch; 1-3 is typical.
+ * @param oversampling Extra sketch columns beyond k.
+ * @return A std::tuple of U (m x k), the k singular values (descending) and
+ * V (n x k), A ~ U diag(s) V^T.
+ *
+ * @throws std::invalid_argument if k is zero or exceeds min(m, n).
+ */
+template <typename ResultType = void, MatrixOperand E>
+[[nodiscard]] auto randomized_svd(const E& matrix,
+                                  size_t k,
+                                  size_t power_iterations = 2,
+                                  size_t oversampling = detail::SKETCH_OVERSAMPLING) {
+    using T = typename E::value_type;
+    using TargetType =
+        std::conditional_t<std::is_same_v<ResultType, void>,
+                           std::conditional_t<std::is_floating_point_v<T>, T, double>,
+                           ResultType>;
+
+    static_assert(std::is_floating_point_v<TargetType>,
+                  "SVD result type must be floating point!");
+
+    if (k == 0 || k > std::min(matrix.row_count(), matrix.column_count())) {
+        throw std::invalid_argument(
+            "Rank of the approximation must be in [1, min(m, n)]!");
+    }
+    if constexpr (detail::_strided_operand<E>) {
+        return detail::_randomized_svd<TargetType>(
+            detail::_as_view(matrix), k, power_iterations, oversampling);
+    } else {
+        const Matrix<TargetType> evaluated =
+            detail::_svd_working_copy<TargetType>(matrix);
+        return detail::_randomized_svd<TargetType>(
+            evaluated.view(), k, power_iterations, oversampling);
+    }
+}
+
+/**
+ * @brief Moore-Penrose pseudo-inverse A^+ = V diag(1 / s) U^T (n x m).
+ * @details Singular values below rcond * s_max are treated as zero; a
+ * negative rcond selects max(m, n) * epsilon.
+ * @throws std::runtime_error if the SVD fails to converge.
+ */
+template <typename ResultType = void, MatrixOperand E>
+[[nodiscard]] auto pinv(const E& matrix, double rcond = -1.0) {
+    auto [u, s, v] = svd<ResultType>(matrix);
+    using TargetType = typename decltype(s)::value_type;
+    const TargetType cutoff = detail::_singular_cutoff(
+        matrix.row_count(), matrix.column_count(), s, rcond);
+    for (size_t i = 0; i < v.row_count(); ++i) {
+        auto row = v.row_span(i);
+        for (size_t j = 0; j < s.size(); ++j) {
+            row[j] = s[j] > cutoff ? row[j] / s[j] : TargetType(0);
+        }
+    }
+    return v * u.t();
+}
+
+/**
+ * @brief Numerical rank: the number of singular values above
+ * rcond * s_max; a negative rcond selects max(m, n) * epsilon.
+ * @throws std::runtime_error if the SVD fails to converge.
+ */
+template <typename ResultType = void, MatrixOperand E>
+[[nodiscard]] size_t matrix_rank(const E& matrix, double rcond = -1.0) {
+    const auto s = singular_values<ResultType>(matrix);
+    const auto cutoff =
+        detail::_singular_cutoff(matrix.row_count(), matrix.column_count(), s, rcond);
+    size_t rank = 0;
+    while (rank < s.size() && s[rank] > cutoff) {
+        ++rank;
+    }
+    return rank;
+}
+
+}  // namespace maf::math
+
+#endif  // SVD_H
@@ -0,0 +1,226 @@
+#ifndef SVECTOR_H
+#define SVECTOR_H
+#pragma once
+#include "LinAlg.hpp"
+
+namespace maf::math {
+namespace detail {
+/**
+ * @brief Calls fn(std::integral_constant<size_t, I>{}) for I = 0, ..., N - 1.
+ * @details Expands to N separate calls, so the loop is unrolled regardless
+ * of the optimisation level. The index converts implicitly to size_t.
+ */
+template <size_t N, typename Fn>
+constexpr void _static_for(Fn&& fn) {
+    [&]<size_t... I>(std::index_sequence<I...>) {
+        (fn(std::integral_constant<size_t, I>{}), ...);
+    }(std::make_index_sequence<N>{});
+}
+
+/** @brief Unrolled sum of fn(I) for I = 0, ..., N - 1. */
+template <typename R, size_t N, typename Fn>
+[[nodiscard]] constexpr R _static_sum(Fn&& fn) {
+    return [&]<size_t... I>(std::index_sequence<I...>) {
+        return (R(0) + ... + fn(std::integral_constant<size_t, I>{}));
+    }(std::make_index_sequence<N>{});
+}
+
+/** @brief constexpr absolute value (std::abs is not constexpr in C++20). */
+template <Numeric T>
+[[nodiscard]] constexpr T _static_abs(T value) noexcept {
+    return value < T(0) ? -value : value;
+}
+
+}  // namespace detail
+
+/**
+ * @brief A vector whose size is fixed at compile time.
+ *
+ * SVector stores its N elements inline (on the stack when it is a local),
+ * so creating, copying and returning one never allocates. All loops have a
+ * compile-time trip count and are unrolled, and there are no OpenMP or size
+ * checks on the arithmetic, which makes it suitable for the many tiny
+ * vectors of e.g. Kalman filter steps. Use Vector<T> for anything whose size
+ * is only known at runtime or that is large enough to benefit from threads.
+ *
+ * Convert with `SVector<T, N>(vector)` and `to_vector()`.
+ *
+ * @tparam T The numeric type of the elements.
+ * @tparam N The number of elements.
+ */
+template <Numeric T, size_t N>
+class SVector {
+    static_assert(N > 0, "SVector size must be positive!");
+
+public:
+    /** @brief The numeric type of the vector's elements. */
+    using value_type = T;
+
+    // --- Constructors ---
+
+    /** @brief Creates a zero vector. */
+    constexpr SVector() noexcept = default;
+
+    /**
+     * @brief Creates a vector from exactly N values.
+     * @details `SVector<double, 3> v(1, 2, 3);`
+     */
+    template <Numeric... U>
+        requires(sizeof...(U) == N)
+    constexpr SVector(U... values) noexcept : _data{static_cast<T>(values)...} {}
+
+    /** @brief Creates a vector from a std::array. */
+    constexpr explicit SVector(const std::array<T, N>& data) noexcept : _data(data) {}
+
+    /**
+     * @brief Copies a dynamically sized vector.
+     * @throws std::invalid_argument if the vector does not have N elements.
+     */
+    template <Numeric U>
+    explicit SVector(const Vector<U>& vec) {
+        if (vec.size() != N) {
+            throw std::invalid_argument("Vector size does not match SVector size!");
+        }
+        for (size_t i = 0; i < N; ++i) {
+            _data[i] = static_cast<T>(vec.at(i));
+        }
+    }
+
+    // --- Getters ---
+
+    [[nodiscard]] static constexpr size_t size() noexcept {
+        return N;
+    }
+
+    [[nodiscard]] constexpr T* data() noexcept {
+        return _data.data();
+    }
+
+    [[nodiscard]] constexpr const T* data() const noexcept {
+        return _data.data();
+    }
+
+    /** @brief Unchecked element access. */
+    [[nodiscard]] constexpr T& operator[](size_t index) noexcept {
+        return _data[index];
+    }
+
+    /** @brief Unchecked element access. */
+    [[nodiscard]] constexpr const T& operator[](size_t index) const noexcept {
+        return _data[index];
+    }
+
+    /** @throws std::out_of_range if the index is invalid. */
+    [[nodiscard]] constexpr T& at(size_t index) {
+        if (index >= N) {
+            throw std::out_of_range("Index out of bounds.");
+        }
+        return _data[index];
+    }
+
+    /** @throws std::out_of_range if the index is invalid. */
+    [[nodiscard]] constexpr const T& at(size_t index) const {
+        if (index >= N) {
+            throw std::out_of_range("Index out of bounds.");
+        }
+        return _data[index];
+    }
+
+    constexpr auto begin() noexcept {
+        return _data.begin();
+    }
+
+    constexpr auto end() noexcept {
+        return _data.end();
+    }
+
+    constexpr auto begin() const noexcept {
+        return _data.begin();
+    }
+
+    constexpr auto end() const noexcept {
+        return _data.end();
+    }
+
+    // --- Methods ---
+
+    /** @brief Copies the elements into a heap-allocated Vector. */
+    [[nodiscard]] Vector<T> to_vector(Orientation orientation = COLUMN) const {
+        return Vector<T>(N, _data.data(), orientation);
+    }
+
+    /** @brief Dot product. */
+    [[nodiscard]] constexpr T dot(const SVector& other) const noexcept {
+        return detail::_static_sum<T, N>(
+            [&](size_t i) { return _data[i] * other._data[i]; });
+    }
+
+    /** @brief Squared Euclidean norm. */
+    [[nodiscard]] constexpr T squared_norm() const noexcept {
+        return dot(*this);
+    }
+
+    /** @brief Euclidean norm. */
+    [[nodiscard]] auto norm() const noexcept {
+        return std::sqrt(squared_norm());
+    }
+
+    // --- Operators ---
+
+    [[nodiscard]] constexpr bool operator==(const SVector& other) const noexcept {
+        return _data == other._data;
+    }
+
+    constexpr SVector& operator+=(const SVector& other) noexcept {
+        detail::_static_for<N>([&](size_t i) { _data[i] += other._data[i]; });
+        return *this;
+    }
+
+    constexpr SVector& operator-=(const SVector& other) noexcept {
+        detail::_static_for<N>([&](size_t i) { _data[i] -= other._data[i]; });
+        return *this;
+    }
+
+    constexpr SVector& operator*=(T scalar) noexcept {
+        detail::_static_for<N>([&](size_t i) { _data[i] *= scalar; });
+        return *this;
+    }
+
+    constexpr SVector& operator/=(T scalar) noexcept {
+        detail::_static_for<N>([&](size_t i) { _data[i] /= scalar; });
+        return *this;
+    }
+
+    [[nodiscard]] friend constexpr SVector operator+(SVector lhs,
+                                                     const SVector& rhs) noexcept {
+        return lhs += rhs;
+    }
+
+    [[nodiscard]] friend constexpr SVector operator-(SVector lhs,
+                                                     const SVector& rhs) noexcept {
+        return lhs -= rhs;
+    }
+
+    [[nodiscard]] friend constexpr SVector operator-(SVector vec) noexcept {
+        detail::_static_for<N>([&](size_t i) { vec._data[i] = -vec._data[i]; });
+        return vec;
+    }
+
+    [[nodiscard]] friend constexpr SVector operator*(SVector vec, T scalar) noexcept {
+        return vec *= scalar;
+    }
+
+    [[nodiscard]] friend constexpr SVector operator*(T scalar, SVector vec) noexcept {
+        return vec *= scalar;
+    }
+
+    [[nodiscard]] friend constexpr SVector operator/(SVector vec, T scalar) noexcept {
+        return vec /= scalar;
+    }
+
+private:
+    std::array<T, N> _data{};
+};
+
+}  // namespace maf::math
+#endif
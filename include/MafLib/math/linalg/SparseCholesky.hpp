@@ -0,0 +1,786 @@
+#ifndef SPARSE_CHOLESKY_H
+#define SPARSE_CHOLESKY_H
+#pragma once
+#include "Cholesky.hpp"
+#include "SparseMatrix.hpp"
+
+/**
+ * @file SparseCholesky.hpp
+ * @brief Supernodal sparse Cholesky factorization P A P^T = L L^T.
+ *
+ * The factorization is split in two phases:
+ * - symbolic analysis (SparseCholeskyAnalysis), which depends only on the
+ *   pattern of A: a fill-reducing ordering (approximate minimum degree),
+ *   the elimination tree and its postorder, the column counts of L, the
+ *   fundamental supernodes and their row structures, and a map from every
+ *   stored element of A to its slot in L,
+ * - numeric factorization (SparseCholesky), which scatters the values of A
+ *   into the supernode panels and factors them with the dense kernels: the
+ *   blocked _potrf() on the diagonal block of every supernode, a triangular
+ *   solve for the rows below it, and a GEMM for the update it sends to its
+ *   ancestors.
+ *
+ * The analysis is the expensive, allocation-heavy part. When the values of
+ * A change but its pattern does not (e.g. a covariance matrix re-estimated
+ * every tick), call `SparseCholesky::factorize()` again: it reuses the
+ * analysis and all buffers and does not allocate.
+ */
+namespace maf::math {
+/** @brief Fill-reducing orderings for the sparse Cholesky factorization. */
+enum SparseOrdering : uint8 { NATURAL_ORDERING, AMD_ORDERING };
+
+namespace detail {
+/** @brief Supernodal updates with fewer multiply-adds run without GEMM. */
+constexpr static size_t SPARSE_GEMM_LIMIT = 32 * 32 * 32;
+
+/**
+ * @brief Approximate minimum degree ordering of a symmetric graph.
+ *
+ * Works on the quotient graph: eliminating a variable p turns it into an
+ * element whose list L_p holds the variables adjacent to it, absorbing the
+ * elements adjacent to p, so the filled graph is never formed. Degrees are
+ * the AMD upper bounds |A_i| + |L_p \ i| + sum over the other elements e of
+ * i of |L_e \ L_p|, and elements that become subsets of L_p are absorbed
+ * aggressively. (Supervariable detection and mass elimination are not
+ * implemented.)
+ *
+ * @param n Number of vertices.
+ * @param ptr Adjacency offsets (n + 1 entries).
+ * @param adj Adjacency lists, without self loops.
+ * @return The elimination order: order[k] is the k-th vertex eliminated.
+ */
+[[nodiscard]] inline std::vector<size_t> _amd_order(size_t n,
+                                                    const std::vector<size_t>& ptr,
+                                                    const std::vector<size_t>& adj) {
+    enum Status : uint8 { VARIABLE, ELEMENT, ABSORBED };
+    std::vector<std::vector<size_t>> variables(n);
+    std::vector<std::vector<size_t>> elements(n);
+    std::vector<std::vector<size_t>> element_lists(n);
+    std::vector<Status> status(n, VARIABLE);
+    std::vector<size_t> degree(n);
+    std::vector<size_t> mark(n, 0);
+    std::vector<size_t> w_mark(n, 0);
+    std::vector<size_t> w(n, 0);
+    std::set<std::pair<size_t, size_t>> queue;
+    for (size_t i = 0; i < n; ++i) {
+        variables[i].assign(adj.begin() + ptr[i], adj.begin() + ptr[i + 1]);
+        degree[i] = variables[i].size();
+        queue.emplace(degree[i], i);
+    }
+
+    std::vector<size_t> order;
+    order.reserve(n);
+    for (size_t k = 0; k < n; ++k) {
+        const size_t p = queue.begin()->second;
+        queue.erase(queue.begin());
+        order.push_back(p);
+        status[p] = ELEMENT;
+
+        // L_p: the variables adjacent to p directly or through its elements
+        const size_t stamp = k + 1;
+        mark[p] = stamp;
+        std::vector<size_t>& lp = element_lists[p];
+        for (const size_t v : variables[p]) {
+            if (status[v] == VARIABLE && mark[v] != stamp) {
+                mark[v] = stamp;
+                lp.push_back(v);
+            }
+        }
+        for (const size_t e : elements[p]) {
+            if (status[e] != ELEMENT) {
+                continue;
+            }
+            for (const size_t v : element_lists[e]) {
+                if (status[v] == VARIABLE && mark[v] != stamp) {
+                    mark[v] = stamp;
+                    lp.push_back(v);
+                }
+            }
+            status[e] = ABSORBED;
+            std::vector<size_t>().swap(element_lists[e]);
+        }
+        std::vector<size_t>().swap(variables[p]);
+        std::vector<size_t>().swap(elements[p]);
+
+        // w(e) = |L_e \ L_p| for every other element adjacent to L_p
+        for (const size_t i : lp) {
+            for (const size_t e : elements[i]) {
+                if (status[e] != ELEMENT) {
+                    continue;
+                }
+                if (w_mark[e] != stamp) {
+                    w_mark[e] = stamp;
+                    w[e] = element_lists[e].size();
+                }
+                --w[e];
+            }
+        }
+
+        const size_t remaining = n - k - 1;
+        for (const size_t i : lp) {
+            queue.erase({degree[i], i});
+            std::erase_if(variables[i], [&](size_t v) {
+                return status[v] != VARIABLE || mark[v] == stamp;
+            });
+            std::erase_if(elements[i], [&](size_t e) {
+                if (status[e] == ELEMENT && w[e] == 0) {
+                    status[e] = ABSORBED;
+                    std::vector<size_t>().swap(element_lists[e]);
+                }
+                return status[e] != ELEMENT;
+            });
+
+            size_t bound = variables[i].size() + lp.size() - 1;
+            for (const size_t e : elements[i]) {
+                bound += w[e];
+            }
+            elements[i].push_back(p);
+            degree[i] = std::min(bound, remaining - 1);
+            queue.emplace(degree[i], i);
+        }
+    }
+    return order;
+}
+
+}  // namespace detail
+
+/**
+ * @brief Symbolic analysis of a sparse Cholesky factorization.
+ *
+ * Depends only on the pattern of A, so one analysis serves every matrix with
+ * that pattern, whatever its values or element type. Create it with
+ * `SparseCholeskyAnalysis(pattern, ordering)` and pass it to SparseCholesky.
+ *
+ * L is stored by supernodes: runs of consecutive columns with the same
+ * structure below the diagonal. Supernode s covers columns
+ * [supernode_first[s], supernode_first[s + 1]) and the rows listed in its
+ * row structure; its values form a dense row-major panel of
+ * (rows x columns), whose top square block is the diagonal block.
+ */
+class SparseCholeskyAnalysis {
+public:
+    /**
+     * @brief Analyses the pattern of a square matrix.
+     * @details Only the pattern is read. Either triangle, or both, may be
+     * stored; an element (i, j) stands for (j, i) as well.
+     * @throws std::invalid_argument if the matrix is not square.
+     */
+    template <Numeric U>
+    explicit SparseCholeskyAnalysis(const SparseMatrix<U>& pattern,
+                                    SparseOrdering ordering = AMD_ORDERING)
+        : _n(pattern.row_count()),
+          _pattern_offsets(pattern.row_offsets().begin(), pattern.row_offsets().end()),
+          _pattern_indices(pattern.column_indices().begin(),
+                           pattern.column_indices().end()) {
+        if (!pattern.is_square()) {
+            throw std::invalid_argument("Sparse Cholesky requires a square matrix!");
+        }
+        _analyse(ordering);
+    }
+
+    // --- Getters ---
+
+    [[nodiscard]] size_t size() const noexcept {
+        return _n;
+    }
+
+    /** @brief perm[k] is the row of A that becomes row k of P A P^T. */
+    [[nodiscard]] const std::vector<size_t>& permutation() const noexcept {
+        return _perm;
+    }
+
+    /** @brief Parent of every column of L in the elimination tree (or n). */
+    [[nodiscard]] const std::vector<size_t>& elimination_tree() const noexcept {
+        return _parent;
+    }
+
+    /** @brief Non-zeros of every column of L, diagonal included. */
+    [[nodiscard]] const std::vector<size_t>& column_counts() const noexcept {
+        return _column_counts;
+    }
+
+    /** @brief Non-zeros of L. */
+    [[nodiscard]] size_t factor_non_zero_count() const noexcept {
+        return _factor_non_zeros;
+    }
+
+    [[nodiscard]] size_t supernode_count() const noexcept {
+        return _super_first.size() - 1;
+    }
+
+    /** @brief First column of every supernode, plus n. */
+    [[nodiscard]] const std::vector<size_t>& supernode_first() const noexcept {
+        return _super_first;
+    }
+
+    /**
+     * @brief Checks that a matrix has the analysed pattern.
+     * @details O(nnz). The values are not read.
+     */
+    template <Numeric U>
+    [[nodiscard]] bool matches(const SparseMatrix<U>& a) const noexcept {
+        return a.row_count() == _n && a.column_count() == _n &&
+               std::ranges::equal(a.row_offsets(), _pattern_offsets) &&
+               std::ranges::equal(a.column_indices(), _pattern_indices);
+    }
+
+private:
+    template <std::floating_point T>
+    friend class SparseCholesky;
+
+    size_t _n = 0;
+    std::vector<size_t> _pattern_offsets;
+    std::vector<size_t> _pattern_indices;
+
+    std::vector<size_t> _perm;
+    std::vector<size_t> _inverse;
+    std::vector<size_t> _parent;
+    std::vector<size_t> _column_counts;
+    size_t _factor_non_zeros = 0;
+
+    // Supernodes
+    std::vector<size_t> _super_first;
+    std::vector<size_t> _super_of;
+    std::vector<size_t> _row_ptr;
+    std::vector<size_t> _rows;
+    std::vector<size_t> _panel_ptr;
+    size_t _max_update = 0;
+
+    // Slot in the panels of every stored element of A
+    std::vector<size_t> _scatter;
+
+    /** @brief Adjacency of the symmetrized pattern, without the diagonal. */
+    void _graph(std::vector<size_t>& ptr, std::vector<size_t>& adj) const {
+        ptr.assign(_n + 1, 0);
+        for (size_t r = 0; r < _n; ++r) {
+            for (size_t k = _pattern_offsets[r]; k < _pattern_offsets[r + 1]; ++k) {
+                const size_t c = _pattern_indices[k];
+                if (c != r) {
+                    ++ptr[r + 1];
+                    ++ptr[c + 1];
+                }
+            }
+        }
+        std::partial_sum(ptr.begin(), ptr.end(), ptr.begin());
+        adj.resize(ptr[_n]);
+        std::vector<size_t> cursor(ptr.begin(), ptr.end() - 1);
+        for (size_t r = 0; r < _n; ++r) {
+            for (size_t k = _pattern_offsets[r]; k < _pattern_offsets[r + 1]; ++k) {
+                const size_t c = _pattern_indices[k];
+                if (c != r) {
+                    adj[cursor[r]++] = c;
+                    adj[cursor[c]++] = r;
+                }
+            }
+        }
+
+        // Both triangles stored: drop the duplicates
+        size_t next = 0;
+        for (size_t v = 0; v < _n; ++v) {
+            const auto first = adj.begin() + static_cast<std::ptrdiff_t>(ptr[v]);
+            auto last = adj.begin() + static_cast<std::ptrdiff_t>(ptr[v + 1]);
+            std::sort(first, last);
+            last = std::unique(first, last);
+            ptr[v] = next;
+            for (auto it = first; it != last; ++it) {
+                adj[next++] = *it;
+            }
+        }
+        ptr[_n] = next;
+        adj.resize(next);
+    }
+
+    /** @brief Elimination tree of P A P^T (Liu's algorithm). */
+    void _elimination_tree(const std::vector<size_t>& ptr,
+                           const std::vector<size_t>& adj) {
+        _parent.assign(_n, _n);
+        std::vector<size_t> ancestor(_n, _n);
+        for (size_t k = 0; k < _n; ++k) {
+            const size_t v = _perm[k];
+            for (size_t q = ptr[v]; q < ptr[v + 1]; ++q) {
+                // Climb from i to the root of its current subtree
+                for (size_t i = _inverse[adj[q]]; i < k;) {
+                    const size_t next = ancestor[i];
+                    ancestor[i] = k;
+                    if (next == _n) {
+                        _parent[i] = k;
+                        break;
+                    }
+                    i = next;
+                }
+            }
+        }
+    }
+
+    void _analyse(SparseOrdering ordering) {
+        std::vector<size_t> ptr;
+        std::vector<size_t> adj;
+        _graph(ptr, adj);
+
+        if (ordering == AMD_ORDERING) {
+            _perm = detail::_amd_order(_n, ptr, adj);
+        } else {
+            _perm.resize(_n);
+            std::iota(_perm.begin(), _perm.end(), size_t(0));
+        }
+        _inverse.resize(_n);
+        for (size_t k = 0; k < _n; ++k) {
+            _inverse[_perm[k]] = k;
+        }
+
+        // Postorder the elimination tree so that every subtree, and every
+        // supernode, is a contiguous range of columns
+        _elimination_tree(ptr, adj);
+        std::vector<size_t> head(_n + 1, _n);
+        std::vector<size_t> sibling(_n, _n);
+        for (size_t j = _n; j-- > 0;) {
+            sibling[j] = head[_parent[j]];
+            head[_parent[j]] = j;
+        }
+        std::vector<size_t> postorder;
+        postorder.reserve(_n);
+        std::vector<size_t> stack;
+        for (size_t root = head[_n]; root != _n; root = sibling[root]) {
+            stack.push_back(root);
+            while (!stack.empty()) {
+                const size_t j = stack.back();
+                if (head[j] != _n) {
+                    stack.push_back(head[j]);
+                    head[j] = sibling[head[j]];
+                } else {
+                    stack.pop_back();
+                    postorder.push_back(j);
+                }
+            }
+        }
+        std::vector<size_t> perm(_n);
+        for (size_t k = 0; k < _n; ++k) {
+            perm[k] = _perm[postorder[k]];
+        }
+        _perm = std::move(perm);
+        for (size_t k = 0; k < _n; ++k) {
+            _inverse[_perm[k]] = k;
+        }
+        _elimination_tree(ptr, adj);
+
+        // Column counts from the row subtrees: row k of L has a non-zero in
+        // every column on the tree paths from its A entries up to k
+        _column_counts.assign(_n, 1);
+        std::vector<size_t> visited(_n, _n);
+        for (size_t k = 0; k < _n; ++k) {
+            visited[k] = k;
+            const size_t v = _perm[k];
+            for (size_t q = ptr[v]; q < ptr[v + 1]; ++q) {
+                for (size_t j = _inverse[adj[q]]; j < k && visited[j] != k;
+                     j = _parent[j]) {
+                    visited[j] = k;
+                    ++_column_counts[j];
+                }
+            }
+        }
+        _factor_non_zeros = std::accumulate(
+            _column_counts.begin(), _column_counts.end(), size_t(0));
+
+        _supernodes(ptr, adj);
+        _scatter_map();
+    }
+
+    /** @brief Fundamental supernodes and their row structures. */
+    void _supernodes(const std::vector<size_t>& ptr, const std::vector<size_t>& adj) {
+        std::vector<size_t> children(_n + 1, 0);
+        for (size_t j = 0; j < _n; ++j) {
+            ++children[_parent[j]];
+        }
+        _super_first.assign(1, 0);
+        for (size_t j = 1; j < _n; ++j) {
+            const bool extends = _parent[j - 1] == j && children[j] == 1 &&
+                                 _column_counts[j - 1] == _column_counts[j] + 1;
+            if (!extends) {
+                _super_first.push_back(j);
+            }
+        }
+        _super_first.push_back(_n);
+        const size_t supernodes = _super_first.size() - 1;
+        _super_of.resize(_n);
+        for (size_t s = 0; s < supernodes; ++s) {
+            for (size_t j = _super_first[s]; j < _super_first[s + 1]; ++j) {
+                _super_of[j] = s;
+            }
+        }
+
+        // The structure of a supernode is that of its first column: its own
+        // columns, the A entries below them, and the structures of its
+        // children below their last column
+        std::vector<std::vector<size_t>> child_supernodes(supernodes);
+        for (size_t s = 0; s < supernodes; ++s) {
+            const size_t up = _parent[_super_first[s + 1] - 1];
+            if (up != _n) {
+                child_supernodes[_super_of[up]].push_back(s);
+            }
+        }
+        _row_ptr.assign(1, 0);
+        _panel_ptr.assign(1, 0);
+        _rows.clear();
+        std::vector<size_t> mark(_n, _n);
+        std::vector<size_t> structure;
+        for (size_t s = 0; s < supernodes; ++s) {
+            const size_t first = _super_first[s];
+            const size_t last = _super_first[s + 1];
+            structure.clear();
+            const auto add = [&](size_t i) {
+                if (mark[i] != s) {
+                    mark[i] = s;
+                    structure.push_back(i);
+                }
+            };
+            for (size_t j = first; j < last; ++j) {
+                add(j);
+                const size_t v = _perm[j];
+                for (size_t q = ptr[v]; q < ptr[v + 1]; ++q) {
+                    if (_inverse[adj[q]] >= last) {
+                        add(_inverse[adj[q]]);
+                    }
+                }
+            }
+            for (const size_t c : child_supernodes[s]) {
+                const size_t width = _super_first[c + 1] - _super_first[c];
+                for (size_t r = _row_ptr[c] + width; r < _row_ptr[c + 1]; ++r) {
+                    if (_rows[r] >= last) {
+                        add(_rows[r]);
+                    }
+                }
+            }
+            std::sort(structure.begin(), structure.end());
+            _rows.insert(_rows.end(), structure.begin(), structure.end());
+            _row_ptr.push_back(_rows.size());
+
+            const size_t width = last - first;
+            const size_t below = structure.size() - width;
+            _panel_ptr.push_back(_panel_ptr.back() + (structure.size() * width));
+            _max_update = std::max(_max_update, below * below);
+        }
+    }
+
+    /** @brief Maps every stored element of A to its slot in the panels. */
+    void _scatter_map() {
+        _scatter.resize(_pattern_indices.size());
+        for (size_t r = 0; r < _n; ++r) {
+            for (size_t k = _pattern_offsets[r]; k < _pattern_offsets[r + 1]; ++k) {
+                const size_t a = _inverse[r];
+                const size_t b = _inverse[_pattern_indices[k]];
+                const size_t i = std::max(a, b);
+                const size_t j = std::min(a, b);
+                const size_t s = _super_of[j];
+                const size_t width = _super_first[s + 1] - _super_first[s];
+                const auto rows_begin =
+                    _rows.begin() + static_cast<std::ptrdiff_t>(_row_ptr[s]);
+                const auto rows_end =
+                    _rows.begin() + static_cast<std::ptrdiff_t>(_row_ptr[s + 1]);
+                const auto local =
+                    static_cast<size_t>(std::lower_bound(rows_begin, rows_end, i) -
+                                        rows_begin);
+                _scatter[k] = _panel_ptr[s] + (local * width) + (j - _super_first[s]);
+            }
+        }
+    }
+};
+
+/**
+ * @brief Supernodal sparse Cholesky factorization P A P^T = L L^T of a
+ * symmetric positive definite SparseMatrix.
+ *
+ * Typical use with a pattern that stays fixed:
+ * @code
+ * SparseCholesky<double> chol(A);    // analysis + first factorization
+ * auto x = chol.solve(b);
+ * // ... values of A change, pattern does not ...
+ * chol.factorize(A);                 // numeric phase only, no allocation
+ * @endcode
+ *
+ * Supernodes are factored in postorder. Within a supernode the diagonal
+ * block is factored with _potrf(), the rows below it are found with a
+ * triangular solve (in parallel), and the update L21 * L21^T is formed with
+ * the GEMM kernel and scattered into the ancestor supernodes.
+ *
+ * @tparam T Floating point type of the factor.
+ */
+template <std::floating_point T>
+class SparseCholesky {
+public:
+    /**
+     * @brief Wraps an existing analysis; call factorize() before solving.
+     */
+    explicit SparseCholesky(SparseCholeskyAnalysis analysis)
+        : _analysis(std::move(analysis)),
+          _values(_analysis._panel_ptr.back(), default_init),
+          _update(_analysis._max_update, default_init),
+          _relative(_analysis._n, default_init) {}
+
+    /**
+     * @brief Analyses and factors a symmetric positive definite matrix.
+     * @details Either triangle, or both, of A may be stored.
+     * @throws std::invalid_argument if A is not square or not positive
+     * definite.
+     */
+    template <Numeric U>
+    explicit SparseCholesky(const SparseMatrix<U>& a,
+                            SparseOrdering ordering = AMD_ORDERING)
+        : SparseCholesky(SparseCholeskyAnalysis(a, ordering)) {
+        factorize(a);
+    }
+
+    /**
+     * @brief Numeric factorization of a matrix with the analysed pattern.
+     * @details Reuses the analysis and every buffer; nothing is allocated.
+     * @throws std::invalid_argument if the pattern of A differs from the
+     * analysed one, or A is not positive definite.
+     */
+    template <Numeric U>
+    void factorize(const SparseMatrix<U>& a) {
+        const SparseCholeskyAnalysis& an = _analysis;
+        if (!an.matches(a)) {
+            throw std::invalid_argument(
+                "Matrix pattern does not match the analysed pattern!");
+        }
+        _factored = false;
+
+        std::fill(_values.begin(), _values.end(), T(0));
+        const auto values = a.values();
+        for (size_t k = 0; k < values.size(); ++k) {
+            _values[an._scatter[k]] = static_cast<T>(values[k]);
+        }
+
+        for (size_t s = 0; s < an.supernode_count(); ++s) {
+            _factor_supernode(s);
+        }
+        _factored = true;
+    }
+
+    // --- Getters ---
+
+    [[nodiscard]] const SparseCholeskyAnalysis& analysis() const noexcept {
+        return _analysis;
+    }
+
+    /** @brief The factor L of P A P^T as a sparse matrix. */
+    [[nodiscard]] SparseMatrix<T> factor() const {
+        _check_factored();
+        const SparseCholeskyAnalysis& an = _analysis;
+        std::vector<Triplet<T>> triplets;
+        triplets.reserve(an._factor_non_zeros);
+        for (size_t s = 0; s < an.supernode_count(); ++s) {
+            const size_t first = an._super_first[s];
+            const size_t width = an._super_first[s + 1] - first;
+            const T* panel = _values.data() + an._panel_ptr[s];
+            for (size_t r = 0; r < an._row_ptr[s + 1] - an._row_ptr[s]; ++r) {
+                const size_t i = an._rows[an._row_ptr[s] + r];
+                for (size_t c = 0; c < width && first + c <= i; ++c) {
+                    triplets.push_back({i, first + c, panel[(r * width) + c]});
+                }
+            }
+        }
+        return SparseMatrix<T>(an._n, an._n, triplets);
+    }
+
+    // --- Methods ---
+
+    /**
+     * @brief Solves A x = b.
+     * @throws std::invalid_argument if the size of b does not match.
+     * @throws std::runtime_error if no factorization succeeded yet.
+     */
+    template <Numeric U>
+    [[nodiscard]] Vector<T> solve(const Vector<U>& b) const {
+        _check_factored();
+        const SparseCholeskyAnalysis& an = _analysis;
+        if (b.size() != an._n) {
+            throw std::invalid_argument("Right-hand side size does not match!");
+        }
+        Vector<T> y(an._n, default_init, b.orientation());
+        for (size_t k = 0; k < an._n; ++k) {
+            y[k] = static_cast<T>(b[an._perm[k]]);
+        }
+        _forward(y.data().data());
+        _backward(y.data().data());
+        Vector<T> x(an._n, default_init, b.orientation());
+        for (size_t k = 0; k < an._n; ++k) {
+            x[an._perm[k]] = y[k];
+        }
+        return x;
+    }
+
+    /** @brief log(det(A)) = 2 * sum(log(L(j, j))). */
+    [[nodiscard]] T log_determinant() const {
+        _check_factored();
+        const SparseCholeskyAnalysis& an = _analysis;
+        T sum = T(0);
+        for (size_t s = 0; s < an.supernode_count(); ++s) {
+            const size_t width = an._super_first[s + 1] - an._super_first[s];
+            const T* panel = _values.data() + an._panel_ptr[s];
+            for (size_t c = 0; c < width; ++c) {
+                sum += std::log(panel[(c * width) + c]);
+            }
+        }
+        return T(2) * sum;
+    }
+
+private:
+    SparseCholeskyAnalysis _analysis;
+    AlignedBuffer<T> _values;
+    AlignedBuffer<T> _update;
+    AlignedBuffer<size_t> _relative;
+    bool _factored = false;
+
+    void _check_factored() const {
+        if (!_factored) {
+            throw std::runtime_error("Sparse Cholesky factorization is not available!");
+        }
+    }
+
+    /** @brief Factors supernode s and sends its update to its ancestors. */
+    void _factor_supernode(size_t s) {
+        const SparseCholeskyAnalysis& an = _analysis;
+        const size_t first = an._super_first[s];
+        const size_t width = an._super_first[s + 1] - first;
+        const size_t height = an._row_ptr[s + 1] - an._row_ptr[s];
+        const size_t below = height - width;
+        const size_t* rows = an._rows.data() + an._row_ptr[s];
+        T* panel = _values.data() + an._panel_ptr[s];
+
+        detail::_potrf(width, panel, width);
+        if (below == 0) {
+            return;
+        }
+
+        // L21 = A21 * L11^-T, every row a forward substitution
+        T* l21 = panel + (width * width);
+        const bool parallel = below * width * width > detail::GEMM_OMP_LIMIT;
+        #pragma omp parallel for schedule(static) if (parallel)
+        for (size_t r = 0; r < below; ++r) {
+            T* row = l21 + (r * width);
+            for (size_t c = 0; c < width; ++c) {
+                const T* l_c = panel + (c * width);
+                T sum = row[c];
+                #pragma omp simd reduction(- : sum)
+                for (size_t k = 0; k < c; ++k) {
+                    sum -= row[k] * l_c[k];
+                }
+                row[c] = sum / l_c[c];
+            }
+        }
+
+        // U = L21 * L21^T (lower triangle used)
+        T* update = _update.data();
+        if (below * below * width > detail::SPARSE_GEMM_LIMIT) {
+            detail::_gemm(below,
+                          below,
+                          width,
+                          T(1),
+                          l21,
+                          width,
+                          1,
+                          l21,
+                          1,
+                          width,
+                          T(0),
+                          update,
+                          below,
+                          1);
+        } else {
+            for (size_t a = 0; a < below; ++a) {
+                const T* l_a = l21 + (a * width);
+                for (size_t b = 0; b <= a; ++b) {
+                    const T* l_b = l21 + (b * width);
+                    T sum = T(0);
+                    #pragma omp simd reduction(+ : sum)
+                    for (size_t k = 0; k < width; ++k) {
+                        sum += l_a[k] * l_b[k];
+                    }
+                    update[(a * below) + b] = sum;
+                }
+            }
+        }
+
+        // Scatter-subtract column by column; the columns of one ancestor
+        // are consecutive, so its relative row map is built once
+        size_t target = an.supernode_count();
+        for (size_t b = 0; b < below; ++b) {
+            const size_t j = rows[width + b];
+            if (an._super_of[j] != target) {
+                target = an._super_of[j];
+                for (size_t r = an._row_ptr[target]; r < an._row_ptr[target + 1]; ++r) {
+                    _relative[an._rows[r]] = r - an._row_ptr[target];
+                }
+            }
+            const size_t t_first = an._super_first[target];
+            const size_t t_width = an._super_first[target + 1] - t_first;
+            T* t_panel = _values.data() + an._panel_ptr[target] + (j - t_first);
+            for (size_t a = b; a < below; ++a) {
+                const size_t r = _relative[rows[width + a]];
+                t_panel[r * t_width] -= update[(a * below) + b];
+            }
+        }
+    }
+
+    /** @brief Solves L y = y in place. */
+    void _forward(T* y) const {
+        const SparseCholeskyAnalysis& an = _analysis;
+        for (size_t s = 0; s < an.supernode_count(); ++s) {
+            const size_t first = an._super_first[s];
+            const size_t width = an._super_first[s + 1] - first;
+            const size_t height = an._row_ptr[s + 1] - an._row_ptr[s];
+            const size_t* rows = an._rows.data() + an._row_ptr[s];
+            const T* panel = _values.data() + an._panel_ptr[s];
+            T* y_s = y + first;
+            for (size_t c = 0; c < width; ++c) {
+                const T* l_c = panel + (c * width);
+                T sum = y_s[c];
+                for (size_t k = 0; k < c; ++k) {
+                    sum -= l_c[k] * y_s[k];
+                }
+                y_s[c] = sum / l_c[c];
+            }
+            for (size_t r = width; r < height; ++r) {
+                const T* l_r = panel + (r * width);
+                T sum = T(0);
+                #pragma omp simd reduction(+ : sum)
+                for (size_t k = 0; k < width; ++k) {
+                    sum += l_r[k] * y_s[k];
+                }
+                y[rows[r]] -= sum;
+            }
+        }
+    }
+
+    /** @brief Solves L^T x = x in place. */
+    void _backward(T* x) const {
+        const SparseCholeskyAnalysis& an = _analysis;
+        for (size_t s = an.supernode_count(); s-- > 0;) {
+            const size_t first = an._super_first[s];
+            const size_t width = an._super_first[s + 1] - first;
+            const size_t height = an._row_ptr[s + 1] - an._row_ptr[s];
+            const size_t* rows = an._rows.data() + an._row_ptr[s];
+            const T* panel = _values.data() + an._panel_ptr[s];
+            T* x_s = x + first;
+            for (size_t r = width; r < height; ++r) {
+                const T* l_r = panel + (r * width);
+                const T x_r = x[rows[r]];
+                #pragma omp simd
+                for (size_t k = 0; k < width; ++k) {
+                    x_s[k] -= l_r[k] * x_r;
+                }
+            }
+            for (size_t c = width; c-- > 0;) {
+                T sum = x_s[c];
+                for (size_t k = c + 1; k < width; ++k) {
+                    sum -= panel[(k * width) + c] * x_s[k];
+                }
+                x_s[c] = sum / panel[(c * width) + c];
+            }
+        }
+    }
+};
+
+}  // namespace maf::math
+
+#endif
@@ -0,0 +1,758 @@
+#ifndef SPARSE_MATRIX_H
+#define SPARSE_MATRIX_H
+#pragma once
+#include "LinAlg.hpp"
+
+/**
+ * @file SparseMatrix.hpp
+ * @brief Compressed sparse row (CSR) matrix and its products with dense
+ * vectors and matrices.
+ *
+ * Only the non-zero elements are stored, in three arrays:
+ * - row_offsets() (rows + 1 entries): the non-zeros of row i are the
+ *   positions row_offsets()[i] up to row_offsets()[i + 1],
+ * - column_indices(): the column of every non-zero, increasing within a row,
+ * - values(): the non-zeros themselves.
+ *
+ * The CSR arrays of A^T are the compressed sparse column (CSC) arrays of A,
+ * so `transposed()` doubles as the CSC conversion.
+ *
+ * Products split the rows across OpenMP threads in runs of equal non-zero
+ * counts (not equal row counts), so a few dense rows do not serialize the
+ * work. Transposed products (A^T * x, x^T * A, A^T * B) are computed from
+ * the CSR arrays directly, without building A^T.
+ */
+namespace maf::math {
+/** @brief One (row, column, value) entry of a sparse matrix in COO form. */
+template <Numeric T>
+struct Triplet {
+    size_t row;
+    size_t col;
+    T value;
+};
+
+namespace detail {
+/**
+ * @brief First row of part `part` out of `parts` when the rows are split
+ * into runs with (nearly) equal numbers of non-zeros.
+ */
+[[nodiscard]] inline size_t _sparse_split(const size_t* offsets,
+                                          size_t rows,
+                                          size_t part,
+                                          size_t parts) noexcept {
+    if (part >= parts) {
+        return rows;
+    }
+    const size_t target = offsets[rows] / parts * part +
+                          (offsets[rows] % parts) * part / parts;
+    return static_cast<size_t>(std::lower_bound(offsets, offsets + rows, target) -
+                               offsets);
+}
+
+/**
+ * @brief Runs fn(first_row, last_row, part, parts) on non-zero balanced row
+ * ranges, one per thread when parallel is true.
+ */
+template <typename Fn>
+void _sparse_for_parts(const size_t* offsets, size_t rows, bool parallel, Fn&& fn) {
+    #pragma omp parallel if (parallel)
+    {
+        const auto parts = static_cast<size_t>(omp_get_num_threads());
+        const auto part = static_cast<size_t>(omp_get_thread_num());
+        fn(_sparse_split(offsets, rows, part, parts),
+           _sparse_split(offsets, rows, part + 1, parts),
+           part,
+           parts);
+    }
+}
+
+/**
+ * @brief SpMV kernel y = alpha * A * x + beta * y for a CSR matrix A with
+ * `rows` rows.
+ */
+template <typename R, typename T, typename TX, typename TY>
+void _spmv(size_t rows,
+           const size_t* offsets,
+           const size_t* indices,
+           const T* values,
+           R alpha,
+           const TX* x,
+           R beta,
+           TY* y) {
+    _sparse_for_parts(
+        offsets,
+        rows,
+        offsets[rows] > OMP_LINEAR_LIMIT,
+        [&](size_t first, size_t last, size_t /*part*/, size_t /*parts*/) {
+            for (size_t i = first; i < last; ++i) {
+                R sum = R(0);
+                #pragma omp simd reduction(+ : sum)
+                for (size_t k = offsets[i]; k < offsets[i + 1]; ++k) {
+                    sum += static_cast<R>(values[k]) * static_cast<R>(x[indices[k]]);
+                }
+                _gemv_store(alpha, sum, beta, y[i]);
+            }
+        });
+}
+
+/**
+ * @brief Transposed SpMV kernel y = alpha * A^T * x + beta * y for a
+ * rows x cols CSR matrix A.
+ * @details Rows scatter into per-thread accumulators that are summed at
+ * the end, so threads never write the same element.
+ */
+template <typename R, typename T, typename TX, typename TY>
+void _spmv_transposed(size_t rows,
+                      size_t cols,
+                      const size_t* offsets,
+                      const size_t* indices,
+                      const T* values,
+                      R alpha,
+                      const TX* x,
+                      R beta,
+                      TY* y) {
+    const bool parallel = offsets[rows] > OMP_LINEAR_LIMIT;
+    const size_t threads = parallel ? static_cast<size_t>(omp_get_max_threads()) : 1;
+    AlignedBuffer<R> partial(threads * cols);
+
+    #pragma omp parallel num_threads(threads) if (parallel)
+    {
+        const auto parts = static_cast<size_t>(omp_get_num_threads());
+        const auto part = static_cast<size_t>(omp_get_thread_num());
+        const size_t first = _sparse_split(offsets, rows, part, parts);
+        const size_t last = _sparse_split(offsets, rows, part + 1, parts);
+        R* acc = partial.data() + (part * cols);
+        for (size_t i = first; i < last; ++i) {
+            const auto x_i = static_cast<R>(x[i]);
+            for (size_t k = offsets[i]; k < offsets[i + 1]; ++k) {
+                acc[indices[k]] += static_cast<R>(values[k]) * x_i;
+            }
+        }
+
+        #pragma omp barrier
+        #pragma omp for schedule(static)
+        for (size_t j = 0; j < cols; ++j) {
+            R sum = R(0);
+            for (size_t p = 0; p < parts; ++p) {
+                sum += partial[(p * cols) + j];
+            }
+            _gemv_store(alpha, sum, beta, y[j]);
+        }
+    }
+}
+
+}  // namespace detail
+
+/**
+ * @brief A sparse matrix in compressed sparse row (CSR) format.
+ *
+ * Meant for matrices that are mostly zeros (e.g. factor exposures or
+ * constraint matrices), where dense storage wastes both memory and time.
+ * The structure is fixed after construction; build it from COO triplets
+ * (duplicates are summed), from CSR arrays, or from a dense matrix.
+ *
+ * Supported products: `A * x` (SpMV), `x * A` for a row vector, `A * B`
+ * with a dense B (SpMM), `A.transpose_multiply(x)` and
+ * `A.transpose_multiply(B)`, and the in-place spmv() / spvm().
+ *
+ * @tparam T The numeric type of the elements.
+ */
+template <Numeric T>
+class SparseMatrix {
+public:
+    /** @brief The numeric type of the matrix elements. */
+    using value_type = T;
+
+    // --- Constructors ---
+
+    /** @brief Creates an empty 0x0 matrix. */
+    SparseMatrix() : _rows(0), _cols(0), _offsets(1) {}
+
+    /**
+     * @brief Creates a rows x cols matrix without non-zeros.
+     * @throws std::invalid_argument if dimensions are zero.
+     */
+    SparseMatrix(size_t rows, size_t cols)
+        : _rows(rows), _cols(cols), _offsets(rows + 1) {
+        _check_dimensions();
+    }
+
+    /**
+     * @brief Builds the matrix from COO triplets, in any order.
+     * @details Entries with the same (row, col) are summed. The build is a
+     * counting sort by row followed by a sort of every row by column.
+     * @throws std::invalid_argument if dimensions are zero.
+     * @throws std::out_of_range if an entry lies outside the matrix.
+     */
+    SparseMatrix(size_t rows, size_t cols, std::span<const Triplet<T>> triplets)
+        : _rows(rows), _cols(cols), _offsets(rows + 1) {
+        _check_dimensions();
+        _build(
+            triplets.size(),
+            [&](size_t k) { return triplets[k].row; },
+            [&](size_t k) { return triplets[k].col; },
+            [&](size_t k) { return triplets[k].value; });
+    }
+
+    /**
+     * @brief Builds the matrix from COO arrays: entry k is
+     * values[k] at (row_indices[k], col_indices[k]).
+     * @details Entries with the same (row, col) are summed.
+     * @throws std::invalid_argument if dimensions are zero or the arrays
+     * have different sizes.
+     * @throws std::out_of_range if an entry lies outside the matrix.
+     */
+    SparseMatrix(size_t rows,
+                 size_t cols,
+                 std::span<const size_t> row_indices,
+                 std::span<const size_t> col_indices,
+                 std::span<const T> values)
+        : _rows(rows), _cols(cols), _offsets(rows + 1) {
+        _check_dimensions();
+        if (row_indices.size() != values.size() ||
+            col_indices.size() != values.size()) {
+            throw std::invalid_argument("COO arrays must have the same size!");
+        }
+        _build(
+            values.size(),
+            [&](size_t k) { return row_indices[k]; },
+            [&](size_t k) { return col_indices[k]; },
+            [&](size_t k) { return values[k]; });
+    }
+
+    /**
+     * @brief Keeps the elements of a dense matrix whose magnitude exceeds
+     * tolerance.
+     * @throws std::invalid_argument if the operand has zero dimensions.
+     */
+    template <MatrixOperand E>
+    explicit SparseMatrix(const E& dense, T tolerance = T(0))
+        : _rows(dense.row_count()), _cols(dense.column_count()), _offsets(_rows + 1) {
+        _check_dimensions();
+        const auto keep = [&](size_t i, size_t j) {
+            const auto value = static_cast<T>(dense(i, j));
+            return value > tolerance || -value > tolerance;
+        };
+        for (size_t i = 0; i < _rows; ++i) {
+            size_t count = 0;
+            for (size_t j = 0; j < _cols; ++j) {
+                count += keep(i, j) ? 1 : 0;
+            }
+            _offsets[i + 1] = _offsets[i] + count;
+        }
+        _indices.resize(_offsets[_rows], default_init);
+        _values.resize(_offsets[_rows], default_init);
+        for (size_t i = 0, k = 0; i < _rows; ++i) {
+            for (size_t j = 0; j < _cols; ++j) {
+                if (keep(i, j)) {
+                    _indices[k] = j;
+                    _values[k++] = static_cast<T>(dense(i, j));
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Creates a matrix from CSR arrays, copied as they are.
+     * @throws std::invalid_argument if dimensions are zero or the arrays do
+     * not describe a valid CSR matrix (offsets not starting at zero or not
+     * non-decreasing, columns out of range or not increasing within a row).
+     */
+    [[nodiscard]] static SparseMatrix from_csr(size_t rows,
+                                               size_t cols,
+                                               std::span<const size_t> row_offsets,
+                                               std::span<const size_t> col_indices,
+                                               std::span<const T> values) {
+        SparseMatrix result(rows, cols);
+        result._offsets.assign(row_offsets.begin(), row_offsets.end());
+        result._indices.assign(col_indices.begin(), col_indices.end());
+        result._values.assign(values.begin(), values.end());
+        result._check_structure();
+        return result;
+    }
+
+    // --- Getters ---
+
+    [[nodiscard]] size_t row_count() const noexcept {
+        return _rows;
+    }
+
+    [[nodiscard]] size_t column_count() const noexcept {
+        return _cols;
+    }
+
+    /** @brief Number of stored elements (explicit zeros included). */
+    [[nodiscard]] size_t non_zero_count() const noexcept {
+        return _values.size();
+    }
+
+    /** @brief Fraction of the elements that are stored. */
+    [[nodiscard]] double density() const noexcept {
+        if (_rows == 0) {
+            return 0.0;
+        }
+        const double size = static_cast<double>(_rows) * static_cast<double>(_cols);
+        return static_cast<double>(non_zero_count()) / size;
+    }
+
+    [[nodiscard]] bool is_square() const noexcept {
+        return _rows == _cols;
+    }
+
+    /** @brief Row i occupies positions [offsets[i], offsets[i + 1]). */
+    [[nodiscard]] std::span<const size_t> row_offsets() const noexcept {
+        return {_offsets.data(), _offsets.size()};
+    }
+
+    [[nodiscard]] std::span<const size_t> column_indices() const noexcept {
+        return {_indices.data(), _indices.size()};
+    }
+
+    [[nodiscard]] std::span<const T> values() const noexcept {
+        return {_values.data(), _values.size()};
+    }
+
+    /**
+     * @brief Mutable access to the stored values; the structure stays
+     * fixed.
+     */
+    [[nodiscard]] std::span<T> values() noexcept {
+        return {_values.data(), _values.size()};
+    }
+
+    /**
+     * @brief Reads element (row, col), zero if it is not stored.
+     * @details Binary search within the row.
+     * @throws std::out_of_range if the index is invalid.
+     */
+    [[nodiscard]] T at(size_t row, size_t col) const {
+        if (row >= _rows || col >= _cols) {
+            throw std::out_of_range("Matrix index out of range.");
+        }
+        const size_t* first = _indices.data() + _offsets[row];
+        const size_t* last = _indices.data() + _offsets[row + 1];
+        const size_t* it = std::lower_bound(first, last, col);
+        return (it != last && *it == col) ? _values[it - _indices.data()] : T(0);
+    }
+
+    // --- Methods ---
+
+    /** @brief Expands the matrix into dense storage. */
+    [[nodiscard]] Matrix<T> to_dense() const {
+        Matrix<T> result(_rows, _cols);
+        #pragma omp parallel for if (_rows * _cols > OMP_LINEAR_LIMIT)
+        for (size_t i = 0; i < _rows; ++i) {
+            for (size_t k = _offsets[i]; k < _offsets[i + 1]; ++k) {
+                result(i, _indices[k]) = _values[k];
+            }
+        }
+        return result;
+    }
+
+    /**
+     * @brief Returns A^T, whose CSR arrays are the CSC arrays of A.
+     * @details A counting sort by column; the rows of the result come out
+     * sorted without a comparison sort.
+     */
+    [[nodiscard]] SparseMatrix transposed() const {
+        SparseMatrix result;
+        result._rows = _cols;
+        result._cols = _rows;
+        result._offsets = AlignedBuffer<size_t>(_cols + 1);
+        result._indices = AlignedBuffer<size_t>(non_zero_count(), default_init);
+        result._values = AlignedBuffer<T>(non_zero_count(), default_init);
+
+        for (size_t k = 0; k < non_zero_count(); ++k) {
+            ++result._offsets[_indices[k] + 1];
+        }
+        std::partial_sum(
+            result._offsets.begin(), result._offsets.end(), result._offsets.begin());
+
+        AlignedBuffer<size_t> cursor(result._offsets.begin(),
+                                     result._offsets.end() - 1);
+        for (size_t i = 0; i < _rows; ++i) {
+            for (size_t k = _offsets[i]; k < _offsets[i + 1]; ++k) {
+                const size_t dst = cursor[_indices[k]]++;
+                result._indices[dst] = i;
+                result._values[dst] = _values[k];
+            }
+        }
+        return result;
+    }
+
+    /**
+     * @brief Computes A^T * x (x has row_count() elements) without forming
+     * A^T.
+     * @details The orientation of x is not checked; the result is a column
+     * vector.
+     * @throws std::invalid_argument if the sizes do not match.
+     */
+    template <Numeric U>
+    [[nodiscard]] auto transpose_multiply(const Vector<U>& x) const {
+        using R = std::common_type_t<T, U>;
+        if (x.size() != _rows) {
+            throw std::invalid_argument(
+                "Dimension mismatch in SparseMatrix^T * Vector multiplication.");
+        }
+        Vector<R> result(_cols, default_init, COLUMN);
+        detail::_spmv_transposed(_rows,
+                                 _cols,
+                                 _offsets.data(),
+                                 _indices.data(),
+                                 _values.data(),
+                                 R(1),
+                                 x.data().data(),
+                                 R(0),
+                                 result.data().data());
+        return result;
+    }
+
+    /**
+     * @brief Computes A^T * B for a dense B with row_count() rows, without
+     * forming A^T.
+     * @details Threads own disjoint column ranges of the result, so the
+     * scattered updates never conflict.
+     * @throws std::invalid_argument if the sizes do not match.
+     */
+    template <MatrixOperand E>
+    [[nodiscard]] auto transpose_multiply(const E& dense) const {
+        if constexpr (detail::_strided_operand<E>) {
+            return _multiply_transposed_dense(detail::_as_view(dense));
+        } else {
+            return _multiply_transposed_dense(detail::_as_view(dense.eval()));
+        }
+    }
+
+    // --- Operators ---
+
+    /** @brief Exact equality of shape, structure and values. */
+    [[nodiscard]] bool operator==(const SparseMatrix& other) const noexcept {
+        return _rows == other._rows && _cols == other._cols &&
+               _offsets == other._offsets && _indices == other._indices &&
+               _values == other._values;
+    }
+
+    SparseMatrix& operator*=(T scalar) noexcept {
+        for (T& value : _values) {
+            value *= scalar;
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Sparse matrix - vector multiplication (SpMV).
+     * @throws std::invalid_argument if the vector is a row vector or the
+     * sizes do not match.
+     */
+    template <Numeric U>
+    [[nodiscard]] auto operator*(const Vector<U>& x) const {
+        using R = std::common_type_t<T, U>;
+        if (x.orientation() == Orientation::ROW) {
+            throw std::invalid_argument(
+                "Invalid multiplication: matrix * row vector.\n"
+                "Did you mean Vector * Matrix?");
+        }
+        if (x.size() != _cols) {
+            throw std::invalid_argument(
+                "Dimension mismatch in SparseMatrix * Vector multiplication.");
+        }
+        Vector<R> result(_rows, default_init, COLUMN);
+        detail::_spmv(_rows,
+                      _offsets.data(),
+                      _indices.data(),
+                      _values.data(),
+                      R(1),
+                      x.data().data(),
+                      R(0),
+                      result.data().data());
+        return result;
+    }
+
+    /**
+     * @brief Sparse matrix - dense matrix multiplication (SpMM).
+     * @details Every row of the result is a combination of rows of the
+     * dense operand, updated with SIMD when those rows are contiguous.
+     * @throws std::invalid_argument if the sizes do not match.
+     */
+    template <MatrixOperand E>
+    [[nodiscard]] auto operator*(const E& dense) const {
+        if constexpr (detail::_strided_operand<E>) {
+            return _multiply_dense(detail::_as_view(dense));
+        } else {
+            return _multiply_dense(detail::_as_view(dense.eval()));
+        }
+    }
+
+private:
+    size_t _rows;
+    size_t _cols;
+    AlignedBuffer<size_t> _offsets;
+    AlignedBuffer<size_t> _indices;
+    AlignedBuffer<T> _values;
+
+    void _check_dimensions() const {
+        if (_rows == 0 || _cols == 0) {
+            throw std::invalid_argument("Matrix dimensions must be greater than zero.");
+        }
+    }
+
+    void _check_structure() const {
+        if (_offsets.size() != _rows + 1 || _offsets[0] != 0 ||
+            _offsets[_rows] != _values.size() || _indices.size() != _values.size()) {
+            throw std::invalid_argument("Invalid CSR arrays!");
+        }
+        for (size_t i = 0; i < _rows; ++i) {
+            if (_offsets[i] > _offsets[i + 1]) {
+                throw std::invalid_argument("CSR row offsets must be non-decreasing!");
+            }
+            for (size_t k = _offsets[i]; k < _offsets[i + 1]; ++k) {
+                if (_indices[k] >= _cols ||
+                    (k > _offsets[i] && _indices[k] <= _indices[k - 1])) {
+                    throw std::invalid_argument(
+                        "CSR column indices must be in range and increasing!");
+                }
+            }
+        }
+    }
+
+    /** @brief Builds the CSR arrays from nnz COO entries given by accessors. */
+    template <typename RowAt, typename ColAt, typename ValueAt>
+    void _build(size_t nnz,
+                const RowAt& row_at,
+                const ColAt& col_at,
+                const ValueAt& value_at) {
+        for (size_t k = 0; k < nnz; ++k) {
+            if (row_at(k) >= _rows || col_at(k) >= _cols) {
+                throw std::out_of_range("Sparse matrix entry out of range.");
+            }
+            ++_offsets[row_at(k) + 1];
+        }
+        std::partial_sum(_offsets.begin(), _offsets.end(), _offsets.begin());
+
+        // Counting sort by row
+        _indices.resize(nnz, default_init);
+        _values.resize(nnz, default_init);
+        AlignedBuffer<size_t> cursor(_offsets.begin(), _offsets.end() - 1);
+        for (size_t k = 0; k < nnz; ++k) {
+            const size_t dst = cursor[row_at(k)]++;
+            _indices[dst] = col_at(k);
+            _values[dst] = static_cast<T>(value_at(k));
+        }
+
+        // Sort every row by column and sum duplicates; cursor[i] becomes
+        // the merged length of row i
+        #pragma omp parallel if (nnz > OMP_LINEAR_LIMIT)
+        {
+            std::vector<std::pair<size_t, T>> row;
+            #pragma omp for schedule(dynamic, 64)
+            for (size_t i = 0; i < _rows; ++i) {
+                const size_t begin = _offsets[i];
+                const size_t end = _offsets[i + 1];
+                row.clear();
+                for (size_t k = begin; k < end; ++k) {
+                    row.emplace_back(_indices[k], _values[k]);
+                }
+                std::sort(row.begin(), row.end(), [](const auto& a, const auto& b) {
+                    return a.first < b.first;
+                });
+                size_t length = 0;
+                for (const auto& [col, value] : row) {
+                    if (length > 0 && _indices[begin + length - 1] == col) {
+                        _values[begin + length - 1] += value;
+                    } else {
+                        _indices[begin + length] = col;
+                        _values[begin + length] = value;
+                        ++length;
+                    }
+                }
+                cursor[i] = length;
+            }
+        }
+
+        // Close the gaps left by merged duplicates
+        size_t next = 0;
+        for (size_t i = 0; i < _rows; ++i) {
+            const size_t begin = _offsets[i];
+            std::copy(_indices.begin() + begin,
+                      _indices.begin() + begin + cursor[i],
+                      _indices.begin() + next);
+            std::copy(_values.begin() + begin,
+                      _values.begin() + begin + cursor[i],
+                      _values.begin() + next);
+            _offsets[i] = next;
+            next += cursor[i];
+        }
+        _offsets[_rows] = next;
+        _indices.resize(next, default_init, next);
+        _values.resize(next, default_init, next);
+    }
+
+    /** @brief SpMM: every thread owns a non-zero balanced range of rows. */
+    template <Numeric U>
+    [[nodiscard]] auto _multiply_dense(ConstMatrixView<U> b) const {
+        using R = std::common_type_t<T, U>;
+        if (b.row_count() != _cols) {
+            throw std::invalid_argument(
+                "Dimension mismatch in SparseMatrix * Matrix multiplication.");
+        }
+        const size_t n = b.column_count();
+        const size_t rsb = b.row_stride();
+        const size_t csb = b.col_stride();
+        Matrix<R> result(_rows, n);
+        R* c = result.data().data();
+        const size_t ldc = result.leading_dimension();
+
+        detail::_sparse_for_parts(
+            _offsets.data(),
+            _rows,
+            non_zero_count() * n > OMP_LINEAR_LIMIT,
+            [&](size_t first, size_t last, size_t /*part*/, size_t /*parts*/) {
+                for (size_t i = first; i < last; ++i) {
+                    R* c_row = c + (i * ldc);
+                    for (size_t k = _offsets[i]; k < _offsets[i + 1]; ++k) {
+                        const auto a_ik = static_cast<R>(_values[k]);
+                        const U* b_row = b.data() + (_indices[k] * rsb);
+                        if (csb == 1) {
+                            #pragma omp simd
+                            for (size_t j = 0; j < n; ++j) {
+                                c_row[j] += a_ik * static_cast<R>(b_row[j]);
+                            }
+                        } else {
+                            for (size_t j = 0; j < n; ++j) {
+                                c_row[j] += a_ik * static_cast<R>(b_row[j * csb]);
+                            }
+                        }
+                    }
+                }
+            });
+        return result;
+    }
+
+    /** @brief A^T * B: threads split the columns of B and of the result. */
+    template <Numeric U>
+    [[nodiscard]] auto _multiply_transposed_dense(ConstMatrixView<U> b) const {
+        using R = std::common_type_t<T, U>;
+        if (b.row_count() != _rows) {
+            throw std::invalid_argument(
+                "Dimension mismatch in SparseMatrix^T * Matrix multiplication.");
+        }
+        const size_t n = b.column_count();
+        const size_t rsb = b.row_stride();
+        const size_t csb = b.col_stride();
+        Matrix<R> result(_cols, n);
+        R* c = result.data().data();
+        const size_t ldc = result.leading_dimension();
+
+        #pragma omp parallel if (non_zero_count() * n > OMP_LINEAR_LIMIT)
+        {
+            const auto parts = static_cast<size_t>(omp_get_num_threads());
+            const auto part = static_cast<size_t>(omp_get_thread_num());
+            const size_t j0 = n * part / parts;
+            const size_t j1 = n * (part + 1) / parts;
+            for (size_t i = 0; i < _rows && j0 < j1; ++i) {
+                const U* b_row = b.data() + (i * rsb);
+                for (size_t k = _offsets[i]; k < _offsets[i + 1]; ++k) {
+                    const auto a_ik = static_cast<R>(_values[k]);
+                    R* c_row = c + (_indices[k] * ldc);
+                    #pragma omp simd
+                    for (size_t j = j0; j < j1; ++j) {
+                        c_row[j] += a_ik * static_cast<R>(b_row[j * csb]);
+                    }
+                }
+            }
+        }
+        return result;
+    }
+};
+
+/**
+ * @brief Row vector - sparse matrix multiplication x^T * A.
+ * @details Computed from the CSR arrays of A, without forming A^T.
+ * @throws std::invalid_argument if the vector is a column vector or the
+ * sizes do not match.
+ */
+template <Numeric U, Numeric T>
+[[nodiscard]] auto operator*(const Vector<U>& x, const SparseMatrix<T>& a) {
+    if (x.orientation() == Orientation::COLUMN) {
+        throw std::invalid_argument(
+            "Invalid multiplication: column vector * matrix.\n"
+            "Did you mean Matrix * Vector?");
+    }
+    auto result = a.transpose_multiply(x);
+    result.transpose();
+    return result;
+}
+
+/**
+ * @brief In-place sparse matrix - vector product y = alpha * A * x + beta * y.
+ * @details Does not allocate. The orientation of the vectors is not checked.
+ * When beta is zero, y is not read.
+ * @throws std::invalid_argument if x does not have a.column_count()
+ * elements, y does not have a.row_count() elements, or x and y are the same
+ * vector.
+ */
+template <Numeric T, Numeric TA, Numeric U>
+void spmv(std::type_identity_t<T> alpha,
+          const SparseMatrix<TA>& a,
+          const Vector<U>& x,
+          std::type_identity_t<T> beta,
+          Vector<T>& y) {
+    if (x.size() != a.column_count() || y.size() != a.row_count()) {
+        throw std::invalid_argument(
+            "Dimension mismatch in SparseMatrix * Vector multiplication.");
+    }
+    if constexpr (std::is_same_v<T, U>) {
+        if (&x == &y) {
+            throw std::invalid_argument("Output vector must not be the input vector!");
+        }
+    }
+    using R = std::common_type_t<T, TA, U>;
+    detail::_spmv(a.row_count(),
+                  a.row_offsets().data(),
+                  a.column_indices().data(),
+                  a.values().data(),
+                  static_cast<R>(alpha),
+                  x.data().data(),
+                  static_cast<R>(beta),
+                  y.data().data());
+}
+
+/**
+ * @brief In-place vector - sparse matrix product
+ * y = alpha * x^T * A + beta * y (equivalently A^T * x).
+ * @details Allocates one accumulator of a.column_count() elements per
+ * thread. The orientation of the vectors is not checked. When beta is zero,
+ * y is not read.
+ * @throws std::invalid_argument if x does not have a.row_count() elements,
+ * y does not have a.column_count() elements, or x and y are the same vector.
+ */
+template <Numeric T, Numeric U, Numeric TA>
+void spvm(std::type_identity_t<T> alpha,
+          const Vector<U>& x,
+          const SparseMatrix<TA>& a,
+          std::type_identity_t<T> beta,
+          Vector<T>& y) {
+    if (x.size() != a.row_count() || y.size() != a.column_count()) {
+        throw std::invalid_argument(
+            "Dimension mismatch in Vector * SparseMatrix multiplication.");
+    }
+    if constexpr (std::is_same_v<T, U>) {
+        if (&x == &y) {
+            throw std::invalid_argument("Output vector must not be the input vector!");
+        }
+    }
+    using R = std::common_type_t<T, TA, U>;
+    detail::_spmv_transposed(a.row_count(),
+                             a.column_count(),
+                             a.row_offsets().data(),
+                             a.column_indices().data(),
+                             a.values().data(),
+                             static_cast<R>(alpha),
+                             x.data().data(),
+                             static_cast<R>(beta),
+                             y.data().data());
+}
+
+}  // namespace maf::math
+
+#endif
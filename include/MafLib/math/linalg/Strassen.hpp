@@ -0,0 +1,452 @@
+#ifndef STRASSEN_H
+#define STRASSEN_H
+#pragma once
+#include "Matrix.hpp"
+
+/**
+ * @file Strassen.hpp
+ * @brief Opt-in Strassen-Winograd multiplication for very large products.
+ *
+ * Every recursion level splits A, B and C into 2 x 2 quadrants and forms the
+ * product from 7 half-size products and 15 quadrant additions (Winograd's
+ * variant of Strassen's algorithm) instead of 8 products. Below a cutoff the
+ * packed GEMM engine from Gemm.hpp takes over, because there the saved
+ * multiplications no longer pay for the extra additions and memory traffic.
+ *
+ * - Workspace: the temporaries of all recursion levels are carved out of a
+ *   single buffer that is allocated once per call. Sequential levels use the
+ *   two-temporary schedule of Boyer, Dumas, Pernet and Zhou ("Memory
+ *   efficient scheduling of Strassen-Winograd's matrix multiplication
+ *   algorithm", 2009) and write the products straight into C.
+ * - Parallelism: the top STRASSEN_TASK_LEVELS levels store their operands
+ *   and products in separate temporaries and run the 7 products as OpenMP
+ *   tasks (49 tasks for two levels).
+ * - Odd dimensions are handled by dynamic peeling: the even part is
+ *   multiplied recursively and the remaining row, column and rank-1 update
+ *   are done with GEMM.
+ *
+ * The result differs from the classical product by rounding only, but the
+ * error bound grows faster with n, so this is not the default for
+ * Matrix::operator*.
+ *
+ * This file is included by Matrix.hpp and should not be included directly
+ * anywhere else.
+ */
+namespace maf::math {
+/** @brief Default dimension at or below which Strassen recursion stops. */
+constexpr static size_t STRASSEN_CUTOFF = 512;
+
+/** @brief Recursion levels that run their 7 products as OpenMP tasks. */
+constexpr static size_t STRASSEN_TASK_LEVELS = 2;
+
+namespace detail {
+/** @brief c = a + sign * b for strided operands of equal shape. */
+template <std::floating_point T>
+void _strassen_add(ConstMatrixView<T> a,
+                   ConstMatrixView<T> b,
+                   T sign,
+                   MatrixView<T> c) noexcept {
+    const size_t rows = c.row_count();
+    const size_t cols = c.column_count();
+    const bool contiguous =
+        a.col_stride() == 1 && b.col_stride() == 1 && c.col_stride() == 1;
+
+    for (size_t i = 0; i < rows; ++i) {
+        const T* a_row = a.data() + (i * a.row_stride());
+        const T* b_row = b.data() + (i * b.row_stride());
+        T* c_row = c.data() + (i * c.row_stride());
+        if (contiguous) {
+            #pragma omp simd
+            for (size_t j = 0; j < cols; ++j) {
+                c_row[j] = a_row[j] + (sign * b_row[j]);
+            }
+        } else {
+            for (size_t j = 0; j < cols; ++j) {
+                c_row[j * c.col_stride()] =
+                    a_row[j * a.col_stride()] + (sign * b_row[j * b.col_stride()]);
+            }
+        }
+    }
+}
+
+/** @brief Takes a rows x cols row-major matrix off the front of a workspace. */
+template <std::floating_point T>
+[[nodiscard]] MatrixView<T> _strassen_take(T*& workspace, size_t rows, size_t cols) {
+    MatrixView<T> view(workspace, rows, cols, cols, 1);
+    workspace += rows * cols;
+    return view;
+}
+
+/** @brief True if (m, n, k) is small enough for the GEMM base case. */
+[[nodiscard]] inline bool _strassen_is_leaf(size_t m,
+                                            size_t n,
+                                            size_t k,
+                                            size_t cutoff) noexcept {
+    return std::min({m, n, k}) <= std::max<size_t>(cutoff, 1);
+}
+
+/**
+ * @brief Number of workspace elements _strassen() needs for an m x k by
+ * k x n product.
+ */
+[[nodiscard]] inline size_t _strassen_workspace_size(size_t m,
+                                                     size_t n,
+                                                     size_t k,
+                                                     size_t cutoff,
+                                                     size_t task_levels) noexcept {
+    if (_strassen_is_leaf(m, n, k, cutoff)) {
+        return 0;
+    }
+    const size_t m2 = m / 2;
+    const size_t n2 = n / 2;
+    const size_t k2 = k / 2;
+    const size_t child = _strassen_workspace_size(
+        m2, n2, k2, cutoff, task_levels > 0 ? task_levels - 1 : 0);
+
+    if (task_levels > 0) {
+        // S1..S4, T1..T4, P1..P7 and a private workspace for every task
+        return (4 * m2 * k2) + (4 * k2 * n2) + (7 * m2 * n2) + (7 * child);
+    }
+    // X, Y and the workspace shared by the sequential sub-products
+    return (m2 * std::max(k2, n2)) + (k2 * n2) + child;
+}
+
+template <std::floating_point T>
+void _strassen(ConstMatrixView<T> a,
+               ConstMatrixView<T> b,
+               MatrixView<T> c,
+               T* workspace,
+               size_t cutoff,
+               size_t task_levels);
+
+/**
+ * @brief One sequential Strassen-Winograd level on even-sized operands.
+ * @details Two temporaries, X (m2 x max(k2, n2)) and Y (k2 x n2); the
+ * quadrants of C hold the remaining intermediate results.
+ */
+template <std::floating_point T>
+void _strassen_sequential_step(ConstMatrixView<T> a,
+                               ConstMatrixView<T> b,
+                               MatrixView<T> c,
+                               T* workspace,
+                               size_t cutoff) {
+    const size_t m2 = c.row_count() / 2;
+    const size_t n2 = c.column_count() / 2;
+    const size_t k2 = a.column_count() / 2;
+
+    const auto a11 = a.block(0, 0, m2, k2);
+    const auto a12 = a.block(0, k2, m2, k2);
+    const auto a21 = a.block(m2, 0, m2, k2);
+    const auto a22 = a.block(m2, k2, m2, k2);
+    const auto b11 = b.block(0, 0, k2, n2);
+    const auto b12 = b.block(0, n2, k2, n2);
+    const auto b21 = b.block(k2, 0, k2, n2);
+    const auto b22 = b.block(k2, n2, k2, n2);
+    auto c11 = c.block(0, 0, m2, n2);
+    auto c12 = c.block(0, n2, m2, n2);
+    auto c21 = c.block(m2, 0, m2, n2);
+    auto c22 = c.block(m2, n2, m2, n2);
+
+    T* x_data = workspace;
+    const auto x = MatrixView<T>(x_data, m2, k2, k2, 1);
+    const auto x_product = MatrixView<T>(x_data, m2, n2, n2, 1);
+    workspace += m2 * std::max(k2, n2);
+    const auto y = _strassen_take(workspace, k2, n2);
+
+    _strassen_add<T>(a11, a21, T(-1), x);                     // S3
+    _strassen_add<T>(b22, b12, T(-1), y);                     // T3
+    _strassen<T>(x, y, c21, workspace, cutoff, 0);            // P7
+    _strassen_add<T>(a21, a22, T(1), x);                      // S1
+    _strassen_add<T>(b12, b11, T(-1), y);                     // T1
+    _strassen<T>(x, y, c22, workspace, cutoff, 0);            // P5
+    _strassen_add<T>(x, a11, T(-1), x);                       // S2
+    _strassen_add<T>(b22, y, T(-1), y);                       // T2
+    _strassen<T>(x, y, c12, workspace, cutoff, 0);            // P6
+    _strassen_add<T>(a12, x, T(-1), x);                       // S4
+    _strassen<T>(x, b22, c11, workspace, cutoff, 0);          // P3
+    _strassen<T>(a11, b11, x_product, workspace, cutoff, 0);  // P1
+    _strassen_add<T>(x_product, c12, T(1), c12);              // U2 = P1 + P6
+    _strassen_add<T>(c12, c21, T(1), c21);                    // U3 = U2 + P7
+    _strassen_add<T>(c12, c22, T(1), c12);                    // U4 = U2 + P5
+    _strassen_add<T>(c21, c22, T(1), c22);                    // U7 = U3 + P5
+    _strassen_add<T>(c12, c11, T(1), c12);                    // U5 = U4 + P3
+    _strassen_add<T>(y, b21, T(-1), y);                       // T4
+    _strassen<T>(a22, y, c11, workspace, cutoff, 0);          // P4
+    _strassen_add<T>(c21, c11, T(-1), c21);                   // U6 = U3 - P4
+    _strassen<T>(a12, b21, c11, workspace, cutoff, 0);        // P2
+    _strassen_add<T>(x_product, c11, T(1), c11);              // U1 = P1 + P2
+}
+
+/**
+ * @brief One task-parallel Strassen-Winograd level on even-sized operands.
+ * @details Operand sums and the 7 products get their own temporaries so
+ * that the products are independent and can run as OpenMP tasks. Must be
+ * called from inside a parallel region.
+ */
+template <std::floating_point T>
+void _strassen_parallel_step(ConstMatrixView<T> a,
+                             ConstMatrixView<T> b,
+                             MatrixView<T> c,
+                             T* workspace,
+                             size_t cutoff,
+                             size_t task_levels) {
+    const size_t m2 = c.row_count() / 2;
+    const size_t n2 = c.column_count() / 2;
+    const size_t k2 = a.column_count() / 2;
+
+    const auto a11 = a.block(0, 0, m2, k2);
+    const auto a12 = a.block(0, k2, m2, k2);
+    const auto a21 = a.block(m2, 0, m2, k2);
+    const auto a22 = a.block(m2, k2, m2, k2);
+    const auto b11 = b.block(0, 0, k2, n2);
+    const auto b12 = b.block(0, n2, k2, n2);
+    const auto b21 = b.block(k2, 0, k2, n2);
+    const auto b22 = b.block(k2, n2, k2, n2);
+
+    std::array<MatrixView<T>, 4> s = {_strassen_take(workspace, m2, k2),
+                                      _strassen_take(workspace, m2, k2),
+                                      _strassen_take(workspace, m2, k2),
+                                      _strassen_take(workspace, m2, k2)};
+    std::array<MatrixView<T>, 4> t = {_strassen_take(workspace, k2, n2),
+                                      _strassen_take(workspace, k2, n2),
+                                      _strassen_take(workspace, k2, n2),
+                                      _strassen_take(workspace, k2, n2)};
+    _strassen_add<T>(a21, a22, T(1), s[0]);    // S1
+    _strassen_add<T>(s[0], a11, T(-1), s[1]);  // S2
+    _strassen_add<T>(a11, a21, T(-1), s[2]);   // S3
+    _strassen_add<T>(a12, s[1], T(-1), s[3]);  // S4
+    _strassen_add<T>(b12, b11, T(-1), t[0]);   // T1
+    _strassen_add<T>(b22, t[0], T(-1), t[1]);  // T2
+    _strassen_add<T>(b22, b12, T(-1), t[2]);   // T3
+    _strassen_add<T>(t[1], b21, T(-1), t[3]);  // T4
+
+    // P1 = A11 B11, P2 = A12 B21, P3 = S4 B22, P4 = A22 T4, P5 = S1 T1,
+    // P6 = S2 T2, P7 = S3 T3
+    const std::array<ConstMatrixView<T>, 7> lhs = {
+        a11, a12, s[3], a22, s[0], s[1], s[2]};
+    const std::array<ConstMatrixView<T>, 7> rhs = {
+        b11, b21, b22, t[3], t[0], t[1], t[2]};
+    std::array<MatrixView<T>, 7> p = {_strassen_take(workspace, m2, n2),
+                                      _strassen_take(workspace, m2, n2),
+                                      _strassen_take(workspace, m2, n2),
+                                      _strassen_take(workspace, m2, n2),
+                                      _strassen_take(workspace, m2, n2),
+                                      _strassen_take(workspace, m2, n2),
+                                      _strassen_take(workspace, m2, n2)};
+    const size_t child_size =
+        _strassen_workspace_size(m2, n2, k2, cutoff, task_levels - 1);
+
+    for (size_t i = 0; i < 7; ++i) {
+        T* child_workspace = workspace + (i * child_size);
+        #pragma omp task firstprivate(i, child_workspace) shared(lhs, rhs, p)
+        _strassen<T>(lhs[i], rhs[i], p[i], child_workspace, cutoff, task_levels - 1);
+    }
+    #pragma omp taskwait
+
+    auto c11 = c.block(0, 0, m2, n2);
+    auto c12 = c.block(0, n2, m2, n2);
+    auto c21 = c.block(m2, 0, m2, n2);
+    auto c22 = c.block(m2, n2, m2, n2);
+    _strassen_add<T>(p[0], p[1], T(1), c11);  // U1 = P1 + P2
+    _strassen_add<T>(p[0], p[5], T(1), c12);  // U2 = P1 + P6
+    _strassen_add<T>(c12, p[6], T(1), c21);   // U3 = U2 + P7
+    _strassen_add<T>(c21, p[4], T(1), c22);   // U7 = U3 + P5
+    _strassen_add<T>(c21, p[3], T(-1), c21);  // U6 = U3 - P4
+    _strassen_add<T>(c12, p[4], T(1), c12);   // U4 = U2 + P5
+    _strassen_add<T>(c12, p[2], T(1), c12);   // U5 = U4 + P3
+}
+
+/**
+ * @brief Recursive Strassen-Winograd product C = A * B.
+ * @details C must not alias A or B and is write-only. The workspace must
+ * hold _strassen_workspace_size(m, n, k, cutoff, task_levels) elements.
+ */
+template <std::floating_point T>
+void _strassen(ConstMatrixView<T> a,
+               ConstMatrixView<T> b,
+               MatrixView<T> c,
+               T* workspace,
+               size_t cutoff,
+               size_t task_levels) {
+    const size_t m = a.row_count();
+    const size_t k = a.column_count();
+    const size_t n = b.column_count();
+
+    if (_strassen_is_leaf(m, n, k, cutoff)) {
+        _gemm(m,
+              n,
+              k,
+              T(1),
+              a.data(),
+              a.row_stride(),
+              a.col_stride(),
+              b.data(),
+              b.row_stride(),
+              b.col_stride(),
+              T(0),
+              c.data(),
+              c.row_stride(),
+              c.col_stride());
+        return;
+    }
+
+    // Recurse on the even part, peel the odd row / column / inner index
+    const size_t me = m - (m % 2);
+    const size_t ne = n - (n % 2);
+    const size_t ke = k - (k % 2);
+    const auto a_even = a.block(0, 0, me, ke);
+    const auto b_even = b.block(0, 0, ke, ne);
+    auto c_even = c.block(0, 0, me, ne);
+
+    if (task_levels > 0) {
+        _strassen_parallel_step(a_even, b_even, c_even, workspace, cutoff, task_levels);
+    } else {
+        _strassen_sequential_step(a_even, b_even, c_even, workspace, cutoff);
+    }
+
+    if (ke != k) {
+        const auto a_col = a.block(0, ke, me, 1);
+        const auto b_row = b.block(ke, 0, 1, ne);
+        _gemm(me,
+              ne,
+              1,
+              T(1),
+              a_col.data(),
+              a_col.row_stride(),
+              a_col.col_stride(),
+              b_row.data(),
+              b_row.row_stride(),
+              b_row.col_stride(),
+              T(1),
+              c_even.data(),
+              c_even.row_stride(),
+              c_even.col_stride());
+    }
+    if (ne != n) {
+        const auto a_top = a.block(0, 0, me, k);
+        const auto b_col = b.block(0, ne, k, 1);
+        auto c_col = c.block(0, ne, me, 1);
+        _gemm(me,
+              1,
+              k,
+              T(1),
+              a_top.data(),
+              a_top.row_stride(),
+              a_top.col_stride(),
+              b_col.data(),
+              b_col.row_stride(),
+              b_col.col_stride(),
+              T(0),
+              c_col.data(),
+              c_col.row_stride(),
+              c_col.col_stride());
+    }
+    if (me != m) {
+        const auto a_row = a.block(me, 0, 1, k);
+        auto c_row = c.block(me, 0, 1, n);
+        _gemm(1,
+              n,
+              k,
+              T(1),
+              a_row.data(),
+              a_row.row_stride(),
+              a_row.col_stride(),
+              b.data(),
+              b.row_stride(),
+              b.col_stride(),
+              T(0),
+              c_row.data(),
+              c_row.row_stride(),
+              c_row.col_stride());
+    }
+}
+
+/**
+ * @brief Allocates the workspace once and runs _strassen(), spawning tasks
+ * when more than one thread is available.
+ */
+template <std::floating_point T>
+void _strassen_multiply(ConstMatrixView<T> a,
+                        ConstMatrixView<T> b,
+                        MatrixView<T> c,
+                        size_t cutoff) {
+    const size_t m = a.row_count();
+    const size_t k = a.column_count();
+    const size_t n = b.column_count();
+
+    const bool parallel = omp_get_max_threads() > 1 && !omp_in_parallel() &&
+                          !_strassen_is_leaf(m, n, k, cutoff);
+    const size_t task_levels = parallel ? STRASSEN_TASK_LEVELS : 0;
+    AlignedBuffer<T> workspace(_strassen_workspace_size(m, n, k, cutoff, task_levels),
+                               default_init);
+
+    #pragma omp parallel if (parallel)
+    {
+        #pragma omp single
+        _strassen<T>(a, b, c, workspace.data(), cutoff, task_levels);
+    }
+}
+
+}  // namespace detail
+
+/**
+ * @brief Multiplies two matrices with the Strassen-Winograd algorithm.
+ *
+ * Opt-in alternative to `a * b` for very large dense products. Recursion
+ * stops once any dimension is at or below `cutoff`; those products run on
+ * the packed GEMM engine. Rectangular and odd-sized operands are supported.
+ * Integer operands are multiplied in double.
+ *
+ * Roughly, the recursion saves 1/8 of the work per level, so it starts to
+ * beat the plain product at a few times the cutoff. The best cutoff depends
+ * on the machine; `strassen_time_test` in the matrix tests prints the
+ * timings of both algorithms for a range of sizes.
+ *
+ * More information:
+ * https://en.wikipedia.org/wiki/Strassen_algorithm#Winograd_form
+ *
+ * @tparam ResultType Optional floating point type of the result.
+ * @param a Left operand (m x k).
+ * @param b Right operand (k x n).
+ * @param cutoff Dimension at or below which the packed GEMM is used.
+ * @return (Matrix) The m x n product.
+ * @throws std::invalid_argument if inner dimensions do not match.
+ */
+template <typename ResultType = void, Numeric T, Numeric U>
+[[nodiscard]] auto strassen_multiply(const Matrix<T>& a,
+                                     const Matrix<U>& b,
+                                     size_t cutoff = STRASSEN_CUTOFF) {
+    using CommonType = std::common_type_t<T, U>;
+    using TargetType = std::conditional_t<
+        std::is_same_v<ResultType, void>,
+        std::conditional_t<std::is_floating_point_v<CommonType>, CommonType, double>,
+        ResultType>;
+
+    static_assert(std::is_floating_point_v<TargetType>,
+                  "Strassen result type must be floating point!");
+
+    if (a.column_count() != b.row_count()) {
+        throw std::invalid_argument(
+            "Matrix inner dimensions do not match for multiplication!");
+    }
+
+    Matrix<TargetType> result(a.row_count(), b.column_count(), default_init);
+    const auto run = [&](const auto& lhs, const auto& rhs) {
+        detail::_strassen_multiply<TargetType>(lhs, rhs, result.view(), cutoff);
+    };
+
+    if constexpr (std::is_same_v<T, TargetType> && std::is_same_v<U, TargetType>) {
+        run(a.view(), b.view());
+    } else if constexpr (std::is_same_v<T, TargetType>) {
+        run(a.view(), b.template cast<TargetType>().view());
+    } else if constexpr (std::is_same_v<U, TargetType>) {
+        run(a.template cast<TargetType>().view(), b.view());
+    } else {
+        run(a.template cast<TargetType>().view(), b.template cast<TargetType>().view());
+    }
+    return result;
+}
+
+}  // namespace maf::math
+
+#endif
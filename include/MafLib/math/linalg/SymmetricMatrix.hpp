@@ -0,0 +1,549 @@
+#ifndef SYMMETRIC_MATRIX_H
+#define SYMMETRIC_MATRIX_H
+#pragma once
+#include "Cholesky.hpp"
+#include "LinAlg.hpp"
+#include "TriangularMatrix.hpp"
+
+/**
+ * @file SymmetricMatrix.hpp
+ * @brief Symmetric matrices in lower tile storage and the symmetric kernels
+ * SYMV, SYRK and SYMM, plus a tiled Cholesky factorization.
+ *
+ * The n x n matrix is cut into square tiles of tile_size() = min(n,
+ * BLOCK_SIZE) rows, and only the tiles on or below the diagonal are
+ * stored, each as a dense row-major tile_size() x tile_size() block:
+ * tile (I, J), I >= J, is tile number I * (I + 1) / 2 + J. That is about
+ * n * (n + tile_size()) / 2 elements, half of a dense Matrix for large n,
+ * while every tile can still be handed to the GEMM kernel as an ordinary
+ * strided block.
+ *
+ * Invariants: the strict upper half of every diagonal tile and the padding
+ * of the last tile row and column (when tile_size() does not divide n) are
+ * zero. Element (i, j) and (j, i) are the same stored element.
+ */
+namespace maf::math {
+template <Numeric T>
+class SymmetricMatrix;
+
+namespace detail {
+/**
+ * @brief Accumulates the contribution of the stored tile (I, J) to A * x:
+ * acc_i += A_IJ * x_j and, below the diagonal, acc_j += A_IJ^T * x_i.
+ * @details One pass over the tile serves both halves of the matrix.
+ */
+template <typename R, typename T, typename TX>
+inline void _symv_tile(const T* tile,
+                       size_t ld,
+                       size_t rows,
+                       size_t cols,
+                       bool diagonal,
+                       const TX* x_i,
+                       const TX* x_j,
+                       R* acc_i,
+                       R* acc_j) noexcept {
+    for (size_t r = 0; r < rows; ++r) {
+        const T* a = tile + (r * ld);
+        const auto x_r = static_cast<R>(x_i[r]);
+        const size_t width = diagonal ? r : cols;
+        R sum = R(0);
+        #pragma omp simd reduction(+ : sum)
+        for (size_t c = 0; c < width; ++c) {
+            sum += static_cast<R>(a[c]) * static_cast<R>(x_j[c]);
+            acc_j[c] += static_cast<R>(a[c]) * x_r;
+        }
+        if (diagonal) {
+            sum += static_cast<R>(a[r]) * x_r;
+        }
+        acc_i[r] += sum;
+    }
+}
+
+}  // namespace detail
+
+/**
+ * @brief A symmetric n x n matrix storing only its lower triangle, in
+ * BLOCK_SIZE tiles.
+ *
+ * Built from a dense matrix (its lower triangle is read), element by
+ * element, or with syrk(). Supports A * x (SYMV), A * B (SYMM), the
+ * in-place symv() / syrk() / symm() and cholesky().
+ *
+ * @tparam T The numeric type of the elements.
+ */
+template <Numeric T>
+class SymmetricMatrix {
+public:
+    /** @brief The numeric type of the matrix elements. */
+    using value_type = T;
+
+    // --- Constructors ---
+
+    /**
+     * @brief Creates a zero n x n symmetric matrix.
+     * @throws std::invalid_argument if n is zero.
+     */
+    explicit SymmetricMatrix(size_t n)
+        : _n(n),
+          _tile(std::min<size_t>(n, BLOCK_SIZE)),
+          _tiles(n == 0 ? 0 : (n + _tile - 1) / _tile),
+          _data(_tiles * (_tiles + 1) / 2 * _tile * _tile) {
+        if (_n == 0) {
+            throw std::invalid_argument("Matrix dimensions must be greater than zero.");
+        }
+    }
+
+    /**
+     * @brief Copies the lower triangle of a square dense matrix; the upper
+     * triangle is not read.
+     * @throws std::invalid_argument if the operand is not square.
+     */
+    template <MatrixOperand E>
+    explicit SymmetricMatrix(const E& dense) : SymmetricMatrix(dense.row_count()) {
+        if (dense.column_count() != _n) {
+            throw std::invalid_argument("Symmetric matrix must be square!");
+        }
+        #pragma omp parallel for schedule(dynamic) if (_n * _n > OMP_LINEAR_LIMIT)
+        for (size_t i = 0; i < _n; ++i) {
+            for (size_t j = 0; j <= i; ++j) {
+                (*this)(i, j) = static_cast<T>(dense(i, j));
+            }
+        }
+    }
+
+    // --- Getters ---
+
+    [[nodiscard]] size_t size() const noexcept {
+        return _n;
+    }
+
+    [[nodiscard]] size_t row_count() const noexcept {
+        return _n;
+    }
+
+    [[nodiscard]] size_t column_count() const noexcept {
+        return _n;
+    }
+
+    /** @brief Rows (and columns) of every stored tile. */
+    [[nodiscard]] size_t tile_size() const noexcept {
+        return _tile;
+    }
+
+    /** @brief Number of tile rows (and tile columns). */
+    [[nodiscard]] size_t tile_count() const noexcept {
+        return _tiles;
+    }
+
+    /** @brief Rows of tile row I; smaller than tile_size() only for the last. */
+    [[nodiscard]] size_t tile_extent(size_t tile) const noexcept {
+        return std::min(_tile, _n - (tile * _tile));
+    }
+
+    /**
+     * @brief The stored tile (I, J), I >= J: a row-major tile_size() x
+     * tile_size() block holding rows I * tile_size().. and columns
+     * J * tile_size()..
+     */
+    [[nodiscard]] std::span<T> tile(size_t I, size_t J) noexcept {
+        return {_data.data() + _tile_offset(I, J), _tile * _tile};
+    }
+
+    [[nodiscard]] std::span<const T> tile(size_t I, size_t J) const noexcept {
+        return {_data.data() + _tile_offset(I, J), _tile * _tile};
+    }
+
+    /** @brief Number of stored elements, padding included. */
+    [[nodiscard]] size_t storage_size() const noexcept {
+        return _data.size();
+    }
+
+    /**
+     * @brief Unchecked access to element (row, col); (row, col) and
+     * (col, row) are the same element.
+     */
+    [[nodiscard]] T& operator()(size_t row, size_t col) noexcept {
+        return _data[_element_offset(row, col)];
+    }
+
+    [[nodiscard]] const T& operator()(size_t row, size_t col) const noexcept {
+        return _data[_element_offset(row, col)];
+    }
+
+    /**
+     * @brief Reads element (row, col).
+     * @throws std::out_of_range if the index is invalid.
+     */
+    [[nodiscard]] T at(size_t row, size_t col) const {
+        if (row >= _n || col >= _n) {
+            throw std::out_of_range("Matrix index out of range.");
+        }
+        return (*this)(row, col);
+    }
+
+    // --- Methods ---
+
+    /** @brief Expands the matrix into dense storage (both triangles). */
+    [[nodiscard]] Matrix<T> to_dense() const {
+        Matrix<T> result(_n, _n, default_init);
+        #pragma omp parallel for schedule(dynamic) if (_n * _n > OMP_LINEAR_LIMIT)
+        for (size_t i = 0; i < _n; ++i) {
+            for (size_t j = 0; j <= i; ++j) {
+                result(i, j) = result(j, i) = (*this)(i, j);
+            }
+        }
+        return result;
+    }
+
+    // --- Operators ---
+
+    [[nodiscard]] bool operator==(const SymmetricMatrix& other) const noexcept {
+        return _n == other._n && _data == other._data;
+    }
+
+    SymmetricMatrix& operator*=(T scalar) noexcept {
+        for (T& value : _data) {
+            value *= scalar;
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Symmetric matrix - vector multiplication (SYMV).
+     * @throws std::invalid_argument if the vector is a row vector or the
+     * sizes do not match.
+     */
+    template <Numeric U>
+    [[nodiscard]] auto operator*(const Vector<U>& x) const {
+        using R = std::common_type_t<T, U>;
+        if (x.orientation() == Orientation::ROW) {
+            throw std::invalid_argument(
+                "Invalid multiplication: matrix * row vector.\n"
+                "Did you mean Vector * Matrix?");
+        }
+        Vector<R> result(_n, default_init, COLUMN);
+        symv(R(1), *this, x, R(0), result);
+        return result;
+    }
+
+    /**
+     * @brief Symmetric matrix - dense matrix multiplication (SYMM).
+     * @throws std::invalid_argument if the sizes do not match.
+     */
+    template <MatrixOperand E>
+    [[nodiscard]] auto operator*(const E& dense) const
+        requires std::floating_point<T>
+    {
+        Matrix<T> result(_n, dense.column_count(), default_init);
+        symm(T(1), *this, dense, T(0), result);
+        return result;
+    }
+
+private:
+    size_t _n;
+    size_t _tile;
+    size_t _tiles;
+    AlignedBuffer<T> _data;
+
+    [[nodiscard]] size_t _tile_offset(size_t I, size_t J) const noexcept {
+        return ((I * (I + 1) / 2) + J) * _tile * _tile;
+    }
+
+    [[nodiscard]] size_t _element_offset(size_t row, size_t col) const noexcept {
+        if (row < col) {
+            std::swap(row, col);
+        }
+        return _tile_offset(row / _tile, col / _tile) + ((row % _tile) * _tile) +
+               (col % _tile);
+    }
+};
+
+/**
+ * @brief In-place symmetric matrix - vector product
+ * y = alpha * A * x + beta * y (SYMV).
+ * @details Every stored tile is read once and used for both of its
+ * mirrored blocks; threads accumulate into private vectors that are summed
+ * at the end. The orientation of the vectors is not checked. When beta is
+ * zero, y is not read.
+ * @throws std::invalid_argument if the sizes do not match or x and y are
+ * the same vector.
+ */
+template <Numeric T, Numeric TA, Numeric U>
+void symv(std::type_identity_t<T> alpha,
+          const SymmetricMatrix<TA>& a,
+          const Vector<U>& x,
+          std::type_identity_t<T> beta,
+          Vector<T>& y) {
+    const size_t n = a.size();
+    if (x.size() != n || y.size() != n) {
+        throw std::invalid_argument(
+            "Dimension mismatch in SymmetricMatrix * Vector multiplication.");
+    }
+    if constexpr (std::is_same_v<T, U>) {
+        if (&x == &y) {
+            throw std::invalid_argument("Output vector must not be the input vector!");
+        }
+    }
+
+    using R = std::common_type_t<T, TA, U>;
+    const size_t nb = a.tile_size();
+    const size_t tiles = a.tile_count();
+    const bool parallel = tiles > 1 && a.storage_size() > OMP_LINEAR_LIMIT;
+    const size_t threads = parallel ? static_cast<size_t>(omp_get_max_threads()) : 1;
+    AlignedBuffer<R> partial(threads * n);
+    const U* x_data = x.data().data();
+    T* y_data = y.data().data();
+
+    #pragma omp parallel num_threads(threads) if (parallel)
+    {
+        const auto parts = static_cast<size_t>(omp_get_num_threads());
+        R* acc = partial.data() + (static_cast<size_t>(omp_get_thread_num()) * n);
+
+        #pragma omp for schedule(dynamic)
+        for (size_t I = 0; I < tiles; ++I) {
+            for (size_t J = 0; J <= I; ++J) {
+                detail::_symv_tile(a.tile(I, J).data(),
+                                   nb,
+                                   a.tile_extent(I),
+                                   a.tile_extent(J),
+                                   I == J,
+                                   x_data + (I * nb),
+                                   x_data + (J * nb),
+                                   acc + (I * nb),
+                                   acc + (J * nb));
+            }
+        }
+
+        #pragma omp for schedule(static)
+        for (size_t i = 0; i < n; ++i) {
+            R sum = R(0);
+            for (size_t p = 0; p < parts; ++p) {
+                sum += partial[(p * n) + i];
+            }
+            detail::_gemv_store(
+                static_cast<R>(alpha), sum, static_cast<R>(beta), y_data[i]);
+        }
+    }
+}
+
+namespace detail {
+/** @brief SYRK on a strided operand; see syrk(). */
+template <std::floating_point T, typename U>
+void _syrk(T alpha, ConstMatrixView<U> a, T beta, SymmetricMatrix<T>& c) {
+    if (a.row_count() != c.size()) {
+        throw std::invalid_argument("Dimension mismatch in SYRK.");
+    }
+    const size_t nb = c.tile_size();
+    const size_t tiles = c.tile_count();
+    const size_t k = a.column_count();
+    const size_t rsa = a.row_stride();
+    const size_t csa = a.col_stride();
+
+    // Tiles are independent; each tile GEMM runs on one thread unless there
+    // is a single tile, in which case the GEMM parallelizes internally.
+    #pragma omp parallel for schedule(dynamic) if (tiles > 1)
+    for (size_t I = 0; I < tiles; ++I) {
+        for (size_t J = 0; J <= I; ++J) {
+            T* tile = c.tile(I, J).data();
+            _gemm(c.tile_extent(I),
+                  c.tile_extent(J),
+                  k,
+                  alpha,
+                  a.data() + (I * nb * rsa),
+                  rsa,
+                  csa,
+                  a.data() + (J * nb * rsa),
+                  csa,
+                  rsa,
+                  beta,
+                  tile,
+                  nb,
+                  1);
+            if (I == J) {
+                for (size_t r = 0; r < c.tile_extent(I); ++r) {
+                    std::fill(tile + (r * nb) + r + 1, tile + (r * nb) + nb, T(0));
+                }
+            }
+        }
+    }
+}
+
+/** @brief SYMM on a strided operand; see symm(). */
+template <std::floating_point T, typename U>
+void _symm(T alpha,
+           const SymmetricMatrix<T>& a,
+           ConstMatrixView<U> b,
+           T beta,
+           Matrix<T>& c) {
+    const size_t n = a.size();
+    if (b.row_count() != n || c.row_count() != n ||
+        c.column_count() != b.column_count()) {
+        throw std::invalid_argument(
+            "Dimension mismatch in SymmetricMatrix * Matrix multiplication.");
+    }
+    const size_t nb = a.tile_size();
+    const size_t tiles = a.tile_count();
+    const size_t m = b.column_count();
+    const size_t rsb = b.row_stride();
+    const size_t csb = b.col_stride();
+    const size_t ldc = c.leading_dimension();
+
+    #pragma omp parallel if (tiles > 1)
+    {
+        // The diagonal tile expanded to both triangles
+        AlignedBuffer<T> diagonal(nb * nb, default_init);
+
+        #pragma omp for schedule(dynamic)
+        for (size_t I = 0; I < tiles; ++I) {
+            const size_t rows = a.tile_extent(I);
+            for (size_t J = 0; J < tiles; ++J) {
+                const size_t cols = a.tile_extent(J);
+                const T* tile = nullptr;
+                size_t rsa = nb;
+                size_t csa = 1;
+                if (J < I) {
+                    tile = a.tile(I, J).data();
+                } else if (J > I) {
+                    tile = a.tile(J, I).data();
+                    std::swap(rsa, csa);
+                } else {
+                    const T* lower = a.tile(I, I).data();
+                    for (size_t r = 0; r < rows; ++r) {
+                        for (size_t s = 0; s < rows; ++s) {
+                            diagonal[(r * nb) + s] =
+                                r >= s ? lower[(r * nb) + s] : lower[(s * nb) + r];
+                        }
+                    }
+                    tile = diagonal.data();
+                }
+                _gemm(rows,
+                      m,
+                      cols,
+                      alpha,
+                      tile,
+                      rsa,
+                      csa,
+                      b.data() + (J * nb * rsb),
+                      rsb,
+                      csb,
+                      J == 0 ? beta : T(1),
+                      c.data().data() + (I * nb * ldc),
+                      ldc,
+                      1);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Tiled Cholesky in place on the lower tiles of a SymmetricMatrix or
+ * a lower TriangularMatrix (same layout), scheduled as a task graph by
+ * _potrf_tiles().
+ * @details On return the stored tiles hold L (strict upper halves of the
+ * diagonal tiles zeroed).
+ * @throws std::invalid_argument if the matrix is not positive definite.
+ */
+template <typename Tiles>
+void _tiled_potrf(Tiles& a) {
+    using T = typename Tiles::value_type;
+    _potrf_tiles<T>(a.size(), a.tile_size(), a.tile_size(), [&](size_t I, size_t J) {
+        return a.tile(I, J).data();
+    });
+}
+
+}  // namespace detail
+
+/**
+ * @brief Symmetric rank-k update C = alpha * A * A^T + beta * C (SYRK).
+ * @details Only the stored (lower) tiles of C are computed, half the work
+ * of the GEMM A * A^T; pass `a.t()` for alpha * A^T * A. When beta is zero,
+ * C is not read.
+ * @throws std::invalid_argument if A does not have c.size() rows.
+ */
+template <std::floating_point T, MatrixOperand E>
+void syrk(std::type_identity_t<T> alpha,
+          const E& a,
+          std::type_identity_t<T> beta,
+          SymmetricMatrix<T>& c) {
+    if constexpr (detail::_strided_operand<E>) {
+        detail::_syrk<T>(alpha, detail::_as_view(a), beta, c);
+    } else {
+        detail::_syrk<T>(alpha, detail::_as_view(a.eval()), beta, c);
+    }
+}
+
+/**
+ * @brief Returns A * A^T as a SymmetricMatrix, computing one triangle.
+ * @details E.g. `syrk(returns.t())`, scaled by 1 / (n - 1), is the
+ * covariance of centered returns stored one observation per row.
+ */
+template <typename ResultType = void, MatrixOperand E>
+[[nodiscard]] auto syrk(const E& a) {
+    using T = typename E::value_type;
+    using TargetType =
+        std::conditional_t<std::is_same_v<ResultType, void>,
+                           std::conditional_t<std::is_floating_point_v<T>, T, double>,
+                           ResultType>;
+    SymmetricMatrix<TargetType> result(a.row_count());
+    syrk(TargetType(1), a, TargetType(0), result);
+    return result;
+}
+
+/**
+ * @brief Symmetric matrix - matrix product C = alpha * A * B + beta * C
+ * (SYMM) with a symmetric A.
+ * @details Tile rows of C are computed in parallel; tiles above the
+ * diagonal of A are read transposed from their stored mirror. When beta is
+ * zero, C is not read.
+ * @throws std::invalid_argument if the sizes do not match.
+ */
+template <std::floating_point T, MatrixOperand E>
+void symm(std::type_identity_t<T> alpha,
+          const SymmetricMatrix<T>& a,
+          const E& b,
+          std::type_identity_t<T> beta,
+          Matrix<T>& c) {
+    if constexpr (detail::_strided_operand<E>) {
+        detail::_symm<T>(alpha, a, detail::_as_view(b), beta, c);
+    } else {
+        detail::_symm<T>(alpha, a, detail::_as_view(b.eval()), beta, c);
+    }
+}
+
+/**
+ * @brief Computes the Cholesky factor L of a symmetric positive definite
+ * SymmetricMatrix.
+ * @details The tiles are copied into the factor, which has the same
+ * layout, and factored there with a tiled algorithm; L never takes more
+ * than half the memory of a dense matrix. Symmetry is not checked: the
+ * matrix is symmetric by construction.
+ * @return (TriangularMatrix<T, LOWER>) The packed lower triangular factor
+ * (L); `L.solve(b)` and `L.solve(y, TRANSPOSE)` solve with it.
+ * @throws std::invalid_argument if the matrix is not positive definite.
+ */
+template <typename ResultType = void, Numeric T>
+[[nodiscard]] auto cholesky(const SymmetricMatrix<T>& matrix) {
+    using TargetType =
+        std::conditional_t<std::is_same_v<ResultType, void>,
+                           std::conditional_t<std::is_floating_point_v<T>, T, double>,
+                           ResultType>;
+
+    static_assert(std::is_floating_point_v<TargetType>,
+                  "Cholesky result type must be floating point!");
+
+    TriangularMatrix<TargetType, LOWER> L(matrix.size());
+    for (size_t I = 0; I < matrix.tile_count(); ++I) {
+        for (size_t J = 0; J <= I; ++J) {
+            std::ranges::transform(
+                matrix.tile(I, J), L.tile(I, J).begin(), [](T value) {
+                    return static_cast<TargetType>(value);
+                });
+        }
+    }
+    detail::_tiled_potrf(L);
+    return L;
+}
+
+}  // namespace maf::math
+
+#endif
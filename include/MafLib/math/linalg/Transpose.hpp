@@ -0,0 +1,147 @@
+#ifndef TRANSPOSE_H
+#define TRANSPOSE_H
+#pragma once
+#include "MafLib/math/Math.hpp"
+
+/**
+ * @file Transpose.hpp
+ * @brief Out-of-place and in-place transpose kernels.
+ *
+ * A naive transpose reads one matrix along rows and writes the other along
+ * columns, so for large matrices every write touches a new cache line (and a
+ * new page). The out-of-place kernel is cache-oblivious instead: it halves
+ * the larger dimension recursively until a block of at most
+ * TRANSPOSE_LEAF x TRANSPOSE_LEAF elements remains, whose source and
+ * destination rows both stay in L1 whatever the cache sizes are. The top
+ * TRANSPOSE_TASK_LEVELS levels of the recursion run as OpenMP tasks.
+ *
+ * The in-place kernel transposes a dense rectangular matrix inside its own
+ * storage by following the cycles of the permutation p -> p * rows mod
+ * (rows * cols - 1), marking visited positions in a bitmap of one bit per
+ * element. It costs rows * cols / 8 bytes of scratch instead of a second
+ * copy of the matrix.
+ *
+ * This file is included by Matrix.hpp and should not be included directly
+ * anywhere else.
+ */
+namespace maf::math {
+namespace detail {
+/** @brief Largest side of a block transposed directly by the recursion. */
+constexpr static size_t TRANSPOSE_LEAF = 16;
+
+/** @brief Recursion levels of the out-of-place transpose run as tasks. */
+constexpr static size_t TRANSPOSE_TASK_LEVELS = 4;
+
+/** @brief Transposes a block that fits in L1: dst(j, i) = src(i, j). */
+template <typename T, typename U>
+inline void _transpose_leaf(
+    size_t rows, size_t cols, const T* src, size_t lds, U* dst, size_t ldd) noexcept {
+    for (size_t j = 0; j < cols; ++j) {
+        U* out = dst + (j * ldd);
+        #pragma omp simd
+        for (size_t i = 0; i < rows; ++i) {
+            out[i] = static_cast<U>(src[(i * lds) + j]);
+        }
+    }
+}
+
+/** @brief Halves the larger dimension until a leaf block remains. */
+template <typename T, typename U>
+void _transpose_recursive(size_t rows,
+                          size_t cols,
+                          const T* src,
+                          size_t lds,
+                          U* dst,
+                          size_t ldd,
+                          size_t task_levels) {
+    if (rows <= TRANSPOSE_LEAF && cols <= TRANSPOSE_LEAF) {
+        _transpose_leaf(rows, cols, src, lds, dst, ldd);
+        return;
+    }
+
+    const size_t levels = task_levels > 0 ? task_levels - 1 : 0;
+    if (rows >= cols) {
+        const size_t half = rows / 2;
+        #pragma omp task if (task_levels > 0)
+        _transpose_recursive(half, cols, src, lds, dst, ldd, levels);
+        _transpose_recursive(
+            rows - half, cols, src + (half * lds), lds, dst + half, ldd, levels);
+    } else {
+        const size_t half = cols / 2;
+        #pragma omp task if (task_levels > 0)
+        _transpose_recursive(rows, half, src, lds, dst, ldd, levels);
+        _transpose_recursive(
+            rows, cols - half, src + half, lds, dst + (half * ldd), ldd, levels);
+    }
+    if (task_levels > 0) {
+        #pragma omp taskwait
+    }
+}
+
+/**
+ * @brief Out-of-place transpose dst = src^T.
+ * @param rows Rows of src (and columns of dst).
+ * @param cols Columns of src (and rows of dst).
+ * @param src Pointer to src(0, 0); consecutive columns are adjacent.
+ * @param lds Distance between consecutive rows of src.
+ * @param dst Pointer to dst(0, 0). Must not overlap src.
+ * @param ldd Distance between consecutive rows of dst.
+ */
+template <typename T, typename U>
+void _transpose(
+    size_t rows, size_t cols, const T* src, size_t lds, U* dst, size_t ldd) {
+    const bool parallel = rows * cols > OMP_LINEAR_LIMIT &&
+                          omp_get_max_threads() > 1 && !omp_in_parallel();
+    const size_t task_levels = parallel ? TRANSPOSE_TASK_LEVELS : 0;
+
+    #pragma omp parallel if (parallel)
+    {
+        #pragma omp single
+        _transpose_recursive(rows, cols, src, lds, dst, ldd, task_levels);
+    }
+}
+
+/**
+ * @brief In-place transpose of a dense rows x cols row-major matrix into a
+ * dense cols x rows one.
+ * @details The element at position p = i * cols + j belongs at
+ * j * rows + i. Positions 0 and rows * cols - 1 never move; every other
+ * cycle of the permutation is rotated once, starting from its lowest
+ * unvisited position.
+ */
+template <typename T>
+void _transpose_in_place(T* data, size_t rows, size_t cols) {
+    if (rows == 1 || cols == 1) {
+        return;
+    }
+
+    const size_t last = (rows * cols) - 1;
+    std::vector<uint64> visited((last + 64) / 64, 0);
+    const auto mark = [&](size_t p) { visited[p / 64] |= uint64(1) << (p % 64); };
+    const auto is_marked = [&](size_t p) {
+        return (visited[p / 64] >> (p % 64) & 1) != 0;
+    };
+
+    for (size_t start = 1; start < last; ++start) {
+        if (visited[start / 64] == ~uint64(0)) {
+            start += 63 - (start % 64);
+            continue;
+        }
+        if (is_marked(start)) {
+            continue;
+        }
+
+        T carried = data[start];
+        size_t p = start;
+        do {
+            p = ((p % cols) * rows) + (p / cols);
+            std::swap(carried, data[p]);
+            mark(p);
+        } while (p != start);
+    }
+}
+
+}  // namespace detail
+}  // namespace maf::math
+
+#endif
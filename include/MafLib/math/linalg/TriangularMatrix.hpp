@@ -0,0 +1,480 @@
+#ifndef TRIANGULAR_MATRIX_H
+#define TRIANGULAR_MATRIX_H
+#pragma once
+#include "LinAlg.hpp"
+
+/**
+ * @file TriangularMatrix.hpp
+ * @brief Packed triangular matrices and the blocked triangular solvers TRSV
+ * (one right-hand side) and TRSM (many).
+ *
+ * Storage uses the tiles of SymmetricMatrix: the n x n matrix is cut into
+ * square tiles of tile_size() = min(n, BLOCK_SIZE) rows and only the tiles
+ * of the stored triangle are kept, each a dense row-major block. A lower
+ * matrix stores tile (I, J), I >= J, as tile number I * (I + 1) / 2 + J
+ * (the SymmetricMatrix layout, so a Cholesky factor is computed in place);
+ * an upper matrix stores the tiles J >= I row by row. Inside a diagonal
+ * tile the other triangle is zero.
+ *
+ * The solvers are right-looking over the tiles: solve the diagonal tile of
+ * step I by substitution, then subtract its contribution from every later
+ * tile row with one GEMM (GEMV for a single right-hand side) per tile, the
+ * tiles in parallel. Many right-hand sides are also split into column
+ * chunks, so a TRSM parallelizes over both.
+ */
+namespace maf::math {
+/** @brief Which triangle of a TriangularMatrix is stored. */
+enum Triangle : uint8 { LOWER, UPPER };
+
+/** @brief Whether the diagonal is stored (NON_UNIT) or implicitly one (UNIT). */
+enum Diagonal : uint8 { NON_UNIT, UNIT };
+
+/** @brief Whether a solver uses the matrix itself or its transpose. */
+enum Transpose : uint8 { NO_TRANSPOSE, TRANSPOSE };
+
+namespace detail {
+/** @brief Right-hand side columns handled by one task of a TRSM step. */
+constexpr static size_t TRSM_COLUMNS = 256;
+
+}  // namespace detail
+
+/**
+ * @brief A square triangular matrix storing only its triangle, in
+ * BLOCK_SIZE tiles.
+ *
+ * @tparam T The numeric type of the elements.
+ * @tparam Uplo LOWER or UPPER.
+ * @tparam Diag NON_UNIT, or UNIT for an implicit unit diagonal (as in the
+ * L factor of an LU decomposition); the stored diagonal is then ignored.
+ */
+template <Numeric T, Triangle Uplo = LOWER, Diagonal Diag = NON_UNIT>
+class TriangularMatrix {
+public:
+    /** @brief The numeric type of the matrix elements. */
+    using value_type = T;
+
+    /** @brief The stored triangle. */
+    static constexpr Triangle triangle = Uplo;
+
+    /** @brief The kind of diagonal. */
+    static constexpr Diagonal diagonal = Diag;
+
+    // --- Constructors ---
+
+    /**
+     * @brief Creates a zero n x n triangular matrix (with ones on the
+     * diagonal if it is UNIT).
+     * @throws std::invalid_argument if n is zero.
+     */
+    explicit TriangularMatrix(size_t n)
+        : _n(n),
+          _tile(std::min<size_t>(n, BLOCK_SIZE)),
+          _tiles(n == 0 ? 0 : (n + _tile - 1) / _tile),
+          _data(_tiles * (_tiles + 1) / 2 * _tile * _tile) {
+        if (_n == 0) {
+            throw std::invalid_argument("Matrix dimensions must be greater than zero.");
+        }
+    }
+
+    /**
+     * @brief Copies the triangle of a square dense matrix; the other
+     * triangle (and a UNIT diagonal) is not read.
+     * @throws std::invalid_argument if the operand is not square.
+     */
+    template <MatrixOperand E>
+    explicit TriangularMatrix(const E& dense) : TriangularMatrix(dense.row_count()) {
+        if (dense.column_count() != _n) {
+            throw std::invalid_argument("Triangular matrix must be square!");
+        }
+        #pragma omp parallel for schedule(dynamic) if (_n * _n > OMP_LINEAR_LIMIT)
+        for (size_t i = 0; i < _n; ++i) {
+            const size_t first = Uplo == LOWER ? 0 : i;
+            const size_t last = Uplo == LOWER ? i + 1 : _n;
+            for (size_t j = first; j < last; ++j) {
+                if (Diag == NON_UNIT || i != j) {
+                    (*this)(i, j) = static_cast<T>(dense(i, j));
+                }
+            }
+        }
+    }
+
+    // --- Getters ---
+
+    [[nodiscard]] size_t size() const noexcept {
+        return _n;
+    }
+
+    [[nodiscard]] size_t row_count() const noexcept {
+        return _n;
+    }
+
+    [[nodiscard]] size_t column_count() const noexcept {
+        return _n;
+    }
+
+    /** @brief Rows (and columns) of every stored tile. */
+    [[nodiscard]] size_t tile_size() const noexcept {
+        return _tile;
+    }
+
+    /** @brief Number of tile rows (and tile columns). */
+    [[nodiscard]] size_t tile_count() const noexcept {
+        return _tiles;
+    }
+
+    /** @brief Rows of tile row I; smaller than tile_size() only for the last. */
+    [[nodiscard]] size_t tile_extent(size_t tile) const noexcept {
+        return std::min(_tile, _n - (tile * _tile));
+    }
+
+    /**
+     * @brief The stored tile (I, J) (I >= J for LOWER, I <= J for UPPER), a
+     * row-major tile_size() x tile_size() block.
+     */
+    [[nodiscard]] std::span<T> tile(size_t I, size_t J) noexcept {
+        return {_data.data() + _tile_offset(I, J), _tile * _tile};
+    }
+
+    [[nodiscard]] std::span<const T> tile(size_t I, size_t J) const noexcept {
+        return {_data.data() + _tile_offset(I, J), _tile * _tile};
+    }
+
+    /** @brief Number of stored elements, padding included. */
+    [[nodiscard]] size_t storage_size() const noexcept {
+        return _data.size();
+    }
+
+    /** @brief Whether (row, col) lies in the stored triangle. */
+    [[nodiscard]] static constexpr bool in_triangle(size_t row, size_t col) noexcept {
+        return Uplo == LOWER ? row >= col : row <= col;
+    }
+
+    /**
+     * @brief Unchecked access to an element of the stored triangle.
+     * @details (row, col) must satisfy in_triangle(); use at() otherwise.
+     */
+    [[nodiscard]] T& operator()(size_t row, size_t col) noexcept {
+        return _data[_element_offset(row, col)];
+    }
+
+    [[nodiscard]] const T& operator()(size_t row, size_t col) const noexcept {
+        return _data[_element_offset(row, col)];
+    }
+
+    /**
+     * @brief Reads element (row, col): zero outside the triangle, one on a
+     * UNIT diagonal.
+     * @throws std::out_of_range if the index is invalid.
+     */
+    [[nodiscard]] T at(size_t row, size_t col) const {
+        if (row >= _n || col >= _n) {
+            throw std::out_of_range("Matrix index out of range.");
+        }
+        if (Diag == UNIT && row == col) {
+            return T(1);
+        }
+        return in_triangle(row, col) ? (*this)(row, col) : T(0);
+    }
+
+    // --- Methods ---
+
+    /** @brief Expands the matrix into dense storage. */
+    [[nodiscard]] Matrix<T> to_dense() const {
+        Matrix<T> result(_n, _n);
+        #pragma omp parallel for schedule(dynamic) if (_n * _n > OMP_LINEAR_LIMIT)
+        for (size_t i = 0; i < _n; ++i) {
+            const size_t first = Uplo == LOWER ? 0 : i;
+            const size_t last = Uplo == LOWER ? i + 1 : _n;
+            for (size_t j = first; j < last; ++j) {
+                result(i, j) = at(i, j);
+            }
+        }
+        return result;
+    }
+
+    /** @brief Returns A^T, a triangular matrix of the other kind. */
+    [[nodiscard]] auto transposed() const {
+        constexpr Triangle other = Uplo == LOWER ? UPPER : LOWER;
+        TriangularMatrix<T, other, Diag> result(_n);
+        for (size_t I = 0; I < _tiles; ++I) {
+            const size_t first = Uplo == LOWER ? 0 : I;
+            const size_t last = Uplo == LOWER ? I + 1 : _tiles;
+            for (size_t J = first; J < last; ++J) {
+                detail::_transpose(_tile,
+                                   _tile,
+                                   tile(I, J).data(),
+                                   _tile,
+                                   result.tile(J, I).data(),
+                                   _tile);
+            }
+        }
+        return result;
+    }
+
+    /**
+     * @brief Solves A x = b (or A^T x = b) and returns x.
+     * @throws std::invalid_argument if the size of b does not match.
+     */
+    template <Numeric U>
+    [[nodiscard]] Vector<T> solve(const Vector<U>& b, Transpose op = NO_TRANSPOSE) const
+        requires std::floating_point<T>
+    {
+        Vector<T> x(b.size(), default_init, b.orientation());
+        for (size_t i = 0; i < b.size(); ++i) {
+            x[i] = static_cast<T>(b[i]);
+        }
+        trsv(*this, x, op);
+        return x;
+    }
+
+    /**
+     * @brief Solves A X = B (or A^T X = B) for every column of B and
+     * returns X.
+     * @throws std::invalid_argument if the row count of B does not match.
+     */
+    template <MatrixOperand E>
+    [[nodiscard]] Matrix<T> solve(const E& b, Transpose op = NO_TRANSPOSE) const
+        requires std::floating_point<T>
+    {
+        Matrix<T> x(b.row_count(), b.column_count(), default_init);
+        for (size_t i = 0; i < b.row_count(); ++i) {
+            for (size_t j = 0; j < b.column_count(); ++j) {
+                x(i, j) = static_cast<T>(b(i, j));
+            }
+        }
+        trsm(*this, x, op);
+        return x;
+    }
+
+    // --- Operators ---
+
+    [[nodiscard]] bool operator==(const TriangularMatrix& other) const noexcept {
+        return _n == other._n && _data == other._data;
+    }
+
+    TriangularMatrix& operator*=(T scalar) noexcept {
+        for (T& value : _data) {
+            value *= scalar;
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Triangular matrix - vector multiplication (TRMV), tile rows
+     * in parallel.
+     * @throws std::invalid_argument if the vector is a row vector or the
+     * sizes do not match.
+     */
+    template <Numeric U>
+    [[nodiscard]] auto operator*(const Vector<U>& x) const {
+        using R = std::common_type_t<T, U>;
+        if (x.orientation() == Orientation::ROW) {
+            throw std::invalid_argument(
+                "Invalid multiplication: matrix * row vector.\n"
+                "Did you mean Vector * Matrix?");
+        }
+        if (x.size() != _n) {
+            throw std::invalid_argument(
+                "Dimension mismatch in TriangularMatrix * Vector multiplication.");
+        }
+        Vector<R> result(_n, COLUMN);
+        const U* x_data = x.data().data();
+        R* y = result.data().data();
+
+        #pragma omp parallel for schedule(dynamic) if (_data.size() > OMP_LINEAR_LIMIT)
+        for (size_t I = 0; I < _tiles; ++I) {
+            const size_t first = Uplo == LOWER ? 0 : I + 1;
+            const size_t last = Uplo == LOWER ? I : _tiles;
+            R* y_i = y + (I * _tile);
+            for (size_t J = first; J < last; ++J) {
+                detail::_gemv(tile_extent(I),
+                              tile_extent(J),
+                              R(1),
+                              tile(I, J).data(),
+                              _tile,
+                              1,
+                              x_data + (J * _tile),
+                              1,
+                              R(1),
+                              y_i,
+                              1);
+            }
+            // Diagonal tile, honouring a UNIT diagonal
+            const T* d = tile(I, I).data();
+            const U* x_i = x_data + (I * _tile);
+            for (size_t r = 0; r < tile_extent(I); ++r) {
+                const size_t c0 = Uplo == LOWER ? 0 : r + 1;
+                const size_t c1 = Uplo == LOWER ? r : tile_extent(I);
+                R sum = Diag == UNIT ? static_cast<R>(x_i[r])
+                                     : static_cast<R>(d[(r * _tile) + r]) *
+                                           static_cast<R>(x_i[r]);
+                for (size_t c = c0; c < c1; ++c) {
+                    sum += static_cast<R>(d[(r * _tile) + c]) * static_cast<R>(x_i[c]);
+                }
+                y_i[r] += sum;
+            }
+        }
+        return result;
+    }
+
+private:
+    size_t _n;
+    size_t _tile;
+    size_t _tiles;
+    AlignedBuffer<T> _data;
+
+    [[nodiscard]] size_t _tile_offset(size_t I, size_t J) const noexcept {
+        if constexpr (Uplo == LOWER) {
+            return ((I * (I + 1) / 2) + J) * _tile * _tile;
+        } else {
+            // Tile rows 0..I-1 hold _tiles, _tiles - 1, ... tiles
+            return ((I * _tiles) - (I * (I - 1) / 2) + (J - I)) * _tile * _tile;
+        }
+    }
+
+    [[nodiscard]] size_t _element_offset(size_t row, size_t col) const noexcept {
+        return _tile_offset(row / _tile, col / _tile) + ((row % _tile) * _tile) +
+               (col % _tile);
+    }
+};
+
+namespace detail {
+/**
+ * @brief Blocked right-looking solve op(A) X = B in place, B being n x m
+ * with row stride ldb.
+ * @details op(A) is lower triangular when A is LOWER and not transposed or
+ * UPPER and transposed; tile (I, J) of op(A) is then tile (J, I) of A read
+ * with swapped strides.
+ */
+template <std::floating_point T, Triangle Uplo, Diagonal Diag>
+void _trsm(const TriangularMatrix<T, Uplo, Diag>& a,
+           Transpose op,
+           T* b,
+           size_t ldb,
+           size_t m) {
+    const size_t nb = a.tile_size();
+    const size_t tiles = a.tile_count();
+    const bool transposed = op == TRANSPOSE;
+    const bool lower = (Uplo == LOWER) != transposed;
+    const size_t rs = transposed ? 1 : nb;
+    const size_t cs = transposed ? nb : 1;
+    const auto op_tile = [&](size_t I, size_t J) {
+        return transposed ? a.tile(J, I).data() : a.tile(I, J).data();
+    };
+    const size_t chunks = (m + TRSM_COLUMNS - 1) / TRSM_COLUMNS;
+
+    for (size_t step = 0; step < tiles; ++step) {
+        const size_t I = lower ? step : tiles - 1 - step;
+        const size_t width = a.tile_extent(I);
+        const T* d = op_tile(I, I);
+        T* b_i = b + (I * nb * ldb);
+
+        // X_I = op(A)_II^-1 B_I by substitution, column chunks in parallel
+        #pragma omp parallel for if (chunks > 1 && m * width * width > GEMM_OMP_LIMIT)
+        for (size_t chunk = 0; chunk < chunks; ++chunk) {
+            const size_t c0 = chunk * TRSM_COLUMNS;
+            const size_t c1 = std::min(c0 + TRSM_COLUMNS, m);
+            for (size_t s = 0; s < width; ++s) {
+                const size_t r = lower ? s : width - 1 - s;
+                T* x_r = b_i + (r * ldb);
+                const size_t k0 = lower ? 0 : r + 1;
+                const size_t k1 = lower ? r : width;
+                for (size_t k = k0; k < k1; ++k) {
+                    const T d_rk = d[(r * rs) + (k * cs)];
+                    const T* x_k = b_i + (k * ldb);
+                    #pragma omp simd
+                    for (size_t c = c0; c < c1; ++c) {
+                        x_r[c] -= d_rk * x_k[c];
+                    }
+                }
+                if (Diag == NON_UNIT) {
+                    const T inv = T(1) / d[(r * rs) + (r * cs)];
+                    #pragma omp simd
+                    for (size_t c = c0; c < c1; ++c) {
+                        x_r[c] *= inv;
+                    }
+                }
+            }
+        }
+
+        // B_J -= op(A)_JI X_I for the tile rows still to be solved
+        const size_t remaining = tiles - 1 - step;
+        const bool parallel = remaining * nb * width * m > GEMM_OMP_LIMIT;
+        #pragma omp parallel for collapse(2) schedule(dynamic) if (parallel)
+        for (size_t k = 0; k < remaining; ++k) {
+            for (size_t chunk = 0; chunk < chunks; ++chunk) {
+                const size_t J = lower ? I + 1 + k : k;
+                const size_t c0 = chunk * TRSM_COLUMNS;
+                const size_t cols = std::min(TRSM_COLUMNS, m - c0);
+                T* b_j = b + (J * nb * ldb) + c0;
+                if (m == 1) {
+                    _gemv(a.tile_extent(J),
+                          width,
+                          T(-1),
+                          op_tile(J, I),
+                          rs,
+                          cs,
+                          b_i,
+                          ldb,
+                          T(1),
+                          b_j,
+                          ldb);
+                } else {
+                    _gemm(a.tile_extent(J),
+                          cols,
+                          width,
+                          T(-1),
+                          op_tile(J, I),
+                          rs,
+                          cs,
+                          b_i + c0,
+                          ldb,
+                          1,
+                          T(1),
+                          b_j,
+                          ldb,
+                          1);
+                }
+            }
+        }
+    }
+}
+
+}  // namespace detail
+
+/**
+ * @brief Solves op(A) x = b in place (TRSV), op(A) = A or A^T.
+ * @details Blocked: a substitution per diagonal tile, then one GEMV per
+ * remaining tile, in parallel. The orientation of x is not checked.
+ * @throws std::invalid_argument if the size of x does not match.
+ */
+template <std::floating_point T, Triangle Uplo, Diagonal Diag>
+void trsv(const TriangularMatrix<T, Uplo, Diag>& a,
+          Vector<T>& x,
+          Transpose op = NO_TRANSPOSE) {
+    if (x.size() != a.size()) {
+        throw std::invalid_argument("Right-hand side size does not match!");
+    }
+    detail::_trsm(a, op, x.data().data(), 1, 1);
+}
+
+/**
+ * @brief Solves op(A) X = B in place for every column of B (TRSM),
+ * op(A) = A or A^T.
+ * @details Blocked: a substitution per diagonal tile, then one GEMM per
+ * remaining tile and chunk of detail::TRSM_COLUMNS columns, in parallel.
+ * @throws std::invalid_argument if B does not have a.size() rows.
+ */
+template <std::floating_point T, Triangle Uplo, Diagonal Diag>
+void trsm(const TriangularMatrix<T, Uplo, Diag>& a,
+          Matrix<T>& b,
+          Transpose op = NO_TRANSPOSE) {
+    if (b.row_count() != a.size()) {
+        throw std::invalid_argument("Right-hand side size does not match!");
+    }
+    detail::_trsm(a, op, b.data().data(), b.leading_dimension(), b.column_count());
+}
+
+}  // namespace maf::math
+
+#endif
@@ -37,13 +37,27 @@ public:
     Vector() : _orientation(COLUMN) {}
 
     /**
-     * @brief Constructs an uninitialized vector of a given size.
+     * @brief Constructs a zero-filled vector of a given size.
      * @param size The number of elements in the vector.
      * @param orientation The vector's orientation (default: COLUMN).
      * @throws std::invalid_argument if size is zero.
      */
     Vector(size_t size, Orientation orientation = COLUMN);
 
+    /**
+     * @brief Constructs a vector without initialising its elements.
+     * @details Use this for results that are overwritten right away.
+     * @param size The number of elements in the vector.
+     * @param orientation The vector's orientation (default: COLUMN).
+     * @param resource Memory resource for the storage, or nullptr for
+     * std::pmr::get_default_resource().
+     * @throws std::invalid_argument if size is zero.
+     */
+    Vector(size_t size,
+           default_init_t /*unused*/,
+           Orientation orientation = COLUMN,
+           std::pmr::memory_resource* resource = nullptr);
+
     /**
      * @brief Constructs from a raw data pointer.
      * @details Elements are COPIED from the data pointer.
@@ -67,7 +81,8 @@ public:
     Vector(size_t size, const std::vector<U>& data, Orientation orientation = COLUMN);
 
     /**
-     * @brief Constructs from a std::vector by moving its data.
+     * @brief Constructs from a std::vector r-value.
+     * @details The elements are copied into aligned storage.
      * @param size The number of elements. Must match data.size().
      * @param data The std::vector to move from (r-value).
      * @param orientation The vector's orientation (default: COLUMN).
@@ -95,6 +110,15 @@ public:
     template <Numeric U>
     [[nodiscard]] Vector(const Vector<U>& other);
 
+    /**
+     * @brief Constructs by evaluating a lazy element-wise expression.
+     * @details The whole expression tree is computed in one fused, parallel
+     * and vectorized loop. Elements are converted to T.
+     * @param expr The expression to evaluate (see Expressions.hpp).
+     */
+    template <VectorExpression E>
+    Vector(const E& expr);
+
     // --- Iterators ---
     /** @brief Returns an iterator to the beginning. */
     [[nodiscard]] auto begin() noexcept {
@@ -153,11 +177,18 @@ public:
     // --- Getters ---
 
     /**
-     * @brief Gets a const reference to the underlying std::vector data
-     * store.
-     * @return const std::vector<T>&
+     * @brief Gets a const reference to the underlying aligned storage.
+     * @return const AlignedBuffer<T>&
+     */
+    [[nodiscard]] const AlignedBuffer<T>& data() const noexcept {
+        return _data;
+    }
+
+    /**
+     * @brief Gets a reference to the underlying aligned storage.
+     * @return AlignedBuffer<T>&
      */
-    [[nodiscard]] const std::vector<T>& data() const noexcept {
+    [[nodiscard]] AlignedBuffer<T>& data() noexcept {
         return _data;
     }
 
@@ -242,59 +273,16 @@ public:
     [[nodiscard]] constexpr bool operator==(const Vector& other) const noexcept;
 
     /**
-     * @brief Unary minus. Returns a new Vector with all elements negated.
-     * @return `Vector<T>`
+     * @brief Assigns a lazy element-wise expression.
+     * @details The expression is evaluated in one fused loop directly into
+     * this vector's storage when the sizes match.
      */
-    [[nodiscard]] auto operator-() const noexcept;
+    template <VectorExpression E>
+    Vector<T>& operator=(const E& expr);
 
-    /**
-     * @brief Element-wise vector addition (Vector + Vector).
-     * @tparam U Numeric type of the other vector.
-     * @param other The vector to add.
-     * @return A new Vector of the common, promoted type.
-     * @throws std::invalid_argument if dimensions or orientations do not
-     * match.
-     */
-    template <Numeric U>
-    [[nodiscard]] auto operator+(const Vector<U>& other) const;
+    // Element-wise +, - and scalar * and unary minus are lazy free operators,
+    // see VectorOperators.hpp and Expressions.hpp.
 
-    /**
-     * @brief Element-wise scalar addition (Vector + scalar).
-     * @tparam U An arithmetic scalar type.
-     * @param scalar The scalar value to add to each element.
-     * @return A new Vector of the common, promoted type.
-     */
-    template <Numeric U>
-    [[nodiscard]] auto operator+(const U& scalar) const noexcept;
-
-    /**
-     * @brief Element-wise vector subtraction (Vector - Vector).
-     * @tparam U Numeric type of the other vector.
-     * @param other The vector to subtract.
-     * @return A new Vector of the common, promoted type.
-     * @throws std::invalid_argument if dimensions or orientations do not
-     * match.
-     */
-    template <Numeric U>
-    [[nodiscard]] auto operator-(const Vector<U>& other) const;
-
-    /**
-     * @brief Element-wise scalar subtraction (Vector - scalar).
-     * @tparam U An arithmetic scalar type.
-     * @param scalar The scalar value to subtract from each element.
-     * @return A new Vector of the common, promoted type.
-     */
-    template <Numeric U>
-    [[nodiscard]] auto operator-(const U& scalar) const noexcept;
-
-    /**
-     * @brief Element-wise scalar multiplication (Vector * scalar).
-     * @tparam U An arithmetic scalar type.
-     * @param scalar The scalar value to multiply by.
-     * @return A new Vector of the common, promoted type.
-     */
-    template <Numeric U>
-    [[nodiscard]] auto operator*(const U& scalar) const noexcept;
 
     // TODO: Refactoring and stopped here. Continue from here
     // COMPARE BLAS ROUTINES TO OMP ONES
@@ -358,27 +346,13 @@ private:
     /** @brief Stores the vector's orientation (ROW or COLUMN). */
     Orientation _orientation;
 
-    /** @brief Internal contiguous storage for the vector elements. */
-    std::vector<T> _data;
-
-    /**
-     * @brief Internal helper to invert the sign of all elements in-place.
-     */
-    void _invert_sign() {
-        if (_data.size() > OMP_LINEAR_LIMIT) {
-            #pragma omp parallel for
-            for (size_t i = 0; i < _data.size(); ++i) {
-                _data[i] = -_data[i];
-            }
-        } else {
-            #pragma omp simd
-            for (size_t i = 0; i < _data.size(); ++i) {
-                _data[i] = -_data[i];
-            }
-        }
-    }
+    /** @brief Internal contiguous, aligned storage for the vector elements. */
+    AlignedBuffer<T> _data;
 };
 
+template <VectorExpression E>
+Vector(const E&) -> Vector<typename E::value_type>;
+
 }  // namespace maf::math
 
 #include "VectorCheckers.hpp"
@@ -11,7 +11,7 @@
  * should not be included directly anywhere else.
  */
 namespace maf::math {
-// Constructs an uninitialized vector of size size.
+// Constructs a zero-filled vector of size size.
 template <Numeric T>
 Vector<T>::Vector(size_t size, Orientation orientation) : _orientation(orientation) {
     if (size == 0) {
@@ -20,6 +20,19 @@ Vector<T>::Vector(size_t size, Orientation orientation) : _orientation(orientati
     _data.resize(size);
 }
 
+// Constructs a vector without initialising its elements.
+template <Numeric T>
+Vector<T>::Vector(size_t size,
+                  default_init_t /*unused*/,
+                  Orientation orientation,
+                  std::pmr::memory_resource* resource)
+    : _orientation(orientation), _data(resource) {
+    if (size == 0) {
+        throw std::invalid_argument("Vector size must be greater than zero.");
+    }
+    _data.resize(size, default_init);
+}
+
 // Constructs a vector from a raw data pointer.
 template <Numeric T>
 template <Numeric U>
@@ -47,10 +60,10 @@ Vector<T>::Vector(size_t size, const std::vector<U>& data, Orientation orientati
     if (data.size() != size) {
         throw std::invalid_argument("Data size does not match vector size.");
     }
-    _data = data;
+    _data.assign(data.begin(), data.end());
 }
 
-// Constructs from a std::vector, move constructor
+// Constructs from a std::vector r-value, copying into aligned storage
 template <Numeric T>
 Vector<T>::Vector(size_t size, std::vector<T>&& data, Orientation orientation)
     : _orientation(orientation) {
@@ -62,7 +75,7 @@ Vector<T>::Vector(size_t size, std::vector<T>&& data, Orientation orientation)
         throw std::invalid_argument("Data size does not match vector size.");
     }
 
-    _data = std::move(data);
+    _data.assign(data.begin(), data.end());
 }
 
 // Constructs from a std::array, copy constructor
@@ -87,6 +100,15 @@ Vector<T>::Vector(const Vector<U>& other)
     : _orientation(other.orientation()),
       _data(other.data().begin(), other.data().end()) {}
 
+// Evaluates a lazy element-wise expression
+template <Numeric T>
+template <VectorExpression E>
+Vector<T>::Vector(const E& expr)
+    : _orientation(expr.orientation()), _data(expr.size(), default_init) {
+    detail::_assign_vector(
+        _data.data(), expr, [](T& dst, auto value) { dst = static_cast<T>(value); });
+}
+
 }  // namespace maf::math
 
 #endif
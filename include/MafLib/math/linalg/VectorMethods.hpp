@@ -71,8 +71,9 @@ void Vector<T>::transpose() noexcept {
 // Creates new transposed vector
 template <Numeric T>
 [[nodiscard]] Vector<T> Vector<T>::transposed() const noexcept {
-    Orientation new_orientation = (_orientation == COLUMN) ? ROW : COLUMN;
-    return Vector<T>(this->size(), _data, new_orientation);
+    Vector<T> result(*this);
+    result.transpose();
+    return result;
 }
 
 }  // namespace maf::math
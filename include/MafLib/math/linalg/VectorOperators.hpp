@@ -18,189 +18,166 @@ template <Numeric T>
     return _data == other._data;
 }
 
-// Unary minus sign, creates a copy
-template <Numeric T>
-[[nodiscard]] auto Vector<T>::operator-() const noexcept {
-    Vector<T> result(*this);
-    result._invert_sign();
-    return result;
+namespace detail {
+/**
+ * @brief Builds an element-wise binary vector expression after checking
+ * that both operands have the same orientation and size.
+ * @throws std::invalid_argument on mismatch.
+ */
+template <typename Fn, typename L, typename Rhs>
+[[nodiscard]] auto _make_vector_binary(L&& lhs, Rhs&& rhs) {
+    if (lhs.orientation() != rhs.orientation() || lhs.size() != rhs.size()) {
+        throw std::invalid_argument("Vectors must be same orientation and size!");
+    }
+    using R = std::common_type_t<typename std::remove_cvref_t<L>::value_type,
+                                 typename std::remove_cvref_t<Rhs>::value_type>;
+    return VectorBinaryExpr<R, Fn, _operand_storage_t<L>, _operand_storage_t<Rhs>>(
+        std::forward<L>(lhs), std::forward<Rhs>(rhs));
 }
 
-// Vector + Vector
-template <Numeric T>
-template <Numeric U>
-[[nodiscard]] auto Vector<T>::operator+(const Vector<U>& other) const {
-    using R = std::common_type_t<T, U>;
+/** @brief Builds an element-wise unary vector expression with result type R. */
+template <Numeric R, typename Fn, typename E>
+[[nodiscard]] auto _make_vector_unary(E&& operand, Fn fn) noexcept {
+    return VectorUnaryExpr<R, Fn, _operand_storage_t<E>>(std::forward<E>(operand), fn);
+}
 
-    if (_orientation != other.orientation() || _data.size() != other.data().size()) {
-        throw std::invalid_argument("Vectors must be same orientation and size!");
-    }
+}  // namespace detail
 
-    size_t n = _data.size();
-    Vector<R> result(n, _orientation);
-    if (n > OMP_LINEAR_LIMIT) {
-        #pragma omp parallel for
-        for (size_t i = 0; i < n; ++i) {
-            result[i] = static_cast<R>(_data[i]) + static_cast<R>(other[i]);
-        }
-    } else {
-        #pragma omp simd
-        for (size_t i = 0; i < n; ++i) {
-            result[i] = static_cast<R>(_data[i]) + static_cast<R>(other[i]);
+/**
+ * @brief Checks for exact element-wise equality when at least one side is a
+ * lazy expression.
+ * @return true if size, orientation, and all elements are identical.
+ */
+template <VectorOperand L, VectorOperand R>
+    requires(VectorExpression<L> || VectorExpression<R>)
+[[nodiscard]] bool operator==(const L& lhs, const R& rhs) {
+    if (lhs.orientation() != rhs.orientation() || lhs.size() != rhs.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < lhs.size(); ++i) {
+        if (lhs[i] != rhs[i]) {
+            return false;
         }
     }
-    return result;
+    return true;
 }
 
-// Vector + Scalar
+// Assigns a lazy expression, evaluating it in one fused loop
 template <Numeric T>
-template <Numeric U>
-[[nodiscard]] auto Vector<T>::operator+(const U& scalar) const noexcept {
-    using R = std::common_type_t<T, U>;
-
-    R r_scalar = static_cast<R>(scalar);
-    size_t n = _data.size();
-
-    Vector<R> result(n, _orientation);
-    if (n > OMP_LINEAR_LIMIT) {
-        #pragma omp parallel for
-        for (size_t i = 0; i < n; ++i) {
-            result[i] = static_cast<R>(_data[i]) + r_scalar;
-        }
-    } else {
-        #pragma omp simd
-        for (size_t i = 0; i < n; ++i) {
-            result[i] = static_cast<R>(_data[i]) + r_scalar;
-        }
+template <VectorExpression E>
+Vector<T>& Vector<T>::operator=(const E& expr) {
+    if (size() != expr.size()) {
+        // The expression may reference this vector, so evaluate it first
+        *this = Vector<T>(expr);
+        return *this;
     }
-    return result;
+    _orientation = expr.orientation();
+    detail::_assign_vector(
+        _data.data(), expr, [](T& dst, auto value) { dst = static_cast<T>(value); });
+    return *this;
 }
 
 /**
- * @brief Element-wise scalar addition (scalar + Vector).
- * @tparam U An arithmetic scalar type.
- * @param scalar The scalar value.
- * @param vec The vector.
- * @return A new Vector of the common, promoted type.
+ * @brief Unary minus. Lazily negates all elements.
+ * @return An expression of the operand's element type.
  */
-template <Numeric T, Numeric U>
-[[nodiscard]] auto operator+(const U& scalar, const Vector<T>& vec) noexcept {
-    return vec + scalar;
+template <typename E>
+    requires VectorOperand<E>
+[[nodiscard]] auto operator-(E&& vec) noexcept {
+    using R = typename std::remove_cvref_t<E>::value_type;
+    return detail::_make_vector_unary<R>(std::forward<E>(vec), detail::_negate{});
 }
 
-// Vector - Vector
-template <Numeric T>
-template <Numeric U>
-[[nodiscard]] auto Vector<T>::operator-(const Vector<U>& other) const {
-    using R = std::common_type_t<T, U>;
-
-    if (_orientation != other.orientation() || _data.size() != other.size()) {
-        throw std::invalid_argument("Vectors must be same orientation and size!");
-    }
+/**
+ * @brief Element-wise vector addition (Vector + Vector).
+ * @return An expression of the common, promoted type.
+ * @throws std::invalid_argument if dimensions or orientations do not match.
+ */
+template <typename L, typename R>
+    requires VectorOperand<L> && VectorOperand<R>
+[[nodiscard]] auto operator+(L&& lhs, R&& rhs) {
+    return detail::_make_vector_binary<detail::_add>(std::forward<L>(lhs),
+                                                     std::forward<R>(rhs));
+}
 
-    size_t n = _data.size();
-    Vector<R> result(n, _orientation);
-    if (n > OMP_LINEAR_LIMIT) {
-        #pragma omp parallel for
-        for (size_t i = 0; i < n; ++i) {
-            result[i] = static_cast<R>(_data[i]) - static_cast<R>(other[i]);
-        }
-    } else {
-        #pragma omp simd
-        for (size_t i = 0; i < n; ++i) {
-            result[i] = static_cast<R>(_data[i]) - static_cast<R>(other[i]);
-        }
-    }
-    return result;
+/**
+ * @brief Element-wise scalar addition (Vector + scalar).
+ * @return An expression of the common, promoted type.
+ */
+template <typename E, Numeric U>
+    requires VectorOperand<E>
+[[nodiscard]] auto operator+(E&& vec, const U& scalar) noexcept {
+    using R = std::common_type_t<typename std::remove_cvref_t<E>::value_type, U>;
+    return detail::_make_vector_unary<R>(
+        std::forward<E>(vec), detail::_add_scalar<R>{static_cast<R>(scalar)});
 }
 
-// Vector - Scalar
-template <Numeric T>
-template <Numeric U>
-auto Vector<T>::operator-(const U& scalar) const noexcept {
-    using R = std::common_type_t<T, U>;
+/**
+ * @brief Element-wise scalar addition (scalar + Vector).
+ * @return An expression of the common, promoted type.
+ */
+template <Numeric U, typename E>
+    requires VectorOperand<E>
+[[nodiscard]] auto operator+(const U& scalar, E&& vec) noexcept {
+    return std::forward<E>(vec) + scalar;
+}
 
-    R r_scalar = static_cast<R>(scalar);
-    size_t n = _data.size();
+/**
+ * @brief Element-wise vector subtraction (Vector - Vector).
+ * @return An expression of the common, promoted type.
+ * @throws std::invalid_argument if dimensions or orientations do not match.
+ */
+template <typename L, typename R>
+    requires VectorOperand<L> && VectorOperand<R>
+[[nodiscard]] auto operator-(L&& lhs, R&& rhs) {
+    return detail::_make_vector_binary<detail::_subtract>(std::forward<L>(lhs),
+                                                          std::forward<R>(rhs));
+}
 
-    Vector<R> result(n, _orientation);
-    if (n > OMP_LINEAR_LIMIT) {
-        #pragma omp parallel for
-        for (size_t i = 0; i < n; ++i) {
-            result[i] = static_cast<R>(_data[i]) - r_scalar;
-        }
-    } else {
-        #pragma omp simd
-        for (size_t i = 0; i < n; ++i) {
-            result[i] = static_cast<R>(_data[i]) - r_scalar;
-        }
-    }
-    return result;
+/**
+ * @brief Element-wise scalar subtraction (Vector - scalar).
+ * @return An expression of the common, promoted type.
+ */
+template <typename E, Numeric U>
+    requires VectorOperand<E>
+[[nodiscard]] auto operator-(E&& vec, const U& scalar) noexcept {
+    using R = std::common_type_t<typename std::remove_cvref_t<E>::value_type, U>;
+    return detail::_make_vector_unary<R>(
+        std::forward<E>(vec), detail::_subtract_scalar<R>{static_cast<R>(scalar)});
 }
 
 /**
  * @brief Element-wise scalar subtraction (scalar - Vector).
- * @tparam U An arithmetic scalar type.
- * @param scalar The scalar value from which elements are subtracted.
- * @param vec The vector.
- * @return A new Vector of the common, promoted type.
+ * @return An expression of the common, promoted type.
  */
-template <Numeric T, Numeric U>
-auto operator-(const U& scalar, const Vector<T>& vec) noexcept {
-    using R = std::common_type_t<T, U>;
-
-    R r_scalar = static_cast<R>(scalar);
-    size_t n = vec.size();
-
-    Vector<R> result(n, vec.orientation());
-    if (n > OMP_LINEAR_LIMIT) {
-        #pragma omp parallel for
-        for (size_t i = 0; i < n; ++i) {
-            result[i] = r_scalar - static_cast<R>(vec[i]);
-        }
-    } else {
-        #pragma omp simd
-        for (size_t i = 0; i < n; ++i) {
-            result[i] = r_scalar - static_cast<R>(vec[i]);
-        }
-    }
-    return result;
+template <Numeric U, typename E>
+    requires VectorOperand<E>
+[[nodiscard]] auto operator-(const U& scalar, E&& vec) noexcept {
+    using R = std::common_type_t<typename std::remove_cvref_t<E>::value_type, U>;
+    return detail::_make_vector_unary<R>(
+        std::forward<E>(vec), detail::_subtract_from_scalar<R>{static_cast<R>(scalar)});
 }
 
-// Vector * Scalar
-template <Numeric T>
-template <Numeric U>
-[[nodiscard]] auto Vector<T>::operator*(const U& scalar) const noexcept {
-    using R = std::common_type_t<T, U>;
-
-    R r_scalar = static_cast<R>(scalar);
-    size_t n = _data.size();
-
-    Vector<R> result(n, _orientation);
-    if (n > OMP_LINEAR_LIMIT) {
-        #pragma omp parallel for
-        for (size_t i = 0; i < n; ++i) {
-            result[i] = static_cast<R>(_data[i]) * r_scalar;
-        }
-    } else {
-        #pragma omp simd
-        for (size_t i = 0; i < n; ++i) {
-            result[i] = static_cast<R>(_data[i]) * r_scalar;
-        }
-    }
-    return result;
+/**
+ * @brief Element-wise scalar multiplication (Vector * scalar).
+ * @return An expression of the common, promoted type.
+ */
+template <typename E, Numeric U>
+    requires VectorOperand<E>
+[[nodiscard]] auto operator*(E&& vec, const U& scalar) noexcept {
+    using R = std::common_type_t<typename std::remove_cvref_t<E>::value_type, U>;
+    return detail::_make_vector_unary<R>(
+        std::forward<E>(vec), detail::_multiply_scalar<R>{static_cast<R>(scalar)});
 }
 
 /**
  * @brief Element-wise scalar multiplication (scalar * Vector).
- * @tparam U An arithmetic scalar type.
- * @param scalar The scalar value.
- * @param vec The vector.
- * @return A new Vector of the common, promoted type.
+ * @return An expression of the common, promoted type.
  */
-template <Numeric T, Numeric U>
-[[nodiscard]] auto operator*(const U& scalar, const Vector<T>& vec) noexcept {
-    return vec * scalar;
+template <Numeric U, typename E>
+    requires VectorOperand<E>
+[[nodiscard]] auto operator*(const U& scalar, E&& vec) noexcept {
+    return std::forward<E>(vec) * scalar;
 }
 
 // TODO: Check if makes sense to use BLAS on routines below
@@ -224,13 +201,70 @@ auto Vector<T>::operator*(const Matrix<U>& other) const {
         throw std::invalid_argument("Dimensions do not match!");
     }
 
-    Vector<R> result(r, std::vector<R>(r), ROW);
-    for (size_t i = 0; i < r; ++i) {
+    // x^T * A is the GEMV of the transposed (column-contiguous) matrix
+    Vector<R> result(r, default_init, ROW);
+    detail::_gemv(r,
+                  n,
+                  R(1),
+                  other.data().data(),
+                  1,
+                  other.leading_dimension(),
+                  _data.data(),
+                  1,
+                  R(0),
+                  result.data().data(),
+                  1);
+    return result;
+}
+
+/**
+ * @brief Vector-Matrix multiplication (row_vector * view or expression).
+ * @details Views run on the GEMV kernel with their strides; expressions are
+ * read element-wise, without being materialized.
+ * @return A new row Vector of the common, promoted type.
+ * @throws std::invalid_argument if vector is not a row vector or
+ * dimensions do not match.
+ */
+template <Numeric T, MatrixExpression E>
+[[nodiscard]] auto operator*(const Vector<T>& vec, const E& matrix) {
+    using R = std::common_type_t<T, typename E::value_type>;
+
+    const size_t n = vec.size();
+    const size_t r = matrix.column_count();
+
+    if (vec.orientation() == COLUMN) {
+        throw std::invalid_argument(
+            "Invalid multiplication: column Vector * Matrix. "
+            "Did you mean Matrix * Vector?");
+    }
+    if (n != matrix.row_count()) {
+        throw std::invalid_argument("Dimensions do not match!");
+    }
+
+    if constexpr (detail::is_matrix_view<E>::value) {
+        Vector<R> result(r, default_init, ROW);
+        detail::_gemv(r,
+                      n,
+                      R(1),
+                      matrix.data(),
+                      matrix.col_stride(),
+                      matrix.row_stride(),
+                      vec.data().data(),
+                      1,
+                      R(0),
+                      result.data().data(),
+                      1);
+        return result;
+    } else {
+        Vector<R> result(r, ROW);
         for (size_t j = 0; j < n; ++j) {
-            result.at(i) += at(j) * other.at(j, i);
+            const R v_j = static_cast<R>(vec[j]);
+            for (size_t i = 0; i < r; ++i) {
+                result[i] += v_j * static_cast<R>(matrix(j, i));
+            }
         }
+        return result;
     }
-    return result;
 }
 
 // Vector * Vector -> Matrix
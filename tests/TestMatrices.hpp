@@ -0,0 +1,47 @@
+#pragma once
+#include "MafLib/main/GlobalHeader.hpp"
+#include "MafLib/math/linalg/LinAlg.hpp"
+
+/**
+ * @file TestMatrices.hpp
+ * @brief Seeded random matrices shared by the linear algebra test suites.
+ */
+namespace maf::test {
+/** @brief A random rows x cols dense matrix with elements in [-1, 1). */
+inline math::Matrix<double> random_dense(size_t rows, size_t cols, uint32 seed) {
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<> dis(-1.0, 1.0);
+    math::Matrix<double> result(rows, cols);
+    for (size_t i = 0; i < rows; ++i) {
+        for (size_t j = 0; j < cols; ++j) {
+            result(i, j) = dis(gen);
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief A random well-conditioned n x n matrix: diagonal near 2,
+ * off-diagonal elements of order 1 / n.
+ */
+inline math::Matrix<double> random_diagonally_dominant(size_t n, uint32 seed) {
+    math::Matrix<double> result = random_dense(n, n, seed);
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j < n; ++j) {
+            result(i, j) = i == j ? 2.0 + result(i, j)
+                                  : result(i, j) / static_cast<double>(n);
+        }
+    }
+    return result;
+}
+
+/** @brief A random symmetric positive definite n x n matrix. */
+inline math::Matrix<double> random_spd(size_t n, uint32 seed) {
+    const auto a = random_dense(n, n, seed);
+    math::Matrix<double> result = a * a.transposed();
+    for (size_t i = 0; i < n; ++i) {
+        result(i, i) += static_cast<double>(n);
+    }
+    return result;
+}
+}  // namespace maf::test
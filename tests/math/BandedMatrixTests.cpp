@@ -0,0 +1,315 @@
+#include "ITest.hpp"
+#include "MafLib/main/GlobalHeader.hpp"
+#include "MafLib/math/linalg/BandedMatrix.hpp"
+#include "MafLib/math/linalg/LinAlg.hpp"
+#include "TestMatrices.hpp"
+
+namespace maf::test {
+
+using namespace maf;
+using namespace util;
+using namespace std::chrono;
+class BandedMatrixTests : public ITest {
+private:
+    /** @brief A random n x n band matrix, diagonally dominant if requested. */
+    static math::BandedMatrix<double> random_banded(
+        size_t n, size_t lower, size_t upper, bool dominant, uint32 seed) {
+        // Column j of the band is row j of a random n x (lower + upper + 1)
+        const auto band = random_dense(n, lower + upper + 1, seed);
+        math::BandedMatrix<double> a(n, n, lower, upper);
+        for (size_t j = 0; j < n; ++j) {
+            for (size_t i = j > upper ? j - upper : 0; i < n && i <= j + lower; ++i) {
+                a(i, j) = band(j, i + upper - j);
+            }
+            if (dominant) {
+                a(j, j) += static_cast<double>(lower + upper + 1);
+            }
+        }
+        return a;
+    }
+
+    /** @brief max |A x - b| computed densely. */
+    static double residual(const math::Matrix<double>& a,
+                           const math::Vector<double>& x,
+                           const math::Vector<double>& b) {
+        const auto ax = a * x;
+        double worst = 0.0;
+        for (size_t i = 0; i < b.size(); ++i) {
+            worst = std::max(worst, std::abs(ax[i] - b[i]));
+        }
+        return worst;
+    }
+
+    static math::Vector<double> ramp(size_t n) {
+        math::Vector<double> b(n, math::COLUMN);
+        for (size_t i = 0; i < n; ++i) {
+            b[i] = std::cos(static_cast<double>(i));
+        }
+        return b;
+    }
+
+    //=============================================================================
+    // BANDED MATRIX STORAGE TESTS
+    //=============================================================================
+    void should_store_band_in_lapack_layout() {
+        const math::Matrix<double> dense(
+            4, 5, {1, 2, 0, 0, 9, 3, 4, 5, 0, 0, 6, 7, 8, 9, 0, 0, 1, 2, 3, 4});
+        const math::BandedMatrix<double> a(dense, 1, 1);
+
+        ASSERT_TRUE(a.leading_dimension() == 3);
+        ASSERT_TRUE(a.band_data().size() == 15);
+        // Column 1 holds A(0, 1), A(1, 1), A(2, 1)
+        ASSERT_TRUE(a.band_data()[3] == 2 && a.band_data()[4] == 4 &&
+                    a.band_data()[5] == 7);
+        ASSERT_TRUE(a.at(0, 4) == 0);  // outside the band, dropped
+        ASSERT_TRUE(a.at(2, 0) == 0);  // outside the band, dropped
+        ASSERT_TRUE(a.at(3, 3) == 3);
+        ASSERT_TRUE(!a.in_band(3, 1) && a.in_band(3, 4));
+
+        math::Matrix<double> expected = dense;
+        expected(0, 4) = 0;
+        expected(2, 0) = 0;
+        expected(3, 1) = 0;
+        ASSERT_TRUE(a.to_dense() == expected);
+
+        math::Vector<double> x(5, std::vector<double>{1, -1, 2, 0.5, 3});
+        ASSERT_TRUE(residual(expected, x, a * x) < 1e-12);
+
+        bool thrown = false;
+        try {
+            static_cast<void>(a.at(4, 0));
+        } catch (const std::out_of_range& e) {
+            thrown = true;
+        }
+        ASSERT_TRUE(thrown);
+
+        const std::vector<double> sub = {1, 2};
+        const std::vector<double> diag = {4, 5, 6};
+        const std::vector<double> super = {7, 8};
+        const auto t = math::BandedMatrix<double>::tridiagonal(sub, diag, super);
+        ASSERT_TRUE(t.to_dense() ==
+                    math::Matrix<double>(3, 3, {4, 7, 0, 1, 5, 8, 0, 2, 6}));
+    }
+
+    //=============================================================================
+    // BANDED FACTORIZATION TESTS
+    //=============================================================================
+    void should_solve_with_banded_lu() {
+        // Not diagonally dominant, so the factorization has to pivot
+        const size_t n = 300;
+        const auto a = random_banded(n, 3, 2, false, 5);
+        const auto dense = a.to_dense();
+        const auto b = ramp(n);
+
+        const math::BandedLU<double> lu(a);
+        bool pivoted = false;
+        for (size_t j = 0; j < n; ++j) {
+            pivoted = pivoted || lu.pivots()[j] != j;
+        }
+        ASSERT_TRUE(pivoted);
+        ASSERT_TRUE(residual(dense, lu.solve(b), b) < 1e-8);
+
+        // Several right-hand sides at once, more than one column block
+        math::Matrix<double> rhs(n, 70);
+        for (size_t i = 0; i < n; ++i) {
+            for (size_t j = 0; j < 70; ++j) {
+                rhs(i, j) = std::sin(static_cast<double>(i + (3 * j)));
+            }
+        }
+        ASSERT_TRUE(math::loosely_equal(dense * lu.solve(rhs), rhs, 1e-8));
+
+        const auto small = random_banded(6, 1, 2, false, 9);
+        const auto [p, l, u] = math::plu(small.to_dense());
+        double det = 1.0;
+        for (size_t i = 0; i < 6; ++i) {
+            det *= u(i, i);
+        }
+        ASSERT_TRUE(is_close(std::abs(math::BandedLU<double>(small).determinant()),
+                             std::abs(det),
+                             1e-9));
+
+        bool thrown = false;
+        try {
+            math::BandedLU<double> singular(math::BandedMatrix<double>(4, 4, 1, 1));
+        } catch (const std::runtime_error& e) {
+            thrown = true;
+        }
+        ASSERT_TRUE(thrown);
+    }
+
+    void should_solve_with_banded_cholesky() {
+        const size_t n = 400;
+        // Symmetric, both bands stored
+        math::BandedMatrix<double> a(n, n, 4, 4);
+        for (size_t i = 0; i < n; ++i) {
+            a(i, i) = 10.0;
+            for (size_t d = 1; d <= 4 && i + d < n; ++d) {
+                a(i + d, i) = a(i, i + d) = 1.0 / static_cast<double>(d + i % 3);
+            }
+        }
+        const auto dense = a.to_dense();
+        const auto b = ramp(n);
+
+        const math::BandedCholesky<double> chol(a);
+        ASSERT_TRUE(residual(dense, chol.solve(b), b) < 1e-10);
+        const auto l = chol.factor().to_dense();
+        ASSERT_TRUE(math::loosely_equal(l * l.transposed(), dense, 1e-10));
+
+        // Only the lower band stored gives the same factor
+        math::BandedMatrix<double> lower(n, n, 4, 0);
+        for (size_t j = 0; j < n; ++j) {
+            for (size_t i = j; i <= std::min(j + 4, n - 1); ++i) {
+                lower(i, j) = a(i, j);
+            }
+        }
+        ASSERT_TRUE(math::BandedCholesky<double>(lower).factor() == chol.factor());
+
+        const auto dense_l = math::cholesky(dense.block(0, 0, 50, 50));
+        double log_det = 0.0;
+        for (size_t i = 0; i < 50; ++i) {
+            log_det += 2.0 * std::log(dense_l(i, i));
+        }
+        math::BandedMatrix<double> leading(dense.block(0, 0, 50, 50), 4, 4);
+        ASSERT_TRUE(
+            is_close(math::BandedCholesky<double>(leading).log_determinant(), log_det));
+
+        bool thrown = false;
+        try {
+            a(3, 4) = 2.0;
+            math::BandedCholesky<double> asymmetric(a);
+        } catch (const std::invalid_argument& e) {
+            thrown = true;
+        }
+        ASSERT_TRUE(thrown);
+
+        thrown = false;
+        try {
+            math::BandedCholesky<double> indefinite(
+                math::BandedMatrix<double>::tridiagonal(std::vector<double>{2.0},
+                                                        std::vector<double>{1.0, 1.0},
+                                                        std::vector<double>{2.0}));
+        } catch (const std::invalid_argument& e) {
+            thrown = true;
+        }
+        ASSERT_TRUE(thrown);
+    }
+
+    //=============================================================================
+    // TRIDIAGONAL SOLVER TESTS
+    //=============================================================================
+    void should_solve_tridiagonal_systems() {
+        const size_t n = 1000;
+        std::vector<double> sub(n - 1, -1.0);
+        std::vector<double> diag(n, 2.5);
+        std::vector<double> super(n - 1, -1.2);
+        for (size_t i = 0; i < n - 1; ++i) {
+            sub[i] += 0.1 * std::sin(static_cast<double>(i));
+        }
+        const auto b = ramp(n);
+        const auto x = math::solve_tridiagonal<double>(sub, diag, super, b);
+        const auto t = math::BandedMatrix<double>::tridiagonal(sub, diag, super);
+        const auto tx = t * x;
+        double worst = 0.0;
+        for (size_t i = 0; i < n; ++i) {
+            worst = std::max(worst, std::abs(tx[i] - b[i]));
+        }
+        ASSERT_TRUE(worst < 1e-12);
+
+        // A batch of systems, one per column, each with its own coefficients
+        const size_t batch = 515;
+        math::Matrix<double> lower(n, batch);
+        math::Matrix<double> diagonal(n, batch);
+        math::Matrix<double> upper(n, batch);
+        math::Matrix<double> rhs(n, batch);
+        for (size_t i = 0; i < n; ++i) {
+            for (size_t s = 0; s < batch; ++s) {
+                const auto v = static_cast<double>((i * 7) + (s * 13));
+                lower(i, s) = -1.0 + (0.3 * std::sin(v));
+                upper(i, s) = -1.0 + (0.3 * std::cos(v));
+                diagonal(i, s) = 3.0 + std::sin(v * 0.5);
+                rhs(i, s) = std::cos(v * 0.25);
+            }
+        }
+        math::Matrix<double> solution = rhs;
+        math::solve_tridiagonal_batched(lower, diagonal, upper, solution);
+
+        bool matches = true;
+        for (size_t s = 0; s < batch; s += 37) {
+            std::vector<double> sub_s(n - 1);
+            std::vector<double> diag_s(n);
+            std::vector<double> super_s(n - 1);
+            math::Vector<double> b_s(n, math::COLUMN);
+            for (size_t i = 0; i < n; ++i) {
+                diag_s[i] = diagonal(i, s);
+                b_s[i] = rhs(i, s);
+                if (i + 1 < n) {
+                    sub_s[i] = lower(i + 1, s);
+                    super_s[i] = upper(i, s);
+                }
+            }
+            const auto x_s =
+                math::solve_tridiagonal<double>(sub_s, diag_s, super_s, b_s);
+            for (size_t i = 0; i < n; ++i) {
+                matches = matches && is_close(x_s[i], solution(i, s), 1e-12);
+            }
+        }
+        ASSERT_TRUE(matches);
+
+        bool thrown = false;
+        try {
+            math::Matrix<double> zero(n, batch);
+            math::solve_tridiagonal_batched(lower, zero, upper, solution);
+        } catch (const std::runtime_error& e) {
+            thrown = true;
+        }
+        ASSERT_TRUE(thrown);
+    }
+
+    void banded_solve_time_test() {
+        const size_t n = 200000;
+        const auto a = random_banded(n, 2, 2, true, 3);
+        const auto b = ramp(n);
+
+        auto start = high_resolution_clock::now();
+        const math::BandedLU<double> lu(a);
+        const auto x = lu.solve(b);
+        duration<double> lu_elapsed = high_resolution_clock::now() - start;
+
+        const size_t m = 256;
+        const size_t batch = 4096;
+        math::Matrix<double> lower(m, batch);
+        math::Matrix<double> diagonal(m, batch);
+        math::Matrix<double> upper(m, batch);
+        math::Matrix<double> rhs(m, batch);
+        lower.fill(-1.0);
+        upper.fill(-1.0);
+        diagonal.fill(4.0);
+        rhs.fill(1.0);
+        start = high_resolution_clock::now();
+        math::solve_tridiagonal_batched(lower, diagonal, upper, rhs);
+        duration<double> batched_elapsed = high_resolution_clock::now() - start;
+
+        std::cout << "Banded LU solve, n = " << n << ", kl = ku = 2: "
+                  << lu_elapsed.count() << " s\n"
+                  << batch << " tridiagonal systems of size " << m << ": "
+                  << batched_elapsed.count() << " s\n";
+        const auto ax = a * x;
+        double worst = 0.0;
+        for (size_t i = 0; i < n; ++i) {
+            worst = std::max(worst, std::abs(ax[i] - b[i]));
+        }
+        ASSERT_TRUE(worst < 1e-10);
+    }
+
+public:
+    int run_all_tests() override {
+        should_store_band_in_lapack_layout();
+        should_solve_with_banded_lu();
+        should_solve_with_banded_cholesky();
+        should_solve_tridiagonal_systems();
+        banded_solve_time_test();
+        return 0;
+    }
+};
+
+}  // namespace maf::test
@@ -0,0 +1,315 @@
+#include "ITest.hpp"
+#include "MafLib/main/GlobalHeader.hpp"
+#include "MafLib/math/linalg/Factorization.hpp"
+#include "MafLib/math/linalg/LinAlg.hpp"
+#include "TestMatrices.hpp"
+
+namespace maf::test {
+
+using namespace maf;
+using namespace util;
+using namespace std::chrono;
+class FactorizationTests : public ITest {
+private:
+    /** @brief max |A x - b|. */
+    static double residual(const math::Matrix<double>& a,
+                           const math::Vector<double>& x,
+                           const math::Vector<double>& b) {
+        const auto ax = a * x;
+        double worst = 0.0;
+        for (size_t i = 0; i < b.size(); ++i) {
+            worst = std::max(worst, std::abs(ax[i] - b[i]));
+        }
+        return worst;
+    }
+
+    static math::Vector<double> ramp(size_t n) {
+        math::Vector<double> b(n, math::COLUMN);
+        for (size_t i = 0; i < n; ++i) {
+            b[i] = std::cos(static_cast<double>(i));
+        }
+        return b;
+    }
+
+    //=============================================================================
+    // LU FACTORIZATION TESTS
+    //=============================================================================
+    void should_solve_with_lu_factorization() {
+        const size_t n = 200;
+        const auto a = random_dense(n, n, 1);
+        const math::LUFactorization<double> lu(a);
+        ASSERT_TRUE(lu.size() == n);
+
+        const auto b = ramp(n);
+        ASSERT_TRUE(residual(a, lu.solve(b), b) < 1e-10);
+
+        // More right-hand sides than one column chunk of the solver
+        const auto rhs = random_dense(n, 300, 2);
+        ASSERT_TRUE(math::loosely_equal(a * lu.solve(rhs), rhs, 1e-10));
+        // A transposed (strided) right-hand side
+        const auto wide = random_dense(50, n, 3);
+        ASSERT_TRUE(math::loosely_equal(a * lu.solve(wide.t()), wide.t(), 1e-10));
+
+        // P A = L U
+        const auto [p, l, u] = math::plu(a);
+        ASSERT_TRUE(lu.permutation() == p);
+        ASSERT_TRUE(math::loosely_equal(lu.lower().to_dense(), l, 1e-12));
+        ASSERT_TRUE(math::loosely_equal(lu.upper().to_dense(), u, 1e-12));
+
+        ASSERT_TRUE(math::loosely_equal(
+            a * lu.inverse(), math::identity_matrix<double>(n), 1e-10));
+
+        // An integer matrix is converted
+        const math::Matrix<int> small(3, 3, {2, 1, 1, 4, -6, 0, -2, 7, 2});
+        const math::LUFactorization<double> small_lu(small);
+        ASSERT_TRUE(is_close(small_lu.determinant(), -16.0, 1e-12));
+        ASSERT_TRUE(is_close(small_lu.log_determinant(), std::log(16.0), 1e-12));
+
+        bool thrown = false;
+        try {
+            math::LUFactorization<double> singular(
+                math::Matrix<double>(3, 3, {1, 2, 3, 2, 4, 6, 1, 2, 3}));
+        } catch (const std::runtime_error& e) {
+            thrown = true;
+        }
+        ASSERT_TRUE(thrown);
+
+        thrown = false;
+        try {
+            static_cast<void>(lu.solve(ramp(n + 1)));
+        } catch (const std::invalid_argument& e) {
+            thrown = true;
+        }
+        ASSERT_TRUE(thrown);
+    }
+
+    //=============================================================================
+    // CHOLESKY FACTORIZATION TESTS
+    //=============================================================================
+    void should_solve_with_cholesky_factorization() {
+        const size_t n = 150;
+        const auto a = random_spd(n, 3);
+        const math::CholeskyFactorization<double> chol(a);
+        ASSERT_TRUE(chol.size() == n);
+
+        const auto b = ramp(n);
+        ASSERT_TRUE(residual(a, chol.solve(b), b) < 1e-10);
+        const auto rhs = random_dense(n, 40, 4);
+        ASSERT_TRUE(math::loosely_equal(a * chol.solve(rhs), rhs, 1e-10));
+        ASSERT_TRUE(math::loosely_equal(
+            a * chol.inverse(), math::identity_matrix<double>(n), 1e-10));
+
+        // The same factor from packed symmetric storage
+        const math::SymmetricMatrix<double> symmetric(a);
+        const math::CholeskyFactorization<double> packed(symmetric);
+        ASSERT_TRUE(packed.factor() == chol.factor());
+
+        const math::LUFactorization<double> lu(a);
+        ASSERT_TRUE(is_close(chol.log_determinant(), lu.log_determinant(), 1e-9));
+        const math::Matrix<double> small(2, 2, {4, 2, 2, 3});
+        ASSERT_TRUE(
+            is_close(math::CholeskyFactorization<double>(small).determinant(), 8.0));
+
+        bool thrown = false;
+        try {
+            math::CholeskyFactorization<double> asymmetric(random_dense(4, 4, 5));
+        } catch (const std::invalid_argument& e) {
+            thrown = true;
+        }
+        ASSERT_TRUE(thrown);
+
+        thrown = false;
+        try {
+            math::CholeskyFactorization<double> indefinite(
+                math::Matrix<double>(2, 2, {1, 2, 2, 1}));
+        } catch (const std::invalid_argument& e) {
+            thrown = true;
+        }
+        ASSERT_TRUE(thrown);
+    }
+
+    //=============================================================================
+    // QR FACTORIZATION TESTS
+    //=============================================================================
+    void should_solve_least_squares_with_qr_factorization() {
+        const size_t m = 300;
+        const size_t n = 120;
+        const auto a = random_dense(m, n, 8);
+        const math::QRFactorization<double> qr(a);
+        ASSERT_TRUE(qr.row_count() == m && qr.column_count() == n);
+        ASSERT_TRUE(qr.tau().size() == n);
+
+        const auto q = qr.q();
+        const auto r = qr.r();
+        ASSERT_TRUE(r.is_upper_triangular());
+        ASSERT_TRUE(math::loosely_equal(q * r, a, 1e-10));
+        ASSERT_TRUE(math::loosely_equal(
+            q.transposed() * q, math::identity_matrix<double>(n), 1e-10));
+
+        // Q^T then Q is the identity on any block of columns
+        const auto c = random_dense(m, 70, 9);
+        math::Matrix<double> round_trip = c;
+        qr.apply_qt(round_trip);
+        qr.apply_q(round_trip);
+        ASSERT_TRUE(math::loosely_equal(round_trip, c, 1e-10));
+
+        // The least squares solution satisfies the normal equations
+        const auto b = ramp(m);
+        const auto x = qr.solve(b);
+        const math::CholeskyFactorization<double> normal(a.transposed() * a);
+        const auto expected = normal.solve(a.transposed() * b);
+        bool matches = x.size() == n;
+        for (size_t i = 0; i < n && matches; ++i) {
+            matches = is_close(x[i], expected[i], 1e-8);
+        }
+        ASSERT_TRUE(matches);
+        const auto rhs = random_dense(m, 5, 10);
+        ASSERT_TRUE(math::loosely_equal(
+            qr.solve(rhs), normal.solve(a.transposed() * rhs), 1e-8));
+
+        bool thrown = false;
+        try {
+            static_cast<void>(math::QRFactorization<double>(a.transposed()).solve(
+                ramp(n)));
+        } catch (const std::invalid_argument& e) {
+            thrown = true;
+        }
+        ASSERT_TRUE(thrown);
+
+        thrown = false;
+        try {
+            const math::Matrix<double> rank_one(3, 2, {1, 2, 2, 4, 3, 6});
+            static_cast<void>(math::QRFactorization<double>(rank_one).solve(ramp(3)));
+        } catch (const std::runtime_error& e) {
+            thrown = true;
+        }
+        ASSERT_TRUE(thrown);
+    }
+
+    //=============================================================================
+    // TSQR TESTS
+    //=============================================================================
+    void should_solve_least_squares_with_tsqr() {
+        // Several chunks per thread and a tree of per-thread factors
+        const size_t m = 20000;
+        const size_t n = 12;
+        const auto a = random_dense(m, n, 11);
+        const auto r = math::tsqr(a);
+        ASSERT_TRUE(r.row_count() == n && r.is_upper_triangular());
+        ASSERT_TRUE(
+            math::loosely_equal(r.transposed() * r, a.transposed() * a, 1e-8));
+
+        const auto noise = random_dense(m, 1, 12);
+        math::Vector<double> b(m);
+        for (size_t i = 0; i < m; ++i) {
+            b[i] = a(i, 0) - (2.0 * a(i, n - 1)) + noise(i, 0);
+        }
+        const auto x = math::lstsq(a, b);
+        const auto expected = math::QRFactorization<double>(a).solve(b);
+        bool matches = x.size() == n;
+        for (size_t i = 0; i < n && matches; ++i) {
+            matches = is_close(x[i], expected[i], 1e-10);
+        }
+        ASSERT_TRUE(matches);
+
+        // Streaming the augmented rows [A b] gives the same coefficients
+        math::Matrix<double> augmented(m, n + 1);
+        for (size_t i = 0; i < m; ++i) {
+            for (size_t j = 0; j < n; ++j) {
+                augmented(i, j) = a(i, j);
+            }
+            augmented(i, n) = b[i];
+        }
+        math::TallSkinnyQR<double> stream(n + 1);
+        for (size_t first = 0; first < m; first += 3000) {
+            const size_t rows = std::min<size_t>(3000, m - first);
+            stream.add_rows(augmented.block(first, 0, rows, n + 1));
+        }
+        ASSERT_TRUE(stream.row_count() == m);
+        const auto streamed = stream.solve();
+        matches = streamed.size() == n;
+        for (size_t i = 0; i < n && matches; ++i) {
+            matches = is_close(streamed[i], expected[i], 1e-10);
+        }
+        ASSERT_TRUE(matches);
+
+        bool thrown = false;
+        try {
+            static_cast<void>(math::lstsq(a, ramp(m - 1)));
+        } catch (const std::invalid_argument& e) {
+            thrown = true;
+        }
+        ASSERT_TRUE(thrown);
+
+        thrown = false;
+        try {
+            static_cast<void>(math::tsqr(a.t()));
+        } catch (const std::invalid_argument& e) {
+            thrown = true;
+        }
+        ASSERT_TRUE(thrown);
+    }
+
+    void tsqr_time_test() {
+        const size_t m = 400000;
+        const size_t n = 50;
+        const auto a = random_dense(m, n, 13);
+        const auto b = ramp(m);
+
+        auto start = high_resolution_clock::now();
+        const auto x = math::lstsq(a, b);
+        duration<double> tsqr_elapsed = high_resolution_clock::now() - start;
+
+        start = high_resolution_clock::now();
+        const auto expected = math::QRFactorization<double>(a).solve(b);
+        duration<double> householder_elapsed = high_resolution_clock::now() - start;
+
+        std::cout << "Least squares " << m << " x " << n
+                  << ": TSQR: " << tsqr_elapsed.count()
+                  << " s, blocked Householder: " << householder_elapsed.count()
+                  << " s\n";
+        bool matches = true;
+        for (size_t i = 0; i < n; ++i) {
+            matches = matches && is_close(x[i], expected[i], 1e-9);
+        }
+        ASSERT_TRUE(matches);
+    }
+
+    void factorization_time_test() {
+        const size_t n = 1000;
+        const size_t scenarios = 2000;
+        const auto covariance = random_spd(n, 6);
+        const auto rhs = random_dense(n, scenarios, 7);
+
+        auto start = high_resolution_clock::now();
+        const math::CholeskyFactorization<double> chol(covariance);
+        duration<double> factor_elapsed = high_resolution_clock::now() - start;
+
+        start = high_resolution_clock::now();
+        const auto x = chol.solve(rhs);
+        duration<double> solve_elapsed = high_resolution_clock::now() - start;
+
+        start = high_resolution_clock::now();
+        const math::LUFactorization<double> lu(covariance);
+        duration<double> lu_elapsed = high_resolution_clock::now() - start;
+
+        std::cout << "Cholesky of " << n << " x " << n << ": " << factor_elapsed.count()
+                  << " s, solve for " << scenarios
+                  << " right-hand sides: " << solve_elapsed.count()
+                  << " s, LU: " << lu_elapsed.count() << " s\n";
+        ASSERT_TRUE(math::loosely_equal(covariance * x, rhs, 1e-9));
+    }
+
+public:
+    int run_all_tests() override {
+        should_solve_with_lu_factorization();
+        should_solve_with_cholesky_factorization();
+        should_solve_least_squares_with_qr_factorization();
+        should_solve_least_squares_with_tsqr();
+        tsqr_time_test();
+        factorization_time_test();
+        return 0;
+    }
+};
+
+}  // namespace maf::test
@@ -1,5 +1,12 @@
 #include "MafLib/main/GlobalHeader.hpp"
+#include "BandedMatrixTests.cpp"
+#include "FactorizationTests.cpp"
 #include "MatrixTests.cpp"
+#include "PCATests.cpp"
+#include "SparseMatrixTests.cpp"
+#include "SymmetricMatrixTests.cpp"
+#include "TestMatrices.hpp"
+#include "TriangularMatrixTests.cpp"
 #include "VectorTests.cpp"
 
 int main() {
@@ -10,5 +17,35 @@ int main() {
 
     auto vector_tests = maf::test::VectorTests();
     vector_tests.run_all_tests();
+
+    std::cout << "=== Running SparseMatrix tests ===" << std::endl;
+    auto sparse_tests = maf::test::SparseMatrixTests();
+    sparse_tests.run_all_tests();
+    sparse_tests.print_summary();
+
+    std::cout << "=== Running BandedMatrix tests ===" << std::endl;
+    auto banded_tests = maf::test::BandedMatrixTests();
+    banded_tests.run_all_tests();
+    banded_tests.print_summary();
+
+    std::cout << "=== Running SymmetricMatrix tests ===" << std::endl;
+    auto symmetric_tests = maf::test::SymmetricMatrixTests();
+    symmetric_tests.run_all_tests();
+    symmetric_tests.print_summary();
+
+    std::cout << "=== Running TriangularMatrix tests ===" << std::endl;
+    auto triangular_tests = maf::test::TriangularMatrixTests();
+    triangular_tests.run_all_tests();
+    triangular_tests.print_summary();
+
+    std::cout << "=== Running Factorization tests ===" << std::endl;
+    auto factorization_tests = maf::test::FactorizationTests();
+    factorization_tests.run_all_tests();
+    factorization_tests.print_summary();
+
+    std::cout << "=== Running PCA tests ===" << std::endl;
+    auto pca_tests = maf::test::PCATests();
+    pca_tests.run_all_tests();
+    pca_tests.print_summary();
     return 0;
 }
@@ -3,6 +3,7 @@
 #include "MafLib/math/linalg/Matrix.hpp"
 #include "MafLib/math/linalg/MatrixCheckers.hpp"
 #include "MafLib/math/linalg/Vector.hpp"
+#include "TestMatrices.hpp"
 
 namespace maf::test {
 using namespace maf;
@@ -123,6 +124,54 @@ private:
         ASSERT_TRUE(thrown);
     }
 
+    void should_allocate_aligned_storage() {
+        math::Matrix<double> m(3, 5);
+        math::Vector<float> v(7);
+        const auto m_address = reinterpret_cast<std::uintptr_t>(m.data().data());
+        const auto v_address = reinterpret_cast<std::uintptr_t>(v.data().data());
+        ASSERT_TRUE(m_address % math::STORAGE_ALIGNMENT == 0);
+        ASSERT_TRUE(v_address % math::STORAGE_ALIGNMENT == 0);
+        ASSERT_TRUE(m.at(2, 4) == 0.0 && v[6] == 0.0F);
+    }
+
+    void should_construct_padded_and_uninitialised_matrices() {
+        math::Matrix<double> padded(5, 3, math::PADDED);
+        ASSERT_TRUE(padded.leading_dimension() == 8);
+        ASSERT_TRUE(padded.size() == 15);
+
+        // 512 doubles per row is exactly 4 KiB, so one cache line is added
+        math::Matrix<double> wide(2, 512, math::default_init, math::PADDED);
+        ASSERT_TRUE(wide.leading_dimension() == 520);
+
+        math::Matrix<double> a(5, 3, math::default_init, math::PADDED);
+        math::Matrix<double> b(5, 3);
+        for (size_t i = 0; i < 5; ++i) {
+            for (size_t j = 0; j < 3; ++j) {
+                a.at(i, j) = static_cast<double>((i * 3) + j);
+                b.at(i, j) = static_cast<double>((i * 3) + j);
+            }
+        }
+        ASSERT_TRUE(a == b);
+        ASSERT_TRUE(a.transposed() * a == b.transposed() * b);
+        ASSERT_TRUE(a.t() * a == b.t() * b);
+        ASSERT_TRUE(a.cast<int>() == b.cast<int>());
+        ASSERT_TRUE(math::Matrix<double>(a - b) == math::Matrix<double>(5, 3));
+    }
+
+    void should_allocate_from_memory_resource() {
+        std::pmr::monotonic_buffer_resource arena;
+        math::Matrix<double> m(4, 4, math::default_init, math::UNPADDED, &arena);
+        ASSERT_TRUE(m.data().resource() == &arena);
+        m.fill(1.0);
+
+        // Copies allocate from the default resource, moves keep the storage
+        math::Matrix<double> copy = m;
+        ASSERT_TRUE(copy.data().resource() == std::pmr::get_default_resource());
+        math::Matrix<double> moved = std::move(m);
+        ASSERT_TRUE(moved.data().resource() == &arena);
+        ASSERT_TRUE(moved == copy);
+    }
+
     //=============================================================================
     // MATRIX CHECKERS TESTS
     //=============================================================================
@@ -359,6 +408,95 @@ private:
         ASSERT_TRUE(t.at(0, 1) == 4);
     }
 
+    void should_transpose_rectangular_matrix_in_place() {
+        math::Matrix<int> m(2, 3, {1, 2, 3, 4, 5, 6});
+        m.transpose();
+        ASSERT_TRUE(m == math::Matrix<int>(3, 2, {1, 4, 2, 5, 3, 6}));
+        m.transpose();
+        ASSERT_TRUE(m == math::Matrix<int>(2, 3, {1, 2, 3, 4, 5, 6}));
+
+        // Long cycles and a bitmap spanning several words
+        const size_t rows = 37;
+        const size_t cols = 130;
+        math::Matrix<int> a(rows, cols);
+        math::Matrix<int> padded(rows, cols, math::PADDED);
+        for (size_t i = 0; i < rows; ++i) {
+            for (size_t j = 0; j < cols; ++j) {
+                a(i, j) = static_cast<int>((i * cols) + j);
+                padded(i, j) = a(i, j);
+            }
+        }
+        const auto expected = a.transposed();
+        a.transpose();
+        padded.transpose();
+        ASSERT_TRUE(a.row_count() == cols && a.column_count() == rows);
+        ASSERT_TRUE(a == expected);
+        ASSERT_TRUE(padded.leading_dimension() >= rows);
+        bool matches = true;
+        for (size_t i = 0; i < cols; ++i) {
+            for (size_t j = 0; j < rows; ++j) {
+                matches = matches && a(i, j) == static_cast<int>((j * cols) + i) &&
+                          padded(i, j) == a(i, j);
+            }
+        }
+        ASSERT_TRUE(matches);
+    }
+
+    void should_transpose_large_matrix_with_cache_oblivious_kernel() {
+        // Odd sizes leave partial leaf blocks on both sides
+        const size_t rows = 517;
+        const size_t cols = 263;
+        math::Matrix<double> m(rows, cols, math::PADDED);
+        for (size_t i = 0; i < rows; ++i) {
+            for (size_t j = 0; j < cols; ++j) {
+                m(i, j) = static_cast<double>(i) - (0.001 * static_cast<double>(j));
+            }
+        }
+
+        const auto t = m.transposed();
+        const math::Matrix<double> from_view(m.t());
+        const math::Matrix<double> from_block(m.block(3, 5, 100, 200).t());
+        ASSERT_TRUE(t.row_count() == cols && t.column_count() == rows);
+        ASSERT_TRUE(t.leading_dimension() != t.column_count());
+        ASSERT_TRUE(from_view == t);
+        bool matches = true;
+        for (size_t i = 0; i < cols; ++i) {
+            for (size_t j = 0; j < rows; ++j) {
+                matches = matches && t(i, j) == m(j, i);
+            }
+        }
+        for (size_t i = 0; i < 200; ++i) {
+            for (size_t j = 0; j < 100; ++j) {
+                matches = matches && from_block(i, j) == m(j + 3, i + 5);
+            }
+        }
+        ASSERT_TRUE(matches);
+    }
+
+    void transpose_time_test() {
+        // A tall data matrix: samples x features
+        const size_t rows = 200000;
+        const size_t cols = 64;
+        math::Matrix<double> X(rows, cols);
+        for (size_t i = 0; i < rows; ++i) {
+            for (size_t j = 0; j < cols; ++j) {
+                X(i, j) = static_cast<double>(j);
+            }
+        }
+
+        auto start = high_resolution_clock::now();
+        const auto T = X.transposed();
+        duration<double> copy_elapsed = high_resolution_clock::now() - start;
+        start = high_resolution_clock::now();
+        X.transpose();
+        duration<double> in_place_elapsed = high_resolution_clock::now() - start;
+
+        std::cout << "Transpose of " << rows << "x" << cols << ": out-of-place "
+                  << copy_elapsed.count() << " s, in-place "
+                  << in_place_elapsed.count() << " s\n";
+        ASSERT_TRUE(X == T);
+    }
+
     //=============================================================================
     // MATRIX OPERATORS TESTS
     //=============================================================================
@@ -441,6 +579,25 @@ private:
         ASSERT_TRUE(e.at(1, 1) == 0.5);
     }
 
+    void should_evaluate_fused_element_wise_expression() {
+        math::Matrix<int> a(2, 2, std::vector<int>{1, 2, 3, 4});
+        math::Matrix<double> b(2, 2, std::vector<double>{0.5, 1.5, 2.5, 3.5});
+        math::Matrix<int> c(2, 2, std::vector<int>{1, 1, 2, 2});
+
+        math::Matrix result = a + b - (2 * c);
+        math::Matrix<double> expected(2, 2, std::vector<double>{-0.5, 1.5, 1.5, 3.5});
+        ASSERT_TRUE(result == expected);
+
+        // Assigning into an operand of the expression
+        math::Matrix<double> d(2, 2, std::vector<double>{1, 2, 3, 4});
+        d = -d + (d * 3);
+        ASSERT_TRUE(d == math::Matrix<double>(2, 2, std::vector<double>{2, 4, 6, 8}));
+
+        d += b - 0.5;
+        ASSERT_TRUE(d == math::Matrix<double>(2, 2, std::vector<double>{2, 5, 8, 11}));
+        ASSERT_TRUE((d / 2).eval().at(1, 1) == 5.5);
+    }
+
     void should_add_assign_matrix() {
         math::Matrix<float> a(2, 2, {1.5f, 2.5f, 3.5f, 4.5f});
         math::Matrix<int> b(2, 2, {10, 20, 30, 40});
@@ -556,6 +713,43 @@ private:
         }
     }
 
+    void should_multiply_odd_sized_matrices_with_packed_kernel() {
+        // Shapes chosen to leave partial register tiles and KC slices
+        const std::array<std::array<size_t, 3>, 3> shapes = {
+            {{1, 1, 1}, {13, 300, 7}, {131, 77, 203}}};
+        std::mt19937 gen(42);
+        std::uniform_real_distribution<> dis(-1.0, 1.0);
+
+        for (const auto& [m, k, n] : shapes) {
+            math::Matrix<double> A(m, k);
+            math::Matrix<double> B(k, n);
+            for (size_t i = 0; i < m; ++i) {
+                for (size_t p = 0; p < k; ++p) {
+                    A.at(i, p) = dis(gen);
+                }
+            }
+            for (size_t p = 0; p < k; ++p) {
+                for (size_t j = 0; j < n; ++j) {
+                    B.at(p, j) = dis(gen);
+                }
+            }
+
+            math::Matrix<double> expected(m, n);
+            for (size_t i = 0; i < m; ++i) {
+                for (size_t j = 0; j < n; ++j) {
+                    for (size_t p = 0; p < k; ++p) {
+                        expected.at(i, j) += A.at(i, p) * B.at(p, j);
+                    }
+                }
+            }
+
+            auto C = A * B;
+            auto C_float = A.cast<float>() * B.cast<float>();
+            ASSERT_TRUE(math::loosely_equal(C, expected, 1e-9));
+            ASSERT_TRUE(math::loosely_equal(C_float, expected, 1e-3));
+        }
+    }
+
     void matmul_time_test() {
         const size_t n = 1024;
         math::Matrix<double> A(n, n);
@@ -588,6 +782,349 @@ private:
         ASSERT_TRUE(math::loosely_equal(C, D));
     }
 
+    void should_multiply_mixed_precision_matrices() {
+        math::Matrix<float> F(7, 9);
+        math::Matrix<double> D(9, 5, math::PADDED);
+        math::Matrix<int> I(7, 9);
+        for (size_t i = 0; i < 7; ++i) {
+            for (size_t j = 0; j < 9; ++j) {
+                F(i, j) = static_cast<float>(i) - (0.25F * static_cast<float>(j));
+                I(i, j) = static_cast<int>(i * j % 4) - 1;
+            }
+        }
+        for (size_t i = 0; i < 9; ++i) {
+            for (size_t j = 0; j < 5; ++j) {
+                D(i, j) = 0.5 * static_cast<double>(i + j) - 1.0;
+            }
+        }
+
+        const auto FD = F * D;
+        static_assert(std::is_same_v<decltype(FD), const math::Matrix<double>>);
+        ASSERT_TRUE(math::loosely_equal(FD, F.cast<double>() * D));
+        ASSERT_TRUE(math::loosely_equal(I * D, I.cast<double>() * D));
+        // Transposed views of different types go through the same kernel
+        ASSERT_TRUE(math::loosely_equal(D.t() * F.t(), (F.cast<double>() * D).t()));
+    }
+
+    void should_accumulate_float_products_in_double() {
+        const math::Matrix<float> A(1, 3, {1e8F, 1.0F, -1e8F});
+        const math::Matrix<float> B(3, 1, {1.0F, 1.0F, 1.0F});
+
+        ASSERT_TRUE((A * B).at(0, 0) == 0.0F);
+        const auto C = math::multiply<double>(A, B);
+        static_assert(std::is_same_v<decltype(C), const math::Matrix<float>>);
+        ASSERT_TRUE(C.at(0, 0) == 1.0F);
+        ASSERT_TRUE(math::multiply<double>(A.view(), B.view()).at(0, 0) == 1.0F);
+    }
+
+    void should_multiply_strided_batch_of_small_matrices() {
+        // 37 members: several full SIMD groups and a partial one
+        const size_t batch = 37;
+        const size_t m = 3;
+        const size_t k = 4;
+        const size_t n = 2;
+        std::vector<double> a(batch * m * k);
+        std::vector<double> b(batch * k * n);
+        std::vector<double> c(batch * m * n, 1.0);
+        for (size_t i = 0; i < a.size(); ++i) {
+            a[i] = static_cast<double>(i % 11) - 5.0;
+        }
+        for (size_t i = 0; i < b.size(); ++i) {
+            b[i] = static_cast<double>(i % 7) * 0.5;
+        }
+
+        math::batched_gemm(batch,
+                           m,
+                           n,
+                           k,
+                           2.0,
+                           a.data(),
+                           m * k,
+                           b.data(),
+                           k * n,
+                           1.0,
+                           c.data(),
+                           m * n);
+
+        bool all_equal = true;
+        for (size_t l = 0; l < batch; ++l) {
+            const math::Matrix<double> A(m, k, a.data() + (l * m * k));
+            const math::Matrix<double> B(k, n, b.data() + (l * k * n));
+            const math::Matrix<double> expected = 2.0 * (A * B) + 1.0;
+            const math::Matrix<double> C(m, n, c.data() + (l * m * n));
+            all_equal = all_equal && math::loosely_equal(C, expected);
+        }
+        ASSERT_TRUE(all_equal);
+    }
+
+    void should_multiply_batch_of_views() {
+        // Members are blocks of one large matrix and transposed views
+        math::Matrix<float> pool(20, 6);
+        for (size_t i = 0; i < 20; ++i) {
+            for (size_t j = 0; j < 6; ++j) {
+                pool(i, j) = static_cast<float>((i * 6 + j) % 13) - 6.0F;
+            }
+        }
+        std::vector<math::Matrix<float>> results(5, math::Matrix<float>(4, 4));
+        std::vector<math::ConstMatrixView<float>> a;
+        std::vector<math::ConstMatrixView<float>> b;
+        std::vector<math::MatrixView<float>> c;
+        for (size_t l = 0; l < 5; ++l) {
+            a.push_back(std::as_const(pool).block(l * 4, 0, 4, 6));
+            b.push_back(std::as_const(pool).block(l * 4, 0, 4, 6).t());
+            c.push_back(results[l].view());
+        }
+
+        math::batched_gemm(1.0F, a, b, 0.0F, c);
+
+        bool all_equal = true;
+        for (size_t l = 0; l < 5; ++l) {
+            all_equal = all_equal && math::loosely_equal(results[l], a[l] * b[l]);
+        }
+        ASSERT_TRUE(all_equal);
+
+        bool thrown = false;
+        try {
+            c.pop_back();
+            math::batched_gemm(1.0F, a, b, 0.0F, c);
+        } catch (const std::invalid_argument&) {
+            thrown = true;
+        }
+        ASSERT_TRUE(thrown);
+    }
+
+    void should_multiply_with_strassen_winograd() {
+        std::mt19937 gen(7);
+        std::uniform_real_distribution<> dis(-1.0, 1.0);
+        // Small cutoffs force several recursion levels and odd-size peeling
+        for (const auto& [m, k, n, cutoff] : std::vector<std::array<size_t, 4>>{
+                 {64, 64, 64, 8}, {67, 45, 53, 4}, {33, 128, 17, 2}}) {
+            math::Matrix<double> A(m, k);
+            math::Matrix<double> B(k, n);
+            for (size_t i = 0; i < m * k; ++i) {
+                A(i / k, i % k) = dis(gen);
+            }
+            for (size_t i = 0; i < k * n; ++i) {
+                B(i / n, i % n) = dis(gen);
+            }
+            const auto C = math::strassen_multiply(A, B, cutoff);
+            ASSERT_TRUE(math::loosely_equal(C, A * B));
+        }
+
+        math::Matrix<int> I(40, 40, math::PADDED);
+        math::Matrix<int> J(40, 40);
+        for (size_t i = 0; i < 40; ++i) {
+            for (size_t j = 0; j < 40; ++j) {
+                I(i, j) = static_cast<int>((i + 2 * j) % 7) - 3;
+                J(i, j) = static_cast<int>((3 * i + j) % 5) - 2;
+            }
+        }
+        const auto P = math::strassen_multiply(I, J, 4);
+        static_assert(std::is_same_v<decltype(P), const math::Matrix<double>>);
+        ASSERT_TRUE(math::loosely_equal(P, (I * J).cast<double>()));
+
+        bool thrown = false;
+        try {
+            const math::Matrix<double> M(3, 4);
+            static_cast<void>(math::strassen_multiply(M, M));
+        } catch (const std::invalid_argument&) {
+            thrown = true;
+        }
+        ASSERT_TRUE(thrown);
+    }
+
+    void strassen_time_test() {
+        // Prints both algorithms side by side to locate the crossover
+        for (const size_t n : {512, 1024, 2048, 4096}) {
+            const auto A = random_dense(n, n, 11);
+            const auto B = random_dense(n, n, 12);
+
+            auto start = high_resolution_clock::now();
+            auto C = A * B;
+            duration<double> gemm_elapsed = high_resolution_clock::now() - start;
+
+            start = high_resolution_clock::now();
+            auto S = math::strassen_multiply(A, B, 256);
+            duration<double> strassen_elapsed = high_resolution_clock::now() - start;
+
+            std::cout << "n = " << n << ": GEMM " << gemm_elapsed.count()
+                      << " s, Strassen-Winograd " << strassen_elapsed.count()
+                      << " s\n";
+            ASSERT_TRUE(math::loosely_equal(S, C));
+        }
+    }
+
+    void should_compute_gemv_and_gevm_in_place() {
+        // 263 rows: a partial GEMV_ROWS block and a partial GEMV_PANEL panel
+        const size_t m = 263;
+        const size_t n = 37;
+        std::mt19937 gen(5);
+        std::uniform_real_distribution<> dis(-1.0, 1.0);
+        math::Matrix<double> A(m, n, math::PADDED);
+        math::Matrix<double> U(1, m);
+        math::Matrix<double> X(n, 1);
+        math::Vector<float> u(m, math::ROW);
+        math::Vector<double> x(n, math::COLUMN);
+        for (size_t i = 0; i < m; ++i) {
+            for (size_t j = 0; j < n; ++j) {
+                A(i, j) = dis(gen);
+            }
+            u[i] = static_cast<float>(dis(gen));
+            U(0, i) = u[i];
+        }
+        for (size_t j = 0; j < n; ++j) {
+            x[j] = dis(gen);
+            X(j, 0) = x[j];
+        }
+        const auto AX = A * X;
+        const auto UA = U * A;
+
+        // y = 2 * A * x - y
+        math::Vector<double> y(m, math::COLUMN);
+        y.fill(1.0);
+        math::gemv(2.0, A, x, -1.0, y);
+        for (size_t i = 0; i < m; ++i) {
+            ASSERT_TRUE(is_close(y[i], (2.0 * AX(i, 0)) - 1.0));
+        }
+
+        // Mixed types on the column kernel, as u^T * A and as A^T * u
+        math::Vector<double> z(n, math::ROW);
+        math::gevm(1.0, u, A, 0.0, z);
+        const auto uA = u * A;
+        for (size_t j = 0; j < n; ++j) {
+            ASSERT_TRUE(is_close(z[j], UA(0, j)));
+            ASSERT_TRUE(is_close(uA[j], UA(0, j)));
+        }
+        z.fill(0.0);
+        math::gemv(1.0, A.t(), u, 0.0, z);
+        const auto Atu = A.t() * u.transposed();
+        for (size_t j = 0; j < n; ++j) {
+            ASSERT_TRUE(is_close(z[j], UA(0, j)));
+            ASSERT_TRUE(is_close(Atu[j], UA(0, j)));
+        }
+
+        // Blocks go through the strided path
+        const auto Bx = A.block(3, 0, 200, n) * x;
+        for (size_t i = 0; i < 200; ++i) {
+            ASSERT_TRUE(is_close(Bx[i], AX(i + 3, 0)));
+        }
+
+        bool thrown = false;
+        try {
+            math::gemv(1.0, A, u, 0.0, y);
+        } catch (const std::invalid_argument& e) {
+            thrown = true;
+        }
+        ASSERT_TRUE(thrown);
+        thrown = false;
+        math::Matrix<double> S(n, n);
+        try {
+            math::gemv(1.0, S, z, 0.0, z);
+        } catch (const std::invalid_argument& e) {
+            thrown = true;
+        }
+        ASSERT_TRUE(thrown);
+    }
+
+    void gemv_time_test() {
+        const size_t n = 4096;
+        math::Matrix<double> A(n, n);
+        math::Vector<double> x(n, math::COLUMN);
+        math::Vector<double> y(n, math::COLUMN);
+        A.fill(0.5);
+        x.fill(1.0);
+
+        auto start = high_resolution_clock::now();
+        for (int r = 0; r < 10; ++r) {
+            math::gemv(1.0, A, x, 0.0, y);
+        }
+        duration<double> gemv_elapsed = high_resolution_clock::now() - start;
+        start = high_resolution_clock::now();
+        for (int r = 0; r < 10; ++r) {
+            math::gevm(1.0, x, A, 0.0, y);
+        }
+        duration<double> gevm_elapsed = high_resolution_clock::now() - start;
+
+        std::cout << "10 x GEMV of " << n << "x" << n << ": " << gemv_elapsed.count()
+                  << " s, GEVM: " << gevm_elapsed.count() << " s\n";
+        ASSERT_TRUE(is_close(y[n - 1], 0.5 * static_cast<double>(n)));
+    }
+
+    //=============================================================================
+    // MATRIX VIEW TESTS
+    //=============================================================================
+    void should_view_blocks_rows_and_columns_without_copying() {
+        math::Matrix<int> m(
+            3, 4, std::vector<int>{1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12});
+
+        auto block = m.block(1, 1, 2, 2);
+        ASSERT_TRUE(block.row_count() == 2 && block.column_count() == 2);
+        ASSERT_TRUE(block(0, 0) == 6 && block(1, 1) == 11);
+        ASSERT_TRUE(m.col(2) == math::Matrix<int>(3, 1, std::vector<int>{3, 7, 11}));
+        ASSERT_TRUE(m.row(1).at(0, 3) == 8);
+        ASSERT_TRUE(m.t() == m.transposed());
+        ASSERT_TRUE(m.t().block(1, 0, 2, 1)(1, 0) == 3);
+
+        // Writes go through to the parent matrix
+        block.fill(0);
+        m.row(0) += m.row(2);
+        ASSERT_TRUE(m.at(1, 1) == 0 && m.at(2, 2) == 0 && m.at(1, 3) == 8);
+        ASSERT_TRUE(m.at(0, 0) == 10 && m.at(0, 2) == 3);
+
+        bool thrown = false;
+        try {
+            static_cast<void>(m.block(2, 2, 2, 2));
+        } catch (const std::out_of_range&) {
+            thrown = true;
+        }
+        ASSERT_TRUE(thrown);
+    }
+
+    void should_handle_aliasing_views_in_assignment() {
+        math::Matrix<int> m(2, 2, std::vector<int>{1, 2, 3, 4});
+        m = m.t();
+        ASSERT_TRUE(m == math::Matrix<int>(2, 2, std::vector<int>{1, 3, 2, 4}));
+
+        m += m.t();
+        ASSERT_TRUE(m == math::Matrix<int>(2, 2, std::vector<int>{2, 5, 5, 8}));
+
+        math::Matrix<int> v(1, 4, std::vector<int>{1, 2, 3, 4});
+        v.block(0, 1, 1, 3) = v.block(0, 0, 1, 3);
+        ASSERT_TRUE(v == math::Matrix<int>(1, 4, std::vector<int>{1, 1, 2, 3}));
+    }
+
+    void should_multiply_and_decompose_views() {
+        std::mt19937 gen(7);
+        std::uniform_real_distribution<> dis(-1.0, 1.0);
+        math::Matrix<double> X(40, 30);
+        for (auto& value : X.data()) {
+            value = dis(gen);
+        }
+
+        auto gram = X.t() * X;
+        ASSERT_TRUE(math::loosely_equal(gram, X.transposed() * X, 1e-9));
+
+        auto sub = X.block(5, 3, 20, 10).t() * X.block(5, 13, 20, 7);
+        auto expected = X.block(5, 3, 20, 10).eval().transposed() *
+                        X.block(5, 13, 20, 7).eval();
+        ASSERT_TRUE(math::loosely_equal(sub, expected, 1e-9));
+
+        math::Vector<double> x(30, std::vector<double>(30, 1.0));
+        auto y = X.block(0, 0, 40, 30) * x;
+        auto y_expected = X * x;
+        for (size_t i = 0; i < y.size(); ++i) {
+            ASSERT_TRUE(is_close(y[i], y_expected[i], 1e-9));
+        }
+
+        // Decompose the leading block of a larger SPD matrix in place
+        math::Matrix<double> spd = gram + 30.0 * math::identity_matrix<double>(30);
+        auto L = math::cholesky(spd.block(0, 0, 10, 10));
+        ASSERT_TRUE(math::loosely_equal(L * L.t(), spd.block(0, 0, 10, 10)));
+
+        auto [P, L_lu, U] = math::plu(spd.block(0, 0, 10, 10));
+        ASSERT_TRUE(P.size() == 10 && U.row_count() == 10);
+    }
+
     //=============================================================================
     // MATRIX PLU TESTS
     //=============================================================================
@@ -688,6 +1225,83 @@ private:
         ASSERT_TRUE(loosely_equal(PA, LU));
     }
 
+    void should_factor_in_place_with_getrf() {
+        math::Matrix<double> A(
+            4, 4, {0, 2, 1, 3, 4, -6, 0, 1, -2, 7, 2, 5, 1, 1, 8, -3});
+        math::Matrix<double> packed = A;
+        const auto ipiv = math::getrf(packed);
+        ASSERT_TRUE(ipiv.size() == 4 && ipiv[0] == 1);
+
+        // The packed factors are exactly what plu() unpacks
+        const auto [p, L, U] = math::plu(A);
+        bool matches = true;
+        for (size_t i = 0; i < 4; ++i) {
+            for (size_t j = 0; j < 4; ++j) {
+                const double expected = i > j ? L.at(i, j) : U.at(i, j);
+                matches = matches && packed.at(i, j) == expected;
+            }
+        }
+        ASSERT_TRUE(matches);
+
+        // Replaying the interchanges on A gives L * U
+        math::Matrix<double> pa = A;
+        for (size_t i = 0; i < 4; ++i) {
+            std::ranges::swap_ranges(pa.row_span(i), pa.row_span(ipiv[i]));
+        }
+        ASSERT_TRUE(loosely_equal(pa, L * U));
+
+        // 300 columns span several panels and the trailing updates between them
+        const size_t n = 300;
+        const auto B = random_dense(n, n, 7);
+        const auto [pb, Lb, Ub] = math::plu(B);
+        ASSERT_TRUE(loosely_equal(math::permutation_matrix<double>(pb) * B, Lb * Ub));
+
+        bool thrown = false;
+        try {
+            math::Matrix<double> singular(3, 3, {1, 2, 3, 2, 4, 6, 1, 2, 3});
+            math::getrf(singular);
+        } catch (const std::runtime_error& e) {
+            thrown = true;
+        }
+        ASSERT_TRUE(thrown);
+        ASSERT_TRUE(math::Matrix<int>(2, 2, {1, 2, 2, 4}).is_singular());
+        ASSERT_TRUE(!math::Matrix<int>(2, 2, {1, 2, 3, 4}).is_singular());
+    }
+
+    void should_factor_recursively_with_getrf() {
+        // 100 columns split unevenly down to leaf panels of a few columns
+        const size_t n = 100;
+        auto A = random_dense(n, n, 13);
+        // Small leading entries force interchanges in every panel
+        for (size_t i = 0; i < n; ++i) {
+            A.at(i, i) *= 1e-3;
+        }
+        math::Matrix<double> packed = A;
+        const auto ipiv = math::getrf(packed);
+        math::Matrix<double> pa = A;
+        math::Matrix<double> L = math::identity_matrix<double>(n);
+        math::Matrix<double> U(n, n);
+        for (size_t i = 0; i < n; ++i) {
+            std::ranges::swap_ranges(pa.row_span(i), pa.row_span(ipiv[i]));
+            for (size_t j = 0; j < n; ++j) {
+                (i > j ? L : U).at(i, j) = packed.at(i, j);
+            }
+        }
+        ASSERT_TRUE(math::loosely_equal(pa, L * U, 1e-9));
+
+        // The singular pivot only shows up in the last leaf panel
+        for (size_t j = 0; j < n; ++j) {
+            A.at(n - 1, j) = A.at(n - 2, j);
+        }
+        bool thrown = false;
+        try {
+            math::getrf(A);
+        } catch (const std::runtime_error& e) {
+            thrown = true;
+        }
+        ASSERT_TRUE(thrown);
+    }
+
     void plu_time_test() {
         const size_t n = 1000;
         math::Matrix<double> A(n, n);
@@ -708,11 +1322,429 @@ private:
         auto end = std::chrono::high_resolution_clock::now();
         std::chrono::duration<double> elapsed = end - start;
         std::cout << "PLU elapsed time:" << elapsed.count() << " seconds.\n";
+
+        math::Matrix<double> packed = A;
+        start = std::chrono::high_resolution_clock::now();
+        static_cast<void>(math::getrf(packed));
+        end = std::chrono::high_resolution_clock::now();
+        elapsed = end - start;
+        std::cout << "In-place getrf elapsed time:" << elapsed.count() << " seconds.\n";
         auto PA = P * A;
         auto LU = L * U;
         ASSERT_TRUE(math::loosely_equal(PA, LU));
     }
 
+    //=============================================================================
+    // MATRIX QR TESTS
+    //=============================================================================
+    void should_correctly_perform_qr_decomposition_on_small_matrix() {
+        math::Matrix<double> A(3, 3, {12, -51, 4, 6, 167, -68, -4, 24, -41});
+        auto [Q, R] = math::qr(A);
+
+        ASSERT_TRUE(R.is_upper_triangular());
+        ASSERT_TRUE(math::loosely_equal(Q * R, A));
+        ASSERT_TRUE(math::loosely_equal(
+            Q.transposed() * Q, math::identity_matrix<double>(3), 1e-12));
+        // Known factorization up to the signs of the rows of R
+        ASSERT_TRUE(is_close(std::abs(R.at(0, 0)), 14.0, 1e-12));
+        ASSERT_TRUE(is_close(std::abs(R.at(1, 1)), 175.0, 1e-12));
+        ASSERT_TRUE(is_close(std::abs(R.at(2, 2)), 35.0, 1e-12));
+
+        auto [Qi, Ri] = math::qr(math::Matrix<int>(2, 2, {3, 1, 4, 2}));
+        ASSERT_TRUE(math::loosely_equal(
+            Qi * Ri, math::Matrix<double>(2, 2, {3, 1, 4, 2}), 1e-12));
+    }
+
+    void should_qr_decompose_tall_and_wide_matrices() {
+        // 150 columns: two full panels and a partial one
+        const auto tall = random_dense(400, 150, 17);
+        auto [Q, R] = math::qr(tall);
+        ASSERT_TRUE(Q.row_count() == 400 && Q.column_count() == 150);
+        ASSERT_TRUE(R.is_upper_triangular());
+        ASSERT_TRUE(math::loosely_equal(Q * R, tall, 1e-10));
+        ASSERT_TRUE(math::loosely_equal(
+            Q.transposed() * Q, math::identity_matrix<double>(150), 1e-10));
+
+        // The blocked factors match the unblocked reference
+        math::Matrix<double> blocked = tall;
+        const auto tau = math::geqrf(blocked);
+        math::Matrix<double> unblocked = tall;
+        std::vector<double> tau_ref(150);
+        math::detail::_geqr2(400,
+                             150,
+                             unblocked.data().data(),
+                             unblocked.leading_dimension(),
+                             tau_ref.data());
+        ASSERT_TRUE(math::loosely_equal(blocked, unblocked, 1e-10));
+
+        auto [Qw, Rw] = math::qr(tall.t().block(0, 0, 150, 300));
+        ASSERT_TRUE(Qw.row_count() == 150 && Rw.column_count() == 300);
+        ASSERT_TRUE(
+            math::loosely_equal(Qw * Rw, tall.t().block(0, 0, 150, 300), 1e-10));
+    }
+
+    void qr_time_test() {
+        const size_t m = 1200;
+        const size_t n = 800;
+        const auto A = random_dense(m, n, 19);
+
+        math::Matrix<double> unblocked = A;
+        std::vector<double> tau(n);
+        auto start = std::chrono::high_resolution_clock::now();
+        math::detail::_geqr2(
+            m, n, unblocked.data().data(), unblocked.leading_dimension(), tau.data());
+        std::chrono::duration<double> elapsed =
+            std::chrono::high_resolution_clock::now() - start;
+        std::cout << "Unblocked QR elapsed time:" << elapsed.count() << " seconds.\n";
+
+        math::Matrix<double> blocked = A;
+        start = std::chrono::high_resolution_clock::now();
+        static_cast<void>(math::geqrf(blocked));
+        elapsed = std::chrono::high_resolution_clock::now() - start;
+        std::cout << "Blocked WY QR elapsed time:" << elapsed.count() << " seconds.\n";
+        ASSERT_TRUE(math::loosely_equal(blocked, unblocked, 1e-9));
+    }
+
+    //=============================================================================
+    // MATRIX EIGEN TESTS
+    //=============================================================================
+    /** @brief Checks A V = V diag(lambda), V^T V = I and ascending lambda. */
+    static bool is_eigendecomposition(const math::Matrix<double>& A,
+                                      const math::Vector<double>& values,
+                                      const math::Matrix<double>& vectors,
+                                      double eps) {
+        const size_t n = A.row_count();
+        math::Matrix<double> scaled = vectors;
+        for (size_t i = 0; i < n; ++i) {
+            for (size_t j = 0; j < n; ++j) {
+                scaled.at(i, j) *= values[j];
+            }
+        }
+        bool ascending = true;
+        for (size_t i = 1; i < n; ++i) {
+            ascending = ascending && values[i - 1] <= values[i];
+        }
+        return ascending && math::loosely_equal(A * vectors, scaled, eps) &&
+               math::loosely_equal(vectors.transposed() * vectors,
+                                   math::identity_matrix<double>(n),
+                                   eps);
+    }
+
+    void should_compute_eigenpairs_of_small_symmetric_matrix() {
+        math::Matrix<double> A(3, 3, {2, -1, 0, -1, 2, -1, 0, -1, 2});
+        const auto [values, vectors] = math::eigh(A);
+        ASSERT_TRUE(is_close(values[0], 2.0 - std::sqrt(2.0), 1e-12));
+        ASSERT_TRUE(is_close(values[1], 2.0, 1e-12));
+        ASSERT_TRUE(is_close(values[2], 2.0 + std::sqrt(2.0), 1e-12));
+        ASSERT_TRUE(is_eigendecomposition(A, values, vectors, 1e-12));
+
+        const auto only_values = math::eigvalsh(math::Matrix<int>(2, 2, {2, 1, 1, 2}));
+        ASSERT_TRUE(is_close(only_values[0], 1.0, 1e-12));
+        ASSERT_TRUE(is_close(only_values[1], 3.0, 1e-12));
+
+        bool thrown = false;
+        try {
+            auto asymmetric = math::eigh(math::Matrix<double>(2, 2, {1, 2, 3, 4}));
+        } catch (const std::invalid_argument& e) {
+            thrown = true;
+        }
+        ASSERT_TRUE(thrown);
+    }
+
+    void should_compute_eigenpairs_of_large_symmetric_matrix() {
+        // 300 spans several reduction panels and divide and conquer levels
+        const size_t n = 300;
+        const auto X = random_dense(n, n, 23);
+        const math::Matrix<double> A = X + X.transposed();
+        const auto [values, vectors] = math::eigh(A);
+        ASSERT_TRUE(is_eigendecomposition(A, values, vectors, 1e-10));
+
+        const auto only_values = math::eigvalsh(A);
+        bool matches = true;
+        for (size_t i = 0; i < n; ++i) {
+            matches = matches && is_close(only_values[i], values[i], 1e-10);
+        }
+        ASSERT_TRUE(matches);
+
+        // Repeated eigenvalues deflate in every merge: Q diag(1, .., 1, 2, .., 2) Q^T
+        auto [Q, R] = math::qr(X);
+        math::Matrix<double> D(n, n);
+        for (size_t i = 0; i < n; ++i) {
+            D.at(i, i) = i < n / 3 ? 1.0 : 2.0;
+        }
+        const math::Matrix<double> B = Q * D * Q.transposed();
+        const auto [b_values, b_vectors] = math::eigh(B);
+        ASSERT_TRUE(is_eigendecomposition(B, b_values, b_vectors, 1e-10));
+        ASSERT_TRUE(is_close(b_values[0], 1.0, 1e-10));
+        ASSERT_TRUE(is_close(b_values[n / 3], 2.0, 1e-10));
+
+        // A view is decomposed without copying the parent first
+        const auto [v_values, v_vectors] = math::eigh(A.block(0, 0, 50, 50));
+        ASSERT_TRUE(is_eigendecomposition(
+            math::Matrix<double>(A.block(0, 0, 50, 50)), v_values, v_vectors, 1e-10));
+    }
+
+    void eigh_time_test() {
+        const size_t n = 1000;
+        const auto X = random_dense(2 * n, n, 29);
+        const math::Matrix<double> covariance = X.transposed() * X;
+
+        auto start = std::chrono::high_resolution_clock::now();
+        const auto [values, vectors] = math::eigh(covariance);
+        std::chrono::duration<double> elapsed =
+            std::chrono::high_resolution_clock::now() - start;
+        std::cout << "Symmetric eigen-decomposition elapsed time:" << elapsed.count()
+                  << " seconds.\n";
+
+        start = std::chrono::high_resolution_clock::now();
+        const auto only_values = math::eigvalsh(covariance);
+        elapsed = std::chrono::high_resolution_clock::now() - start;
+        std::cout << "Symmetric eigenvalues elapsed time:" << elapsed.count()
+                  << " seconds.\n";
+        ASSERT_TRUE(is_eigendecomposition(covariance, values, vectors, 1e-8));
+        ASSERT_TRUE(is_close(only_values[n - 1], values[n - 1], 1e-8));
+    }
+
+    void should_compute_top_eigenpairs_with_eigsh() {
+        // Q diag(lambda) Q^T with a decaying spectrum, large enough to iterate
+        const size_t n = 400;
+        const size_t k = 6;
+        const auto X = random_dense(n, n, 31);
+        auto [Q, R] = math::qr(X);
+        math::Matrix<double> D(n, n);
+        for (size_t i = 0; i < n; ++i) {
+            D.at(i, i) = 100.0 * std::pow(0.9, static_cast<double>(i));
+        }
+        const math::Matrix<double> A = Q * D * Q.transposed();
+
+        const auto [values, vectors] = math::eigsh(A, k);
+        ASSERT_TRUE(values.size() == k);
+        ASSERT_TRUE(vectors.row_count() == n && vectors.column_count() == k);
+        bool matches = true;
+        for (size_t j = 0; j < k; ++j) {
+            matches = matches && is_close(values[j], D.at(j, j), 1e-8);
+        }
+        ASSERT_TRUE(matches);
+        math::Matrix<double> scaled = vectors;
+        for (size_t i = 0; i < n; ++i) {
+            for (size_t j = 0; j < k; ++j) {
+                scaled.at(i, j) *= values[j];
+            }
+        }
+        ASSERT_TRUE(math::loosely_equal(A * vectors, scaled, 1e-6));
+        ASSERT_TRUE(math::loosely_equal(
+            vectors.transposed() * vectors, math::identity_matrix<double>(k), 1e-10));
+
+        // The same operator given only as a block product
+        const auto [free_values, free_vectors] = math::eigsh<double>(
+            n, [&A](const math::Matrix<double>& block) { return A * block; }, k);
+        ASSERT_TRUE(is_close(free_values[k - 1], values[k - 1], 1e-8));
+
+        // Small operators take the dense path
+        const auto [small_values, small_vectors] =
+            math::eigsh(math::Matrix<int>(3, 3, {2, -1, 0, -1, 2, -1, 0, -1, 2}), 1);
+        ASSERT_TRUE(is_close(small_values[0], 2.0 + std::sqrt(2.0), 1e-12));
+
+        bool thrown = false;
+        try {
+            auto too_many = math::eigsh(A, n + 1);
+        } catch (const std::invalid_argument& e) {
+            thrown = true;
+        }
+        ASSERT_TRUE(thrown);
+    }
+
+    //=============================================================================
+    // MATRIX SVD TESTS
+    //=============================================================================
+    /**
+     * @brief Checks U diag(s) V^T = A, orthonormal U and V and descending,
+     * non-negative s.
+     */
+    static bool is_svd(const math::Matrix<double>& A,
+                       const math::Matrix<double>& U,
+                       const math::Vector<double>& s,
+                       const math::Matrix<double>& V,
+                       double eps) {
+        const size_t p = s.size();
+        math::Matrix<double> scaled = U;
+        for (size_t i = 0; i < U.row_count(); ++i) {
+            for (size_t j = 0; j < p; ++j) {
+                scaled.at(i, j) *= s[j];
+            }
+        }
+        bool descending = s[p - 1] >= 0.0;
+        for (size_t i = 1; i < p; ++i) {
+            descending = descending && s[i - 1] >= s[i];
+        }
+        return descending && math::loosely_equal(scaled * V.transposed(), A, eps) &&
+               math::loosely_equal(
+                   U.transposed() * U, math::identity_matrix<double>(p), eps) &&
+               math::loosely_equal(
+                   V.transposed() * V, math::identity_matrix<double>(p), eps);
+    }
+
+    void should_compute_svd_of_small_matrix() {
+        math::Matrix<double> A(2, 3, {3, 2, 2, 2, 3, -2});
+        const auto [U, s, V] = math::svd(A);
+        ASSERT_TRUE(U.row_count() == 2 && U.column_count() == 2);
+        ASSERT_TRUE(V.row_count() == 3 && V.column_count() == 2);
+        ASSERT_TRUE(is_close(s[0], 5.0, 1e-12));
+        ASSERT_TRUE(is_close(s[1], 3.0, 1e-12));
+        ASSERT_TRUE(is_svd(A, U, s, V, 1e-12));
+
+        const auto values =
+            math::singular_values(math::Matrix<int>(2, 2, {0, 2, 1, 0}));
+        ASSERT_TRUE(is_close(values[0], 2.0, 1e-12));
+        ASSERT_TRUE(is_close(values[1], 1.0, 1e-12));
+    }
+
+    void should_compute_svd_of_tall_wide_and_singular_matrices() {
+        std::mt19937 gen(37);
+        std::uniform_real_distribution<> dis(-1.0, 1.0);
+        math::Matrix<double> X(200, 60);
+        for (size_t i = 0; i < 200; ++i) {
+            for (size_t j = 0; j < 60; ++j) {
+                X.at(i, j) = dis(gen);
+            }
+        }
+        const auto [U, s, V] = math::svd(X);
+        ASSERT_TRUE(is_svd(X, U, s, V, 1e-10));
+        const auto [Ut, st, Vt] = math::svd(X.t());
+        ASSERT_TRUE(is_svd(X.transposed(), Ut, st, Vt, 1e-10));
+        ASSERT_TRUE(is_close(st[59], s[59], 1e-12));
+
+        // Rank 2: the missing left vectors are completed to an orthonormal U
+        math::Matrix<double> R(6, 6);
+        for (size_t i = 0; i < 6; ++i) {
+            for (size_t j = 0; j < 6; ++j) {
+                R.at(i, j) = static_cast<double>(i + 1) + static_cast<double>(j % 2);
+            }
+        }
+        const auto [Ur, sr, Vr] = math::svd(R);
+        ASSERT_TRUE(is_svd(R, Ur, sr, Vr, 1e-10));
+        ASSERT_TRUE(math::matrix_rank(R) == 2);
+        ASSERT_TRUE(math::matrix_rank(X) == 60);
+
+        // Graded columns keep their small singular values to high relative
+        // accuracy
+        math::Matrix<double> G(3, 3, {1, 0, 0, 0, 1e-10, 0, 0, 0, 1e-20});
+        const auto graded =
+            math::singular_values(G * math::qr(X.block(0, 0, 3, 3)).first);
+        ASSERT_TRUE(std::abs(graded[2] - 1e-20) < 1e-14 * 1e-20);
+    }
+
+    void should_compute_pseudo_inverse_with_svd() {
+        std::mt19937 gen(41);
+        std::uniform_real_distribution<> dis(-1.0, 1.0);
+        math::Matrix<double> A(50, 8);
+        for (size_t i = 0; i < 50; ++i) {
+            for (size_t j = 0; j < 8; ++j) {
+                A.at(i, j) = dis(gen);
+            }
+        }
+        // Full column rank: A^+ = (A^T A)^-1 A^T, so A^+ A = I
+        const auto A_pinv = math::pinv(A);
+        ASSERT_TRUE(A_pinv.row_count() == 8 && A_pinv.column_count() == 50);
+        ASSERT_TRUE(
+            math::loosely_equal(A_pinv * A, math::identity_matrix<double>(8), 1e-10));
+
+        // Rank deficient: the Moore-Penrose conditions
+        math::Matrix<double> B = A.block(0, 0, 50, 4) * A.block(0, 0, 4, 8);
+        const auto B_pinv = math::pinv(B);
+        ASSERT_TRUE(math::matrix_rank(B) == 4);
+        ASSERT_TRUE(math::loosely_equal(B * B_pinv * B, B, 1e-10));
+        ASSERT_TRUE(math::loosely_equal(B_pinv * B * B_pinv, B_pinv, 1e-10));
+        const math::Matrix<double> P = B * B_pinv;
+        ASSERT_TRUE(math::loosely_equal(P, P.transposed(), 1e-10));
+    }
+
+    void should_approximate_leading_triplets_with_randomized_svd() {
+        // U diag(2^-j) V^T plus a tiny perturbation
+        const size_t m = 600;
+        const size_t n = 300;
+        std::mt19937 gen(43);
+        std::normal_distribution<> dis(0.0, 1.0);
+        math::Matrix<double> L(m, n);
+        math::Matrix<double> R(n, n);
+        for (size_t i = 0; i < m; ++i) {
+            for (size_t j = 0; j < n; ++j) {
+                L.at(i, j) = dis(gen);
+            }
+        }
+        for (size_t i = 0; i < n; ++i) {
+            for (size_t j = 0; j < n; ++j) {
+                R.at(i, j) = dis(gen);
+            }
+        }
+        math::Matrix<double> Q_l = math::qr(L).first;
+        const math::Matrix<double> Q_r = math::qr(R).first;
+        for (size_t i = 0; i < m; ++i) {
+            for (size_t j = 0; j < n; ++j) {
+                Q_l.at(i, j) *= std::pow(0.5, static_cast<double>(j));
+            }
+        }
+        const math::Matrix<double> A = Q_l * Q_r.transposed();
+
+        const size_t k = 10;
+        const auto [U, s, V] = math::randomized_svd(A, k);
+        ASSERT_TRUE(U.row_count() == m && U.column_count() == k);
+        ASSERT_TRUE(V.row_count() == n && V.column_count() == k);
+        bool matches = true;
+        for (size_t j = 0; j < k; ++j) {
+            const double expected = std::pow(0.5, static_cast<double>(j));
+            matches = matches && is_close(s[j], expected, 1e-10);
+        }
+        ASSERT_TRUE(matches);
+        ASSERT_TRUE(math::loosely_equal(
+            U.transposed() * U, math::identity_matrix<double>(k), 1e-10));
+
+        // A lazy expression is evaluated once and then sketched
+        const auto [U_e, s_e, V_e] = math::randomized_svd(A * 2.0, k);
+        ASSERT_TRUE(is_close(s_e[0], 2.0, 1e-10));
+
+        bool thrown = false;
+        try {
+            auto too_many = math::randomized_svd(A, n + 1);
+        } catch (const std::invalid_argument& e) {
+            thrown = true;
+        }
+        ASSERT_TRUE(thrown);
+    }
+
+    void svd_time_test() {
+        std::mt19937 gen(47);
+        std::uniform_real_distribution<> dis(-1.0, 1.0);
+        const size_t n = 300;
+        math::Matrix<double> A(n, n);
+        for (size_t i = 0; i < n; ++i) {
+            for (size_t j = 0; j < n; ++j) {
+                A.at(i, j) = dis(gen);
+            }
+        }
+        auto start = std::chrono::high_resolution_clock::now();
+        const auto [U, s, V] = math::svd(A);
+        std::chrono::duration<double> elapsed =
+            std::chrono::high_resolution_clock::now() - start;
+        std::cout << "Jacobi SVD " << n << " x " << n
+                  << " elapsed time:" << elapsed.count() << " seconds.\n";
+        ASSERT_TRUE(is_svd(A, U, s, V, 1e-9));
+
+        const size_t m = 4000;
+        math::Matrix<double> B(m, 1000);
+        for (size_t i = 0; i < m; ++i) {
+            for (size_t j = 0; j < 1000; ++j) {
+                B.at(i, j) = dis(gen);
+            }
+        }
+        start = std::chrono::high_resolution_clock::now();
+        const auto [U_r, s_r, V_r] = math::randomized_svd(B, 20);
+        elapsed = std::chrono::high_resolution_clock::now() - start;
+        std::cout << "Randomized SVD " << m << " x 1000, k = 20 elapsed time:"
+                  << elapsed.count() << " seconds.\n";
+        ASSERT_TRUE(s_r[0] >= s_r[19] && s_r[19] > 0.0);
+    }
+
     //=============================================================================
     // MATRIX CHOLESKY TESTS
     //=============================================================================
@@ -784,6 +1816,37 @@ private:
         ASSERT_TRUE(thrown);
     }
 
+    void should_factor_across_tiles_with_task_cholesky() {
+        // 300 = two full tiles and a partial one
+        const size_t n = 300;
+        std::mt19937 gen(11);
+        std::uniform_real_distribution<> dis(-1.0, 1.0);
+        math::Matrix<double> X(n, n);
+        for (size_t i = 0; i < n; ++i) {
+            for (size_t j = 0; j < n; ++j) {
+                X.at(i, j) = dis(gen);
+            }
+        }
+        math::Matrix<double> A = X * X.transposed();
+        for (size_t i = 0; i < n; ++i) {
+            A.at(i, i) += static_cast<double>(n);
+        }
+
+        const auto L = math::cholesky(A);
+        ASSERT_TRUE(L.is_lower_triangular());
+        ASSERT_TRUE(math::loosely_equal(L * L.transposed(), A, 1e-9));
+
+        // The failing pivot is in the last tile, after other tasks ran
+        A.at(290, 290) = -1.0;
+        bool thrown = false;
+        try {
+            auto indefinite = math::cholesky(A);
+        } catch (const std::invalid_argument& e) {
+            thrown = true;
+        }
+        ASSERT_TRUE(thrown);
+    }
+
     void should_auto_convert_int_matrix_to_double_in_cholesky() {
         math::Matrix<int> m_int(3, 3, {4, 12, -16, 12, 37, -43, -16, -43, 98});
 
@@ -893,6 +1956,103 @@ private:
         ASSERT_TRUE(math::loosely_equal(C, A));
     }
 
+    //=============================================================================
+    // FIXED-SIZE MATRIX TESTS
+    //=============================================================================
+    void should_construct_and_multiply_fixed_size_matrices_at_compile_time() {
+        constexpr math::SMatrix<int, 2, 3> A(1, 2, 3, 4, 5, 6);
+        constexpr math::SMatrix<int, 3, 2> B(7, 8, 9, 10, 11, 12);
+        constexpr auto C = A * B;
+        static_assert(C == math::SMatrix<int, 2, 2>(58, 64, 139, 154));
+        static_assert(C.determinant() == 58.0 * 154.0 - 64.0 * 139.0);
+        static_assert(A.transposed() * math::SVector<int, 2>(1, 1) ==
+                      math::SVector<int, 3>(5, 7, 9));
+
+        constexpr auto I = math::SMatrix<double, 3, 3>::identity();
+        static_assert(I.trace() == 3.0);
+        ASSERT_TRUE(C(1, 0) == 139);
+        ASSERT_TRUE(
+            (math::SVector<int, 2>(1, 2) * A == math::SVector<int, 3>(9, 12, 15)));
+    }
+
+    void should_invert_and_take_determinant_of_fixed_size_matrices() {
+        const math::SMatrix<double, 3, 3> A(4, 7, 2, 3, 6, 1, 2, 5, 3);
+        ASSERT_TRUE(is_close(A.determinant(), 9.0));
+        const auto A_inv = A.inverse();
+        const auto I3 = math::SMatrix<double, 3, 3>::identity();
+        ASSERT_TRUE(math::loosely_equal((A * A_inv).to_matrix(), I3.to_matrix()));
+
+        // 6x6 goes through the unrolled pivoted elimination
+        math::SMatrix<double, 6, 6> B;
+        for (size_t i = 0; i < 6; ++i) {
+            for (size_t j = 0; j < 6; ++j) {
+                B(i, j) = static_cast<double>((i * 7 + j * 3) % 5);
+                B(i, j) -= i == j ? 9.0 : 0.0;
+            }
+        }
+        const auto B_inv = B.inverse();
+        const auto I6 = math::SMatrix<double, 6, 6>::identity();
+        ASSERT_TRUE(math::loosely_equal((B * B_inv).to_matrix(), I6.to_matrix()));
+        ASSERT_TRUE(math::loosely_equal((B_inv * B).to_matrix(), I6.to_matrix()));
+
+        const auto [P, L, U] = math::plu(B.to_matrix());
+        double det_lu = 1.0;
+        for (size_t i = 0; i < 6; ++i) {
+            det_lu *= U.at(i, i) * static_cast<double>(L.at(i, i));
+            for (size_t j = i + 1; j < 6; ++j) {
+                det_lu *= P[i] > P[j] ? -1.0 : 1.0;
+            }
+        }
+        ASSERT_TRUE(std::abs(B.determinant() - det_lu) < 1e-6 * std::abs(det_lu));
+
+        const math::SMatrix<int, 4, 4> S(
+            1, 2, 3, 4, 2, 4, 6, 8, 0, 1, 0, 1, 1, 0, 1, 0);
+        ASSERT_TRUE(S.determinant() == 0.0);
+        bool thrown = false;
+        try {
+            static_cast<void>(S.inverse());
+        } catch (const std::runtime_error&) {
+            thrown = true;
+        }
+        ASSERT_TRUE(thrown);
+
+        // Small elements are not singular: det(1e-4 I) = 1e-12, pivots of 1e-11
+        const auto small = math::SMatrix<double, 3, 3>::identity() * 1e-4;
+        const auto small_inv = small.inverse();
+        ASSERT_TRUE(is_close(small_inv(0, 0), 1e4, 1e-6) && small_inv(0, 1) == 0.0);
+        const auto tiny = B * 1e-12;
+        const auto tiny_inv = tiny.inverse();
+        ASSERT_TRUE(math::loosely_equal((tiny * tiny_inv).to_matrix(), I6.to_matrix()));
+    }
+
+    void should_decompose_fixed_size_matrix_and_interoperate_with_matrix() {
+        math::Matrix<double> A(
+            4, 4, {4, 12, -16, 0, 12, 37, -43, 0, -16, -43, 98, 0, 0, 0, 0, 1});
+        const math::SMatrix<double, 3, 3> S(A.block(0, 0, 3, 3));
+        const auto L = math::cholesky(S);
+        ASSERT_TRUE(
+            math::loosely_equal(L.to_matrix(), math::cholesky(A.block(0, 0, 3, 3))));
+        ASSERT_TRUE(
+            math::loosely_equal((L * L.transposed()).to_matrix(), S.to_matrix()));
+
+        // Write back into a block of a dynamic matrix through the view
+        A.block(1, 1, 3, 3) = S.view();
+        ASSERT_TRUE(A.at(3, 3) == 98.0 && A.at(1, 1) == 4.0);
+
+        const math::SVector<double, 3> x(1, 2, 3);
+        const math::Vector<double> y = S.to_matrix() * x.to_vector();
+        ASSERT_TRUE((math::SVector<double, 3>(y) == S * x));
+
+        bool thrown = false;
+        try {
+            math::SMatrix<double, 2, 2> wrong(A);
+            static_cast<void>(wrong);
+        } catch (const std::invalid_argument&) {
+            thrown = true;
+        }
+        ASSERT_TRUE(thrown);
+    }
+
 public:
     int run_all_tests() override {
         should_construct_empty_matrix_with_zero_rows_and_columns();
@@ -907,6 +2067,9 @@ public:
         should_construct_from_std_array();
         should_construct_from_initializer_list();
         should_throw_if_initializer_list_size_mismatch();
+        should_allocate_aligned_storage();
+        should_construct_padded_and_uninitialised_matrices();
+        should_allocate_from_memory_resource();
         should_return_true_for_square_matrix();
         should_return_true_for_symmetric_matrix();
         should_return_true_for_triangular_matrix();
@@ -928,24 +2091,54 @@ public:
         should_make_identity_matrix();
         should_transpose_square_matrix_in_place();
         should_return_transposed_copy_for_non_square_matrix();
+        should_transpose_rectangular_matrix_in_place();
+        should_transpose_large_matrix_with_cache_oblivious_kernel();
+        transpose_time_test();
         should_correctly_perform_unary_minus();
         should_check_equality_between_identical_matrices();
         should_not_be_equal_if_any_element_differs();
         should_add_two_matrices_of_same_size();
         should_add_scalar_and_matrix();
         should_subtract_two_matrices_of_same_size();
+        should_evaluate_fused_element_wise_expression();
         should_subtract_scalar_and_matrix();
         should_multiply_matrix_and_scalar();
         should_multiply_matrices();
         should_multiply_matrix_and_vector();
+        should_multiply_odd_sized_matrices_with_packed_kernel();
         matmul_time_test();
+        should_multiply_mixed_precision_matrices();
+        should_accumulate_float_products_in_double();
+        should_multiply_strided_batch_of_small_matrices();
+        should_multiply_batch_of_views();
+        should_multiply_with_strassen_winograd();
+        strassen_time_test();
+        should_compute_gemv_and_gevm_in_place();
+        gemv_time_test();
+        should_view_blocks_rows_and_columns_without_copying();
+        should_handle_aliasing_views_in_assignment();
+        should_multiply_and_decompose_views();
         should_throw_if_plu_called_on_non_square_matrix();
         should_throw_for_singular_matrix();
         should_correctly_perform_plu_decomposition_on_small_matrix();
         should_correctly_handle_identity_matrix_in_plu();
         should_correctly_decompose_upper_triangular_matrix();
         should_correctly_handle_negative_pivots_in_plu();
+        should_factor_in_place_with_getrf();
+        should_factor_recursively_with_getrf();
         plu_time_test();
+        should_correctly_perform_qr_decomposition_on_small_matrix();
+        should_qr_decompose_tall_and_wide_matrices();
+        qr_time_test();
+        should_compute_eigenpairs_of_small_symmetric_matrix();
+        should_compute_eigenpairs_of_large_symmetric_matrix();
+        eigh_time_test();
+        should_compute_top_eigenpairs_with_eigsh();
+        should_compute_svd_of_small_matrix();
+        should_compute_svd_of_tall_wide_and_singular_matrices();
+        should_compute_pseudo_inverse_with_svd();
+        should_approximate_leading_triplets_with_randomized_svd();
+        svd_time_test();
         should_decompose_identity_matrix();
         should_decompose_known_small_matrix();
         should_correctly_decompose_for_known_example();
@@ -953,6 +2146,7 @@ public:
         should_reconstruct_from_random_b_times_b_t();
         should_throw_if_non_symmetric();
         should_throw_if_not_positive_definite();
+        should_factor_across_tiles_with_task_cholesky();
         should_auto_convert_int_matrix_to_double_in_cholesky();
         should_preserve_float_type_in_cholesky();
         should_preserve_double_type_in_cholesky();
@@ -961,6 +2155,9 @@ public:
         should_handle_int_identity_matrix_in_cholesky();
         should_handle_diagonal_int_matrix_in_cholesky();
         cholesky_time_test();
+        should_construct_and_multiply_fixed_size_matrices_at_compile_time();
+        should_invert_and_take_determinant_of_fixed_size_matrices();
+        should_decompose_fixed_size_matrix_and_interoperate_with_matrix();
         return 0;
     }
 };
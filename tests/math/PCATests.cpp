@@ -0,0 +1,236 @@
+#include "ITest.hpp"
+#include "MafLib/main/GlobalHeader.hpp"
+#include "MafLib/math/linalg/LinAlg.hpp"
+#include "MafLib/math/linalg/PCA.hpp"
+
+namespace maf::test {
+
+using namespace maf;
+using namespace util;
+using namespace std::chrono;
+class PCATests : public ITest {
+private:
+    /**
+     * @brief rows x cols returns of a factor model: `factors` factors with
+     * volatilities 10, 8, 6.4, ..., idiosyncratic noise of size `noise` and
+     * a non-zero mean.
+     */
+    static math::Matrix<double> factor_returns(
+        size_t rows, size_t cols, size_t factors, double noise, uint32 seed) {
+        std::mt19937 gen(seed);
+        std::normal_distribution<> dis(0.0, 1.0);
+        math::Matrix<double> loadings(cols, factors);
+        for (size_t i = 0; i < cols; ++i) {
+            for (size_t j = 0; j < factors; ++j) {
+                loadings(i, j) = dis(gen);
+            }
+        }
+        const auto axes = math::qr(loadings).first;
+        math::Matrix<double> result(rows, cols);
+        for (size_t i = 0; i < rows; ++i) {
+            for (size_t j = 0; j < factors; ++j) {
+                const double volatility = 10.0 * std::pow(0.8, static_cast<double>(j));
+                const double f = dis(gen) * volatility;
+                for (size_t t = 0; t < cols; ++t) {
+                    result(i, t) += f * axes(t, j);
+                }
+            }
+            for (size_t t = 0; t < cols; ++t) {
+                result(i, t) += (noise * dis(gen)) + (0.01 * static_cast<double>(t));
+            }
+        }
+        return result;
+    }
+
+    /** @brief The exact eigenpairs of the sample covariance, descending. */
+    static std::pair<std::vector<double>, math::Matrix<double>> exact_pca(
+        const math::Matrix<double>& data) {
+        const size_t m = data.row_count();
+        const size_t d = data.column_count();
+        math::Matrix<double> centered = data;
+        for (size_t j = 0; j < d; ++j) {
+            double mean = 0.0;
+            for (size_t i = 0; i < m; ++i) {
+                mean += data(i, j);
+            }
+            mean /= static_cast<double>(m);
+            for (size_t i = 0; i < m; ++i) {
+                centered(i, j) -= mean;
+            }
+        }
+        const math::Matrix<double> covariance =
+            centered.transposed() * centered / static_cast<double>(m - 1);
+        const auto [values, vectors] = math::eigh(covariance);
+        std::vector<double> variances(d);
+        math::Matrix<double> axes(d, d);
+        for (size_t j = 0; j < d; ++j) {
+            variances[j] = values[d - 1 - j];
+            for (size_t i = 0; i < d; ++i) {
+                axes(i, j) = vectors(i, d - 1 - j);
+            }
+        }
+        return std::make_pair(std::move(variances), std::move(axes));
+    }
+
+    /**
+     * @brief Whether the first k components match the exact ones: relative
+     * variance error and 1 - |cos| of the axes below eps.
+     */
+    static bool matches_exact(const math::PCA<double>& model,
+                              const std::vector<double>& variances,
+                              const math::Matrix<double>& axes,
+                              double eps) {
+        const size_t k = model.component_count();
+        const auto explained = model.explained_variance();
+        bool matches = true;
+        for (size_t j = 0; j < k; ++j) {
+            matches =
+                matches && std::abs(explained[j] - variances[j]) < eps * variances[j];
+            double cosine = 0.0;
+            for (size_t i = 0; i < model.feature_count(); ++i) {
+                cosine += model.components()(i, j) * axes(i, j);
+            }
+            matches = matches && 1.0 - std::abs(cosine) < eps;
+        }
+        return matches;
+    }
+
+    //=============================================================================
+    // RANDOMIZED PCA TESTS
+    //=============================================================================
+    void should_fit_randomized_pca() {
+        const size_t k = 5;
+        const auto data = factor_returns(2000, 120, k, 0.1, 3);
+        const auto [variances, axes] = exact_pca(data);
+
+        const auto model = math::pca(data, k);
+        ASSERT_TRUE(model.row_count() == 2000 && model.component_count() == k);
+        ASSERT_TRUE(matches_exact(model, variances, axes, 1e-8));
+
+        const auto ratio = model.explained_variance_ratio();
+        const double total = std::accumulate(variances.begin(), variances.end(), 0.0);
+        ASSERT_TRUE(is_close(ratio[0], variances[0] / total, 1e-10));
+
+        // Projections are the centered rows times the axes
+        const auto scores = model.transform(data.block(0, 0, 10, 120));
+        const auto mean = model.mean();
+        bool projects = scores.row_count() == 10 && scores.column_count() == k;
+        for (size_t i = 0; i < 10; ++i) {
+            for (size_t j = 0; j < k; ++j) {
+                double score = 0.0;
+                for (size_t t = 0; t < 120; ++t) {
+                    score += (data(i, t) - mean[t]) * model.components()(t, j);
+                }
+                projects = projects && is_close(scores(i, j), score, 1e-10);
+            }
+        }
+        ASSERT_TRUE(projects);
+
+        // A view of integer data is analysed in double without a copy
+        math::Matrix<int> counts(50, 8);
+        for (size_t i = 0; i < 50; ++i) {
+            for (size_t j = 0; j < 8; ++j) {
+                counts(i, j) = static_cast<int>((i * (j + 1)) % 7);
+            }
+        }
+        const auto int_model = math::pca(counts.t().t(), 3);
+        ASSERT_TRUE(matches_exact(int_model,
+                                  exact_pca(counts.cast<double>()).first,
+                                  exact_pca(counts.cast<double>()).second,
+                                  1e-8));
+
+        bool thrown = false;
+        try {
+            auto too_many = math::pca(data, 121);
+        } catch (const std::invalid_argument& e) {
+            thrown = true;
+        }
+        ASSERT_TRUE(thrown);
+    }
+
+    //=============================================================================
+    // INCREMENTAL PCA TESTS
+    //=============================================================================
+    void should_update_pca_incrementally() {
+        const size_t k = 5;
+        const size_t m = 2000;
+        const size_t d = 120;
+        const auto data = factor_returns(m, d, k, 0.01, 4);
+        const auto [variances, axes] = exact_pca(data);
+
+        math::PCA<double> model(d, k);
+        // A first batch smaller than k keeps fewer components
+        model.add_rows(data.block(0, 0, 3, d));
+        ASSERT_TRUE(model.component_count() <= 3);
+        for (size_t first = 3; first < m; first += 100) {
+            model.add_rows(data.block(first, 0, std::min<size_t>(100, m - first), d));
+        }
+        ASSERT_TRUE(model.row_count() == m && model.component_count() == k);
+        ASSERT_TRUE(matches_exact(model, variances, axes, 1e-4));
+
+        const auto mean = model.mean();
+        bool mean_matches = true;
+        for (size_t j = 0; j < d; ++j) {
+            double expected = 0.0;
+            for (size_t i = 0; i < m; ++i) {
+                expected += data(i, j);
+            }
+            expected /= static_cast<double>(m);
+            mean_matches = mean_matches && is_close(mean[j], expected, 1e-10);
+        }
+        ASSERT_TRUE(mean_matches);
+
+        // Batches continue a randomized fit
+        math::PCA<double> rolled(d, k);
+        rolled.fit(data.block(0, 0, m / 2, d));
+        rolled.add_rows(data.block(m / 2, 0, m / 2, d));
+        ASSERT_TRUE(matches_exact(rolled, variances, axes, 1e-4));
+
+        bool thrown = false;
+        try {
+            model.add_rows(math::Matrix<double>(4, d + 1));
+        } catch (const std::invalid_argument& e) {
+            thrown = true;
+        }
+        ASSERT_TRUE(thrown);
+    }
+
+    void pca_time_test() {
+        const size_t m = 20000;
+        const size_t d = 500;
+        const size_t k = 10;
+        const auto data = factor_returns(m, d, k, 0.5, 5);
+
+        auto start = high_resolution_clock::now();
+        const auto model = math::pca(data, k);
+        duration<double> randomized_elapsed = high_resolution_clock::now() - start;
+
+        start = high_resolution_clock::now();
+        math::PCA<double> streamed(d, k);
+        for (size_t first = 0; first < m; first += 1000) {
+            streamed.add_rows(data.block(first, 0, 1000, d));
+        }
+        duration<double> incremental_elapsed = high_resolution_clock::now() - start;
+
+        start = high_resolution_clock::now();
+        const auto [variances, axes] = exact_pca(data);
+        duration<double> exact_elapsed = high_resolution_clock::now() - start;
+
+        std::cout << "PCA " << m << " x " << d << ", " << k
+                  << " components: randomized: " << randomized_elapsed.count()
+                  << " s, incremental: " << incremental_elapsed.count()
+                  << " s, covariance + eigh: " << exact_elapsed.count() << " s\n";
+        ASSERT_TRUE(matches_exact(model, variances, axes, 1e-2));
+        ASSERT_TRUE(matches_exact(streamed, variances, axes, 1e-2));
+    }
+
+public:
+    int run_all_tests() override {
+        should_fit_randomized_pca();
+        should_update_pca_incrementally();
+        pca_time_test();
+        return 0;
+    }
+};
+
+}  // namespace maf::test
@@ -0,0 +1,430 @@
+#include "ITest.hpp"
+#include "MafLib/main/GlobalHeader.hpp"
+#include "MafLib/math/linalg/LinAlg.hpp"
+#include "MafLib/math/linalg/SparseCholesky.hpp"
+#include "MafLib/math/linalg/SparseMatrix.hpp"
+
+namespace maf::test {
+
+using namespace maf;
+using namespace util;
+using namespace std::chrono;
+class SparseMatrixTests : public ITest {
+private:
+    /** @brief A random rows x cols matrix with about density * size non-zeros. */
+    static math::SparseMatrix<double> random_sparse(size_t rows,
+                                                    size_t cols,
+                                                    double density,
+                                                    uint32 seed) {
+        std::mt19937 gen(seed);
+        std::uniform_real_distribution<> dis(-1.0, 1.0);
+        std::uniform_int_distribution<size_t> row(0, rows - 1);
+        std::uniform_int_distribution<size_t> col(0, cols - 1);
+        std::vector<math::Triplet<double>> triplets;
+        const auto size = static_cast<double>(rows * cols);
+        const auto count = static_cast<size_t>(density * size);
+        for (size_t k = 0; k < count; ++k) {
+            triplets.push_back({row(gen), col(gen), dis(gen)});
+        }
+        // One dense row, to unbalance the row split
+        for (size_t j = 0; j < cols; ++j) {
+            triplets.push_back({rows / 2, j, dis(gen)});
+        }
+        return math::SparseMatrix<double>(rows, cols, triplets);
+    }
+
+    /**
+     * @brief The 5-point Laplacian of a side x side grid plus shift * I,
+     * with both triangles stored.
+     */
+    static math::SparseMatrix<double> grid_laplacian(size_t side, double shift) {
+        std::vector<math::Triplet<double>> triplets;
+        const auto at = [&](size_t x, size_t y) { return (y * side) + x; };
+        for (size_t y = 0; y < side; ++y) {
+            for (size_t x = 0; x < side; ++x) {
+                triplets.push_back({at(x, y), at(x, y), 4.0 + shift});
+                if (x + 1 < side) {
+                    triplets.push_back({at(x, y), at(x + 1, y), -1.0});
+                    triplets.push_back({at(x + 1, y), at(x, y), -1.0});
+                }
+                if (y + 1 < side) {
+                    triplets.push_back({at(x, y), at(x, y + 1), -1.0});
+                    triplets.push_back({at(x, y + 1), at(x, y), -1.0});
+                }
+            }
+        }
+        const size_t n = side * side;
+        return math::SparseMatrix<double>(n, n, triplets);
+    }
+
+    /** @brief max |A x - b|. */
+    static double residual(const math::SparseMatrix<double>& a,
+                           const math::Vector<double>& x,
+                           const math::Vector<double>& b) {
+        const auto ax = a * x;
+        double worst = 0.0;
+        for (size_t i = 0; i < b.size(); ++i) {
+            worst = std::max(worst, std::abs(ax[i] - b[i]));
+        }
+        return worst;
+    }
+
+    //=============================================================================
+    // SPARSE MATRIX CONSTRUCTION TESTS
+    //=============================================================================
+    void should_build_csr_from_unsorted_triplets_with_duplicates() {
+        const std::vector<math::Triplet<int>> triplets = {
+            {2, 1, 5}, {0, 3, 1}, {0, 0, 2}, {2, 1, 4}, {1, 2, -3}, {0, 3, 6}};
+        const math::SparseMatrix<int> a(3, 4, triplets);
+
+        ASSERT_TRUE(a.row_count() == 3 && a.column_count() == 4);
+        ASSERT_TRUE(a.non_zero_count() == 4);
+        ASSERT_TRUE(
+            std::ranges::equal(a.row_offsets(), std::vector<size_t>{0, 2, 3, 4}));
+        ASSERT_TRUE(
+            std::ranges::equal(a.column_indices(), std::vector<size_t>{0, 3, 2, 1}));
+        ASSERT_TRUE(std::ranges::equal(a.values(), std::vector<int>{2, 7, -3, 9}));
+        ASSERT_TRUE(a.at(0, 3) == 7 && a.at(2, 1) == 9 && a.at(1, 1) == 0);
+        ASSERT_TRUE(a.to_dense() ==
+                    math::Matrix<int>(3, 4, {2, 0, 0, 7, 0, 0, -3, 0, 0, 9, 0, 0}));
+
+        const std::vector<size_t> rows = {1, 0, 1};
+        const std::vector<size_t> cols = {0, 1, 0};
+        const std::vector<double> values = {1.5, 2.0, 0.5};
+        const math::SparseMatrix<double> b(2, 2, rows, cols, values);
+        ASSERT_TRUE(b.non_zero_count() == 2 && b.at(1, 0) == 2.0);
+
+        bool thrown = false;
+        try {
+            const std::vector<math::Triplet<int>> outside = {{3, 0, 1}};
+            math::SparseMatrix<int> c(3, 4, outside);
+        } catch (const std::out_of_range& e) {
+            thrown = true;
+        }
+        ASSERT_TRUE(thrown);
+    }
+
+    void should_validate_csr_arrays() {
+        const std::vector<size_t> offsets = {0, 1, 3};
+        const std::vector<size_t> indices = {1, 0, 2};
+        const std::vector<float> values = {1.0F, 2.0F, 3.0F};
+        const auto a =
+            math::SparseMatrix<float>::from_csr(2, 3, offsets, indices, values);
+        ASSERT_TRUE(a.at(0, 1) == 1.0F && a.at(1, 2) == 3.0F);
+
+        const std::vector<size_t> unsorted = {1, 2, 0};
+        bool thrown = false;
+        try {
+            auto b =
+                math::SparseMatrix<float>::from_csr(2, 3, offsets, unsorted, values);
+        } catch (const std::invalid_argument& e) {
+            thrown = true;
+        }
+        ASSERT_TRUE(thrown);
+
+        thrown = false;
+        try {
+            math::SparseMatrix<float> c(0, 3);
+        } catch (const std::invalid_argument& e) {
+            thrown = true;
+        }
+        ASSERT_TRUE(thrown);
+    }
+
+    void should_convert_between_dense_csr_and_csc() {
+        const math::Matrix<double> dense(
+            3, 4, {0.0, 1.0, 0.0, 1e-12, 2.0, 0.0, 0.0, 3.0, 0.0, 0.0, 4.0, 0.0});
+        const math::SparseMatrix<double> a(dense, 1e-9);
+        ASSERT_TRUE(a.non_zero_count() == 4);
+        ASSERT_TRUE(is_close(a.density(), 4.0 / 12.0));
+
+        // The CSR arrays of A^T are the CSC arrays of A
+        const auto csc = a.transposed();
+        ASSERT_TRUE(std::ranges::equal(csc.row_offsets(),
+                                       std::vector<size_t>{0, 1, 2, 3, 4}));
+        ASSERT_TRUE(std::ranges::equal(csc.column_indices(),
+                                       std::vector<size_t>{1, 0, 2, 1}));
+        ASSERT_TRUE(csc.to_dense() == a.to_dense().transposed());
+        ASSERT_TRUE(csc.transposed() == a);
+    }
+
+    //=============================================================================
+    // SPARSE MATRIX PRODUCT TESTS
+    //=============================================================================
+    void should_multiply_sparse_matrix_and_vectors() {
+        const size_t rows = 300;
+        const size_t cols = 200;
+        const auto a = random_sparse(rows, cols, 0.02, 3);
+        const auto dense = a.to_dense();
+        math::Vector<float> x(cols, math::COLUMN);
+        math::Vector<double> u(rows, math::ROW);
+        for (size_t j = 0; j < cols; ++j) {
+            x[j] = static_cast<float>(j % 7) - 3.0F;
+        }
+        for (size_t i = 0; i < rows; ++i) {
+            u[i] = 0.01 * static_cast<double>(i);
+        }
+
+        const auto ax = a * x;
+        const auto expected_ax = dense * x;
+        static_assert(std::is_same_v<decltype(ax), const math::Vector<double>>);
+        bool matches = true;
+        for (size_t i = 0; i < rows; ++i) {
+            matches = matches && is_close(ax[i], expected_ax[i]);
+        }
+        ASSERT_TRUE(matches);
+
+        const auto ua = u * a;
+        const auto expected_ua = u * dense;
+        const auto atu = a.transpose_multiply(u);
+        ASSERT_TRUE(ua.orientation() == math::ROW);
+        matches = true;
+        for (size_t j = 0; j < cols; ++j) {
+            matches = matches && is_close(ua[j], expected_ua[j]) &&
+                      is_close(atu[j], expected_ua[j]);
+        }
+        ASSERT_TRUE(matches);
+
+        // In place: y = 2 * A * x - y and z = u^T * A + z
+        math::Vector<double> y(rows, math::COLUMN);
+        math::Vector<double> z(cols, math::ROW);
+        y.fill(1.0);
+        z.fill(1.0);
+        math::spmv(2.0, a, x, -1.0, y);
+        math::spvm(1.0, u, a, 1.0, z);
+        matches = true;
+        for (size_t i = 0; i < rows; ++i) {
+            matches = matches && is_close(y[i], (2.0 * expected_ax[i]) - 1.0);
+        }
+        for (size_t j = 0; j < cols; ++j) {
+            matches = matches && is_close(z[j], expected_ua[j] + 1.0);
+        }
+        ASSERT_TRUE(matches);
+
+        bool thrown = false;
+        try {
+            math::spmv(1.0, a, u, 0.0, y);
+        } catch (const std::invalid_argument& e) {
+            thrown = true;
+        }
+        ASSERT_TRUE(thrown);
+    }
+
+    void should_multiply_sparse_and_dense_matrices() {
+        const auto a = random_sparse(120, 90, 0.05, 7);
+        const auto dense = a.to_dense();
+        math::Matrix<double> b(90, 33);
+        math::Matrix<double> c(120, 17);
+        for (size_t i = 0; i < 90; ++i) {
+            for (size_t j = 0; j < 33; ++j) {
+                b(i, j) = std::sin(static_cast<double>((i * 33) + j));
+            }
+        }
+        for (size_t i = 0; i < 120; ++i) {
+            for (size_t j = 0; j < 17; ++j) {
+                c(i, j) = std::cos(static_cast<double>((i * 17) + j));
+            }
+        }
+
+        ASSERT_TRUE(math::loosely_equal(a * b, dense * b));
+        // Strided operands and expressions
+        ASSERT_TRUE(math::loosely_equal(a * b.t().t(), dense * b));
+        const auto top = c.block(0, 0, 90, 17);
+        ASSERT_TRUE(math::loosely_equal(a * top, dense * top));
+        ASSERT_TRUE(math::loosely_equal(a * (b + b), dense * (b * 2.0)));
+        // A^T * C without forming A^T
+        ASSERT_TRUE(math::loosely_equal(a.transpose_multiply(c), dense.t() * c));
+        ASSERT_TRUE(math::loosely_equal(a.transpose_multiply(c.t().t()),
+                                        a.transposed() * c));
+    }
+
+    void spmv_time_test() {
+        // About 10 non-zeros per row, like a discretized operator
+        const size_t n = 200000;
+        const auto a = random_sparse(n, n, 10.0 / static_cast<double>(n), 13);
+        math::Vector<double> x(n, math::COLUMN);
+        math::Vector<double> y(n, math::COLUMN);
+        x.fill(1.0);
+
+        auto start = high_resolution_clock::now();
+        for (int r = 0; r < 10; ++r) {
+            math::spmv(1.0, a, x, 0.0, y);
+        }
+        duration<double> spmv_elapsed = high_resolution_clock::now() - start;
+        start = high_resolution_clock::now();
+        for (int r = 0; r < 10; ++r) {
+            math::spvm(1.0, x, a, 0.0, y);
+        }
+        duration<double> spvm_elapsed = high_resolution_clock::now() - start;
+
+        std::cout << "10 x SpMV with " << a.non_zero_count()
+                  << " non-zeros: " << spmv_elapsed.count()
+                  << " s, transposed: " << spvm_elapsed.count() << " s\n";
+        ASSERT_TRUE(y.size() == n);
+    }
+
+    void should_compute_top_eigenpairs_of_sparse_matrix() {
+        // Eigenvalues of the grid Laplacian: 4 - 2 cos(i pi / 21) - 2 cos(j pi / 21)
+        const size_t side = 20;
+        const auto a = grid_laplacian(side, 0.0);
+        const size_t n = a.row_count();
+        std::vector<double> exact;
+        const double h = std::acos(-1.0) / static_cast<double>(side + 1);
+        for (size_t i = 1; i <= side; ++i) {
+            for (size_t j = 1; j <= side; ++j) {
+                exact.push_back(4.0 - (2.0 * std::cos(static_cast<double>(i) * h)) -
+                                (2.0 * std::cos(static_cast<double>(j) * h)));
+            }
+        }
+        std::ranges::sort(exact, std::greater<>());
+
+        const size_t k = 4;
+        const auto [values, vectors] = math::eigsh(a, k);
+        const auto dense = a.to_dense();
+        bool matches = true;
+        for (size_t j = 0; j < k; ++j) {
+            matches = matches && is_close(values[j], exact[j], 1e-8);
+            double residual = 0.0;
+            for (size_t i = 0; i < n; ++i) {
+                double row = -values[j] * vectors(i, j);
+                for (size_t t = 0; t < n; ++t) {
+                    row += dense(i, t) * vectors(t, j);
+                }
+                residual = std::max(residual, std::abs(row));
+            }
+            matches = matches && residual < 1e-6;
+        }
+        ASSERT_TRUE(matches);
+    }
+
+    //=============================================================================
+    // SPARSE CHOLESKY TESTS
+    //=============================================================================
+    void should_factor_and_solve_sparse_spd_system() {
+        const auto a = grid_laplacian(30, 0.01);
+        const size_t n = a.row_count();
+        math::Vector<double> b(n, math::COLUMN);
+        for (size_t i = 0; i < n; ++i) {
+            b[i] = std::sin(static_cast<double>(i));
+        }
+
+        const math::SparseCholesky<double> natural(a, math::NATURAL_ORDERING);
+        const math::SparseCholesky<double> amd(a);
+        ASSERT_TRUE(residual(a, natural.solve(b), b) < 1e-10);
+        ASSERT_TRUE(residual(a, amd.solve(b), b) < 1e-10);
+        // The fill-reducing ordering must actually reduce the fill
+        ASSERT_TRUE(amd.analysis().factor_non_zero_count() <
+                    natural.analysis().factor_non_zero_count() / 2);
+        ASSERT_TRUE(amd.analysis().supernode_count() < n);
+        ASSERT_TRUE(is_close(amd.log_determinant(), natural.log_determinant()));
+
+        // P A P^T = L L^T, checked densely
+        const auto& perm = amd.analysis().permutation();
+        const auto dense = a.to_dense();
+        math::Matrix<double> pap(n, n);
+        for (size_t i = 0; i < n; ++i) {
+            for (size_t j = 0; j < n; ++j) {
+                pap(i, j) = dense(perm[i], perm[j]);
+            }
+        }
+        const auto l = amd.factor().to_dense();
+        ASSERT_TRUE(amd.factor().non_zero_count() ==
+                    amd.analysis().factor_non_zero_count());
+        ASSERT_TRUE(math::loosely_equal(l * l.transposed(), pap, 1e-9));
+    }
+
+    void should_refactor_with_the_same_analysis() {
+        // Only the lower triangle stored
+        std::vector<math::Triplet<double>> triplets;
+        const size_t n = 200;
+        for (size_t i = 0; i < n; ++i) {
+            triplets.push_back({i, i, 10.0});
+            triplets.push_back({i, (i * 7) % (i + 1), 0.5});
+            if (i >= 3) {
+                triplets.push_back({i, i - 3, -1.0});
+            }
+        }
+        math::SparseMatrix<double> a(n, n, triplets);
+        math::Vector<double> b(n, math::COLUMN);
+        b.fill(1.0);
+
+        math::SparseCholesky<double> chol{math::SparseCholeskyAnalysis(a)};
+        for (int tick = 0; tick < 3; ++tick) {
+            for (double& value : a.values()) {
+                value *= 1.5;
+            }
+            chol.factorize(a);
+            const auto x = chol.solve(b);
+
+            // Residual against the symmetric matrix the lower triangle stands for
+            const auto lower = a.to_dense();
+            math::Matrix<double> sym = lower + lower.transposed();
+            for (size_t i = 0; i < n; ++i) {
+                sym(i, i) = lower(i, i);
+            }
+            const auto ax = sym * x;
+            double worst = 0.0;
+            for (size_t i = 0; i < n; ++i) {
+                worst = std::max(worst, std::abs(ax[i] - b[i]));
+            }
+            ASSERT_TRUE(worst < 1e-10);
+        }
+
+        bool thrown = false;
+        try {
+            chol.factorize(grid_laplacian(3, 0.0));
+        } catch (const std::invalid_argument& e) {
+            thrown = true;
+        }
+        ASSERT_TRUE(thrown);
+
+        thrown = false;
+        try {
+            math::SparseCholesky<double> indefinite(grid_laplacian(10, -5.0));
+        } catch (const std::invalid_argument& e) {
+            thrown = true;
+        }
+        ASSERT_TRUE(thrown);
+    }
+
+    void sparse_cholesky_time_test() {
+        const auto a = grid_laplacian(300, 0.01);
+        math::Vector<double> b(a.row_count(), math::COLUMN);
+        b.fill(1.0);
+
+        auto start = high_resolution_clock::now();
+        math::SparseCholesky<double> chol{math::SparseCholeskyAnalysis(a)};
+        duration<double> analysis_elapsed = high_resolution_clock::now() - start;
+        start = high_resolution_clock::now();
+        chol.factorize(a);
+        duration<double> factor_elapsed = high_resolution_clock::now() - start;
+        start = high_resolution_clock::now();
+        const auto x = chol.solve(b);
+        duration<double> solve_elapsed = high_resolution_clock::now() - start;
+
+        std::cout << "Sparse Cholesky of a " << a.row_count()
+                  << " node grid Laplacian (nnz(L) = "
+                  << chol.analysis().factor_non_zero_count()
+                  << "): analysis " << analysis_elapsed.count() << " s, factorization "
+                  << factor_elapsed.count() << " s, solve " << solve_elapsed.count()
+                  << " s\n";
+        ASSERT_TRUE(residual(a, x, b) < 1e-8);
+    }
+
+public:
+    int run_all_tests() override {
+        should_build_csr_from_unsorted_triplets_with_duplicates();
+        should_validate_csr_arrays();
+        should_convert_between_dense_csr_and_csc();
+        should_multiply_sparse_matrix_and_vectors();
+        should_multiply_sparse_and_dense_matrices();
+        spmv_time_test();
+        should_compute_top_eigenpairs_of_sparse_matrix();
+        should_factor_and_solve_sparse_spd_system();
+        should_refactor_with_the_same_analysis();
+        sparse_cholesky_time_test();
+        return 0;
+    }
+};
+
+}  // namespace maf::test
@@ -0,0 +1,205 @@
+#include "ITest.hpp"
+#include "MafLib/main/GlobalHeader.hpp"
+#include "MafLib/math/linalg/LinAlg.hpp"
+#include "MafLib/math/linalg/SymmetricMatrix.hpp"
+#include "TestMatrices.hpp"
+
+namespace maf::test {
+
+using namespace maf;
+using namespace util;
+using namespace std::chrono;
+class SymmetricMatrixTests : public ITest {
+private:
+    //=============================================================================
+    // SYMMETRIC MATRIX STORAGE TESTS
+    //=============================================================================
+    void should_store_lower_tiles_only() {
+        // 150 = 2 full tiles + a partial one
+        const size_t n = 150;
+        const auto dense = random_spd(n, 1);
+        const math::SymmetricMatrix<double> a(dense);
+
+        ASSERT_TRUE(a.tile_size() == 64 && a.tile_count() == 3);
+        ASSERT_TRUE(a.storage_size() == 6 * 64 * 64);
+        // About half of the dense storage once n is large against the tiles
+        ASSERT_TRUE(math::SymmetricMatrix<double>(2048).storage_size() <
+                    2048 * 2048 * 52 / 100);
+        ASSERT_TRUE(a.to_dense() == dense);
+        ASSERT_TRUE(a(3, 120) == dense(120, 3) && a.at(120, 3) == dense(3, 120));
+
+        // Writing one side writes the other
+        math::SymmetricMatrix<double> b(3);
+        b(0, 2) = 5.0;
+        ASSERT_TRUE(b(2, 0) == 5.0 && b.tile_count() == 1 && b.storage_size() == 9);
+
+        bool thrown = false;
+        try {
+            static_cast<void>(a.at(n, 0));
+        } catch (const std::out_of_range& e) {
+            thrown = true;
+        }
+        ASSERT_TRUE(thrown);
+
+        thrown = false;
+        try {
+            math::SymmetricMatrix<double> rectangular(random_dense(3, 4, 2));
+        } catch (const std::invalid_argument& e) {
+            thrown = true;
+        }
+        ASSERT_TRUE(thrown);
+
+        ASSERT_TRUE(dense.is_symmetric());
+        math::Matrix<double> perturbed = dense;
+        perturbed(140, 70) += 1.0;
+        ASSERT_TRUE(!perturbed.is_symmetric());
+    }
+
+    //=============================================================================
+    // SYMMETRIC KERNEL TESTS
+    //=============================================================================
+    void should_multiply_with_symv_and_symm() {
+        const size_t n = 200;
+        const auto dense = random_spd(n, 3);
+        const math::SymmetricMatrix<double> a(dense);
+
+        math::Vector<double> x(n, math::COLUMN);
+        for (size_t i = 0; i < n; ++i) {
+            x[i] = std::sin(static_cast<double>(i));
+        }
+        const auto expected = dense * x;
+        const auto ax = a * x;
+        double worst = 0.0;
+        for (size_t i = 0; i < n; ++i) {
+            worst = std::max(worst, std::abs(ax[i] - expected[i]));
+        }
+        ASSERT_TRUE(worst < 1e-10);
+
+        math::Vector<double> y(n, math::COLUMN);
+        y.fill(1.0);
+        math::symv(2.0, a, x, -1.0, y);
+        worst = 0.0;
+        for (size_t i = 0; i < n; ++i) {
+            worst = std::max(worst, std::abs(y[i] - ((2.0 * expected[i]) - 1.0)));
+        }
+        ASSERT_TRUE(worst < 1e-10);
+
+        const auto b = random_dense(n, 37, 4);
+        ASSERT_TRUE(math::loosely_equal(a * b, dense * b, 1e-10));
+        // A transposed (strided) operand
+        const auto bt = random_dense(37, n, 5);
+        ASSERT_TRUE(math::loosely_equal(a * bt.t(), dense * bt.t(), 1e-10));
+
+        math::Matrix<double> c = random_dense(n, 37, 6);
+        const math::Matrix<double> c0 = c;
+        math::symm(0.5, a, b, 2.0, c);
+        ASSERT_TRUE(math::loosely_equal(c, (dense * b) * 0.5 + c0 * 2.0, 1e-10));
+    }
+
+    void should_compute_one_triangle_with_syrk() {
+        const auto a = random_dense(130, 70, 7);
+        const auto expected = a * a.transposed();
+        const auto c = math::syrk(a);
+        ASSERT_TRUE(c.size() == 130);
+        ASSERT_TRUE(math::loosely_equal(c.to_dense(), expected, 1e-10));
+
+        // A^T A through a transposed view, accumulated onto an existing C
+        math::SymmetricMatrix<double> gram(random_spd(70, 8));
+        const auto before = gram.to_dense();
+        math::syrk(2.0, a.t(), 1.0, gram);
+        ASSERT_TRUE(math::loosely_equal(
+            gram.to_dense(), before + (a.transposed() * a) * 2.0, 1e-10));
+        // The upper halves of the diagonal tiles stay zero
+        bool upper_zero = true;
+        for (size_t r = 0; r < gram.tile_size(); ++r) {
+            for (size_t s = r + 1; s < gram.tile_size(); ++s) {
+                upper_zero = upper_zero && gram.tile(0, 0)[(r * 64) + s] == 0.0;
+            }
+        }
+        ASSERT_TRUE(upper_zero);
+    }
+
+    void should_factor_symmetric_matrix_with_cholesky() {
+        const size_t n = 300;
+        const auto dense = random_spd(n, 9);
+        const math::SymmetricMatrix<double> a(dense);
+
+        const auto l = math::cholesky(a).to_dense();
+        ASSERT_TRUE(l.is_lower_triangular());
+        ASSERT_TRUE(math::loosely_equal(l * l.transposed(), dense, 1e-9));
+        ASSERT_TRUE(math::loosely_equal(l, math::cholesky(dense), 1e-9));
+
+        math::SymmetricMatrix<double> indefinite(a);
+        indefinite(250, 250) = -1.0;
+        bool thrown = false;
+        try {
+            static_cast<void>(math::cholesky(indefinite));
+        } catch (const std::invalid_argument& e) {
+            thrown = true;
+        }
+        ASSERT_TRUE(thrown);
+    }
+
+    void should_compute_top_eigenpairs_of_symmetric_matrix() {
+        const size_t n = 300;
+        const auto dense = random_spd(n, 12);
+        const math::SymmetricMatrix<double> a(dense);
+
+        const size_t k = 3;
+        const auto [values, vectors] = math::eigsh(a, k);
+        const auto [all_values, all_vectors] = math::eigh(dense);
+        bool matches = true;
+        for (size_t j = 0; j < k; ++j) {
+            matches = matches && is_close(values[j], all_values[n - 1 - j], 1e-8);
+        }
+        ASSERT_TRUE(matches);
+        ASSERT_TRUE(math::loosely_equal(
+            vectors.transposed() * vectors, math::identity_matrix<double>(k), 1e-10));
+    }
+
+    void symmetric_time_test() {
+        const size_t n = 1024;
+        const auto returns = random_dense(2048, n, 10);
+
+        auto start = high_resolution_clock::now();
+        const auto covariance = math::syrk(returns.t());
+        duration<double> syrk_elapsed = high_resolution_clock::now() - start;
+        start = high_resolution_clock::now();
+        const math::Matrix<double> dense = returns.transposed() * returns;
+        duration<double> gemm_elapsed = high_resolution_clock::now() - start;
+
+        math::Vector<double> x(n, math::COLUMN);
+        x.fill(1.0);
+        start = high_resolution_clock::now();
+        for (int i = 0; i < 10; ++i) {
+            x = covariance * x;
+            x.normalize();
+        }
+        duration<double> symv_elapsed = high_resolution_clock::now() - start;
+
+        start = high_resolution_clock::now();
+        const auto l = math::cholesky(covariance);
+        duration<double> cholesky_elapsed = high_resolution_clock::now() - start;
+
+        std::cout << "Covariance of " << n << " assets: SYRK " << syrk_elapsed.count()
+                  << " s (GEMM " << gemm_elapsed.count() << " s), 10 x SYMV "
+                  << symv_elapsed.count() << " s, tiled Cholesky "
+                  << cholesky_elapsed.count() << " s, storage "
+                  << covariance.storage_size() << " of " << n * n << " elements\n";
+        ASSERT_TRUE(math::loosely_equal(covariance.to_dense(), dense, 1e-8));
+        ASSERT_TRUE(is_close(l(0, 0) * l(0, 0), covariance(0, 0), 1e-8));
+    }
+
+public:
+    int run_all_tests() override {
+        should_store_lower_tiles_only();
+        should_multiply_with_symv_and_symm();
+        should_compute_one_triangle_with_syrk();
+        should_factor_symmetric_matrix_with_cholesky();
+        should_compute_top_eigenpairs_of_symmetric_matrix();
+        symmetric_time_test();
+        return 0;
+    }
+};
+
+}  // namespace maf::test
@@ -0,0 +1,177 @@
+#include "ITest.hpp"
+#include "MafLib/main/GlobalHeader.hpp"
+#include "MafLib/math/linalg/LinAlg.hpp"
+#include "MafLib/math/linalg/SymmetricMatrix.hpp"
+#include "MafLib/math/linalg/TriangularMatrix.hpp"
+#include "TestMatrices.hpp"
+
+namespace maf::test {
+
+using namespace maf;
+using namespace util;
+using namespace std::chrono;
+class TriangularMatrixTests : public ITest {
+private:
+    /** @brief The diagonal of a square matrix as a dense diagonal matrix. */
+    static math::Matrix<double> diagonal_of(const math::Matrix<double>& a) {
+        math::Matrix<double> result(a.row_count(), a.column_count());
+        for (size_t i = 0; i < a.row_count(); ++i) {
+            result(i, i) = a(i, i);
+        }
+        return result;
+    }
+
+    /** @brief Checks trsv and trsm of one triangular kind against dense products. */
+    template <math::Triangle Uplo, math::Diagonal Diag>
+    bool solves_match(size_t n, size_t columns, uint32 seed) {
+        const math::TriangularMatrix<double, Uplo, Diag> a(
+            random_diagonally_dominant(n, seed));
+        const auto dense = a.to_dense();
+        const auto b = random_dense(n, columns, seed + 1);
+        math::Vector<double> v(n, math::COLUMN);
+        for (size_t i = 0; i < n; ++i) {
+            v[i] = b(i, 0);
+        }
+
+        bool matches = true;
+        for (const math::Transpose op : {math::NO_TRANSPOSE, math::TRANSPOSE}) {
+            const math::Matrix<double> op_a =
+                op == math::TRANSPOSE ? dense.transposed() : dense;
+            matches = matches && math::loosely_equal(op_a * a.solve(b, op), b, 1e-10);
+
+            math::Vector<double> x = v;
+            math::trsv(a, x, op);
+            const auto ax = op_a * x;
+            for (size_t i = 0; i < n; ++i) {
+                matches = matches && is_close(ax[i], v[i], 1e-10);
+            }
+        }
+        return matches;
+    }
+
+    //=============================================================================
+    // TRIANGULAR MATRIX STORAGE TESTS
+    //=============================================================================
+    void should_store_one_triangle_in_tiles() {
+        const size_t n = 150;
+        const auto dense = random_diagonally_dominant(n, 1);
+        const math::TriangularMatrix<double> lower(dense);
+        const math::TriangularMatrix<double, math::UPPER> upper(dense);
+        const math::TriangularMatrix<double, math::LOWER, math::UNIT> unit(dense);
+
+        ASSERT_TRUE(lower.storage_size() == 6 * 64 * 64);
+        ASSERT_TRUE(upper.storage_size() == 6 * 64 * 64);
+        ASSERT_TRUE(lower.at(100, 20) == dense(100, 20) && lower.at(20, 100) == 0.0);
+        ASSERT_TRUE(upper.at(20, 100) == dense(20, 100) && upper.at(100, 20) == 0.0);
+        ASSERT_TRUE(unit.at(70, 70) == 1.0 && unit.at(71, 70) == dense(71, 70));
+
+        const auto l = lower.to_dense();
+        const auto u = upper.to_dense();
+        ASSERT_TRUE(l.is_lower_triangular() && u.is_upper_triangular());
+        ASSERT_TRUE(math::loosely_equal(l + u - diagonal_of(dense), dense, 1e-15));
+        ASSERT_TRUE(lower.transposed().to_dense() == l.transposed());
+        const math::TriangularMatrix<double> lower_of_u(u.transposed());
+        ASSERT_TRUE(upper.transposed() == lower_of_u);
+
+        math::Vector<double> x(n, math::COLUMN);
+        for (size_t i = 0; i < n; ++i) {
+            x[i] = std::cos(static_cast<double>(i));
+        }
+        const auto expected = unit.to_dense() * x;
+        const auto ux = unit * x;
+        bool matches = true;
+        for (size_t i = 0; i < n; ++i) {
+            matches = matches && is_close(ux[i], expected[i], 1e-12);
+        }
+        ASSERT_TRUE(matches);
+
+        bool thrown = false;
+        try {
+            static_cast<void>(lower.at(0, n));
+        } catch (const std::out_of_range& e) {
+            thrown = true;
+        }
+        ASSERT_TRUE(thrown);
+    }
+
+    //=============================================================================
+    // TRIANGULAR SOLVER TESTS
+    //=============================================================================
+    void should_solve_every_triangular_kind() {
+        // 200 rows: three full tiles and a partial one; 300 columns: two chunks
+        ASSERT_TRUE((solves_match<math::LOWER, math::NON_UNIT>(200, 300, 2)));
+        ASSERT_TRUE((solves_match<math::LOWER, math::UNIT>(200, 300, 3)));
+        ASSERT_TRUE((solves_match<math::UPPER, math::NON_UNIT>(200, 300, 4)));
+        ASSERT_TRUE((solves_match<math::UPPER, math::UNIT>(200, 300, 5)));
+        ASSERT_TRUE((solves_match<math::LOWER, math::NON_UNIT>(30, 3, 6)));
+
+        bool thrown = false;
+        try {
+            math::Vector<double> wrong(7, math::COLUMN);
+            math::trsv(
+                math::TriangularMatrix<double>(random_diagonally_dominant(8, 7)),
+                wrong);
+        } catch (const std::invalid_argument& e) {
+            thrown = true;
+        }
+        ASSERT_TRUE(thrown);
+    }
+
+    void should_solve_with_packed_cholesky_factor() {
+        const size_t n = 260;
+        const auto g = random_dense(n, n, 8);
+        math::Matrix<double> spd = g * g.transposed();
+        for (size_t i = 0; i < n; ++i) {
+            spd(i, i) += static_cast<double>(n);
+        }
+        const auto l = math::cholesky(math::SymmetricMatrix<double>(spd));
+
+        math::Vector<double> b(n, math::COLUMN);
+        for (size_t i = 0; i < n; ++i) {
+            b[i] = std::sin(static_cast<double>(i));
+        }
+        // A x = b as L y = b, L^T x = y
+        const auto x = l.solve(l.solve(b), math::TRANSPOSE);
+        const auto ax = spd * x;
+        double worst = 0.0;
+        for (size_t i = 0; i < n; ++i) {
+            worst = std::max(worst, std::abs(ax[i] - b[i]));
+        }
+        ASSERT_TRUE(worst < 1e-10);
+    }
+
+    void trsm_time_test() {
+        const size_t n = 1024;
+        const math::TriangularMatrix<double> a(random_diagonally_dominant(n, 9));
+        math::Matrix<double> b = random_dense(n, n, 10);
+        const math::Matrix<double> b0 = b;
+
+        auto start = high_resolution_clock::now();
+        math::trsm(a, b);
+        duration<double> trsm_elapsed = high_resolution_clock::now() - start;
+
+        math::Vector<double> x(n, math::COLUMN);
+        x.fill(1.0);
+        start = high_resolution_clock::now();
+        for (int i = 0; i < 10; ++i) {
+            math::trsv(a, x);
+        }
+        duration<double> trsv_elapsed = high_resolution_clock::now() - start;
+
+        std::cout << "TRSM " << n << " x " << n << " with " << n
+                  << " right-hand sides: " << trsm_elapsed.count() << " s, 10 x TRSV: "
+                  << trsv_elapsed.count() << " s\n";
+        ASSERT_TRUE(math::loosely_equal(a.to_dense() * b, b0, 1e-9));
+    }
+
+public:
+    int run_all_tests() override {
+        should_store_one_triangle_in_tiles();
+        should_solve_every_triangular_kind();
+        should_solve_with_packed_cholesky_factor();
+        trsm_time_test();
+        return 0;
+    }
+};
+
+}  // namespace maf::test
@@ -352,6 +352,28 @@ private:
         ASSERT_TRUE(v_prod2[1] == 15);
     }
 
+    void should_evaluate_fused_vector_expression() {
+        math::Vector<int> v1(3, std::vector<int>{1, 2, 3});
+        math::Vector<double> v2(3, std::vector<double>{0.5, 0.5, 0.5});
+
+        math::Vector result = (2 * v1) - v2 + 1;
+        ASSERT_TRUE(result.size() == 3);
+        ASSERT_TRUE(result[0] == 2.5);
+        ASSERT_TRUE(result[2] == 6.5);
+
+        result = -result + v2;
+        ASSERT_TRUE(result[1] == -4);
+
+        bool thrown = false;
+        try {
+            math::Vector<int> v3(2);
+            static_cast<void>(v1 + v3);
+        } catch (const std::invalid_argument&) {
+            thrown = true;
+        }
+        ASSERT_TRUE(thrown);
+    }
+
     //    void should_calculate_dot_product() {
     //        math::Vector<int> v1(3);
     //        v1[0] = 1;
@@ -501,10 +523,11 @@ public:
         should_check_equality();
         should_perform_unary_minus();
         should_add_two_vectors();
-        //    should_add_scalar_to_vector();
-        //    should_subtract_two_vectors();
-        //    should_subtract_scalar_from_vector();
-        //    should_multiply_vector_by_scalar();
+        should_add_scalar_to_vector();
+        should_subtract_two_vectors();
+        should_subtract_scalar_from_vector();
+        should_multiply_vector_by_scalar();
+        should_evaluate_fused_vector_expression();
         //    should_calculate_dot_product();
         //    should_calculate_outer_product();
         //    should_multiply_row_vector_by_matrix();